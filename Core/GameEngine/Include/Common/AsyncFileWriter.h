@@ -0,0 +1,102 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: AsyncFileWriter.h ////////////////////////////////////////////////////////////////////////
+// Collects many small writes in a ring buffer and appends them to a File on a background thread,
+// so the calling thread does not wait for the disk. The ring buffer is allocated once when the
+// writer is opened, writing into it does not allocate.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+class File;
+
+class AsyncFileWriter
+{
+public:
+	enum
+	{
+		RING_SIZE = 256 * 1024,	///< must be a power of two
+		BLOCK_SIZE = 16 * 1024	///< bytes handed to the thread at once with FLUSH_BLOCKS
+	};
+
+	enum FlushPolicy
+	{
+		FLUSH_BLOCKS,	///< hand over full blocks only and let the operating system decide when they reach the disk
+		FLUSH_COMMITS,	///< hand over every commit and flush it to the operating system, so it survives a crash of the game
+		FLUSH_DISK,		///< hand over every commit and wait until it reached the disk, so it survives a crash of the system
+
+		FLUSH_POLICY_COUNT
+	};
+
+	AsyncFileWriter();
+	~AsyncFileWriter();
+
+	/// Start appending to the end of the file. Without the thread, every write goes straight to the file.
+	void open( File *file, FlushPolicy policy );
+
+	/// Write everything that is left and stop the thread. Does not close the file.
+	void close();
+
+	Bool isOpen() const { return m_file != NULL; }
+
+	/// Append to the ring buffer. Only waits for the thread if the ring buffer is full.
+	void write( const void *data, Int bytes )
+	{
+		const UnsignedInt offset = m_writePos & (RING_SIZE - 1);
+		if (m_buffer != NULL && (UnsignedInt)bytes <= RING_SIZE - offset && (UnsignedInt)bytes <= RING_SIZE - (m_writePos - (UnsignedInt)m_donePos))
+		{
+			memcpy(m_buffer + offset, data, bytes);
+			m_writePos += (UnsignedInt)bytes;
+		}
+		else
+		{
+			writeSlow(data, bytes);
+		}
+	}
+
+	/// Hand the writes since the last commit to the thread, depending on the flush policy.
+	void commit();
+
+	/// Hand all writes to the thread and wait until they are in the file. Afterwards the file
+	/// can be used directly until the next write.
+	void flush();
+
+private:
+
+	void writeSlow( const void *data, Int bytes );
+	void handOver();
+	void waitUntilWritten( UnsignedInt position );
+
+	static DWORD WINAPI threadProc( LPVOID param );
+	void threadLoop();
+
+	File *m_file;
+	FlushPolicy m_policy;
+	UnsignedByte *m_buffer;
+	HANDLE m_thread;
+	HANDLE m_workEvent;						///< set when there is something to write or the thread must quit
+	HANDLE m_doneEvent;						///< set by the thread whenever it wrote a part of the ring buffer
+	UnsignedInt m_writePos;				///< bytes ever written into the ring buffer, only used by the caller
+	volatile LONG m_commitPos;		///< bytes ever handed to the thread
+	volatile LONG m_donePos;			///< bytes ever written to the file by the thread
+	volatile LONG m_quit;
+	Bool m_failed;
+};
@@ -81,6 +81,10 @@ public:
 	void generateFilename( void );
 	AsciiString getFilename( void );
 
+	// Appends every file this sound effect may play, attack and decay portions included, without
+	// consuming any random values. Used to load the files before the event is first played.
+	void generateAllFilenames( std::vector<AsciiString> &filenames );
+
 	// The attack and decay sounds are generated in generatePlayInfo, because they will never be played more
 	// than once during a given sound event.
 	void generatePlayInfo( void );
@@ -0,0 +1,144 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: AudioVoiceScheduler.h ////////////////////////////////////////////////////////////////////
+// Device independent bookkeeping of the playing sound effects, so that the limit, priority and
+// voice checks done for every audio request don't have to walk the playing lists of the device.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/AsciiString.h"
+#include "Common/AudioEventInfo.h"
+#include "Common/GameAudio.h"
+#include "Common/GameType.h"
+#include "Common/STLTypedefs.h"
+
+class AudioEventRTS;
+struct AudioRequest;
+
+enum AudioVoiceChannel CPP_11(: Int)
+{
+	AVC_2D,
+	AVC_3D,
+
+	AVC_COUNT
+};
+
+struct AudioVoiceList;
+
+// One playing sound effect. The device keeps the pointer returned by addVoice and hands it back
+// to removeVoice when the sound is released.
+struct AudioVoice
+{
+	AudioHandle m_handle;
+	ObjectID m_objectID;
+	AudioPriority m_priority;
+	AudioVoiceChannel m_channel;
+	Bool m_isVoice;								///< ST_VOICE, tracked per object
+	void *m_userData;							///< owned by the device, eg the PlayingAudio
+
+	AudioVoiceList *m_nameList;		///< the voices on this channel with the same event name
+	AudioVoice *m_prevByName;
+	AudioVoice *m_nextByName;
+	AudioVoice *m_prevByPriority;
+	AudioVoice *m_nextByPriority;
+};
+
+// Intrusive list in the order the voices were added, so the head is always the oldest voice.
+struct AudioVoiceList
+{
+	AudioVoice *m_head;
+	AudioVoice *m_tail;
+	Int m_count;
+
+	AudioVoiceList() : m_head(NULL), m_tail(NULL), m_count(0) { }
+};
+
+struct AudioVoiceSchedulerStats
+{
+	UnsignedInt m_requests;				///< sound effects that went through the scheduling checks
+	UnsignedInt m_accepted;				///< of those, how many were queued to play
+	UnsignedInt m_voicesAdded;
+	UnsignedInt m_peakVoices;
+	Int64 m_requestTicks;					///< time spent in the scheduling checks
+	Int64 m_ticksPerSec;
+
+	Real getRequestsPerSec() const;
+};
+
+class AudioVoiceScheduler
+{
+public:
+	AudioVoiceScheduler();
+	~AudioVoiceScheduler();
+
+	// Voices. Every voice that was added must be removed before the scheduler is destroyed.
+	AudioVoice *addVoice( AudioEventRTS *event, void *userData );
+	void removeVoice( AudioVoice *voice );
+	AudioVoice *findVoice( AudioHandle handle ) const;
+	void getVoices( std::vector<AudioVoice *> &voices ) const;
+
+	// Requests that are queued but not yet processed by the device count towards the limits.
+	// Remove a request before the device processes it, as that may release its event.
+	void addRequest( const AudioRequest *request );
+	void removeRequest( const AudioRequest *request );
+	void removeAllRequests();
+
+	// The checks the devices used to do by walking their playing lists.
+	Bool doesViolateLimit( AudioEventRTS *event ) const;
+	Bool isPlayingAlready( const AudioEventRTS *event ) const;
+	Bool isPlayingLowerPriority( const AudioEventRTS *event ) const;
+	Bool isObjectPlayingVoice( ObjectID objID ) const;
+	AudioVoice *findLowestPriorityVoice( const AudioEventRTS *event ) const;
+
+	Int getVoiceCount( AudioVoiceChannel channel ) const { return m_voiceCount[channel]; }
+
+	// Benchmarking of the checks done by SoundManager::canPlayNow
+	void startRequestTimer();
+	void stopRequestTimer( Bool accepted );
+	const AudioVoiceSchedulerStats &getStats() const { return m_stats; }
+	void resetStats();
+	void reportStats() const;
+
+	static AudioVoiceChannel getChannel( const AudioEventRTS *event );
+
+protected:
+	typedef std::hash_map< AsciiString, AudioVoiceList, rts::hash<AsciiString>, rts::equal_to<AsciiString> > VoicesByNameMap;
+	typedef std::hash_map< AsciiString, Int, rts::hash<AsciiString>, rts::equal_to<AsciiString> > CountByNameMap;
+	typedef std::hash_map< ObjectID, Int, rts::hash<ObjectID>, rts::equal_to<ObjectID> > CountByObjectMap;
+	typedef std::hash_map< AudioHandle, AudioVoice *, rts::hash<AudioHandle>, rts::equal_to<AudioHandle> > VoicesByHandleMap;
+
+	const AudioVoiceList *findNameList( AudioVoiceChannel channel, const AsciiString &eventName ) const;
+	Int getPendingCount( const AsciiString &eventName ) const;
+
+	AudioVoice *allocateVoice();
+	void releaseVoice( AudioVoice *voice );
+
+	VoicesByNameMap m_voicesByName[AVC_COUNT];
+	AudioVoiceList m_voicesByPriority[AVC_COUNT][AP_COUNT];
+	Int m_voiceCount[AVC_COUNT];
+	CountByObjectMap m_voicesByObject;
+	VoicesByHandleMap m_voicesByHandle;
+	CountByNameMap m_pendingByName;
+
+	std::vector<AudioVoice *> m_freeVoices;
+
+	AudioVoiceSchedulerStats m_stats;
+	Int64 m_requestStart;
+};
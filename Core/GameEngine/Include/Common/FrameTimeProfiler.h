@@ -0,0 +1,62 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: FrameTimeProfiler.h //////////////////////////////////////////////////////////////////////
+// Times the client part and the logic part of every engine update that steps the logic and reports
+// the distribution of the frame times. Next to the frame times of the serial update, it reports the frame times of a
+// pipeline where the logic of the next frame runs while the client draws the current one, which
+// is the most that running the two side by side could gain.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+class FrameTimeProfiler
+{
+public:
+
+	// Start timing an engine update with its client part. Does nothing unless -benchmarkFrameTime is given.
+	static void beginFrame();
+
+	// End the client part and start the logic part of the engine update.
+	static void markClientDone();
+
+	// End the logic part and record the engine update.
+	static void endFrame();
+
+	// Print the frame time distribution of the recorded updates as JSON and start over.
+	static void report(const char *name);
+
+private:
+
+	struct Sample
+	{
+		Real clientMilliseconds;
+		Real logicMilliseconds;
+	};
+	typedef std::vector<Sample> SampleList;
+
+	static Real millisecondsSince(Int64 start, Int64 &now);
+	static void printDistribution(const char *name, std::vector<Real> &milliseconds, Bool last);
+
+private:
+
+	static SampleList s_samples;
+	static Sample s_current;
+	static Int64 s_partStart;
+	static Bool s_inFrame;
+};
@@ -51,6 +51,8 @@
 
 class AsciiString;
 class AudioEventRTS;
+class AudioVoiceScheduler;
+struct AudioVoice;
 class DebugDisplayInterface;
 class Drawable;
 class MusicManager;
@@ -161,6 +163,11 @@ class AudioManager : public SubsystemInterface
 		virtual Bool isValidAudioEvent( const AudioEventRTS *eventToCheck ) const;	///< validate that this piece of audio exists
 		virtual Bool isValidAudioEvent( AudioEventRTS *eventToCheck ) const;	///< validate that this piece of audio exists
 
+		// Queue the files of a sound effect to be loaded before it first plays. Does nothing if the device
+		// doesn't cache files. The generation changes on every reset, so callers can prefetch once per game.
+		virtual void prefetchAudioEvent( const AudioEventRTS *eventToPrefetch );
+		UnsignedInt getPrefetchGeneration( void ) const { return m_prefetchGeneration; }
+
 		// add tracks during INIification
 		void addTrackName( const AsciiString& trackName );
 		AsciiString nextTrackName(const AsciiString& currentTrack );
@@ -319,11 +326,15 @@ class AudioManager : public SubsystemInterface
 
     void removeAllAudioRequests( void );
 
+		// Device dependent, load the file in the background if it isn't cached yet.
+		virtual void prefetchAudioFile( const AsciiString& fileName, const AudioEventInfo *eventInfo ) { }
+
 	protected:
 		AudioSettings *m_audioSettings;
 		MiscAudio *m_miscAudio;
 		MusicManager *m_music;
 		SoundManager *m_sound;
+		AudioVoiceScheduler *m_voiceScheduler;	///< bookkeeping of the playing sound effects for the device
 		Coord3D m_listenerPosition;
 		Coord3D m_listenerOrientation;
 		std::list<AudioRequest*> m_audioRequests;
@@ -331,6 +342,7 @@ class AudioManager : public SubsystemInterface
 
 		AudioEventInfoHash m_allAudioEventInfo;
 		AudioHandle theAudioHandlePool;
+		UnsignedInt m_prefetchGeneration;
 		std::list<std::pair<AsciiString, Real> > m_adjustedVolumes;
 
 		Real m_musicVolume;
@@ -378,8 +390,18 @@ class AudioManager : public SubsystemInterface
 
 // TheSuperHackers @feature helmutbuhler 17/05/2025
 // AudioManager that does nothing. Used for Headless Mode.
+// TheSuperHackers @performance Sound effects are still scheduled on a virtual set of channels,
+// so that headless replays exercise the same limit and priority decisions as the real device.
 class AudioManagerDummy : public AudioManager
 {
+public:
+	AudioManagerDummy();
+	virtual ~AudioManagerDummy();
+
+	virtual void reset();
+	virtual void update();
+	virtual void processRequestList(void);
+
 #if defined(RTS_DEBUG)
 	virtual void audioDebugDisplay(DebugDisplayInterface* dd, void* userData, FILE* fp) {}
 #endif
@@ -387,7 +409,7 @@ class AudioManagerDummy : public AudioManager
 	virtual void pauseAudio(AudioAffect which) {}
 	virtual void resumeAudio(AudioAffect which) {}
 	virtual void pauseAmbient(Bool shouldPause) {}
-	virtual void killAudioEventImmediately(AudioHandle audioEvent) {}
+	virtual void killAudioEventImmediately(AudioHandle audioEvent);
 	virtual void nextMusicTrack() {}
 	virtual void prevMusicTrack() {}
 	virtual Bool isMusicPlaying() const { return false; }
@@ -405,13 +427,13 @@ class AudioManagerDummy : public AudioManager
 	virtual UnsignedInt getSelectedProvider(void) const { return 0; }
 	virtual void setSpeakerType(UnsignedInt speakerType) {}
 	virtual UnsignedInt getSpeakerType(void) { return 0; }
-	virtual UnsignedInt getNum2DSamples(void) const { return 0; }
-	virtual UnsignedInt getNum3DSamples(void) const { return 0; }
+	virtual UnsignedInt getNum2DSamples(void) const;
+	virtual UnsignedInt getNum3DSamples(void) const;
 	virtual UnsignedInt getNumStreams(void) const { return 0; }
-	virtual Bool doesViolateLimit(AudioEventRTS* event) const { return false; }
-	virtual Bool isPlayingLowerPriority(AudioEventRTS* event) const { return false; }
-	virtual Bool isPlayingAlready(AudioEventRTS* event) const { return false; }
-	virtual Bool isObjectPlayingVoice(UnsignedInt objID) const { return false; }
+	virtual Bool doesViolateLimit(AudioEventRTS* event) const;
+	virtual Bool isPlayingLowerPriority(AudioEventRTS* event) const;
+	virtual Bool isPlayingAlready(AudioEventRTS* event) const;
+	virtual Bool isObjectPlayingVoice(UnsignedInt objID) const;
 	virtual void adjustVolumeOfPlayingAudio(AsciiString eventName, Real newVolume) {}
 	virtual void removePlayingAudio(AsciiString eventName) {}
 	virtual void removeAllDisabledAudio() {}
@@ -424,6 +446,14 @@ class AudioManagerDummy : public AudioManager
 	virtual Real getFileLengthMS(AsciiString strToLoad) const { return -1; }
 	virtual void closeAnySamplesUsingFile(const void* fileToClose) {}
 	virtual void setDeviceListenerPosition(void) {}
+
+protected:
+	void playAudioEvent(AudioEventRTS* event);
+	void stopVoice(AudioVoice* voice);
+	void stopAllVoices();
+
+	// Sound effects are considered finished after a fixed time, except for the ones that loop forever.
+	std::list<std::pair<UnsignedInt, AudioHandle> > m_voiceExpiry;
 };
 
 
@@ -50,6 +50,18 @@
 #define RETAIL_COMPATIBLE_AIGROUP (1) // AIGroup logic is expected to be CRC compatible with retail Generals 1.08, Zero Hour 1.04
 #endif
 
+// Let the members of a large group move order take their paths from one flow field that is built from the group goal,
+// instead of every member running its own search. The field only knows the terrain, so the units in the way are checked
+// along the path a member takes from it, and a member that is blocked runs its own search. This changes the paths that
+// are found and thus breaks retail compatibility.
+#ifndef ENABLE_GROUP_FLOW_FIELD_PATHING
+#if RETAIL_COMPATIBLE_PATHFINDING
+#define ENABLE_GROUP_FLOW_FIELD_PATHING (0)
+#else
+#define ENABLE_GROUP_FLOW_FIELD_PATHING (1)
+#endif
+#endif
+
 #ifndef ENABLE_GAMETEXT_SUBSTITUTES
 #define ENABLE_GAMETEXT_SUBSTITUTES (1) // The code can provide substitute texts when labels and strings are missing in the STR or CSF translation file
 #endif
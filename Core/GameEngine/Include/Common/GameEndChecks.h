@@ -0,0 +1,72 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: GameEndChecks.h //////////////////////////////////////////////////////////////////////////
+// The command line benchmarks and checks that run when a game ends, while its data is still loaded.
+// The subsystem that owns a check registers the function that runs it, and one parser enables the
+// checks by their command line flags.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+class GameEndChecks
+{
+public:
+
+	enum CheckType
+	{
+		BENCHMARK_RADAR_TERRAIN,				///< -benchmarkRadarTerrain
+		BENCHMARK_RADAR_OBJECTS,				///< -benchmarkRadarObjects
+		BENCHMARK_TERRAIN_REBUILD,			///< -benchmarkTerrainRebuild
+		VERIFY_SHROUD_CIRCLES,					///< -verifyShroudCircles <seed>
+		VERIFY_LOS,											///< -verifyLOS <seed>
+		BENCHMARK_SHROUD,								///< -benchmarkShroud
+		BENCHMARK_GROUP_PATH,						///< -benchmarkGroupPath
+		BENCHMARK_ANIM,									///< -benchmarkAnim
+
+		CHECK_COUNT
+	};
+
+	// Runs a check. The seed is the argument of its flag, or 0 for flags without one.
+	typedef void (*CheckFunc)(UnsignedInt seed);
+
+	// Enable the check of the flag in args[0]. Returns the number of arguments used, like the
+	// other command line parsers.
+	static Int parseFlag(char *args[], Int num);
+
+	static Bool isEnabled(CheckType type) { return s_checks[type].enabled; }
+
+	// Set the function that runs the check. The owning subsystem calls it when it is created.
+	static void registerCheck(CheckType type, CheckFunc func);
+
+	// Run the enabled checks in the order of CheckType. Call it before the game data is cleared.
+	static void run();
+
+private:
+
+	struct Check
+	{
+		const char *flag;
+		Bool hasSeed;
+		Bool enabled;
+		UnsignedInt seed;
+		CheckFunc func;
+	};
+
+	static Check s_checks[CHECK_COUNT];
+};
@@ -800,6 +800,12 @@ extern void initMemoryManager();
 */
 extern Bool isMemoryManagerOfficiallyInited();
 
+/**
+	return the number of memory blocks allocated so far. The count wraps around,
+	so only the difference between two calls is meaningful.
+*/
+extern UnsignedInt getMemoryAllocationCount();
+
 /**
 	similar to initMemoryManager, but this should be used if the memory manager must be initialized
 	prior to main() (e.g., from a static constructor). If preMainInitMemoryManager() is called prior
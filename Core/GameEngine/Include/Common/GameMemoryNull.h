@@ -133,6 +133,12 @@ extern void initMemoryManager();
 */
 extern Bool isMemoryManagerOfficiallyInited();
 
+/**
+	return the number of memory blocks allocated so far. The count wraps around,
+	so only the difference between two calls is meaningful.
+*/
+extern UnsignedInt getMemoryAllocationCount();
+
 /**
 	Shut down the memory manager. Throw away TheMemoryPoolFactory and
 	TheDynamicMemoryAllocator.
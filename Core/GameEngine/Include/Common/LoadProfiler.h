@@ -0,0 +1,72 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: LoadProfiler.h ///////////////////////////////////////////////////////////////////////////
+// Times the phases of a map load, together with the memory allocations and the bytes read from
+// the file system in each phase.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+class LoadProfiler
+{
+public:
+
+	struct Phase
+	{
+		const char *name;					///< string literal, not owned
+		Real milliseconds;
+		UnsignedInt allocations;
+		UnsignedInt bytesRead;
+	};
+	typedef std::vector<Phase> PhaseList;
+
+	// Start timing a map load. The first phase starts here.
+	static void beginLoad();
+
+	// End the current phase under the given name and start the next one. Does nothing outside of a load.
+	static void markPhase(const char *name);
+
+	// End the last phase under the given name and log the phases of the load.
+	static void endLoad(const char *name);
+
+	static Bool isLoading() { return s_isLoading; }
+	static const PhaseList &getPhases() { return s_phases; }
+
+	// TheSuperHackers @feature 18/10/2026
+	// Load the given map a number of times without graphics and print the phase timings as JSON.
+	// Returns exit code 1 if the map cannot be loaded, 0 otherwise.
+	static int benchmarkLoad(const AsciiString &mapName, Int runCount);
+
+private:
+
+	struct Counters
+	{
+		Int64 time;
+		UnsignedInt allocations;
+		UnsignedInt bytesRead;
+	};
+
+	static void readCounters(Counters &counters);
+
+private:
+
+	static Bool s_isLoading;
+	static PhaseList s_phases;
+	static Counters s_phaseStart;
+};
@@ -103,6 +103,7 @@ class LocalFile : public File
 		virtual Int		writeChar( const WideChar* character );							///< Write a wide character to the file
 		virtual Int		seek( Int new_pos, seekMode mode = CURRENT );				///< Set file position: See File::seek
 		virtual Bool	flush();													///< flush data to disk
+		virtual Bool	commitToDisk();										///< flush data to disk and wait until the system wrote it: See File::commitToDisk
 		virtual void	nextLine(Char *buf = NULL, Int bufSize = 0);				///< moves file position to after the next new-line
 		virtual Bool	scanInt(Int &newInt);																///< return what gets read in as an integer at the current file position.
 		virtual Bool	scanReal(Real &newReal);														///< return what gets read in as a float at the current file position.
@@ -117,6 +118,8 @@ class LocalFile : public File
 		virtual char* readEntireAndClose();
 		virtual File* convertToRAMFile();
 
+		static UnsignedInt getTotalBytesRead();											///< Bytes read by all local files so far. Wraps around, only use the difference between two calls.
+
 	protected:
 
 		void closeWithoutDelete();
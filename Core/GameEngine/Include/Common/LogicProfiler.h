@@ -0,0 +1,97 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: LogicProfiler.h //////////////////////////////////////////////////////////////////////////
+// Times every logic frame of a simulated replay and the phases of GameLogic::update within it, and
+// writes the frame time distribution and the time of each phase as JSON. The results of two builds
+// can be compared with scripts/benchmark/compare_replay_benchmarks.py.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/ProfileUtil.h"
+
+class LogicProfiler
+{
+public:
+
+	enum Phase
+	{
+		PHASE_SCRIPTS,
+		PHASE_TERRAIN,
+		PHASE_CRC,
+		PHASE_SLEEPY_UPDATES,
+		PHASE_AI,
+		PHASE_PARTITION,
+		PHASE_DESTROY_LIST,
+
+		PHASE_COUNT
+	};
+
+	// Start recording the logic frames of a replay.
+	static void beginReplay();
+
+	// Start timing a logic frame. Does nothing outside of a recorded replay.
+	static void beginFrame();
+
+	// End timing the logic frame and record it.
+	static void endFrame();
+
+	static Bool isInFrame() { return s_inFrame; }
+
+	static void addPhaseTime(Phase phase, Int64 ticks) { s_phaseTicks[phase] += ticks; }
+
+	// Write the recorded frames of the replay as a JSON object, print a summary and stop recording.
+	static void writeReplay(FILE *fp, const char *replayName, Real seconds, Bool failed, Bool first);
+
+private:
+
+	struct PhaseStats
+	{
+		double sum;
+		double sumOfSquares;
+	};
+
+	static void writePhase(FILE *fp, const char *name, const PhaseStats &stats, size_t frameCount, Bool last);
+
+private:
+
+	static std::vector<Real> s_frameMilliseconds;
+	static PhaseStats s_phaseStats[PHASE_COUNT + 1]; ///< the last one is the time outside of the phases
+	static Int64 s_phaseTicks[PHASE_COUNT];
+	static Int64 s_frameStart;
+	static Bool s_isRecording;
+	static Bool s_inFrame;
+};
+
+// Adds the lifetime of the object to a phase of the current logic frame.
+class LogicPhaseScope
+{
+public:
+	LogicPhaseScope(LogicProfiler::Phase phase) : m_phase(phase), m_active(LogicProfiler::isInFrame())
+	{
+		if (m_active)
+			m_startTime = ProfileUtil::getTime();
+	}
+	~LogicPhaseScope() { if (m_active) LogicProfiler::addPhaseTime(m_phase, ProfileUtil::getTime() - m_startTime); }
+
+private:
+	LogicProfiler::Phase m_phase;
+	Bool m_active;
+	Int64 m_startTime;
+};
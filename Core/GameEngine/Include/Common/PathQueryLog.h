@@ -0,0 +1,91 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: PathQueryLog.h ///////////////////////////////////////////////////////////////////////////
+// Records the path queries of the pathfinder with their resulting path cells to a file, or
+// checks them against such a file. A build before a pathfinder change records the queries of a
+// set of replays with -recordPaths, and a build after it runs the same replays with -verifyPaths,
+// which compares each returned path cell by cell.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+class PathQueryLog
+{
+public:
+
+	enum QueryType
+	{
+		FIND_PATH,
+		FIND_CLOSEST_PATH,
+		FIND_ATTACK_PATH,
+		FIND_SAFE_PATH,
+		PATCH_PATH,
+		GROUND_PATH,
+		AIRCRAFT_PATH,
+		MOVE_AWAY_PATH,
+		END_OF_GAME		///< separates the games in the file
+	};
+
+	struct Cell
+	{
+		Int x;
+		Int y;
+		Int layer;
+	};
+
+	struct Query
+	{
+		Int type;
+		UnsignedInt frame;
+		UnsignedInt objectID;
+		Coord3D from;
+		Coord3D to;										///< the goal, victim or repulsor position, depending on the type
+		std::vector<Cell> cells;			///< the cells of the nodes of the returned path, empty if no path was found
+	};
+
+	/// Write the queries to the file. Returns FALSE if the file cannot be opened.
+	static Bool startRecording(const char *fileName);
+
+	/// Compare the queries with those recorded in the file. Returns FALSE if the file cannot be opened.
+	static Bool startVerifying(const char *fileName);
+
+	static Bool isActive() { return s_file != NULL; }
+
+	/// Record or check one path query, from the pathfind queue or a direct call to the pathfinder.
+	static void addQuery(const Query &query);
+
+	/// Print how many queries of the game were recorded or matched. A game that diverged from the
+	/// recording does not affect the next one.
+	static void endGame();
+
+private:
+
+	static Bool readQuery(Query &query);
+	static void writeQuery(const Query &query);
+	static Bool isSameQuery(const Query &a, const Query &b);
+
+	static FILE *s_file;
+	static Bool s_isVerifying;
+	static Bool s_hasDiverged;			///< the queries no longer follow the recording, so the rest is not compared
+	static Bool s_hasReadEndOfGame;	///< the recorded game ended before the current one
+	static UnsignedInt s_queryCount;		///< of the current game
+	static UnsignedInt s_mismatchCount;	///< of the current game
+};
@@ -0,0 +1,53 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: ProfileUtil.h ////////////////////////////////////////////////////////////////////////////
+// The pieces the profilers, the tracer and the command line benchmarks share: a high resolution
+// clock that works on every platform and thread, the statistics of a list of timings, and the
+// output of the results.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+class ProfileUtil
+{
+public:
+
+	// Ticks of a monotonic high resolution clock. Any thread can call it.
+	static Int64 getTime();
+
+	// Ticks per second of getTime.
+	static Int64 getFrequency();
+
+	static double ticksToMilliseconds(Int64 ticks) { return (double)ticks * 1000.0 / (double)getFrequency(); }
+	static double ticksToMicroseconds(Int64 ticks) { return (double)ticks * 1000000.0 / (double)getFrequency(); }
+
+	// Returns the value below which the given percent of the sorted values fall, or 0 for no values.
+	static Real percentile(const std::vector<Real> &sortedValues, Int percent);
+
+	// Returns the sample standard deviation of values with the given sum and sum of squares.
+	static double standardDeviation(double sum, double sumOfSquares, size_t count);
+
+	// Write the string in quotes, with the quotes and backslashes in it escaped.
+	static void writeJsonString(FILE *fp, const char *str);
+
+	// Print the results of a command line benchmark or check.
+	static void print(const char *format, ...);
+};
@@ -128,6 +128,21 @@ protected:
 
 };
 
+//-------------------------------------------------------------------------------------------------
+/** TheSuperHackers @performance 18/10/2026 What is drawn of a visible radar object, a 2x2 pixel
+	* square with its lower left corner at x,y */
+//-------------------------------------------------------------------------------------------------
+struct RadarBlip
+{
+	Int x;
+	Int y;
+	Color color;
+
+	Bool operator==( const RadarBlip &other ) const { return x == other.x && y == other.y && color == other.color; }
+	Bool operator!=( const RadarBlip &other ) const { return !(*this == other); }
+};
+typedef std::vector<RadarBlip> RadarBlipVec;
+
 //-------------------------------------------------------------------------------------------------
 /** Radar priorities.  Keep this in sync with the priority names list below */
 //-------------------------------------------------------------------------------------------------
@@ -218,6 +233,23 @@ public:
 	/// queue a refresh of the terrain at the next available time
 	virtual void queueTerrainRefresh( void );
 
+	// TheSuperHackers @performance 18/10/2026 Refresh only the radar cells of terrain that changed.
+	/// queue a refresh of the terrain inside the world area at the next available time
+	void queueTerrainAreaRefresh( const Region2D *area );
+
+	/// compute the terrain color of the radar cells inside the region, or of all cells when region is NULL
+	void rasterizeTerrain( TerrainLogic *terrain, const IRegion2D *region );
+	const Color *getTerrainColors( void ) const { return m_terrainColors; }	///< RADAR_CELL_WIDTH * RADAR_CELL_HEIGHT colors, row by row
+
+	/// time the rasterization of the whole terrain against the rasterization of a crater sized area
+	void runTerrainBenchmark( TerrainLogic *terrain, Int repeats );
+
+	/// draw the blips in order into RADAR_CELL_WIDTH * RADAR_CELL_HEIGHT colors, cleared to 0 first
+	static void rasterizeBlips( const RadarBlipVec &blips, Color *pixels );
+
+	/// time collecting and rasterizing the blips of all objects on the radar
+	void runObjectBenchmark( Int repeats );
+
 	virtual void newMap( TerrainLogic *terrain );	///< reset radar for new map
 
 	virtual void draw( Int pixelX, Int pixelY, Int width, Int height ) = 0;	///< draw the radar
@@ -249,6 +281,15 @@ protected:
 
 	void clearAllEvents( void );					///< remove all radar events in progress
 
+	/// refresh the terrain of the radar cells inside the region only
+	virtual void refreshTerrainArea( TerrainLogic *terrain, const IRegion2D *region );
+
+	void interpolateColorForHeight( RGBColor *color,
+																	Real height,
+																	Real hiZ,
+																	Real midZ,
+																	Real loZ );		///< "shade" color according to height value
+
 	// search the object list for an object that maps to the given logical radar coordinates
 	Object *searchListForRadarLocationMatch( RadarObject *listHead, ICoord2D *radarMatch );
 
@@ -293,6 +334,9 @@ protected:
 	Region3D m_mapExtent;									///< extents of the current map
 
 	UnsignedInt m_queueTerrainRefreshFrame;  ///< frame we requested the last terrain refresh on
+	IRegion2D m_terrainDirtyRegion;					///< radar cells the queued terrain refresh covers, empty when hi is below lo
+
+	Color m_terrainColors[ RADAR_CELL_WIDTH * RADAR_CELL_HEIGHT ];	///< terrain color of every radar cell
 
 };
 
@@ -0,0 +1,79 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: ReplayIndex.h ////////////////////////////////////////////////////////////////////////////
+// Keeps the parsed headers of the replay files in an index file in the replay directory, keyed by
+// the file name, size and modification time. Only new or changed replays are read again, and
+// those are read in parallel. The replay menu lists its replays through the index, and the
+// -listReplays and -replayFilter command lines filter replays by map, version and duration.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/AsciiString.h"
+#include "Common/Recorder.h"
+#include "Common/STLTypedefs.h"
+
+class ReplayIndex
+{
+public:
+
+	ReplayIndex();
+
+	/// Read the index file. A missing or unreadable index file leaves the index empty.
+	void load();
+
+	/// Write the index file if an entry changed. Drops the entries of replays that no longer exist.
+	void save();
+
+	/// Bring the entries of the replays up to date. The file names are relative to the replay directory.
+	void update(const std::vector<AsciiString> &filenames);
+
+	/// Returns the header of a replay given to update, or NULL if the file is no valid replay.
+	const RecorderClass::ReplayHeader *findHeader(const AsciiString &filename) const;
+
+	/// Keep the replays whose header matches the filter of -replayFilter. Returns FALSE if the filter is invalid.
+	static Bool filterReplays(std::vector<AsciiString> &filenames, const AsciiString &filter);
+
+	/// Print the replays of the wildcard that match the filter. Returns the exit code of -listReplays.
+	static Int listReplays(const AsciiString &wildcard, const AsciiString &filter);
+
+private:
+
+	struct Entry
+	{
+		Int64 fileSize;
+		Int64 fileTime;
+		Bool isValid;			///< FALSE for files that are no replays, so that they are not read again either
+		Bool isUpdated;		///< the file was checked by update since the index was loaded
+		RecorderClass::ReplayHeader header;
+	};
+
+	struct Filter;
+
+	typedef std::hash_map< AsciiString, Entry, rts::hash<AsciiString>, rts::equal_to<AsciiString> > EntryMap;
+
+	static Bool parseFilter(Filter &filter, const AsciiString &filterText);
+	static AsciiString makeKey(const AsciiString &filename);
+	static AsciiString getIndexPath();
+
+	void keepMatching(std::vector<AsciiString> &filenames, const Filter &filter) const;
+
+	EntryMap m_entries;
+	Bool m_isDirty;
+};
@@ -34,11 +34,13 @@ public:
 	static UnsignedInt getCurrentReplayIndex() { return s_replayIndex; }
 	static UnsignedInt getReplayCount() { return s_replayCount; }
 
+	// Expands the wildcards of the file names relative to the replay directory.
+	static std::vector<AsciiString> resolveFilenameWildcards(const std::vector<AsciiString> &filenames);
+
 private:
 
 	static int simulateReplaysInThisProcess(const std::vector<AsciiString> &filenames);
 	static int simulateReplaysInWorkerProcesses(const std::vector<AsciiString> &filenames, int maxProcesses);
-	static std::vector<AsciiString> resolveFilenameWildcards(const std::vector<AsciiString> &filenames);
 
 private:
 
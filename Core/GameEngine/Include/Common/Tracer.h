@@ -0,0 +1,111 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: Tracer.h /////////////////////////////////////////////////////////////////////////////////
+// Records the start and end time of named code zones and streams them to a Chrome trace, which can
+// be opened in chrome://tracing or ui.perfetto.dev. Every thread records into its own ring buffer
+// without locking, and the main thread moves the events from the buffers to the file. Until tracing
+// is enabled with -trace, a zone costs a single test of a flag.
+//
+// The tracer comes in addition to the perf timers of PERF_TIMERS builds and the function level
+// profile library, which report through the debug display and the profile commands instead.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/ProfileUtil.h"
+
+#if !(defined(_MSC_VER) && _MSC_VER < 1300)
+#include <atomic>
+#endif
+
+class Tracer
+{
+public:
+	enum
+	{
+		MAX_THREADS = 32,
+		EVENTS_PER_THREAD = 1 << 16 ///< must be a power of two, events are dropped while the buffer of a thread is full
+	};
+
+	// Open the trace file and start recording. Must be called on the main thread before any other thread records.
+	static Bool enable(const char *fileName);
+
+	static Bool isEnabled() { return s_isEnabled; }
+
+	// Record a zone of the calling thread. The name must stay valid until the next flush.
+	static void addEvent(const char *name, Int64 startTime, Int64 endTime);
+
+	// Move the recorded events of all threads to the trace file. Must be called on the main thread,
+	// which does so once per logic frame, at the end of a map load and when a game ends.
+	static void flush();
+
+private:
+
+#if defined(_MSC_VER) && _MSC_VER < 1300
+	typedef volatile LONG EventIndex;
+#else
+	typedef std::atomic<UnsignedInt> EventIndex;
+#endif
+
+	struct Event
+	{
+		const char *name;
+		Int64 startTime;
+		Int64 endTime;
+	};
+
+	// A ring buffer with a single producer, the owner thread, and a single consumer, the main thread.
+	struct ThreadBuffer
+	{
+		Event *events;
+		EventIndex writeIndex; ///< number of events ever recorded, only written by the owner thread
+		EventIndex readIndex; ///< number of events ever flushed, only written by the main thread
+		EventIndex droppedCount; ///< number of events that found the buffer full, only written by the owner thread
+	};
+
+	static ThreadBuffer *getThreadBuffer();
+	static void flushThread(Int threadIndex);
+	static void close(); ///< called at exit
+
+	static Bool s_isEnabled;
+	static FILE *s_file;
+	static ThreadBuffer s_threadBuffers[MAX_THREADS];
+	static EventIndex s_threadCount;
+	static Int64 s_startTime;
+	static UnsignedInt s_flushedCount;
+	static UnsignedInt s_droppedCount;
+};
+
+// Records the lifetime of the object as a zone of the current thread.
+class TraceScope
+{
+public:
+	TraceScope(const char *name) : m_name(name), m_startTime(name != NULL ? ProfileUtil::getTime() : 0) {}
+	~TraceScope() { if (m_name != NULL) Tracer::addEvent(m_name, m_startTime, ProfileUtil::getTime()); }
+
+private:
+	const char *m_name;
+	Int64 m_startTime;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+// Records the rest of the enclosing block as a zone. The name is only evaluated while tracing.
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(Tracer::isEnabled() ? (name) : (const char *)NULL)
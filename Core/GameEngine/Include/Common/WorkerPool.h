@@ -0,0 +1,75 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: WorkerPool.h /////////////////////////////////////////////////////////////////////////////
+// A pool of worker threads that runs the iterations of a loop in parallel. The calling thread
+// takes part in the work and only returns when all iterations are done, so the loop behaves like
+// a plain for loop as long as every iteration only writes data that no other iteration touches.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+// Runs one iteration of a parallel loop.
+typedef void (*WorkerPoolJobFunc)(Int index, void *userData);
+
+class WorkerPool
+{
+public:
+	enum
+	{
+		MAX_THREADS = 16
+	};
+
+	WorkerPool();
+	~WorkerPool();
+
+	void init( Int numThreads = -1 );	///< start the workers, -1 uses one worker less than there are processors
+	void shutdown();
+
+	Int getNumThreads() const { return m_numThreads; }
+
+	/// Calls func for every index in [0, count) and returns when all calls are done. The indices
+	/// are spread over the workers and the calling thread in no particular order. Calls that
+	/// arrive while the pool is busy, or from one of its workers, run serially on the caller.
+	void parallelFor( Int count, WorkerPoolJobFunc func, void *userData );
+
+	/// Same as parallelFor on TheWorkerPool, or a serial loop when there is no pool.
+	static void run( Int count, WorkerPoolJobFunc func, void *userData );
+
+private:
+	static DWORD WINAPI threadProc( LPVOID param );
+	void runJobs();
+
+	HANDLE m_threads[MAX_THREADS];
+	Int m_numThreads;
+
+	HANDLE m_wakeSemaphore;	///< released once per worker for every loop
+	HANDLE m_doneEvent;			///< set by the last worker that finishes a loop
+	volatile LONG m_busy;
+	volatile LONG m_quit;
+
+	WorkerPoolJobFunc m_func;
+	void *m_userData;
+	Int m_count;
+	volatile LONG m_nextIndex;
+	volatile LONG m_activeWorkers;
+};
+
+extern WorkerPool *TheWorkerPool;
@@ -0,0 +1,85 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: XferMemory.h /////////////////////////////////////////////////////////////////////////////
+// Desc:   Xfer memory buffer write and read implementation. Writes and reads the same data
+//         as XferSave and XferLoad, but without touching the disk.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// USER INCLUDES //////////////////////////////////////////////////////////////////////////////////
+#include "Common/XferLoad.h"
+#include "Common/XferSave.h"
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+class XferMemorySave : public XferSave
+{
+
+public:
+
+	XferMemorySave( void );
+	virtual ~XferMemorySave( void );
+
+	// Xfer methods
+	virtual void open( AsciiString identifier );		///< start writing to an empty buffer
+	virtual void close( void );											///< stop writing, the buffer is kept
+	virtual Int beginBlock( void );									///< write placeholder block size
+	virtual void endBlock( void );									///< backup to last begin block and write size
+	virtual void skip( Int dataSize );							///< skip forward by writing zeroes
+
+	const UnsignedByte *getData( void ) const { return m_data.empty() ? NULL : &m_data[ 0 ]; }
+	Int getDataSize( void ) const { return (Int)m_data.size(); }
+
+protected:
+
+	virtual void xferImplementation( void *data, Int dataSize );		///< the xfer implementation
+
+	std::vector<UnsignedByte> m_data;											///< the written data
+	std::vector<size_t> m_blockPositions;									///< stack of begin block positions
+	Bool m_isOpen;
+
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+class XferMemoryLoad : public XferLoad
+{
+
+public:
+
+	XferMemoryLoad( const UnsignedByte *data, Int dataSize );		///< the data is not copied
+	virtual ~XferMemoryLoad( void );
+
+	// Xfer methods
+	virtual void open( AsciiString identifier );		///< start reading at the start of the buffer
+	virtual void close( void );											///< stop reading
+	virtual Int beginBlock( void );									///< read block size
+	virtual void skip( Int dataSize );							///< skip forward dataSize bytes in the buffer
+
+protected:
+
+	virtual void xferImplementation( void *data, Int dataSize );		///< the xfer implementation
+
+	const UnsignedByte *m_data;
+	Int m_dataSize;
+	Int m_position;
+	Bool m_isOpen;
+
+};
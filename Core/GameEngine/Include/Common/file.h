@@ -183,6 +183,7 @@ class File : public MemoryPoolObject
 																																				*  END: means seek the specified number of bytes back from the end of the file
 																																				*/
 		virtual Bool	flush() = 0;											///< flush data to disk
+		virtual Bool	commitToDisk();										///< flush data to disk and wait until the system wrote it to the storage device
 		virtual void	nextLine(Char *buf = NULL, Int bufSize = 0) = 0;		///< reads until it reaches a new-line character
 
 		virtual Bool	scanInt(Int &newInt) = 0;														///< read an integer from the current file position.
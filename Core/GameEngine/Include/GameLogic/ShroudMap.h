@@ -0,0 +1,111 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: ShroudMap.h //////////////////////////////////////////////////////////////////////////////
+// The shroud levels of all partition cells for all players. Every player has its own planes of
+// looker and shrouder counts, so the spans drawn by looks and shrouds run over contiguous memory.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+#include "Common/GameCommon.h"
+#include "GameClient/Display.h"	// for ShroudLevel
+
+// Called for every cell whose shroud status changes for a player, the edge trigger that objects
+// and the client react to.
+typedef void (*ShroudEdgeFunc)(Int playerIndex, Int x, Int y, CellShroudStatus newStatus);
+
+enum ShroudSpanOpType CPP_11(: UnsignedByte)
+{
+	SHROUD_ADD_LOOKERS,
+	SHROUD_REMOVE_LOOKERS,
+	SHROUD_ADD_SHROUDERS,
+	SHROUD_REMOVE_SHROUDERS
+};
+
+// One span update as recorded for the shroud benchmark.
+struct ShroudSpanOp
+{
+	UnsignedByte m_type;					///< ShroudSpanOpType
+	UnsignedByte m_playerIndex;
+	Short m_y;
+	Short m_x1;
+	Short m_x2;
+};
+
+typedef std::vector<ShroudSpanOp> ShroudSpanOpVec;
+
+class ShroudMap
+{
+public:
+	ShroudMap();
+	~ShroudMap();
+
+	// Every cell starts out as passive shroud for every player.
+	void init( Int cellCountX, Int cellCountY, ShroudEdgeFunc edgeFunc );
+	void clear();
+
+	// Span updates from x1 to x2 inclusive, which must be on the map.
+	void addLookers( Int playerIndex, Int x1, Int x2, Int y );
+	void removeLookers( Int playerIndex, Int x1, Int x2, Int y );
+	void addShrouders( Int playerIndex, Int x1, Int x2, Int y );
+	void removeShrouders( Int playerIndex, Int x1, Int x2, Int y );
+
+	inline CellShroudStatus getShroudStatus( Int playerIndex, Int x, Int y ) const;
+
+	// The per cell layout the shroud is saved and checksummed with, MAX_PLAYER_COUNT entries.
+	void getShroudLevels( Int x, Int y, ShroudLevel *levels ) const;
+	void setShroudLevels( Int x, Int y, const ShroudLevel *levels );
+
+	// Benchmarking. While recording, every span update is kept so that it can be played back
+	// against a fresh map of the same size.
+	void startRecording();
+	void stopRecording();
+	const ShroudSpanOpVec &getRecording() const { return m_recording; }
+	static void runBenchmark( const ShroudSpanOpVec &ops, Int cellCountX, Int cellCountY, Int repeats );
+
+protected:
+	inline Int getCellIndex( Int x, Int y ) const { return y * m_cellCountX + x; }
+	void recordSpan( ShroudSpanOpType type, Int playerIndex, Int x1, Int x2, Int y );
+	void fireEdge( Int playerIndex, Int x, Int y );
+
+	Int m_cellCountX;
+	Int m_cellCountY;
+	Int m_totalCellCount;
+
+	Short *m_currentShroud[MAX_PLAYER_COUNT];	///< 1 shrouded, 0 fogged, negative is the count of lookers
+	Short *m_activeShroud[MAX_PLAYER_COUNT];		///< count of shrouders
+
+	ShroudEdgeFunc m_edgeFunc;
+
+	Bool m_isRecording;
+	ShroudSpanOpVec m_recording;
+};
+
+//-------------------------------------------------------------------------------------------------
+inline CellShroudStatus ShroudMap::getShroudStatus( Int playerIndex, Int x, Int y ) const
+{
+	const Short currentShroud = m_currentShroud[playerIndex][getCellIndex(x, y)];
+	if( currentShroud == 1 )
+		return CELLSHROUD_SHROUDED;
+	else if( currentShroud == 0 )
+		return CELLSHROUD_FOGGED;// ie Nobody actively looking
+	else
+		return CELLSHROUD_CLEAR;
+}
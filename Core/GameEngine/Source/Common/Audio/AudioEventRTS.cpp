@@ -368,6 +368,25 @@ void AudioEventRTS::generateFilename( void )
 	m_delay = GameAudioRandomValueReal(m_eventInfo->m_delayMin, m_eventInfo->m_delayMax);
 }
 
+//-------------------------------------------------------------------------------------------------
+void AudioEventRTS::generateAllFilenames( std::vector<AsciiString> &filenames )
+{
+	if (!m_eventInfo || m_eventInfo->m_soundType != AT_SoundEffect) {
+		return;
+	}
+
+	const std::vector<AsciiString> *lists[] = { &m_eventInfo->m_attackSounds, &m_eventInfo->m_sounds, &m_eventInfo->m_decaySounds };
+	for (size_t i = 0; i < ARRAY_SIZE(lists); ++i) {
+		for (std::vector<AsciiString>::const_iterator it = lists[i]->begin(); it != lists[i]->end(); ++it) {
+			AsciiString filename = generateFilenamePrefix(m_eventInfo->m_soundType, false);
+			filename.concat(*it);
+			filename.concat(generateFilenameExtension(m_eventInfo->m_soundType));
+			adjustForLocalization(filename);
+			filenames.push_back(filename);
+		}
+	}
+}
+
 //-------------------------------------------------------------------------------------------------
 AsciiString AudioEventRTS::getFilename( void )
 {
@@ -0,0 +1,395 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: AudioVoiceScheduler.cpp //////////////////////////////////////////////////////////////////
+// Device independent bookkeeping of the playing sound effects
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/AudioVoiceScheduler.h"
+
+#include "Common/AudioEventRTS.h"
+#include "Common/AudioRequest.h"
+#include "Common/ProfileUtil.h"
+
+
+//-------------------------------------------------------------------------------------------------
+static void linkByName( AudioVoiceList *list, AudioVoice *voice )
+{
+	voice->m_prevByName = list->m_tail;
+	voice->m_nextByName = NULL;
+	if (list->m_tail)
+		list->m_tail->m_nextByName = voice;
+	else
+		list->m_head = voice;
+	list->m_tail = voice;
+	++list->m_count;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void unlinkByName( AudioVoiceList *list, AudioVoice *voice )
+{
+	if (voice->m_prevByName)
+		voice->m_prevByName->m_nextByName = voice->m_nextByName;
+	else
+		list->m_head = voice->m_nextByName;
+	if (voice->m_nextByName)
+		voice->m_nextByName->m_prevByName = voice->m_prevByName;
+	else
+		list->m_tail = voice->m_prevByName;
+	voice->m_prevByName = voice->m_nextByName = NULL;
+	--list->m_count;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void linkByPriority( AudioVoiceList *list, AudioVoice *voice )
+{
+	voice->m_prevByPriority = list->m_tail;
+	voice->m_nextByPriority = NULL;
+	if (list->m_tail)
+		list->m_tail->m_nextByPriority = voice;
+	else
+		list->m_head = voice;
+	list->m_tail = voice;
+	++list->m_count;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void unlinkByPriority( AudioVoiceList *list, AudioVoice *voice )
+{
+	if (voice->m_prevByPriority)
+		voice->m_prevByPriority->m_nextByPriority = voice->m_nextByPriority;
+	else
+		list->m_head = voice->m_nextByPriority;
+	if (voice->m_nextByPriority)
+		voice->m_nextByPriority->m_prevByPriority = voice->m_prevByPriority;
+	else
+		list->m_tail = voice->m_prevByPriority;
+	voice->m_prevByPriority = voice->m_nextByPriority = NULL;
+	--list->m_count;
+}
+
+//-------------------------------------------------------------------------------------------------
+Real AudioVoiceSchedulerStats::getRequestsPerSec() const
+{
+	if (m_requestTicks <= 0 || m_ticksPerSec <= 0) {
+		return 0.0f;
+	}
+	return (Real)((double)m_requests * (double)m_ticksPerSec / (double)m_requestTicks);
+}
+
+//-------------------------------------------------------------------------------------------------
+AudioVoiceScheduler::AudioVoiceScheduler() :
+	m_requestStart(0)
+{
+	for (Int i = 0; i < AVC_COUNT; ++i) {
+		m_voiceCount[i] = 0;
+	}
+	resetStats();
+}
+
+//-------------------------------------------------------------------------------------------------
+AudioVoiceScheduler::~AudioVoiceScheduler()
+{
+	DEBUG_ASSERTCRASH(m_voicesByHandle.empty(), ("AudioVoiceScheduler destroyed with %d voices still playing", (Int)m_voicesByHandle.size()));
+
+	for (size_t i = 0; i < m_freeVoices.size(); ++i) {
+		delete m_freeVoices[i];
+	}
+	m_freeVoices.clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+AudioVoiceChannel AudioVoiceScheduler::getChannel( const AudioEventRTS *event )
+{
+	return event->isPositionalAudio() ? AVC_3D : AVC_2D;
+}
+
+//-------------------------------------------------------------------------------------------------
+AudioVoice *AudioVoiceScheduler::allocateVoice()
+{
+	if (m_freeVoices.empty()) {
+		return NEW AudioVoice;	// poolify
+	}
+
+	AudioVoice *voice = m_freeVoices.back();
+	m_freeVoices.pop_back();
+	return voice;
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioVoiceScheduler::releaseVoice( AudioVoice *voice )
+{
+	m_freeVoices.push_back(voice);
+}
+
+//-------------------------------------------------------------------------------------------------
+AudioVoice *AudioVoiceScheduler::addVoice( AudioEventRTS *event, void *userData )
+{
+	const AudioEventInfo *info = event->getAudioEventInfo();
+
+	AudioVoice *voice = allocateVoice();
+	voice->m_handle = event->getPlayingHandle();
+	voice->m_objectID = event->getObjectID();
+	voice->m_priority = info->m_priority;
+	voice->m_channel = getChannel(event);
+	voice->m_isVoice = BitIsSet(info->m_type, ST_VOICE) && voice->m_objectID != INVALID_ID;
+	voice->m_userData = userData;
+
+	voice->m_nameList = &m_voicesByName[voice->m_channel][event->getEventName()];
+	linkByName(voice->m_nameList, voice);
+	linkByPriority(&m_voicesByPriority[voice->m_channel][voice->m_priority], voice);
+
+	if (voice->m_isVoice) {
+		++m_voicesByObject[voice->m_objectID];
+	}
+
+	m_voicesByHandle[voice->m_handle] = voice;
+	++m_voiceCount[voice->m_channel];
+
+	++m_stats.m_voicesAdded;
+	UnsignedInt numVoices = m_voiceCount[AVC_2D] + m_voiceCount[AVC_3D];
+	if (numVoices > m_stats.m_peakVoices) {
+		m_stats.m_peakVoices = numVoices;
+	}
+
+	return voice;
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioVoiceScheduler::removeVoice( AudioVoice *voice )
+{
+	if (!voice) {
+		return;
+	}
+
+	// The event of the voice may already be released at this point, so only the voice is used.
+	unlinkByName(voice->m_nameList, voice);
+	unlinkByPriority(&m_voicesByPriority[voice->m_channel][voice->m_priority], voice);
+
+	if (voice->m_isVoice) {
+		CountByObjectMap::iterator it = m_voicesByObject.find(voice->m_objectID);
+		if (it != m_voicesByObject.end() && --it->second <= 0) {
+			m_voicesByObject.erase(it);
+		}
+	}
+
+	VoicesByHandleMap::iterator it = m_voicesByHandle.find(voice->m_handle);
+	if (it != m_voicesByHandle.end() && it->second == voice) {
+		m_voicesByHandle.erase(it);
+	}
+	--m_voiceCount[voice->m_channel];
+
+	voice->m_nameList = NULL;
+	voice->m_userData = NULL;
+	releaseVoice(voice);
+}
+
+//-------------------------------------------------------------------------------------------------
+AudioVoice *AudioVoiceScheduler::findVoice( AudioHandle handle ) const
+{
+	VoicesByHandleMap::const_iterator it = m_voicesByHandle.find(handle);
+	if (it == m_voicesByHandle.end()) {
+		return NULL;
+	}
+	return it->second;
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioVoiceScheduler::getVoices( std::vector<AudioVoice *> &voices ) const
+{
+	voices.clear();
+	voices.reserve(m_voicesByHandle.size());
+	for (VoicesByHandleMap::const_iterator it = m_voicesByHandle.begin(); it != m_voicesByHandle.end(); ++it) {
+		voices.push_back(it->second);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioVoiceScheduler::addRequest( const AudioRequest *request )
+{
+	if (request && request->m_usePendingEvent && request->m_pendingEvent) {
+		++m_pendingByName[request->m_pendingEvent->getEventName()];
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioVoiceScheduler::removeRequest( const AudioRequest *request )
+{
+	if (request && request->m_usePendingEvent && request->m_pendingEvent) {
+		CountByNameMap::iterator it = m_pendingByName.find(request->m_pendingEvent->getEventName());
+		if (it != m_pendingByName.end() && --it->second <= 0) {
+			m_pendingByName.erase(it);
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioVoiceScheduler::removeAllRequests()
+{
+	m_pendingByName.clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+Int AudioVoiceScheduler::getPendingCount( const AsciiString &eventName ) const
+{
+	CountByNameMap::const_iterator it = m_pendingByName.find(eventName);
+	if (it == m_pendingByName.end()) {
+		return 0;
+	}
+	return it->second;
+}
+
+//-------------------------------------------------------------------------------------------------
+const AudioVoiceList *AudioVoiceScheduler::findNameList( AudioVoiceChannel channel, const AsciiString &eventName ) const
+{
+	VoicesByNameMap::const_iterator it = m_voicesByName[channel].find(eventName);
+	if (it == m_voicesByName[channel].end() || it->second.m_count == 0) {
+		return NULL;
+	}
+	return &it->second;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool AudioVoiceScheduler::doesViolateLimit( AudioEventRTS *event ) const
+{
+	Int limit = event->getAudioEventInfo()->m_limit;
+	if (limit == 0) {
+		return false;
+	}
+
+	Int totalCount = 0;
+	Int totalRequestCount = 0;
+
+	const AudioVoiceList *list = findNameList(getChannel(event), event->getEventName());
+	if (list) {
+		// This is the oldest audio of this type playing.
+		event->setHandleToKill(list->m_head->m_handle);
+		totalCount = list->m_count;
+	}
+
+	// Also check the request list in case we've requested to play this sound.
+	totalRequestCount = getPendingCount(event->getEventName());
+	totalCount += totalRequestCount;
+
+	//If our event is an interrupting type, then normally we would always add it. The exception is when we have requested
+	//multiple sounds in the same frame and those requests violate the limit. Because we don't have any "old" sounds to
+	//remove in the case of an interrupt, we need to catch it early and prevent the sound from being added if we already
+	//reached the limit
+	if( event->getAudioEventInfo()->m_control & AC_INTERRUPT )
+	{
+		if( totalRequestCount < limit )
+		{
+			Int totalPlayingCount = totalCount - totalRequestCount;
+			if( totalRequestCount + totalPlayingCount < limit )
+			{
+				//We aren't exceeding the actual limit, then clear the kill handle.
+				event->setHandleToKill(0);
+				return false;
+			}
+
+			//We are exceeding the limit - the kill handle will kill the
+			//oldest playing sound to enforce the actual limit.
+			return false;
+		}
+	}
+
+	if( totalCount < limit )
+	{
+		event->setHandleToKill(0);
+		return false;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool AudioVoiceScheduler::isPlayingAlready( const AudioEventRTS *event ) const
+{
+	return findNameList(getChannel(event), event->getEventName()) != NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool AudioVoiceScheduler::isPlayingLowerPriority( const AudioEventRTS *event ) const
+{
+	return findLowestPriorityVoice(event) != NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool AudioVoiceScheduler::isObjectPlayingVoice( ObjectID objID ) const
+{
+	if (objID == INVALID_ID) {
+		return false;
+	}
+
+	return m_voicesByObject.find(objID) != m_voicesByObject.end();
+}
+
+//-------------------------------------------------------------------------------------------------
+AudioVoice *AudioVoiceScheduler::findLowestPriorityVoice( const AudioEventRTS *event ) const
+{
+	// The oldest voice of the lowest priority that is below the priority of the event. There is
+	// nothing lower priority than lowest, so the loop is empty for those.
+	AudioVoiceChannel channel = getChannel(event);
+	Int priority = event->getAudioEventInfo()->m_priority;
+	for (Int i = AP_LOWEST; i < priority; ++i) {
+		if (m_voicesByPriority[channel][i].m_head) {
+			return m_voicesByPriority[channel][i].m_head;
+		}
+	}
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioVoiceScheduler::startRequestTimer()
+{
+	m_requestStart = ProfileUtil::getTime();
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioVoiceScheduler::stopRequestTimer( Bool accepted )
+{
+	m_stats.m_requestTicks += ProfileUtil::getTime() - m_requestStart;
+	++m_stats.m_requests;
+	if (accepted) {
+		++m_stats.m_accepted;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioVoiceScheduler::resetStats()
+{
+	m_stats.m_requests = 0;
+	m_stats.m_accepted = 0;
+	m_stats.m_voicesAdded = 0;
+	m_stats.m_peakVoices = 0;
+	m_stats.m_requestTicks = 0;
+	m_stats.m_ticksPerSec = ProfileUtil::getFrequency();
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioVoiceScheduler::reportStats() const
+{
+	if (m_stats.m_requests == 0) {
+		return;
+	}
+
+	DEBUG_LOG(("AudioVoiceScheduler - %u sound requests, %u accepted, %u voices played, peak of %u voices, %.0f requests/sec",
+		m_stats.m_requests, m_stats.m_accepted, m_stats.m_voicesAdded, m_stats.m_peakVoices, m_stats.getRequestsPerSec()));
+}
@@ -51,6 +51,7 @@
 #include "Common/AudioHandleSpecialValues.h"
 #include "Common/AudioRequest.h"
 #include "Common/AudioSettings.h"
+#include "Common/AudioVoiceScheduler.h"
 #include "Common/FileSystem.h"
 #include "Common/GameEngine.h"
 #include "Common/GameMusic.h"
@@ -148,6 +149,8 @@ AudioManager::AudioManager() :
 	m_speechOn(TRUE),
 	m_music(NULL),
 	m_sound(NULL),
+	m_voiceScheduler(NULL),
+	m_prefetchGeneration(1),
 	m_surroundSpeakers(FALSE),
 	m_hardwareAccel(FALSE),
 	m_musicPlayingFromCD(FALSE)
@@ -173,6 +176,7 @@ AudioManager::AudioManager() :
 	m_audioSettings = NEW AudioSettings;
 	m_miscAudio = NEW MiscAudio;
 	m_silentAudioEvent = NEW AudioEventRTS;
+	m_voiceScheduler = NEW AudioVoiceScheduler;
 	m_savedValues = NULL;
 	m_disallowSpeech = FALSE;
 }
@@ -197,6 +201,9 @@ AudioManager::~AudioManager()
 	delete m_sound;
 	m_sound = NULL;
 
+	delete m_voiceScheduler;
+	m_voiceScheduler = NULL;
+
 	delete m_miscAudio;
 	m_miscAudio = NULL;
 
@@ -301,6 +308,11 @@ void AudioManager::reset()
 	m_speechVolume = m_systemSpeechVolume;
 
 	m_disallowSpeech = FALSE;
+
+	m_voiceScheduler->reportStats();
+	m_voiceScheduler->resetStats();
+
+	++m_prefetchGeneration;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -482,7 +494,9 @@ AudioHandle AudioManager::addAudioEvent(const AudioEventRTS *eventToAdd)
 	else
 	{
 		//Possible to nuke audioEvent inside.
+		m_voiceScheduler->startRequestTimer();
 		m_sound->addAudioEvent(audioEvent);
+		m_voiceScheduler->stopRequestTimer(audioEvent != NULL);
 	}
 
 	if( audioEvent )
@@ -517,6 +531,33 @@ Bool AudioManager::isValidAudioEvent( AudioEventRTS *eventToCheck ) const
 	return( eventToCheck->getAudioEventInfo() );
 }
 
+//-------------------------------------------------------------------------------------------------
+void AudioManager::prefetchAudioEvent( const AudioEventRTS *eventToPrefetch )
+{
+	if (!eventToPrefetch) {
+		return;
+	}
+
+	const AsciiString& eventName = eventToPrefetch->getEventName();
+	if (eventName.isEmpty() || eventName == AsciiString("NoSound")) {
+		return;
+	}
+
+	// Work on a copy, generating the filenames must not touch the play state of the original.
+	AudioEventRTS event(*eventToPrefetch);
+	getInfoForAudioEvent(&event);
+	const AudioEventInfo *eventInfo = event.getAudioEventInfo();
+	if (!eventInfo) {
+		return;
+	}
+
+	std::vector<AsciiString> filenames;
+	event.generateAllFilenames(filenames);
+	for (std::vector<AsciiString>::const_iterator it = filenames.begin(); it != filenames.end(); ++it) {
+		prefetchAudioFile(*it, eventInfo);
+	}
+}
+
 //-------------------------------------------------------------------------------------------------
 void AudioManager::addTrackName( const AsciiString& trackName )
 {
@@ -811,6 +852,7 @@ void AudioManager::releaseAudioRequest( AudioRequest *requestToRelease )
 void AudioManager::appendAudioRequest( AudioRequest *m_request )
 {
 	m_audioRequests.push_back(m_request);
+	m_voiceScheduler->addRequest(m_request);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -823,6 +865,7 @@ void AudioManager::removeAllAudioRequests( void )
   }
 
   m_audioRequests.clear();
+  m_voiceScheduler->removeAllRequests();
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -1122,6 +1165,217 @@ void AudioManager::regainFocus( void )
 	m_savedValues = NULL;
 }
 
+// AudioManagerDummy ///////////////////////////////////////////////////////////////////////////////
+enum
+{
+	DUMMY_VOICE_FRAMES = LOGICFRAMES_PER_SECOND * 2	///< how long a headless sound effect is considered to be playing
+};
+
+//-------------------------------------------------------------------------------------------------
+AudioManagerDummy::AudioManagerDummy()
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+AudioManagerDummy::~AudioManagerDummy()
+{
+	stopAllVoices();
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioManagerDummy::reset()
+{
+	AudioManager::reset();
+	stopAllVoices();
+	removeAllAudioRequests();
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioManagerDummy::update()
+{
+	AudioManager::update();
+
+	UnsignedInt now = TheGameLogic->getFrame();
+	while (!m_voiceExpiry.empty() && m_voiceExpiry.front().first <= now)
+	{
+		AudioVoice *voice = m_voiceScheduler->findVoice(m_voiceExpiry.front().second);
+		if (voice)
+		{
+			stopVoice(voice);
+		}
+		m_voiceExpiry.pop_front();
+	}
+
+	processRequestList();
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioManagerDummy::processRequestList( void )
+{
+	std::list<AudioRequest*>::iterator it;
+	for (it = m_audioRequests.begin(); it != m_audioRequests.end(); /* empty */)
+	{
+		AudioRequest *req = (*it);
+		m_voiceScheduler->removeRequest(req);
+
+		switch (req->m_request)
+		{
+			case AR_Play:
+				if (req->m_usePendingEvent)
+				{
+					playAudioEvent(req->m_pendingEvent);
+				}
+				break;
+
+			case AR_Stop:
+			{
+				AudioVoice *voice = m_voiceScheduler->findVoice(req->m_handleToInteractOn);
+				if (voice)
+				{
+					stopVoice(voice);
+				}
+				break;
+			}
+
+			default:
+				break;
+		}
+
+		releaseAudioRequest(req);
+		it = m_audioRequests.erase(it);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioManagerDummy::killAudioEventImmediately( AudioHandle audioEvent )
+{
+	AudioVoice *voice = m_voiceScheduler->findVoice(audioEvent);
+	if (voice)
+	{
+		stopVoice(voice);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+UnsignedInt AudioManagerDummy::getNum2DSamples( void ) const
+{
+	return m_audioSettings->m_sampleCount2D;
+}
+
+//-------------------------------------------------------------------------------------------------
+UnsignedInt AudioManagerDummy::getNum3DSamples( void ) const
+{
+	return m_audioSettings->m_sampleCount3D;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool AudioManagerDummy::doesViolateLimit( AudioEventRTS *event ) const
+{
+	return m_voiceScheduler->doesViolateLimit(event);
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool AudioManagerDummy::isPlayingLowerPriority( AudioEventRTS *event ) const
+{
+	return m_voiceScheduler->isPlayingLowerPriority(event);
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool AudioManagerDummy::isPlayingAlready( AudioEventRTS *event ) const
+{
+	return m_voiceScheduler->isPlayingAlready(event);
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool AudioManagerDummy::isObjectPlayingVoice( UnsignedInt objID ) const
+{
+	return m_voiceScheduler->isObjectPlayingVoice((ObjectID)objID);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Mirrors the channel handling of the sound effects in MilesAudioManager::playAudioEvent, without
+// playing anything. The voice takes ownership of the event.
+void AudioManagerDummy::playAudioEvent( AudioEventRTS *event )
+{
+	const AudioEventInfo *info = event->getAudioEventInfo();
+	if (!info || info->m_soundType != AT_SoundEffect)
+	{
+		// Music and speech don't use the sample channels.
+		releaseAudioEventRTS(event);
+		return;
+	}
+
+	AudioHandle handleToKill = event->getHandleToKill();
+	if (handleToKill)
+	{
+		AudioVoice *voiceToKill = m_voiceScheduler->findVoice(handleToKill);
+		if (!voiceToKill)
+		{
+			// Someone else already killed the sound we were meant to replace.
+			releaseAudioEventRTS(event);
+			return;
+		}
+		stopVoice(voiceToKill);
+	}
+
+	AudioVoiceChannel channel = AudioVoiceScheduler::getChannel(event);
+	UnsignedInt numChannels = (channel == AVC_3D) ? getNum3DSamples() : getNum2DSamples();
+	if ((UnsignedInt)m_voiceScheduler->getVoiceCount(channel) >= numChannels)
+	{
+		AudioVoice *lowestPriorityVoice = m_voiceScheduler->findLowestPriorityVoice(event);
+		if (!lowestPriorityVoice)
+		{
+			releaseAudioEventRTS(event);
+			return;
+		}
+		stopVoice(lowestPriorityVoice);
+	}
+
+	m_voiceScheduler->addVoice(event, event);
+	if (m_sound)
+	{
+		if (channel == AVC_3D)
+			m_sound->notifyOf3DSampleStart();
+		else
+			m_sound->notifyOf2DSampleStart();
+	}
+
+	if (!info->isPermanentSound())
+	{
+		m_voiceExpiry.push_back(std::make_pair(TheGameLogic->getFrame() + DUMMY_VOICE_FRAMES, event->getPlayingHandle()));
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioManagerDummy::stopVoice( AudioVoice *voice )
+{
+	AudioEventRTS *event = (AudioEventRTS *)voice->m_userData;
+	AudioVoiceChannel channel = voice->m_channel;
+	m_voiceScheduler->removeVoice(voice);
+
+	if (m_sound)
+	{
+		if (channel == AVC_3D)
+			m_sound->notifyOf3DSampleCompletion();
+		else
+			m_sound->notifyOf2DSampleCompletion();
+	}
+
+	releaseAudioEventRTS(event);
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioManagerDummy::stopAllVoices( void )
+{
+	std::vector<AudioVoice *> voices;
+	m_voiceScheduler->getVoices(voices);
+	for (size_t i = 0; i < voices.size(); ++i)
+	{
+		stopVoice(voices[i]);
+	}
+	m_voiceExpiry.clear();
+}
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
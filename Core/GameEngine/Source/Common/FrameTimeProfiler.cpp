@@ -0,0 +1,132 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/FrameTimeProfiler.h"
+
+#include "Common/GlobalData.h"
+#include "Common/ProfileUtil.h"
+
+#include <algorithm>
+
+
+FrameTimeProfiler::SampleList FrameTimeProfiler::s_samples;
+FrameTimeProfiler::Sample FrameTimeProfiler::s_current;
+Int64 FrameTimeProfiler::s_partStart = 0;
+Bool FrameTimeProfiler::s_inFrame = false;
+
+namespace
+{
+// Reserve for an hour at 30 updates per second, so that recording rarely allocates during a game.
+enum { EXPECTED_SAMPLE_COUNT = 30 * 60 * 60 };
+} // namespace
+
+Real FrameTimeProfiler::millisecondsSince(Int64 start, Int64 &now)
+{
+	now = ProfileUtil::getTime();
+	return (Real)ProfileUtil::ticksToMilliseconds(now - start);
+}
+
+void FrameTimeProfiler::beginFrame()
+{
+	if (!TheGlobalData->m_benchmarkFrameTime)
+		return;
+
+	if (s_samples.capacity() == 0)
+		s_samples.reserve(EXPECTED_SAMPLE_COUNT);
+
+	s_partStart = ProfileUtil::getTime();
+	s_current.clientMilliseconds = 0.0f;
+	s_current.logicMilliseconds = 0.0f;
+	s_inFrame = true;
+}
+
+void FrameTimeProfiler::markClientDone()
+{
+	if (!s_inFrame)
+		return;
+
+	s_current.clientMilliseconds = millisecondsSince(s_partStart, s_partStart);
+}
+
+void FrameTimeProfiler::endFrame()
+{
+	if (!s_inFrame)
+		return;
+
+	s_current.logicMilliseconds = millisecondsSince(s_partStart, s_partStart);
+	s_samples.push_back(s_current);
+	s_inFrame = false;
+}
+
+void FrameTimeProfiler::printDistribution(const char *name, std::vector<Real> &milliseconds, Bool last)
+{
+	std::sort(milliseconds.begin(), milliseconds.end());
+
+	const size_t count = milliseconds.size();
+	double sum = 0.0;
+	for (size_t i = 0; i < count; ++i)
+		sum += milliseconds[i];
+
+	ProfileUtil::print("    \"%s\": { \"avgMs\": %.3f, \"p50Ms\": %.3f, \"p90Ms\": %.3f, \"p99Ms\": %.3f, \"maxMs\": %.3f }%s\n",
+		name, sum / (double)count,
+		ProfileUtil::percentile(milliseconds, 50), ProfileUtil::percentile(milliseconds, 90), ProfileUtil::percentile(milliseconds, 99),
+		ProfileUtil::percentile(milliseconds, 100), last ? "" : ",");
+}
+
+void FrameTimeProfiler::report(const char *name)
+{
+	s_inFrame = false;
+	if (s_samples.empty())
+		return;
+
+	const size_t count = s_samples.size();
+	std::vector<Real> client(count);
+	std::vector<Real> logic(count);
+	std::vector<Real> serial(count);
+	std::vector<Real> pipelined(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Sample &sample = s_samples[i];
+		client[i] = sample.clientMilliseconds;
+		logic[i] = sample.logicMilliseconds;
+		serial[i] = sample.clientMilliseconds + sample.logicMilliseconds;
+		// The client draws frame N while the logic computes frame N+1, the slower of the two sets the pace.
+		pipelined[i] = MAX(sample.clientMilliseconds, sample.logicMilliseconds);
+	}
+
+	ProfileUtil::print("{\n");
+	ProfileUtil::print("  \"map\": ");
+	ProfileUtil::writeJsonString(stdout, name);
+	ProfileUtil::print(",\n");
+	ProfileUtil::print("  \"frames\": %u,\n", (UnsignedInt)count);
+	ProfileUtil::print("  \"frameTime\": {\n");
+	printDistribution("client", client, FALSE);
+	printDistribution("logic", logic, FALSE);
+	printDistribution("serial", serial, FALSE);
+	printDistribution("pipelined", pipelined, TRUE);
+	ProfileUtil::print("  }\n");
+	ProfileUtil::print("}\n");
+	fflush(stdout);
+
+	DEBUG_LOG(("FrameTimeProfiler - %u frames of %s: serial p50 %.3f ms, pipelined p50 %.3f ms",
+		(UnsignedInt)count, name, serial[(count - 1) / 2], pipelined[(count - 1) / 2]));
+
+	s_samples.clear();
+}
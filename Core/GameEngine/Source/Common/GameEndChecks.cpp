@@ -0,0 +1,74 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/GameEndChecks.h"
+
+
+GameEndChecks::Check GameEndChecks::s_checks[CHECK_COUNT] =
+{
+	{ "-benchmarkRadarTerrain", FALSE, FALSE, 0, NULL },
+	{ "-benchmarkRadarObjects", FALSE, FALSE, 0, NULL },
+	{ "-benchmarkTerrainRebuild", FALSE, FALSE, 0, NULL },
+	{ "-verifyShroudCircles", TRUE, FALSE, 0, NULL },
+	{ "-verifyLOS", TRUE, FALSE, 0, NULL },
+	{ "-benchmarkShroud", FALSE, FALSE, 0, NULL },
+	{ "-benchmarkGroupPath", FALSE, FALSE, 0, NULL },
+	{ "-benchmarkAnim", FALSE, FALSE, 0, NULL },
+};
+
+Int GameEndChecks::parseFlag(char *args[], Int num)
+{
+	for (Int i = 0; i < CHECK_COUNT; ++i)
+	{
+		Check &check = s_checks[i];
+		if (stricmp(args[0], check.flag) != 0)
+			continue;
+
+		if (!check.hasSeed)
+		{
+			check.enabled = TRUE;
+			return 1;
+		}
+
+		if (num > 1)
+		{
+			check.enabled = TRUE;
+			check.seed = (UnsignedInt)atoi(args[1]);
+			return 2;
+		}
+		break;
+	}
+	return 1;
+}
+
+void GameEndChecks::registerCheck(CheckType type, CheckFunc func)
+{
+	s_checks[type].func = func;
+}
+
+void GameEndChecks::run()
+{
+	for (Int i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Check &check = s_checks[i];
+		if (check.enabled && check.func != NULL)
+			check.func(check.seed);
+	}
+}
@@ -0,0 +1,183 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/LoadProfiler.h"
+
+#include "Common/FileSystem.h"
+#include "Common/GlobalData.h"
+#include "Common/LocalFile.h"
+#include "Common/ProfileUtil.h"
+#include "Common/RandomValue.h"
+#include "Common/Tracer.h"
+#include "GameLogic/GameLogic.h"
+
+
+Bool LoadProfiler::s_isLoading = false;
+LoadProfiler::PhaseList LoadProfiler::s_phases;
+LoadProfiler::Counters LoadProfiler::s_phaseStart;
+
+namespace
+{
+enum { EXPECTED_PHASE_COUNT = 32 };
+} // namespace
+
+void LoadProfiler::readCounters(Counters &counters)
+{
+	counters.time = ProfileUtil::getTime();
+	counters.allocations = getMemoryAllocationCount();
+	counters.bytesRead = LocalFile::getTotalBytesRead();
+}
+
+void LoadProfiler::beginLoad()
+{
+	// Reserve up front so that recording a phase does not count as an allocation of the next one.
+	s_phases.clear();
+	s_phases.reserve(EXPECTED_PHASE_COUNT);
+	s_isLoading = true;
+	readCounters(s_phaseStart);
+}
+
+void LoadProfiler::markPhase(const char *name)
+{
+	if (!s_isLoading)
+		return;
+
+	Counters now;
+	readCounters(now);
+
+	Phase phase;
+	phase.name = name;
+	phase.milliseconds = (Real)ProfileUtil::ticksToMilliseconds(now.time - s_phaseStart.time);
+	// The counters wrap around, the unsigned difference is still right.
+	phase.allocations = now.allocations - s_phaseStart.allocations;
+	phase.bytesRead = now.bytesRead - s_phaseStart.bytesRead;
+	s_phases.push_back(phase);
+
+	// The phases show as zones of the map load in the trace of -trace.
+	Tracer::addEvent(name, s_phaseStart.time, now.time);
+
+	s_phaseStart = now;
+}
+
+void LoadProfiler::endLoad(const char *name)
+{
+	if (!s_isLoading)
+		return;
+
+	markPhase(name);
+	s_isLoading = false;
+
+	// Stream the zones of the load to the trace file of -trace before the first frame adds its own.
+	Tracer::flush();
+
+	Real totalMilliseconds = 0.0f;
+	for (PhaseList::const_iterator it = s_phases.begin(); it != s_phases.end(); ++it)
+	{
+		DEBUG_LOG(("Load phase %s: %.2f ms, %u allocations, %u bytes read", it->name, it->milliseconds, it->allocations, it->bytesRead));
+		totalMilliseconds += it->milliseconds;
+	}
+	DEBUG_LOG(("Load of %s took %.2f ms", TheGlobalData->m_mapName.str(), totalMilliseconds));
+}
+
+int LoadProfiler::benchmarkLoad(const AsciiString &mapName, Int runCount)
+{
+	if (!TheFileSystem->doesFileExist(mapName.str()))
+	{
+		ProfileUtil::print("Cannot open map \"%s\"\n", mapName.str());
+		return 1;
+	}
+
+	std::vector<PhaseList> runs;
+	for (Int run = 0; run < runCount; ++run)
+	{
+		TheWritableGlobalData->m_pendingFile = mapName;
+		InitRandom(0);
+		TheGameLogic->prepareNewGame(GAME_SINGLE_PLAYER, DIFFICULTY_NORMAL, 0);
+
+		// The first call only sets up the load screen of a single player game, the second one loads the map.
+		TheGameLogic->startNewGame(FALSE);
+		TheGameLogic->startNewGame(FALSE);
+
+		if (s_phases.empty())
+		{
+			ProfileUtil::print("Cannot load map \"%s\"\n", mapName.str());
+			return 1;
+		}
+		runs.push_back(s_phases);
+
+		TheGameLogic->clearGameData(FALSE);
+	}
+
+	if (runs.empty())
+		return 0;
+
+	// Every load goes through the same phases, so they are matched up by index.
+	size_t phaseCount = runs[0].size();
+	size_t i, r;
+	for (r = 1; r < runs.size(); ++r)
+		phaseCount = MIN(phaseCount, runs[r].size());
+
+	ProfileUtil::print("{\n");
+	ProfileUtil::print("  \"map\": ");
+	ProfileUtil::writeJsonString(stdout, mapName.str());
+	ProfileUtil::print(",\n");
+	ProfileUtil::print("  \"runs\": %d,\n", (int)runs.size());
+
+	ProfileUtil::print("  \"totalMs\": [");
+	for (r = 0; r < runs.size(); ++r)
+	{
+		Real totalMilliseconds = 0.0f;
+		for (i = 0; i < runs[r].size(); ++i)
+			totalMilliseconds += runs[r][i].milliseconds;
+		ProfileUtil::print("%s%.3f", r == 0 ? "" : ", ", totalMilliseconds);
+	}
+	ProfileUtil::print("],\n");
+
+	ProfileUtil::print("  \"phases\": [\n");
+	for (i = 0; i < phaseCount; ++i)
+	{
+		Real minMilliseconds = runs[0][i].milliseconds;
+		Real maxMilliseconds = runs[0][i].milliseconds;
+		double sumMilliseconds = 0.0;
+		double sumAllocations = 0.0;
+		double sumBytesRead = 0.0;
+		for (r = 0; r < runs.size(); ++r)
+		{
+			const Phase &phase = runs[r][i];
+			minMilliseconds = MIN(minMilliseconds, phase.milliseconds);
+			maxMilliseconds = MAX(maxMilliseconds, phase.milliseconds);
+			sumMilliseconds += phase.milliseconds;
+			sumAllocations += phase.allocations;
+			sumBytesRead += phase.bytesRead;
+		}
+		const double count = (double)runs.size();
+
+		ProfileUtil::print("    { \"name\": ");
+		ProfileUtil::writeJsonString(stdout, runs[0][i].name);
+		ProfileUtil::print(", \"minMs\": %.3f, \"avgMs\": %.3f, \"maxMs\": %.3f, \"allocations\": %.0f, \"bytesRead\": %.0f }%s\n",
+			minMilliseconds, sumMilliseconds / count, maxMilliseconds, sumAllocations / count, sumBytesRead / count,
+			i + 1 < phaseCount ? "," : "");
+	}
+	ProfileUtil::print("  ]\n");
+	ProfileUtil::print("}\n");
+	fflush(stdout);
+
+	return 0;
+}
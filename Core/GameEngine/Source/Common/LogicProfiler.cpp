@@ -0,0 +1,151 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/LogicProfiler.h"
+
+#include <algorithm>
+
+
+std::vector<Real> LogicProfiler::s_frameMilliseconds;
+LogicProfiler::PhaseStats LogicProfiler::s_phaseStats[PHASE_COUNT + 1];
+Int64 LogicProfiler::s_phaseTicks[PHASE_COUNT];
+Int64 LogicProfiler::s_frameStart = 0;
+Bool LogicProfiler::s_isRecording = false;
+Bool LogicProfiler::s_inFrame = false;
+
+namespace
+{
+// Reserve for an hour of game time, so that recording rarely allocates during a replay.
+enum { EXPECTED_FRAME_COUNT = LOGICFRAMES_PER_SECOND * 60 * 60 };
+
+// The JSON names of the phases, in the order of LogicProfiler::Phase.
+const char *const PHASE_NAMES[LogicProfiler::PHASE_COUNT + 1] =
+{
+	"scripts",
+	"terrain",
+	"crc",
+	"sleepyUpdates",
+	"ai",
+	"partition",
+	"destroyList",
+	"other",
+};
+} // namespace
+
+void LogicProfiler::beginReplay()
+{
+	s_frameMilliseconds.clear();
+	s_frameMilliseconds.reserve(EXPECTED_FRAME_COUNT);
+	memset(s_phaseStats, 0, sizeof(s_phaseStats));
+	s_isRecording = true;
+	s_inFrame = false;
+}
+
+void LogicProfiler::beginFrame()
+{
+	if (!s_isRecording)
+		return;
+
+	memset(s_phaseTicks, 0, sizeof(s_phaseTicks));
+	s_inFrame = true;
+	s_frameStart = ProfileUtil::getTime();
+}
+
+void LogicProfiler::endFrame()
+{
+	if (!s_inFrame)
+		return;
+
+	const Int64 frameTicks = ProfileUtil::getTime() - s_frameStart;
+	s_inFrame = false;
+
+	const double millisecondsPerTick = ProfileUtil::ticksToMilliseconds(1);
+	Int64 phaseTicks = 0;
+	for (Int i = 0; i < PHASE_COUNT; ++i)
+	{
+		const double milliseconds = (double)s_phaseTicks[i] * millisecondsPerTick;
+		s_phaseStats[i].sum += milliseconds;
+		s_phaseStats[i].sumOfSquares += milliseconds * milliseconds;
+		phaseTicks += s_phaseTicks[i];
+	}
+
+	const double otherMilliseconds = (double)(frameTicks - phaseTicks) * millisecondsPerTick;
+	s_phaseStats[PHASE_COUNT].sum += otherMilliseconds;
+	s_phaseStats[PHASE_COUNT].sumOfSquares += otherMilliseconds * otherMilliseconds;
+
+	s_frameMilliseconds.push_back((Real)((double)frameTicks * millisecondsPerTick));
+}
+
+void LogicProfiler::writePhase(FILE *fp, const char *name, const PhaseStats &stats, size_t frameCount, Bool last)
+{
+	fprintf(fp, "        \"%s\": { \"totalMs\": %.3f, \"meanMs\": %.4f, \"stddevMs\": %.4f }%s\n",
+		name, stats.sum, frameCount != 0 ? stats.sum / (double)frameCount : 0.0,
+		ProfileUtil::standardDeviation(stats.sum, stats.sumOfSquares, frameCount), last ? "" : ",");
+}
+
+void LogicProfiler::writeReplay(FILE *fp, const char *replayName, Real seconds, Bool failed, Bool first)
+{
+	s_isRecording = false;
+	s_inFrame = false;
+
+	std::vector<Real> &frames = s_frameMilliseconds;
+	std::sort(frames.begin(), frames.end());
+
+	const size_t count = frames.size();
+	double sum = 0.0;
+	double sumOfSquares = 0.0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		sum += frames[i];
+		sumOfSquares += (double)frames[i] * frames[i];
+	}
+
+	const double mean = count != 0 ? sum / (double)count : 0.0;
+	const double logicFps = sum > 0.0 ? (double)count * 1000.0 / sum : 0.0;
+	const Real p50 = ProfileUtil::percentile(frames, 50);
+	const Real p99 = ProfileUtil::percentile(frames, 99);
+	const Real maximum = ProfileUtil::percentile(frames, 100);
+
+	fprintf(fp, "%s    {\n", first ? "" : ",\n");
+	fprintf(fp, "      \"replay\": ");
+	ProfileUtil::writeJsonString(fp, replayName);
+	fprintf(fp, ",\n");
+	fprintf(fp, "      \"failed\": %s,\n", failed ? "true" : "false");
+	fprintf(fp, "      \"frames\": %u,\n", (UnsignedInt)count);
+	fprintf(fp, "      \"seconds\": %.3f,\n", seconds);
+	fprintf(fp, "      \"logicFps\": %.1f,\n", logicFps);
+	fprintf(fp, "      \"frameTime\": { \"meanMs\": %.4f, \"stddevMs\": %.4f, \"p50Ms\": %.4f, \"p99Ms\": %.4f, \"maxMs\": %.4f },\n",
+		mean, ProfileUtil::standardDeviation(sum, sumOfSquares, count), p50, p99, maximum);
+	fprintf(fp, "      \"phases\": {\n");
+	for (Int i = 0; i <= PHASE_COUNT; ++i)
+		writePhase(fp, PHASE_NAMES[i], s_phaseStats[i], count, i == PHASE_COUNT);
+	fprintf(fp, "      }\n");
+	fprintf(fp, "    }");
+	fflush(fp);
+
+	ProfileUtil::print("Logic: %u frames, %.1f frames per second, frame time p50 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+		(UnsignedInt)count, logicFps, p50, p99, maximum);
+	fflush(stdout);
+
+	DEBUG_LOG(("LogicProfiler - %u frames of %s: %.1f frames per second, p50 %.3f ms, p99 %.3f ms, max %.3f ms",
+		(UnsignedInt)count, replayName, logicFps, p50, p99, maximum));
+
+	frames.clear();
+}
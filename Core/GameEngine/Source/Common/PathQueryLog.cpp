@@ -0,0 +1,222 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: PathQueryLog.cpp /////////////////////////////////////////////////////////////////////////
+// Records the path queries of the pathfind queue or checks them against a recording
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/PathQueryLog.h"
+
+#include "Common/ProfileUtil.h"
+
+
+FILE *PathQueryLog::s_file = NULL;
+Bool PathQueryLog::s_isVerifying = FALSE;
+Bool PathQueryLog::s_hasDiverged = FALSE;
+Bool PathQueryLog::s_hasReadEndOfGame = FALSE;
+UnsignedInt PathQueryLog::s_queryCount = 0;
+UnsignedInt PathQueryLog::s_mismatchCount = 0;
+
+namespace
+{
+const UnsignedInt LOG_MAGIC = 0x4C515150; // "PQQL"
+const UnsignedInt LOG_VERSION = 1;
+
+// Only the first mismatches are printed, the later ones usually follow from them.
+const UnsignedInt MAX_PRINTED_MISMATCHES = 10;
+
+const char *const QUERY_TYPE_NAMES[] =
+{
+	"findPath",
+	"findClosestPath",
+	"findAttackPath",
+	"findSafePath",
+	"patchPath",
+	"findGroundPath",
+	"getAircraftPath",
+	"getMoveAwayFromPath"
+};
+
+Bool isSamePosition(const Coord3D &a, const Coord3D &b)
+{
+	return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+} // namespace
+
+Bool PathQueryLog::startRecording(const char *fileName)
+{
+	s_file = fopen(fileName, "wb");
+	if (s_file == NULL)
+	{
+		ProfileUtil::print("Cannot open path query log \"%s\"\n", fileName);
+		return FALSE;
+	}
+	fwrite(&LOG_MAGIC, sizeof(LOG_MAGIC), 1, s_file);
+	fwrite(&LOG_VERSION, sizeof(LOG_VERSION), 1, s_file);
+	s_isVerifying = FALSE;
+	return TRUE;
+}
+
+Bool PathQueryLog::startVerifying(const char *fileName)
+{
+	s_file = fopen(fileName, "rb");
+	if (s_file == NULL)
+	{
+		ProfileUtil::print("Cannot open path query log \"%s\"\n", fileName);
+		return FALSE;
+	}
+
+	UnsignedInt magic = 0;
+	UnsignedInt version = 0;
+	if (fread(&magic, sizeof(magic), 1, s_file) != 1 || fread(&version, sizeof(version), 1, s_file) != 1
+		|| magic != LOG_MAGIC || version != LOG_VERSION)
+	{
+		ProfileUtil::print("\"%s\" is no path query log of this version\n", fileName);
+		fclose(s_file);
+		s_file = NULL;
+		return FALSE;
+	}
+	s_isVerifying = TRUE;
+	return TRUE;
+}
+
+void PathQueryLog::writeQuery(const Query &query)
+{
+	const UnsignedInt cellCount = (UnsignedInt)query.cells.size();
+	fwrite(&query.type, sizeof(query.type), 1, s_file);
+	fwrite(&query.frame, sizeof(query.frame), 1, s_file);
+	fwrite(&query.objectID, sizeof(query.objectID), 1, s_file);
+	fwrite(&query.from, sizeof(query.from), 1, s_file);
+	fwrite(&query.to, sizeof(query.to), 1, s_file);
+	fwrite(&cellCount, sizeof(cellCount), 1, s_file);
+	if (cellCount != 0)
+		fwrite(&query.cells[0], sizeof(Cell), cellCount, s_file);
+}
+
+Bool PathQueryLog::readQuery(Query &query)
+{
+	UnsignedInt cellCount = 0;
+	if (fread(&query.type, sizeof(query.type), 1, s_file) != 1
+		|| fread(&query.frame, sizeof(query.frame), 1, s_file) != 1
+		|| fread(&query.objectID, sizeof(query.objectID), 1, s_file) != 1
+		|| fread(&query.from, sizeof(query.from), 1, s_file) != 1
+		|| fread(&query.to, sizeof(query.to), 1, s_file) != 1
+		|| fread(&cellCount, sizeof(cellCount), 1, s_file) != 1)
+	{
+		return FALSE;
+	}
+	query.cells.resize(cellCount);
+	return cellCount == 0 || fread(&query.cells[0], sizeof(Cell), cellCount, s_file) == cellCount;
+}
+
+Bool PathQueryLog::isSameQuery(const Query &a, const Query &b)
+{
+	return a.type == b.type && a.frame == b.frame && a.objectID == b.objectID
+		&& isSamePosition(a.from, b.from) && isSamePosition(a.to, b.to);
+}
+
+void PathQueryLog::addQuery(const Query &query)
+{
+	if (s_file == NULL)
+		return;
+
+	if (!s_isVerifying)
+	{
+		writeQuery(query);
+		++s_queryCount;
+		return;
+	}
+
+	if (s_hasDiverged)
+		return;
+
+	Query recorded;
+	const Bool hasRecorded = readQuery(recorded);
+	s_hasReadEndOfGame = hasRecorded && recorded.type == END_OF_GAME;
+	if (!hasRecorded || s_hasReadEndOfGame || !isSameQuery(recorded, query))
+	{
+		// A different query means the game took another course before, so nothing after it can be compared.
+		ProfileUtil::print("Path query %u diverged from the recording: %s of object %u in frame %u\n",
+			s_queryCount, QUERY_TYPE_NAMES[query.type], query.objectID, query.frame);
+		s_hasDiverged = TRUE;
+		return;
+	}
+	++s_queryCount;
+
+	size_t mismatchIndex = 0;
+	while (mismatchIndex < query.cells.size() && mismatchIndex < recorded.cells.size())
+	{
+		const Cell &cell = query.cells[mismatchIndex];
+		const Cell &recordedCell = recorded.cells[mismatchIndex];
+		if (cell.x != recordedCell.x || cell.y != recordedCell.y || cell.layer != recordedCell.layer)
+			break;
+		++mismatchIndex;
+	}
+	if (mismatchIndex == query.cells.size() && mismatchIndex == recorded.cells.size())
+		return;
+
+	if (s_mismatchCount < MAX_PRINTED_MISMATCHES)
+	{
+		ProfileUtil::print("Path mismatch: %s of object %u in frame %u has %u nodes, the recording has %u, they differ from node %u\n",
+			QUERY_TYPE_NAMES[query.type], query.objectID, query.frame,
+			(UnsignedInt)query.cells.size(), (UnsignedInt)recorded.cells.size(), (UnsignedInt)mismatchIndex);
+	}
+	++s_mismatchCount;
+}
+
+void PathQueryLog::endGame()
+{
+	if (s_file == NULL)
+		return;
+
+	if (!s_isVerifying)
+	{
+		Query endOfGame;
+		endOfGame.type = END_OF_GAME;
+		endOfGame.frame = 0;
+		endOfGame.objectID = 0;
+		endOfGame.from.zero();
+		endOfGame.to.zero();
+		writeQuery(endOfGame);
+		fflush(s_file);
+		ProfileUtil::print("Path queries: %u recorded\n", s_queryCount);
+	}
+	else
+	{
+		// Skip the rest of the recorded game, so that the next game is compared from its start.
+		UnsignedInt skippedCount = 0;
+		Query recorded;
+		while (!s_hasReadEndOfGame && readQuery(recorded) && recorded.type != END_OF_GAME)
+			++skippedCount;
+
+		if (skippedCount != 0 && !s_hasDiverged)
+		{
+			ProfileUtil::print("Path query %u diverged from the recording: the recording has %u more queries\n", s_queryCount, skippedCount);
+			s_hasDiverged = TRUE;
+		}
+		ProfileUtil::print("Path queries: %u matched the recording, %u returned a different path%s\n",
+			s_queryCount - s_mismatchCount, s_mismatchCount, s_hasDiverged ? ", the rest diverged" : "");
+	}
+
+	s_queryCount = 0;
+	s_mismatchCount = 0;
+	s_hasDiverged = FALSE;
+	s_hasReadEndOfGame = FALSE;
+}
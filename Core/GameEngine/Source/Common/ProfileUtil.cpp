@@ -0,0 +1,94 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/ProfileUtil.h"
+
+#include <math.h>
+#include <stdarg.h>
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+
+Int64 ProfileUtil::getTime()
+{
+#ifdef _WIN32
+	LARGE_INTEGER time;
+	QueryPerformanceCounter(&time);
+	return time.QuadPart;
+#else
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (Int64)time.tv_sec * 1000000000 + time.tv_nsec;
+#endif
+}
+
+Int64 ProfileUtil::getFrequency()
+{
+	// The frequency is fixed at boot, so threads racing to set it all store the same value.
+	static Int64 s_frequency = 0;
+	if (s_frequency == 0)
+	{
+#ifdef _WIN32
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		s_frequency = frequency.QuadPart;
+#else
+		s_frequency = 1000000000;
+#endif
+	}
+	return s_frequency;
+}
+
+Real ProfileUtil::percentile(const std::vector<Real> &sortedValues, Int percent)
+{
+	if (sortedValues.empty())
+		return 0.0f;
+	return sortedValues[(sortedValues.size() - 1) * percent / 100];
+}
+
+double ProfileUtil::standardDeviation(double sum, double sumOfSquares, size_t count)
+{
+	if (count < 2)
+		return 0.0;
+	const double variance = (sumOfSquares - sum * sum / (double)count) / (double)(count - 1);
+	return variance > 0.0 ? sqrt(variance) : 0.0;
+}
+
+void ProfileUtil::writeJsonString(FILE *fp, const char *str)
+{
+	fputc('"', fp);
+	for (; *str; ++str)
+	{
+		if (*str == '"' || *str == '\\')
+			fputc('\\', fp);
+		fputc(*str, fp);
+	}
+	fputc('"', fp);
+}
+
+void ProfileUtil::print(const char *format, ...)
+{
+	// Note that we use printf here because this is run from cmd.
+	va_list args;
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+}
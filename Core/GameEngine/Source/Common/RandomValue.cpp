@@ -148,6 +148,17 @@ UnsignedInt GetGameLogicRandomSeedCRC( void )
 	return c.get();
 }
 
+// TheSuperHackers @feature 18/10/2026 The replay checkpoints restore the generator where they left it.
+void GetGameLogicRandomState( UnsignedInt state[6] )
+{
+	memcpy(state, theGameLogicSeed, 6*sizeof(UnsignedInt));
+}
+
+void SetGameLogicRandomState( const UnsignedInt state[6] )
+{
+	memcpy(theGameLogicSeed, state, 6*sizeof(UnsignedInt));
+}
+
 void InitRandom( void )
 {
 #ifdef DETERMINISTIC
@@ -0,0 +1,575 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: ReplayIndex.cpp //////////////////////////////////////////////////////////////////////////
+// Keeps the parsed replay headers in an index file and filters replays by their header
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/ReplayIndex.h"
+
+#include "Common/file.h"
+#include "Common/FileSystem.h"
+#include "Common/LocalFileSystem.h"
+#include "Common/ProfileUtil.h"
+#include "Common/ReplaySimulation.h"
+#include "Common/WorkerPool.h"
+
+
+namespace
+{
+const char *const INDEX_FILE_NAME = "ReplayIndex.dat";
+const UnsignedInt INDEX_MAGIC = 0x58495052; // "RPIX"
+const UnsignedInt INDEX_VERSION = 1;
+
+// The replay header strings are at most this long, see RecorderClass::readAsciiString.
+enum { MAX_STRING_LENGTH = 1023 };
+
+// Serializes the index into one memory block, so that the index file is written at once.
+class IndexWriter
+{
+public:
+	void write(const void *data, size_t size)
+	{
+		const char *bytes = (const char *)data;
+		m_data.insert(m_data.end(), bytes, bytes + size);
+	}
+
+	template <typename T>
+	void writeValue(const T &value) { write(&value, sizeof(value)); }
+
+	void writeString(const AsciiString &str)
+	{
+		const UnsignedShort length = (UnsignedShort)MIN(str.getLength(), (Int)MAX_STRING_LENGTH);
+		writeValue(length);
+		write(str.str(), length);
+	}
+
+	void writeString(const UnicodeString &str)
+	{
+		const UnsignedShort length = (UnsignedShort)MIN(str.getLength(), (Int)MAX_STRING_LENGTH);
+		writeValue(length);
+		write(str.str(), length * sizeof(WideChar));
+	}
+
+	const std::vector<char> &getData() const { return m_data; }
+
+private:
+	std::vector<char> m_data;
+};
+
+// Reads the index from memory. Any read past the end marks the whole index as unreadable.
+class IndexReader
+{
+public:
+	IndexReader(const char *data, Int size) : m_data(data), m_size(size), m_pos(0), m_failed(FALSE) {}
+
+	void read(void *data, Int size)
+	{
+		if (m_failed || size > m_size - m_pos)
+		{
+			m_failed = TRUE;
+			memset(data, 0, size);
+			return;
+		}
+		memcpy(data, m_data + m_pos, size);
+		m_pos += size;
+	}
+
+	template <typename T>
+	void readValue(T &value) { read(&value, sizeof(value)); }
+
+	void readString(AsciiString &str)
+	{
+		char buffer[MAX_STRING_LENGTH + 1];
+		const Int length = readLength();
+		read(buffer, length);
+		buffer[length] = '\0';
+		str.set(buffer);
+	}
+
+	void readString(UnicodeString &str)
+	{
+		WideChar buffer[MAX_STRING_LENGTH + 1];
+		const Int length = readLength();
+		read(buffer, length * sizeof(WideChar));
+		buffer[length] = L'\0';
+		str.set(buffer);
+	}
+
+	Bool hasFailed() const { return m_failed; }
+
+private:
+	Int readLength()
+	{
+		UnsignedShort length = 0;
+		readValue(length);
+		if (length > MAX_STRING_LENGTH)
+		{
+			m_failed = TRUE;
+			return 0;
+		}
+		return length;
+	}
+
+	const char *m_data;
+	Int m_size;
+	Int m_pos;
+	Bool m_failed;
+};
+
+void writeHeader(IndexWriter &writer, const RecorderClass::ReplayHeader &header)
+{
+	writer.writeString(header.replayName);
+	writer.writeValue(header.timeVal);
+	writer.writeString(header.versionString);
+	writer.writeString(header.versionTimeString);
+	writer.writeValue(header.versionNumber);
+	writer.writeValue(header.exeCRC);
+	writer.writeValue(header.iniCRC);
+	writer.writeValue((Int64)header.startTime);
+	writer.writeValue((Int64)header.endTime);
+	writer.writeValue(header.frameCount);
+	writer.writeValue(header.quitEarly);
+	writer.writeValue(header.desyncGame);
+	writer.write(header.playerDiscons, sizeof(header.playerDiscons));
+	writer.writeString(header.gameOptions);
+	writer.writeValue(header.localPlayerIndex);
+}
+
+void readHeader(IndexReader &reader, RecorderClass::ReplayHeader &header)
+{
+	Int64 time;
+	reader.readString(header.replayName);
+	reader.readValue(header.timeVal);
+	reader.readString(header.versionString);
+	reader.readString(header.versionTimeString);
+	reader.readValue(header.versionNumber);
+	reader.readValue(header.exeCRC);
+	reader.readValue(header.iniCRC);
+	reader.readValue(time);
+	header.startTime = (time_t)time;
+	reader.readValue(time);
+	header.endTime = (time_t)time;
+	reader.readValue(header.frameCount);
+	reader.readValue(header.quitEarly);
+	reader.readValue(header.desyncGame);
+	reader.read(header.playerDiscons, sizeof(header.playerDiscons));
+	reader.readString(header.gameOptions);
+	reader.readValue(header.localPlayerIndex);
+}
+
+// One replay of ReplayIndex::update. The workers only write their own job.
+struct ScanJob
+{
+	const char *path;				///< full path, owned by the caller
+	Bool isCached;				///< the index has an entry for the file
+	Int64 cachedSize;
+	Int64 cachedTime;
+	FileInfo fileInfo;
+	Bool exists;
+	Bool isChanged;
+	Bool isValid;
+	RecorderClass::ReplayHeader header;
+};
+
+void scanReplay(Int index, void *userData)
+{
+	ScanJob &job = ((ScanJob *)userData)[index];
+
+	job.exists = TheLocalFileSystem->getFileInfo(job.path, &job.fileInfo);
+	if (!job.exists)
+		return;
+
+	if (job.isCached && job.cachedSize == job.fileInfo.size() && job.cachedTime == job.fileInfo.timestamp())
+		return;
+
+	// Files that cannot be opened, for example while they are written, are left out until the next update.
+	File *file = TheLocalFileSystem->openFile(job.path, File::READ | File::BINARY);
+	if (file == NULL)
+	{
+		job.exists = FALSE;
+		return;
+	}
+
+	job.isChanged = TRUE;
+	job.isValid = RecorderClass::readReplayHeaderFields(file, job.header)
+		&& job.header.localPlayerIndex >= -1 && job.header.localPlayerIndex < MAX_SLOTS;
+	file->close();
+}
+
+// Returns the map path of the game options of a replay, which follows the content mask in the M key.
+AsciiString getMapFromGameOptions(const AsciiString &gameOptions)
+{
+	AsciiString options = gameOptions;
+	AsciiString token;
+	while (options.nextToken(&token, ";"))
+	{
+		if (token.startsWith("M=") && token.getLength() > 4)
+			return AsciiString(token.str() + 4);
+	}
+	return AsciiString::TheEmptyString;
+}
+
+Bool containsNoCase(const AsciiString &str, const AsciiString &lowerPart)
+{
+	AsciiString lower = str;
+	lower.toLower();
+	return strstr(lower.str(), lowerPart.str()) != NULL;
+}
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+struct ReplayIndex::Filter
+{
+	Filter() : minFrames(0), maxFrames(~0u) {}
+
+	// Parses "map=<text>;version=<text>;minMinutes=<n>;maxMinutes=<n>", every part is optional.
+	Bool parse(const AsciiString &text)
+	{
+		AsciiString rest = text;
+		AsciiString token;
+		while (rest.nextToken(&token, ";,"))
+		{
+			const char *separator = strchr(token.str(), '=');
+			if (separator == NULL)
+				return FALSE;
+
+			AsciiString key;
+			key.set(token.str(), (Int)(separator - token.str()));
+			AsciiString value = separator + 1;
+			value.toLower();
+
+			if (key.compareNoCase("map") == 0)
+				map = value;
+			else if (key.compareNoCase("version") == 0)
+				version = value;
+			else if (key.compareNoCase("minMinutes") == 0)
+				minFrames = (UnsignedInt)(atof(value.str()) * 60.0 * LOGICFRAMES_PER_SECOND);
+			else if (key.compareNoCase("maxMinutes") == 0)
+				maxFrames = (UnsignedInt)(atof(value.str()) * 60.0 * LOGICFRAMES_PER_SECOND);
+			else
+				return FALSE;
+		}
+		return TRUE;
+	}
+
+	Bool matches(const RecorderClass::ReplayHeader &header) const
+	{
+		if (header.frameCount < minFrames || header.frameCount > maxFrames)
+			return FALSE;
+
+		if (version.isNotEmpty())
+		{
+			AsciiString versionString;
+			versionString.translate(header.versionString);
+			if (!containsNoCase(versionString, version))
+				return FALSE;
+		}
+
+		if (map.isNotEmpty() && !containsNoCase(getMapFromGameOptions(header.gameOptions), map))
+			return FALSE;
+
+		return TRUE;
+	}
+
+	AsciiString map;				///< lower case part of the map path
+	AsciiString version;		///< lower case part of the version string
+	UnsignedInt minFrames;
+	UnsignedInt maxFrames;
+};
+
+//-------------------------------------------------------------------------------------------------
+ReplayIndex::ReplayIndex() :
+	m_isDirty(FALSE)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+AsciiString ReplayIndex::makeKey(const AsciiString &filename)
+{
+	// The file system ignores the case of file names.
+	AsciiString key = filename;
+	key.toLower();
+	return key;
+}
+
+//-------------------------------------------------------------------------------------------------
+AsciiString ReplayIndex::getIndexPath()
+{
+	AsciiString path = RecorderClass::getReplayDir();
+	path.concat(INDEX_FILE_NAME);
+	return path;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayIndex::load()
+{
+	m_entries.clear();
+	m_isDirty = FALSE;
+
+	File *file = TheLocalFileSystem->openFile(getIndexPath().str(), File::READ | File::BINARY);
+	if (file == NULL)
+		return;
+
+	const Int size = file->size();
+	char *data = file->readEntireAndClose();
+	if (data == NULL)
+		return;
+
+	IndexReader reader(data, size);
+	UnsignedInt magic = 0;
+	UnsignedInt version = 0;
+	UnsignedInt count = 0;
+	reader.readValue(magic);
+	reader.readValue(version);
+	reader.readValue(count);
+
+	if (magic == INDEX_MAGIC && version == INDEX_VERSION)
+	{
+		for (UnsignedInt i = 0; i < count && !reader.hasFailed(); ++i)
+		{
+			AsciiString key;
+			Entry entry;
+			reader.readString(key);
+			reader.readValue(entry.fileSize);
+			reader.readValue(entry.fileTime);
+			reader.readValue(entry.isValid);
+			entry.isUpdated = FALSE;
+			if (entry.isValid)
+				readHeader(reader, entry.header);
+			entry.header.filename = key;
+			entry.header.forPlayback = FALSE;
+			m_entries[key] = entry;
+		}
+	}
+
+	if (reader.hasFailed() || magic != INDEX_MAGIC || version != INDEX_VERSION)
+	{
+		DEBUG_LOG(("ReplayIndex - %s is outdated or damaged, all replays are read again", getIndexPath().str()));
+		m_entries.clear();
+		m_isDirty = TRUE;
+	}
+
+	delete [] data;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayIndex::save()
+{
+	const AsciiString replayDir = RecorderClass::getReplayDir();
+
+	// Drop the replays that were deleted since they were last listed.
+	EntryMap::iterator it = m_entries.begin();
+	while (it != m_entries.end())
+	{
+		FileInfo fileInfo;
+		AsciiString path = replayDir;
+		path.concat(it->first);
+		if (!it->second.isUpdated && !TheLocalFileSystem->getFileInfo(path, &fileInfo))
+		{
+			m_entries.erase(it++);
+			m_isDirty = TRUE;
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	if (!m_isDirty)
+		return;
+
+	IndexWriter writer;
+	writer.writeValue(INDEX_MAGIC);
+	writer.writeValue(INDEX_VERSION);
+	writer.writeValue((UnsignedInt)m_entries.size());
+	for (it = m_entries.begin(); it != m_entries.end(); ++it)
+	{
+		const Entry &entry = it->second;
+		writer.writeString(it->first);
+		writer.writeValue(entry.fileSize);
+		writer.writeValue(entry.fileTime);
+		writer.writeValue(entry.isValid);
+		if (entry.isValid)
+			writeHeader(writer, entry.header);
+	}
+
+	File *file = TheFileSystem->openFile(getIndexPath().str(), File::WRITE | File::BINARY);
+	if (file == NULL)
+	{
+		DEBUG_LOG(("ReplayIndex - cannot write %s", getIndexPath().str()));
+		return;
+	}
+
+	const std::vector<char> &data = writer.getData();
+	file->write(&data[0], (Int)data.size());
+	file->close();
+	m_isDirty = FALSE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayIndex::update(const std::vector<AsciiString> &filenames)
+{
+	const AsciiString replayDir = RecorderClass::getReplayDir();
+	const size_t count = filenames.size();
+
+	// The workers must not copy shared strings, so every path is built here.
+	std::vector<AsciiString> paths(count);
+	std::vector<AsciiString> keys(count);
+	std::vector<ScanJob> jobs(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		paths[i] = replayDir;
+		paths[i].concat(filenames[i]);
+		keys[i] = makeKey(filenames[i]);
+
+		ScanJob &job = jobs[i];
+		job.path = paths[i].str();
+		job.isCached = FALSE;
+		job.cachedSize = 0;
+		job.cachedTime = 0;
+		job.exists = FALSE;
+		job.isChanged = FALSE;
+		job.isValid = FALSE;
+
+		EntryMap::const_iterator it = m_entries.find(keys[i]);
+		if (it != m_entries.end())
+		{
+			job.isCached = TRUE;
+			job.cachedSize = it->second.fileSize;
+			job.cachedTime = it->second.fileTime;
+		}
+	}
+
+	if (count != 0)
+		WorkerPool::run((Int)count, scanReplay, &jobs[0]);
+
+	UnsignedInt readCount = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const ScanJob &job = jobs[i];
+		if (!job.exists)
+		{
+			if (m_entries.erase(keys[i]) != 0)
+				m_isDirty = TRUE;
+			continue;
+		}
+
+		Entry &entry = m_entries[keys[i]];
+		entry.isUpdated = TRUE;
+		if (job.isChanged)
+		{
+			entry.fileSize = job.fileInfo.size();
+			entry.fileTime = job.fileInfo.timestamp();
+			entry.isValid = job.isValid;
+			entry.header = job.header;
+			entry.header.filename = filenames[i];
+			entry.header.forPlayback = FALSE;
+			m_isDirty = TRUE;
+			++readCount;
+		}
+	}
+
+	DEBUG_LOG(("ReplayIndex - read %u of %u replay headers", readCount, (UnsignedInt)count));
+}
+
+//-------------------------------------------------------------------------------------------------
+const RecorderClass::ReplayHeader *ReplayIndex::findHeader(const AsciiString &filename) const
+{
+	EntryMap::const_iterator it = m_entries.find(makeKey(filename));
+	if (it == m_entries.end() || !it->second.isValid)
+		return NULL;
+	return &it->second.header;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ReplayIndex::parseFilter(Filter &filter, const AsciiString &filterText)
+{
+	if (filter.parse(filterText))
+		return TRUE;
+
+	ProfileUtil::print("Invalid replay filter \"%s\", use map=<text>;version=<text>;minMinutes=<n>;maxMinutes=<n>\n", filterText.str());
+	DEBUG_LOG(("ReplayIndex - invalid replay filter %s", filterText.str()));
+	return FALSE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ReplayIndex::keepMatching(std::vector<AsciiString> &filenames, const Filter &filter) const
+{
+	std::vector<AsciiString> matching;
+	for (size_t i = 0; i < filenames.size(); ++i)
+	{
+		const RecorderClass::ReplayHeader *header = findHeader(filenames[i]);
+		if (header != NULL && filter.matches(*header))
+			matching.push_back(filenames[i]);
+	}
+	filenames.swap(matching);
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool ReplayIndex::filterReplays(std::vector<AsciiString> &filenames, const AsciiString &filterText)
+{
+	Filter filter;
+	if (!parseFilter(filter, filterText))
+		return FALSE;
+
+	const size_t totalCount = filenames.size();
+
+	ReplayIndex index;
+	index.load();
+	index.update(filenames);
+	index.save();
+	index.keepMatching(filenames, filter);
+
+	DEBUG_LOG(("ReplayIndex - %u of %u replays match the filter %s", (UnsignedInt)filenames.size(), (UnsignedInt)totalCount, filterText.str()));
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+Int ReplayIndex::listReplays(const AsciiString &wildcard, const AsciiString &filterText)
+{
+	Filter filter;
+	if (!parseFilter(filter, filterText))
+		return 1;
+
+	std::vector<AsciiString> filenames(1, wildcard);
+	filenames = ReplaySimulation::resolveFilenameWildcards(filenames);
+	const size_t totalCount = filenames.size();
+
+	ReplayIndex index;
+	index.load();
+	index.update(filenames);
+	index.save();
+	index.keepMatching(filenames, filter);
+
+	for (size_t i = 0; i < filenames.size(); ++i)
+	{
+		const RecorderClass::ReplayHeader *header = index.findHeader(filenames[i]);
+		AsciiString version;
+		version.translate(header->versionString);
+		const UnsignedInt seconds = header->frameCount / LOGICFRAMES_PER_SECOND;
+		ProfileUtil::print("%s\t%s\t%u:%02u:%02u\t%s\n", filenames[i].str(), version.str(),
+			seconds / 3600, (seconds / 60) % 60, seconds % 60, getMapFromGameOptions(header->gameOptions).str());
+	}
+	ProfileUtil::print("%u of %u replays match\n", (UnsignedInt)filenames.size(), (UnsignedInt)totalCount);
+	fflush(stdout);
+
+	return 0;
+}
@@ -20,9 +20,12 @@
 
 #include "Common/ReplaySimulation.h"
 
+#include "Common/FrameTimeProfiler.h"
 #include "Common/GameEngine.h"
 #include "Common/LocalFileSystem.h"
+#include "Common/LogicProfiler.h"
 #include "Common/Recorder.h"
+#include "Common/ReplayIndex.h"
 #include "Common/WorkerProcess.h"
 #include "GameLogic/GameLogic.h"
 #include "GameClient/GameClient.h"
@@ -62,7 +65,7 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 		{
 			TheRecorder->playbackFile(filenames[s_replayIndex]);
 			TheGameEngine->execute();
-			if (TheRecorder->sawCRCMismatch())
+			if (TheRecorder->sawCRCMismatch() || TheRecorder->getCheckpointMismatchCount() != 0)
 				numErrors++;
 			if (!s_isRunning)
 				break;
@@ -73,6 +76,19 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 		s_replayCount = 0;
 		return numErrors != 0 ? 1 : 0;
 	}
+	// TheSuperHackers @feature 18/10/2026 Write the logic frame times of each replay to a JSON file with -benchmarkReplays.
+	FILE *benchmarkFile = NULL;
+	if (!TheGlobalData->m_benchmarkReplaysFile.isEmpty())
+	{
+		benchmarkFile = fopen(TheGlobalData->m_benchmarkReplaysFile.str(), "wt");
+		if (benchmarkFile == NULL)
+		{
+			printf("Cannot open benchmark file \"%s\"\n", TheGlobalData->m_benchmarkReplaysFile.str());
+			return 1;
+		}
+		fprintf(benchmarkFile, "{\n  \"replays\": [\n");
+	}
+
 	// Note that we use printf here because this is run from cmd.
 	DWORD totalStartTimeMillis = GetTickCount();
 	for (size_t i = 0; i < filenames.size(); i++)
@@ -81,12 +97,18 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 		printf("Simulating Replay \"%s\"\n", filename.str());
 		fflush(stdout);
 		DWORD startTimeMillis = GetTickCount();
+		const int numErrorsAtStart = numErrors;
 		if (TheRecorder->simulateReplay(filename))
 		{
+			if (benchmarkFile != NULL)
+				LogicProfiler::beginReplay();
+
 			UnsignedInt totalTimeSec = TheRecorder->getPlaybackFrameCount() / LOGICFRAMES_PER_SECOND;
 			while (TheRecorder->isPlaybackInProgress())
 			{
+				FrameTimeProfiler::beginFrame();
 				TheGameClient->updateHeadless();
+				FrameTimeProfiler::markClientDone();
 
 				const int progressFrameInterval = 10*60*LOGICFRAMES_PER_SECOND;
 				if (TheGameLogic->getFrame() != 0 && TheGameLogic->getFrame() % progressFrameInterval == 0)
@@ -98,7 +120,12 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 							realTimeSec/60, realTimeSec%60, gameTimeSec/60, gameTimeSec%60, totalTimeSec/60, totalTimeSec%60);
 					fflush(stdout);
 				}
+				// TheSuperHackers @feature 18/10/2026 Keep the replay checkpoints between two logic frames.
+				TheRecorder->updateCheckpoints();
+				LogicProfiler::beginFrame();
 				TheGameLogic->UPDATE();
+				LogicProfiler::endFrame();
+				FrameTimeProfiler::endFrame();
 				if (TheRecorder->sawCRCMismatch())
 				{
 					numErrors++;
@@ -110,12 +137,28 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 			printf("Elapsed Time: %02d:%02d Game Time: %02d:%02d/%02d:%02d\n",
 					realTimeSec/60, realTimeSec%60, gameTimeSec/60, gameTimeSec%60, totalTimeSec/60, totalTimeSec%60);
 			fflush(stdout);
+			if (TheRecorder->getCheckpointMismatchCount() != 0 && !TheRecorder->sawCRCMismatch())
+				numErrors++;
 		}
 		else
 		{
 			printf("Cannot open replay\n");
 			numErrors++;
 		}
+
+		if (benchmarkFile != NULL)
+		{
+			const Real seconds = (Real)(GetTickCount() - startTimeMillis) / 1000.0f;
+			LogicProfiler::writeReplay(benchmarkFile, filename.str(), seconds, numErrors != numErrorsAtStart, i == 0);
+		}
+	}
+
+	if (benchmarkFile != NULL)
+	{
+		fprintf(benchmarkFile, "\n  ]\n}\n");
+		fclose(benchmarkFile);
+		printf("Wrote benchmark results to \"%s\"\n", TheGlobalData->m_benchmarkReplaysFile.str());
+		fflush(stdout);
 	}
 	if (filenames.size() > 1)
 	{
@@ -248,6 +291,12 @@ std::vector<AsciiString> ReplaySimulation::resolveFilenameWildcards(const std::v
 int ReplaySimulation::simulateReplays(const std::vector<AsciiString> &filenames, int maxProcesses)
 {
 	std::vector<AsciiString> filenamesResolved = resolveFilenameWildcards(filenames);
+	// TheSuperHackers @feature 18/10/2026 Keep the replays that match -replayFilter, their headers come from the replay index.
+	if (TheGlobalData->m_replayFilter.isNotEmpty() && !ReplayIndex::filterReplays(filenamesResolved, TheGlobalData->m_replayFilter))
+		return 1;
+	// TheSuperHackers @info Benchmarks run the replays one after another, so that they do not compete for the CPU.
+	if (!TheGlobalData->m_benchmarkReplaysFile.isEmpty())
+		return simulateReplaysInThisProcess(filenamesResolved);
 	if (maxProcesses == SIMULATE_REPLAYS_SEQUENTIAL)
 		return simulateReplaysInThisProcess(filenamesResolved);
 	else
@@ -0,0 +1,251 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: AsyncFileWriter.cpp //////////////////////////////////////////////////////////////////////
+// Appends the writes of the calling thread to a File on a background thread
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/AsyncFileWriter.h"
+#include "Common/file.h"
+
+//-------------------------------------------------------------------------------------------------
+AsyncFileWriter::AsyncFileWriter() :
+	m_file(NULL),
+	m_policy(FLUSH_COMMITS),
+	m_buffer(NULL),
+	m_thread(NULL),
+	m_workEvent(NULL),
+	m_doneEvent(NULL),
+	m_writePos(0),
+	m_commitPos(0),
+	m_donePos(0),
+	m_quit(0),
+	m_failed(FALSE)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+AsyncFileWriter::~AsyncFileWriter()
+{
+	close();
+}
+
+//-------------------------------------------------------------------------------------------------
+void AsyncFileWriter::open( File *file, FlushPolicy policy )
+{
+	close();
+
+	m_file = file;
+	m_policy = policy;
+	m_writePos = 0;
+	m_commitPos = 0;
+	m_donePos = 0;
+	m_quit = 0;
+	m_failed = FALSE;
+
+	m_workEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+	m_doneEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+	if (m_workEvent != NULL && m_doneEvent != NULL)
+	{
+		m_buffer = MSGNEW("AsyncFileWriter") UnsignedByte[RING_SIZE];
+		m_thread = CreateThread(NULL, 0, threadProc, this, 0, NULL);
+	}
+
+	if (m_thread == NULL)
+	{
+		// Without the thread every write goes straight to the file.
+		DEBUG_LOG(("AsyncFileWriter - cannot start the thread, writing %s directly", file->getName()));
+		if (m_workEvent != NULL)
+			CloseHandle(m_workEvent);
+		if (m_doneEvent != NULL)
+			CloseHandle(m_doneEvent);
+		m_workEvent = NULL;
+		m_doneEvent = NULL;
+		delete [] m_buffer;
+		m_buffer = NULL;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void AsyncFileWriter::close()
+{
+	if (m_file == NULL)
+		return;
+
+	if (m_thread != NULL)
+	{
+		flush();
+
+		InterlockedExchange(&m_quit, 1);
+		SetEvent(m_workEvent);
+		WaitForSingleObject(m_thread, INFINITE);
+
+		CloseHandle(m_thread);
+		CloseHandle(m_workEvent);
+		CloseHandle(m_doneEvent);
+		m_thread = NULL;
+		m_workEvent = NULL;
+		m_doneEvent = NULL;
+
+		delete [] m_buffer;
+		m_buffer = NULL;
+	}
+	else
+	{
+		m_file->flush();
+	}
+
+	if (m_failed)
+	{
+		DEBUG_LOG(("AsyncFileWriter - not all data could be written to %s", m_file->getName()));
+	}
+
+	m_file = NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+void AsyncFileWriter::writeSlow( const void *data, Int bytes )
+{
+	if (m_file == NULL || bytes <= 0)
+		return;
+
+	if (m_buffer == NULL)
+	{
+		if (m_file->write(data, bytes) != bytes)
+			m_failed = TRUE;
+		return;
+	}
+
+	const UnsignedByte *source = (const UnsignedByte *)data;
+	while (bytes > 0)
+	{
+		const UnsignedInt freeBytes = RING_SIZE - (m_writePos - (UnsignedInt)m_donePos);
+		if (freeBytes == 0)
+		{
+			// The thread is a whole ring buffer behind. Give it everything and wait for room.
+			handOver();
+			WaitForSingleObject(m_doneEvent, INFINITE);
+			continue;
+		}
+
+		// Copy up to the end of the ring buffer, the rest wraps around in the next iteration.
+		const UnsignedInt offset = m_writePos & (RING_SIZE - 1);
+		const UnsignedInt count = MIN(MIN((UnsignedInt)bytes, freeBytes), RING_SIZE - offset);
+		memcpy(m_buffer + offset, source, count);
+		m_writePos += count;
+		source += count;
+		bytes -= (Int)count;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void AsyncFileWriter::commit()
+{
+	if (m_file == NULL)
+		return;
+
+	if (m_buffer == NULL)
+	{
+		if (m_policy == FLUSH_COMMITS)
+			m_file->flush();
+		else if (m_policy == FLUSH_DISK)
+			m_file->commitToDisk();
+		return;
+	}
+
+	const UnsignedInt pending = m_writePos - (UnsignedInt)m_commitPos;
+	if (pending == 0 || (m_policy == FLUSH_BLOCKS && pending < BLOCK_SIZE))
+		return;
+
+	handOver();
+}
+
+//-------------------------------------------------------------------------------------------------
+void AsyncFileWriter::flush()
+{
+	if (m_file == NULL)
+		return;
+
+	if (m_buffer != NULL)
+	{
+		if (m_writePos != (UnsignedInt)m_commitPos)
+			handOver();
+		waitUntilWritten(m_writePos);
+	}
+
+	// The thread is idle now, so the file can be used directly.
+	m_file->flush();
+}
+
+//-------------------------------------------------------------------------------------------------
+void AsyncFileWriter::handOver()
+{
+	InterlockedExchange(&m_commitPos, (LONG)m_writePos);
+	SetEvent(m_workEvent);
+}
+
+//-------------------------------------------------------------------------------------------------
+void AsyncFileWriter::waitUntilWritten( UnsignedInt position )
+{
+	while ((UnsignedInt)m_donePos != position)
+		WaitForSingleObject(m_doneEvent, INFINITE);
+}
+
+//-------------------------------------------------------------------------------------------------
+DWORD WINAPI AsyncFileWriter::threadProc( LPVOID param )
+{
+	((AsyncFileWriter *)param)->threadLoop();
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+void AsyncFileWriter::threadLoop()
+{
+	for (;;)
+	{
+		const UnsignedInt done = (UnsignedInt)m_donePos;
+		const UnsignedInt committed = (UnsignedInt)m_commitPos;
+		if (done == committed)
+		{
+			if (m_quit)
+				break;
+			WaitForSingleObject(m_workEvent, INFINITE);
+			continue;
+		}
+
+		// Write up to the end of the ring buffer, the rest wraps around in the next iteration.
+		const UnsignedInt offset = done & (RING_SIZE - 1);
+		const UnsignedInt count = MIN(committed - done, RING_SIZE - offset);
+		if (m_file->write(m_buffer + offset, (Int)count) != (Int)count)
+			m_failed = TRUE;
+
+		if (done + count == committed)
+		{
+			if (m_policy == FLUSH_COMMITS)
+				m_file->flush();
+			else if (m_policy == FLUSH_DISK)
+				m_file->commitToDisk();
+		}
+
+		// Publish the progress only after the file is no longer touched, see flush().
+		InterlockedExchange(&m_donePos, (LONG)(done + count));
+		SetEvent(m_doneEvent);
+	}
+}
@@ -224,6 +224,20 @@ Int File::size( void )
 	return size < 0 ? 0 : size;
 }
 
+//============================================================================
+// File::commitToDisk
+//============================================================================
+/**
+  * Default implementation of File::commitToDisk. Files that are not backed
+	* by a local file can only flush.
+	*/
+//============================================================================
+
+Bool File::commitToDisk( void )
+{
+	return flush();
+}
+
 //============================================================================
 // File::position
 //============================================================================
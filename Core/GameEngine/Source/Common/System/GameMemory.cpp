@@ -194,6 +194,7 @@ DECLARE_PERF_TIMER(MemoryPoolInitFilling)
 
 static Bool thePreMainInitFlag = false;
 static Bool theMainInitFlag = false;
+static volatile LONG theAllocationCount = 0;
 
 // ----------------------------------------------------------------------------
 // PRIVATE PROTOTYPES
@@ -1630,6 +1631,8 @@ void* MemoryPool::allocateBlockDoNotZeroImplementation(DECLARE_LITERALSTRING_ARG
 {
 	ScopedCriticalSection scopedCriticalSection(TheMemoryPoolCriticalSection);
 
+	InterlockedIncrement(&theAllocationCount);
+
 	if (m_firstBlobWithFreeBlocks != NULL && !m_firstBlobWithFreeBlocks->hasAnyFreeBlocks())
 	{
 		// hmm... the current 'free' blob has nothing available. look and see if there
@@ -2195,6 +2198,7 @@ void *DynamicMemoryAllocator::allocateBytesDoNotZeroImplementation(Int numBytes
 	{
 		// too big for our pools -- just go right to the metal.
 		MemoryPoolSingleBlock *block = MemoryPoolSingleBlock::rawAllocateSingleBlock(&m_rawBlocks, numBytes, m_factory PASS_LITERALSTRING_ARG2);
+		InterlockedIncrement(&theAllocationCount);
 
 #ifdef MEMORYPOOL_CHECKPOINTING
 		BlockCheckpointInfo *bi = debugAddCheckpointInfo(block->debugGetLiteralTagString(), m_factory->getCurCheckpoint(), numBytes);
@@ -3474,6 +3478,12 @@ Bool isMemoryManagerOfficiallyInited()
 	return theMainInitFlag;
 }
 
+//-----------------------------------------------------------------------------
+UnsignedInt getMemoryAllocationCount()
+{
+	return (UnsignedInt)theAllocationCount;
+}
+
 //-----------------------------------------------------------------------------
 /**
 	Initialize the memory manager, and create TheMemoryPoolFactory and TheDynamicMemoryAllocator.
@@ -23,6 +23,7 @@
 #include "Common/GameMemoryNull.h"
 
 static Bool theMainInitFlag = false;
+static volatile LONG theAllocationCount = 0;
 
 // ----------------------------------------------------------------------------
 // PUBLIC DATA
@@ -47,6 +48,7 @@ void *DynamicMemoryAllocator::allocateBytesDoNotZeroImplementation(Int numBytes)
 	void *p = malloc(numBytes);
 	if (p == NULL)
 		throw ERROR_OUT_OF_MEMORY;
+	InterlockedIncrement(&theAllocationCount);
 	return p;
 }
 
@@ -129,6 +131,12 @@ Bool isMemoryManagerOfficiallyInited()
 	return theMainInitFlag;
 }
 
+//-----------------------------------------------------------------------------
+UnsignedInt getMemoryAllocationCount()
+{
+	return (UnsignedInt)theAllocationCount;
+}
+
 //-----------------------------------------------------------------------------
 /**
 	shutdown the memory manager and discard all memory. Note: if preMainInitMemoryManager()
@@ -163,6 +171,7 @@ extern void * __cdecl operator new(size_t size)
 	void *p = malloc(size);
 	if (p == NULL)
 		throw ERROR_OUT_OF_MEMORY;
+	InterlockedIncrement(&theAllocationCount);
 	memset(p, 0, size);
 	return p;
 }
@@ -177,6 +186,7 @@ extern void * __cdecl operator new[](size_t size)
 	void *p = malloc(size);
 	if (p == NULL)
 		throw ERROR_OUT_OF_MEMORY;
+	InterlockedIncrement(&theAllocationCount);
 	memset(p, 0, size);
 	return p;
 }
@@ -192,6 +202,7 @@ extern void* __cdecl operator new(size_t size, const char *, int)
 	void *p = malloc(size);
 	if (p == NULL)
 		throw ERROR_OUT_OF_MEMORY;
+	InterlockedIncrement(&theAllocationCount);
 	memset(p, 0, size);
 	return p;
 }
@@ -206,6 +217,7 @@ extern void* __cdecl operator new[](size_t size, const char *, int)
 	void *p = malloc(size);
 	if (p == NULL)
 		throw ERROR_OUT_OF_MEMORY;
+	InterlockedIncrement(&theAllocationCount);
 	memset(p, 0, size);
 	return p;
 }
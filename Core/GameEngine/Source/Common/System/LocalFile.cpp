@@ -83,6 +83,7 @@
 //----------------------------------------------------------------------------
 
 static Int s_totalOpen = 0;
+static volatile LONG s_totalBytesRead = 0;
 
 //----------------------------------------------------------------------------
 //         Public Data
@@ -356,9 +357,23 @@ Int LocalFile::read( void *buffer, Int bytes )
 	Int ret = _read( m_handle, buffer, bytes );
 #endif
 
+	if (ret > 0)
+	{
+		InterlockedExchangeAdd(&s_totalBytesRead, ret);
+	}
+
 	return ret;
 }
 
+//=================================================================
+// LocalFile::getTotalBytesRead
+//=================================================================
+
+UnsignedInt LocalFile::getTotalBytesRead()
+{
+	return (UnsignedInt)s_totalBytesRead;
+}
+
 //=================================================================
 // LocalFile::readChar
 //=================================================================
@@ -515,6 +530,28 @@ Bool LocalFile::flush()
 	return fflush(m_file) != EOF;
 }
 
+//=================================================================
+// LocalFile::commitToDisk
+//=================================================================
+// TheSuperHackers @feature 18/10/2026 Lets replays survive a crash of the system, see -replayFlush.
+Bool LocalFile::commitToDisk()
+{
+	if (!m_open)
+	{
+		return FALSE;
+	}
+
+#if USE_BUFFERED_IO
+	if (fflush(m_file) == EOF)
+	{
+		return FALSE;
+	}
+	return _commit(_fileno(m_file)) == 0;
+#else
+	return _commit(m_handle) == 0;
+#endif
+}
+
 //=================================================================
 // LocalFile::scanInt
 //=================================================================
@@ -31,9 +31,11 @@
 #include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
 
 #include "Common/GameAudio.h"
+#include "Common/GameEndChecks.h"
 #include "Common/GameState.h"
 #include "Common/GameUtility.h"
 #include "Common/MiscAudio.h"
+#include "Common/ProfileUtil.h"
 #include "Common/Radar.h"
 #include "Common/Player.h"
 #include "Common/PlayerList.h"
@@ -46,11 +48,15 @@
 #include "GameClient/GameWindowManager.h"
 #include "GameClient/InGameUI.h"
 #include "GameClient/ControlBar.h"
+#include "GameClient/TerrainRoads.h"
+#include "GameClient/TerrainVisual.h"
+#include "GameClient/Water.h"
 
 #include "GameLogic/GameLogic.h"
 #include "GameLogic/Object.h"
 #include "GameLogic/PartitionManager.h"
 #include "GameLogic/TerrainLogic.h"
+#include "GameLogic/Module/BodyModule.h"
 #include "GameLogic/Module/ContainModule.h"
 #include "GameLogic/Module/StealthUpdate.h"
 
@@ -61,6 +67,32 @@ Radar *TheRadar = NULL;  ///< the radar global singleton
 // PRIVATE ////////////////////////////////////////////////////////////////////////////////////////
 #define RADAR_QUEUE_TERRAIN_REFRESH_DELAY (LOGICFRAMES_PER_SECOND * 3.0f)
 
+//-------------------------------------------------------------------------------------------------
+/** Make the region cover no radar cells */
+//-------------------------------------------------------------------------------------------------
+static void clearRadarRegion( IRegion2D *region )
+{
+
+	region->lo.x = 0;
+	region->lo.y = 0;
+	region->hi.x = -1;
+	region->hi.y = -1;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Make the region cover all radar cells */
+//-------------------------------------------------------------------------------------------------
+static void fillRadarRegion( IRegion2D *region )
+{
+
+	region->lo.x = 0;
+	region->lo.y = 0;
+	region->hi.x = RADAR_CELL_WIDTH - 1;
+	region->hi.y = RADAR_CELL_HEIGHT - 1;
+
+}
+
 //-------------------------------------------------------------------------------------------------
 /** Delete list resources used by the radar and return them to the memory pools */
 //-------------------------------------------------------------------------------------------------
@@ -151,6 +183,102 @@ Bool RadarObject::isTemporarilyHidden(const Object* obj)
 	return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+/** Draw the blips into the colors of the radar cells.  Every blip covers a 2x2 square and later
+	* blips cover earlier ones, the squares are clipped to the radar */
+// ------------------------------------------------------------------------------------------------
+void Radar::rasterizeBlips( const RadarBlipVec &blips, Color *pixels )
+{
+
+	memset( pixels, 0, sizeof( Color ) * RADAR_CELL_WIDTH * RADAR_CELL_HEIGHT );
+
+	const size_t count = blips.size();
+	for( size_t i = 0; i < count; ++i )
+	{
+		const RadarBlip &blip = blips[ i ];
+
+		// blips that are fully inside the radar need no clipping, which is almost all of them
+		if( blip.x >= 0 && blip.y >= 0 && blip.x < RADAR_CELL_WIDTH - 1 && blip.y < RADAR_CELL_HEIGHT - 1 )
+		{
+			Color *row = pixels + blip.y * RADAR_CELL_WIDTH + blip.x;
+			row[ 0 ] = blip.color;
+			row[ 1 ] = blip.color;
+			row[ RADAR_CELL_WIDTH ] = blip.color;
+			row[ RADAR_CELL_WIDTH + 1 ] = blip.color;
+			continue;
+		}
+
+		for( Int y = blip.y; y <= blip.y + 1; ++y )
+		{
+			if( y < 0 || y >= RADAR_CELL_HEIGHT )
+				continue;
+
+			for( Int x = blip.x; x <= blip.x + 1; ++x )
+			{
+				if( x >= 0 && x < RADAR_CELL_WIDTH )
+					pixels[ y * RADAR_CELL_WIDTH + x ] = blip.color;
+			}
+		}
+	}
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Time collecting the blips of all objects on the radar and drawing them into the colors of
+	* the radar cells, which is what a refresh of the radar overlay costs besides the upload */
+// ------------------------------------------------------------------------------------------------
+void Radar::runObjectBenchmark( Int repeats )
+{
+
+	if( m_xSample <= 0.0f || m_ySample <= 0.0f )
+		return;
+
+	if( repeats < 1 )
+		repeats = 1;
+
+	std::vector<Color> pixels( RADAR_CELL_WIDTH * RADAR_CELL_HEIGHT );
+	RadarBlipVec blips;
+
+	Int64 collectTicks = 0;
+	Int64 rasterizeTicks = 0;
+	for( Int r = 0; r < repeats; ++r )
+	{
+
+		Int64 start = ProfileUtil::getTime();
+		blips.clear();
+		const RadarObject *lists[ 2 ] = { m_objectList, m_localObjectList };
+		for( Int l = 0; l < 2; ++l )
+		{
+			for( const RadarObject *rObj = lists[ l ]; rObj; rObj = rObj->friend_getNext() )
+			{
+				const Coord3D *pos = rObj->friend_getObject()->getPosition();
+				RadarBlip blip;
+				blip.x = pos->x / m_xSample;
+				blip.y = pos->y / m_ySample;
+				blip.color = rObj->getColor();
+				blips.push_back( blip );
+			}
+		}
+		collectTicks += ProfileUtil::getTime() - start;
+
+		start = ProfileUtil::getTime();
+		rasterizeBlips( blips, &pixels[ 0 ] );
+		rasterizeTicks += ProfileUtil::getTime() - start;
+
+	}
+
+	const double collectMs = ProfileUtil::ticksToMilliseconds( collectTicks ) / repeats;
+	const double rasterizeMs = ProfileUtil::ticksToMilliseconds( rasterizeTicks ) / repeats;
+
+	ProfileUtil::print("Radar object benchmark: %u blips, %d passes\n", (UnsignedInt)blips.size(), repeats);
+	ProfileUtil::print("  collect:   %.3f ms per pass\n", collectMs);
+	ProfileUtil::print("  rasterize: %.3f ms per pass\n", rasterizeMs);
+
+	DEBUG_LOG(("Radar - object benchmark of %u blips: collect %.3f ms, rasterize %.3f ms",
+		(UnsignedInt)blips.size(), collectMs, rasterizeMs));
+
+}
+
 // ------------------------------------------------------------------------------------------------
 /** CRC */
 // ------------------------------------------------------------------------------------------------
@@ -206,6 +334,21 @@ void RadarObject::loadPostProcess( void )
 
 }
 
+//-------------------------------------------------------------------------------------------------
+/** The radar benchmarks of -benchmarkRadarTerrain and -benchmarkRadarObjects */
+//-------------------------------------------------------------------------------------------------
+static void runRadarTerrainBenchmark( UnsignedInt )
+{
+	if( TheRadar )
+		TheRadar->runTerrainBenchmark( TheTerrainLogic, 10 );
+}
+
+static void runRadarObjectBenchmark( UnsignedInt )
+{
+	if( TheRadar )
+		TheRadar->runObjectBenchmark( 100 );
+}
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 Radar::Radar( void )
@@ -227,10 +370,15 @@ Radar::Radar( void )
 	m_mapExtent.hi.y = 0.0f;
 	m_mapExtent.hi.z = 0.0f;
 	m_queueTerrainRefreshFrame = 0;
+	clearRadarRegion( &m_terrainDirtyRegion );
+	std::fill( m_terrainColors, m_terrainColors + ARRAY_SIZE( m_terrainColors ), 0 );
 
 	// clear the radar events
 	clearAllEvents();
 
+	GameEndChecks::registerCheck( GameEndChecks::BENCHMARK_RADAR_TERRAIN, runRadarTerrainBenchmark );
+	GameEndChecks::registerCheck( GameEndChecks::BENCHMARK_RADAR_OBJECTS, runRadarObjectBenchmark );
+
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -297,6 +445,10 @@ void Radar::reset( void )
 	// stop forcing the radar on
 	std::fill(m_radarForceOn, m_radarForceOn + ARRAY_SIZE(m_radarForceOn), false);
 
+	// forget terrain refreshes queued for the previous map
+	m_queueTerrainRefreshFrame = 0;
+	clearRadarRegion( &m_terrainDirtyRegion );
+
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -322,12 +474,16 @@ void Radar::update( void )
 	}
 
 	// see if we should refresh the terrain
-	if( m_queueTerrainRefreshFrame != 0 &&
+	if( m_terrainDirtyRegion.hi.x >= m_terrainDirtyRegion.lo.x &&
 			TheGameLogic->getFrame() - m_queueTerrainRefreshFrame > RADAR_QUEUE_TERRAIN_REFRESH_DELAY )
 	{
 
-		// refresh the terrain
-		refreshTerrain( TheTerrainLogic );
+		// TheSuperHackers @performance 18/10/2026 Refresh only the radar cells that changed.
+		IRegion2D region = m_terrainDirtyRegion;
+		if( region.width() == RADAR_CELL_WIDTH - 1 && region.height() == RADAR_CELL_HEIGHT - 1 )
+			refreshTerrain( TheTerrainLogic );
+		else
+			refreshTerrainArea( TheTerrainLogic, &region );
 
 	}
 
@@ -1361,6 +1517,20 @@ void Radar::refreshTerrain( TerrainLogic *terrain )
 
 	// no future queue is valid now
 	m_queueTerrainRefreshFrame = 0;
+	clearRadarRegion( &m_terrainDirtyRegion );
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Refresh the terrain of the radar cells inside the region only, the queued area refresh
+	* covers no more than that */
+// ------------------------------------------------------------------------------------------------
+void Radar::refreshTerrainArea( TerrainLogic *terrain, const IRegion2D *region )
+{
+
+	// no future queue is valid now
+	m_queueTerrainRefreshFrame = 0;
+	clearRadarRegion( &m_terrainDirtyRegion );
 
 }
 
@@ -1382,6 +1552,393 @@ void Radar::queueTerrainRefresh( void )
 	// quite often and can't afford the expense of rebuilding the radar visual
 	//
 	m_queueTerrainRefreshFrame = TheGameLogic->getFrame();
+	fillRadarRegion( &m_terrainDirtyRegion );
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Queue a refresh of the radar terrain inside the world area only.  The area is added to
+	* the area of a refresh that is already queued, and is delayed just like queueTerrainRefresh() */
+// ------------------------------------------------------------------------------------------------
+void Radar::queueTerrainAreaRefresh( const Region2D *area )
+{
+
+	// no map yet, newMap will build the whole terrain anyway
+	if( m_xSample <= 0.0f || m_ySample <= 0.0f )
+		return;
+
+	//
+	// the color of a cell is the average of its neighbors, so grow the area by one
+	// cell on every side to include the cells that sample the changed ones
+	//
+	IRegion2D region;
+	region.lo.x = MAX( 0, REAL_TO_INT_FLOOR( area->lo.x / m_xSample ) - 1 );
+	region.lo.y = MAX( 0, REAL_TO_INT_FLOOR( area->lo.y / m_ySample ) - 1 );
+	region.hi.x = MIN( RADAR_CELL_WIDTH - 1, REAL_TO_INT_FLOOR( area->hi.x / m_xSample ) + 1 );
+	region.hi.y = MIN( RADAR_CELL_HEIGHT - 1, REAL_TO_INT_FLOOR( area->hi.y / m_ySample ) + 1 );
+	if( region.hi.x < region.lo.x || region.hi.y < region.lo.y )
+		return;
+
+	// add to the region of the refresh already queued
+	if( m_terrainDirtyRegion.hi.x >= m_terrainDirtyRegion.lo.x )
+	{
+
+		region.lo.x = MIN( region.lo.x, m_terrainDirtyRegion.lo.x );
+		region.lo.y = MIN( region.lo.y, m_terrainDirtyRegion.lo.y );
+		region.hi.x = MAX( region.hi.x, m_terrainDirtyRegion.hi.x );
+		region.hi.y = MAX( region.hi.y, m_terrainDirtyRegion.hi.y );
+
+	}
+
+	m_terrainDirtyRegion = region;
+	m_queueTerrainRefreshFrame = TheGameLogic->getFrame();
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Shade the color passed in using the height parameter to lighten and darken it.  Colors
+	* will be interpolated using the value "height" across the range from loZ to hiZ.  The
+	* midZ is the "middle" point, height values above it will be lightened, while
+	* lower ones are darkened. */
+//-------------------------------------------------------------------------------------------------
+void Radar::interpolateColorForHeight( RGBColor *color,
+																			 Real height,
+																			 Real hiZ,
+																			 Real midZ,
+																			 Real loZ )
+{
+	const Real howBright = 0.95f;  // bigger is brighter (0.0 to 1.0)
+	const Real howDark   = 0.60f;  // bigger is darker (0.0 to 1.0)
+
+	// sanity on map height (flat maps bomb)
+	if (hiZ == midZ)
+		hiZ = midZ+0.1f;
+	if (midZ == loZ)
+		loZ = midZ-0.1f;
+	if (hiZ == loZ)
+		hiZ = loZ+0.2f;
+
+	Real t;
+	RGBColor colorTarget;
+
+	// if "over" the middle height, interpolate lighter
+	if( height >= midZ )
+	{
+
+		// how far are we from the middleZ towards the hi Z
+		t = (height - midZ) / (hiZ - midZ);
+
+		// compute what our "lightest" color possible we want to use is
+		colorTarget.red = color->red + (1.0f - color->red) * howBright;
+		colorTarget.green = color->green + (1.0f - color->green) * howBright;
+		colorTarget.blue = color->blue + (1.0f - color->blue) * howBright;
+
+	}
+	else  // interpolate darker
+	{
+
+		// how far are we from the middleZ towards the low Z
+		t = (midZ - height) / (midZ - loZ);
+
+		// compute what the "darkest" color possible we want to use is
+		colorTarget.red = color->red + (0.0f - color->red) * howDark;
+		colorTarget.green = color->green + (0.0f - color->green) * howDark;
+		colorTarget.blue = color->blue + (0.0f - color->blue) * howDark;
+
+	}
+
+	// interpolate toward the target color
+	color->red = color->red + (colorTarget.red - color->red) * t;
+	color->green = color->green + (colorTarget.green - color->green) * t;
+	color->blue = color->blue + (colorTarget.blue - color->blue) * t;
+
+	// keep the color real
+	if( color->red < 0.0f )
+		color->red = 0.0f;
+	if( color->red > 1.0f )
+		color->red = 1.0f;
+	if( color->green < 0.0f )
+		color->green = 0.0f;
+	if( color->green > 1.0f )
+		color->green = 1.0f;
+	if( color->blue < 0.0f )
+		color->blue = 0.0f;
+	if( color->blue > 1.0f )
+		color->blue = 1.0f;
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Compute the terrain color of the radar cells inside the region from the heights, the water
+	* and the bridges of the map.  This only fills the colors in memory so that it also works
+	* without graphics, the device radar uploads them to its texture */
+// ------------------------------------------------------------------------------------------------
+void Radar::rasterizeTerrain( TerrainLogic *terrain, const IRegion2D *region )
+{
+	RGBColor waterColor;
+
+	IRegion2D cells;
+	if( region != NULL )
+		cells = *region;
+	else
+		fillRadarRegion( &cells );
+
+	// setup our water color
+	waterColor.red = TheWaterTransparency->m_radarColor.red;
+	waterColor.green = TheWaterTransparency->m_radarColor.green;
+	waterColor.blue = TheWaterTransparency->m_radarColor.blue;
+
+	// build the terrain
+	RGBColor sampleColor;
+	RGBColor color;
+	Int i, j, samples;
+	Int x, y;
+	ICoord2D radarPoint;
+	Coord3D worldPoint;
+	Bridge *bridge;
+	for( y = cells.lo.y; y <= cells.hi.y; y++ )
+	{
+
+		for( x = cells.lo.x; x <= cells.hi.x; x++ )
+		{
+
+			// what point are we inspecting
+			radarPoint.x = x;
+			radarPoint.y = y;
+			radarToWorld2D( &radarPoint, &worldPoint );
+
+			// check to see if this point is part of a working bridge
+			Bool workingBridge = FALSE;
+			bridge = TheTerrainLogic->findBridgeAt( &worldPoint );
+			if( bridge != NULL )
+			{
+				Object *obj = TheGameLogic->findObjectByID( bridge->peekBridgeInfo()->bridgeObjectID );
+
+				if( obj )
+				{
+					BodyModuleInterface *body = obj->getBodyModule();
+
+					if( body->getDamageState() != BODY_RUBBLE )
+						workingBridge = TRUE;
+
+				}
+
+			}
+
+			// create a color based on the Z height of the map
+			Real waterZ;
+			if( workingBridge == FALSE && terrain->isUnderwater( worldPoint.x, worldPoint.y, &waterZ ) )
+			{
+				const Int waterSamplesAway = 1;		// how many "tiles" from the center tile we will sample away
+																					// to average a color for the tile color
+
+				sampleColor.red = sampleColor.green = sampleColor.blue = 0.0f;
+				samples = 0;
+
+				for( j = y - waterSamplesAway; j <= y + waterSamplesAway; j++ )
+				{
+
+					if( j >= 0 && j < RADAR_CELL_HEIGHT )
+					{
+
+						for( i = x - waterSamplesAway; i <= x + waterSamplesAway; i++ )
+						{
+
+							if( i >= 0 && i < RADAR_CELL_WIDTH )
+							{
+
+								// the the world point we are concerned with
+								radarPoint.x = i;
+								radarPoint.y = j;
+								radarToWorld2D( &radarPoint, &worldPoint );
+
+								// get color for this Z and add to our sample color
+								Real underwaterZ;
+								if( terrain->isUnderwater( worldPoint.x, worldPoint.y, NULL, &underwaterZ ) )
+								{
+									// this is our "color" for water
+									color = waterColor;
+
+									// interpolate the water color for height in the water table
+									interpolateColorForHeight( &color, underwaterZ, waterZ,
+																						 waterZ,
+																						 m_mapExtent.lo.z );
+
+									// add color to our samples
+									sampleColor.red += color.red;
+									sampleColor.green += color.green;
+									sampleColor.blue += color.blue;
+									samples++;
+
+								}
+
+							}
+
+						}
+
+					}
+
+				}
+
+				// prevent divide by zeros
+				if( samples == 0 )
+					samples = 1;
+
+				// set the color to an average of the colors read
+				color.red = sampleColor.red / (Real)samples;
+				color.green = sampleColor.green / (Real)samples;
+				color.blue = sampleColor.blue / (Real)samples;
+
+			}
+			else  // regular terrain ...
+			{
+				const Int samplesAway = 1;  // how many "tiles" from the center tile we will sample away
+																		// to average a color for the tile color
+
+				sampleColor.red = sampleColor.green = sampleColor.blue = 0.0f;
+				samples = 0;
+
+				for( j = y - samplesAway; j <= y + samplesAway; j++ )
+				{
+
+					if( j >= 0 && j < RADAR_CELL_HEIGHT )
+					{
+
+						for( i = x - samplesAway; i <= x + samplesAway; i++ )
+						{
+
+							if( i >= 0 && i < RADAR_CELL_WIDTH )
+							{
+
+								// the the world point we are concerned with
+								radarPoint.x = i;
+								radarPoint.y = j;
+								radarToWorld( &radarPoint, &worldPoint );
+
+								// get the color we're going to use here
+								if( workingBridge )
+								{
+									AsciiString bridgeTName = bridge->getBridgeTemplateName();
+									TerrainRoadType *bridgeTemplate = TheTerrainRoads->findBridge( bridgeTName );
+
+									// sanity
+									DEBUG_ASSERTCRASH( bridgeTemplate, ("Radar::rasterizeTerrain - Can't find bridge template for '%s'", bridgeTName.str()) );
+
+									// use bridge color
+									if ( bridgeTemplate )
+										color = bridgeTemplate->getRadarColor();
+									else
+										color.setFromInt(0xffffffff);
+									//
+									// we won't use the height of the terrain at this sample point, we will
+									// instead use the height for the entire bridge
+									//
+									Real bridgeHeight = (bridge->peekBridgeInfo()->fromLeft.z +
+																			 bridge->peekBridgeInfo()->fromRight.z +
+																			 bridge->peekBridgeInfo()->toLeft.z +
+																			 bridge->peekBridgeInfo()->toRight.z) / 4.0f;
+
+									// interpolate the color, but use the bridge height, not the terrain height
+									interpolateColorForHeight( &color, bridgeHeight,
+																						 getTerrainAverageZ(),
+																						 m_mapExtent.hi.z, m_mapExtent.lo.z );
+
+								}
+								else
+								{
+
+									// get the color at this point
+									TheTerrainVisual->getTerrainColorAt( worldPoint.x, worldPoint.y, &color );
+
+									// interpolate the color for height
+									interpolateColorForHeight( &color, worldPoint.z, getTerrainAverageZ(),
+																						 m_mapExtent.hi.z, m_mapExtent.lo.z );
+
+								}
+
+								// add color to our samples
+								sampleColor.red += color.red;
+								sampleColor.green += color.green;
+								sampleColor.blue += color.blue;
+								samples++;
+
+							}
+
+						}
+
+					}
+
+				}
+
+				// prevent divide by zeros
+				if( samples == 0 )
+					samples = 1;
+
+				// set the color to an average of the colors read
+				color.red = sampleColor.red / (Real)samples;
+				color.green = sampleColor.green / (Real)samples;
+				color.blue = sampleColor.blue / (Real)samples;
+
+			}
+
+			//
+			// store the color for the terrain at this point, note that because of the orientation
+			// of our world the texture has positive y in the "up" direction
+			//
+			m_terrainColors[ y * RADAR_CELL_WIDTH + x ] = GameMakeColor( color.red * 255,
+																																	 color.green * 255,
+																																	 color.blue * 255,
+																																	 255 );
+
+		}
+
+	}
+
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Time the rasterization of the whole terrain against the rasterization of an area the size
+	* of a crater in the middle of the map, which is what a queued area refresh costs */
+// ------------------------------------------------------------------------------------------------
+void Radar::runTerrainBenchmark( TerrainLogic *terrain, Int repeats )
+{
+
+	if( terrain == NULL || m_xSample <= 0.0f || m_ySample <= 0.0f )
+		return;
+
+	if( repeats < 1 )
+		repeats = 1;
+
+	IRegion2D area;
+	area.lo.x = RADAR_CELL_WIDTH / 2 - 4;
+	area.lo.y = RADAR_CELL_HEIGHT / 2 - 4;
+	area.hi.x = RADAR_CELL_WIDTH / 2 + 4;
+	area.hi.y = RADAR_CELL_HEIGHT / 2 + 4;
+
+	Int64 fullTicks = 0;
+	Int64 areaTicks = 0;
+	for( Int r = 0; r < repeats; ++r )
+	{
+
+		Int64 start = ProfileUtil::getTime();
+		rasterizeTerrain( terrain, NULL );
+		fullTicks += ProfileUtil::getTime() - start;
+
+		start = ProfileUtil::getTime();
+		rasterizeTerrain( terrain, &area );
+		areaTicks += ProfileUtil::getTime() - start;
+
+	}
+
+	const double fullMs = ProfileUtil::ticksToMilliseconds( fullTicks ) / repeats;
+	const double areaMs = ProfileUtil::ticksToMilliseconds( areaTicks ) / repeats;
+
+	ProfileUtil::print("Radar terrain benchmark: %dx%d cells, %d passes\n", (Int)RADAR_CELL_WIDTH, (Int)RADAR_CELL_HEIGHT, repeats);
+	ProfileUtil::print("  whole map:   %.3f ms per pass\n", fullMs);
+	ProfileUtil::print("  %dx%d area:   %.3f ms per pass\n", area.width() + 1, area.height() + 1, areaMs);
+
+	DEBUG_LOG(("Radar - terrain benchmark: whole map %.3f ms, %dx%d area %.3f ms",
+		fullMs, area.width() + 1, area.height() + 1, areaMs));
 
 }
 
@@ -0,0 +1,189 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: WorkerPool.cpp ///////////////////////////////////////////////////////////////////////////
+// A pool of worker threads that runs the iterations of a loop in parallel
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/WorkerPool.h"
+
+WorkerPool *TheWorkerPool = NULL;
+
+static DWORD s_workerThreadTlsIndex = TLS_OUT_OF_INDEXES;
+
+//-------------------------------------------------------------------------------------------------
+WorkerPool::WorkerPool() :
+	m_numThreads(0),
+	m_wakeSemaphore(NULL),
+	m_doneEvent(NULL),
+	m_busy(0),
+	m_quit(0),
+	m_func(NULL),
+	m_userData(NULL),
+	m_count(0),
+	m_nextIndex(0),
+	m_activeWorkers(0)
+{
+	for (Int i = 0; i < MAX_THREADS; ++i)
+		m_threads[i] = NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+WorkerPool::~WorkerPool()
+{
+	shutdown();
+}
+
+//-------------------------------------------------------------------------------------------------
+void WorkerPool::init( Int numThreads )
+{
+	shutdown();
+
+	if (numThreads < 0)
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo( &info );
+		numThreads = (Int)info.dwNumberOfProcessors - 1;
+	}
+	numThreads = MIN(numThreads, (Int)MAX_THREADS);
+	if (numThreads <= 0)
+		return;
+
+	if (s_workerThreadTlsIndex == TLS_OUT_OF_INDEXES)
+		s_workerThreadTlsIndex = TlsAlloc();
+
+	m_wakeSemaphore = CreateSemaphore(NULL, 0, MAX_THREADS, NULL);
+	m_doneEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	m_quit = 0;
+
+	for (Int i = 0; i < numThreads; ++i)
+	{
+		DWORD threadId;
+		m_threads[m_numThreads] = CreateThread(NULL, 0, threadProc, this, 0, &threadId);
+		if (m_threads[m_numThreads] == NULL)
+			break;
+		++m_numThreads;
+	}
+
+	DEBUG_LOG(("WorkerPool - started %d worker threads", m_numThreads));
+}
+
+//-------------------------------------------------------------------------------------------------
+void WorkerPool::shutdown()
+{
+	if (m_numThreads > 0)
+	{
+		InterlockedExchange(&m_quit, 1);
+		ReleaseSemaphore(m_wakeSemaphore, m_numThreads, NULL);
+		WaitForMultipleObjects(m_numThreads, m_threads, TRUE, INFINITE);
+		for (Int i = 0; i < m_numThreads; ++i)
+		{
+			CloseHandle(m_threads[i]);
+			m_threads[i] = NULL;
+		}
+		m_numThreads = 0;
+	}
+
+	if (m_wakeSemaphore != NULL)
+	{
+		CloseHandle(m_wakeSemaphore);
+		m_wakeSemaphore = NULL;
+	}
+	if (m_doneEvent != NULL)
+	{
+		CloseHandle(m_doneEvent);
+		m_doneEvent = NULL;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void WorkerPool::parallelFor( Int count, WorkerPoolJobFunc func, void *userData )
+{
+	const Bool isWorker = s_workerThreadTlsIndex != TLS_OUT_OF_INDEXES && TlsGetValue(s_workerThreadTlsIndex) != NULL;
+
+	if (m_numThreads == 0 || count <= 1 || isWorker || InterlockedCompareExchange(&m_busy, 1, 0) != 0)
+	{
+		for (Int i = 0; i < count; ++i)
+			func(i, userData);
+		return;
+	}
+
+	m_func = func;
+	m_userData = userData;
+	m_count = count;
+	m_nextIndex = 0;
+	m_activeWorkers = m_numThreads;
+	ResetEvent(m_doneEvent);
+	ReleaseSemaphore(m_wakeSemaphore, m_numThreads, NULL);
+
+	runJobs();
+
+	// The workers must all be done before the loop data goes out of scope.
+	WaitForSingleObject(m_doneEvent, INFINITE);
+
+	m_func = NULL;
+	m_userData = NULL;
+	InterlockedExchange(&m_busy, 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+void WorkerPool::run( Int count, WorkerPoolJobFunc func, void *userData )
+{
+	if (TheWorkerPool != NULL)
+	{
+		TheWorkerPool->parallelFor(count, func, userData);
+		return;
+	}
+
+	for (Int i = 0; i < count; ++i)
+		func(i, userData);
+}
+
+//-------------------------------------------------------------------------------------------------
+void WorkerPool::runJobs()
+{
+	for (;;)
+	{
+		const Int index = (Int)InterlockedIncrement(&m_nextIndex) - 1;
+		if (index >= m_count)
+			break;
+		m_func(index, m_userData);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+DWORD WINAPI WorkerPool::threadProc( LPVOID param )
+{
+	WorkerPool *pool = (WorkerPool *)param;
+	TlsSetValue(s_workerThreadTlsIndex, pool);
+
+	for (;;)
+	{
+		WaitForSingleObject(pool->m_wakeSemaphore, INFINITE);
+		if (pool->m_quit)
+			break;
+
+		pool->runJobs();
+
+		if (InterlockedDecrement(&pool->m_activeWorkers) == 0)
+			SetEvent(pool->m_doneEvent);
+	}
+	return 0;
+}
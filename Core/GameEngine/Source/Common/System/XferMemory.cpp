@@ -0,0 +1,279 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: XferMemory.cpp ///////////////////////////////////////////////////////////////////////////
+// Desc:   Xfer memory buffer write and read implementation
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// USER INCLUDES //////////////////////////////////////////////////////////////////////////////////
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+#include "Common/XferMemory.h"
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferMemorySave::XferMemorySave( void )
+{
+
+	m_isOpen = FALSE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferMemorySave::~XferMemorySave( void )
+{
+
+	DEBUG_ASSERTCRASH( m_blockPositions.empty(), ("XferMemorySave::~XferMemorySave - begin block without end block in '%s'",
+										 m_identifier.str()) );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Start writing 'identifier' to an empty buffer */
+//-------------------------------------------------------------------------------------------------
+void XferMemorySave::open( AsciiString identifier )
+{
+
+	// sanity, check to see if we're already open
+	if( m_isOpen )
+	{
+
+		DEBUG_CRASH(( "Cannot open '%s' cause we've already got '%s' open",
+									identifier.str(), m_identifier.str() ));
+		throw XFER_FILE_ALREADY_OPEN;
+
+	}
+
+	// call base class
+	Xfer::open( identifier );
+
+	m_data.clear();
+	m_blockPositions.clear();
+	m_isOpen = TRUE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Stop writing, the written data stays available */
+//-------------------------------------------------------------------------------------------------
+void XferMemorySave::close( void )
+{
+
+	// sanity, if we are not open we can do nothing
+	if( !m_isOpen )
+	{
+
+		DEBUG_CRASH(( "Xfer close called, but nothing was open" ));
+		throw XFER_FILE_NOT_OPEN;
+
+	}
+
+	m_isOpen = FALSE;
+
+	// erase the identifier
+	m_identifier.clear();
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Write a placeholder for the block size, endBlock fills it in. See XferSave::beginBlock */
+//-------------------------------------------------------------------------------------------------
+Int XferMemorySave::beginBlock( void )
+{
+
+	m_blockPositions.push_back( m_data.size() );
+
+	XferBlockSize blockSize = 0;
+	xferImplementation( &blockSize, sizeof( XferBlockSize ) );
+
+	return XFER_OK;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Write the size of the data since the last beginBlock into its placeholder */
+//-------------------------------------------------------------------------------------------------
+void XferMemorySave::endBlock( void )
+{
+
+	// sanity, make sure we have a block started
+	if( m_blockPositions.empty() )
+	{
+
+		DEBUG_CRASH(( "Xfer end block called, but no matching begin block was found" ));
+		throw XFER_BEGIN_END_MISMATCH;
+
+	}
+
+	const size_t blockPosition = m_blockPositions.back();
+	m_blockPositions.pop_back();
+
+	XferBlockSize blockSize = (XferBlockSize)( m_data.size() - blockPosition - sizeof( XferBlockSize ) );
+	memcpy( &m_data[ blockPosition ], &blockSize, sizeof( XferBlockSize ) );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Skip forward 'dataSize' bytes, XferSave leaves a gap of zeroes in the file */
+//-------------------------------------------------------------------------------------------------
+void XferMemorySave::skip( Int dataSize )
+{
+
+	m_data.resize( m_data.size() + dataSize, 0 );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Perform the write operation */
+//-------------------------------------------------------------------------------------------------
+void XferMemorySave::xferImplementation( void *data, Int dataSize )
+{
+
+	// sanity
+	DEBUG_ASSERTCRASH( m_isOpen, ("XferMemorySave - '%s' is not open", m_identifier.str()) );
+
+	const UnsignedByte *bytes = (const UnsignedByte *)data;
+	m_data.insert( m_data.end(), bytes, bytes + dataSize );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferMemoryLoad::XferMemoryLoad( const UnsignedByte *data, Int dataSize )
+{
+
+	m_data = data;
+	m_dataSize = dataSize;
+	m_position = 0;
+	m_isOpen = FALSE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+XferMemoryLoad::~XferMemoryLoad( void )
+{
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Start reading 'identifier' at the start of the buffer */
+//-------------------------------------------------------------------------------------------------
+void XferMemoryLoad::open( AsciiString identifier )
+{
+
+	// sanity, check to see if we're already open
+	if( m_isOpen )
+	{
+
+		DEBUG_CRASH(( "Cannot open '%s' cause we've already got '%s' open",
+									identifier.str(), m_identifier.str() ));
+		throw XFER_FILE_ALREADY_OPEN;
+
+	}
+
+	// call base class
+	Xfer::open( identifier );
+
+	m_position = 0;
+	m_isOpen = TRUE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Stop reading */
+//-------------------------------------------------------------------------------------------------
+void XferMemoryLoad::close( void )
+{
+
+	// sanity, if we are not open we can do nothing
+	if( !m_isOpen )
+	{
+
+		DEBUG_CRASH(( "Xfer close called, but nothing was open" ));
+		throw XFER_FILE_NOT_OPEN;
+
+	}
+
+	m_isOpen = FALSE;
+
+	// erase the identifier
+	m_identifier.clear();
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Read a block size descriptor at the current position */
+//-------------------------------------------------------------------------------------------------
+Int XferMemoryLoad::beginBlock( void )
+{
+
+	if( m_position + (Int)sizeof( XferBlockSize ) > m_dataSize )
+	{
+
+		DEBUG_CRASH(( "Xfer - Error reading block size for '%s'", m_identifier.str() ));
+		return 0;
+
+	}
+
+	XferBlockSize blockSize;
+	memcpy( &blockSize, m_data + m_position, sizeof( XferBlockSize ) );
+	m_position += sizeof( XferBlockSize );
+
+	return blockSize;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Skip forward 'dataSize' bytes in the buffer */
+//-------------------------------------------------------------------------------------------------
+void XferMemoryLoad::skip( Int dataSize )
+{
+
+	// sanity
+	DEBUG_ASSERTCRASH( dataSize >=0, ("XferMemoryLoad::skip - dataSize '%d' must be greater than 0",
+										 dataSize) );
+
+	if( m_position + dataSize > m_dataSize )
+		throw XFER_SKIP_ERROR;
+
+	m_position += dataSize;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Perform the read operation */
+//-------------------------------------------------------------------------------------------------
+void XferMemoryLoad::xferImplementation( void *data, Int dataSize )
+{
+
+	// sanity
+	DEBUG_ASSERTCRASH( m_isOpen, ("XferMemoryLoad - '%s' is not open", m_identifier.str()) );
+
+	if( m_position + dataSize > m_dataSize )
+	{
+
+		DEBUG_CRASH(( "XferMemoryLoad - Error reading from '%s'", m_identifier.str() ));
+		throw XFER_READ_ERROR;
+
+	}
+
+	memcpy( data, m_data + m_position, dataSize );
+	m_position += dataSize;
+
+}
@@ -0,0 +1,198 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/Tracer.h"
+
+#include <stdlib.h>
+
+
+Bool Tracer::s_isEnabled = false;
+FILE *Tracer::s_file = NULL;
+Tracer::ThreadBuffer Tracer::s_threadBuffers[MAX_THREADS];
+Tracer::EventIndex Tracer::s_threadCount;
+Int64 Tracer::s_startTime = 0;
+UnsignedInt Tracer::s_flushedCount = 0;
+UnsignedInt Tracer::s_droppedCount = 0;
+
+namespace
+{
+// The index of the buffer of the calling thread, -1 before its first event and MAX_THREADS
+// if it came after all buffers were taken, in which case its events are dropped.
+#if defined(_MSC_VER) && _MSC_VER < 1300
+__declspec(thread) Int t_threadIndex = -1;
+#else
+thread_local Int t_threadIndex = -1;
+#endif
+
+#if defined(_MSC_VER) && _MSC_VER < 1300
+inline UnsignedInt loadIndex(volatile LONG &index) { return (UnsignedInt)index; }
+inline void storeIndex(volatile LONG &index, UnsignedInt value) { InterlockedExchange((LONG *)&index, (LONG)value); }
+inline UnsignedInt incrementIndex(volatile LONG &index) { return (UnsignedInt)InterlockedIncrement((LONG *)&index) - 1; }
+#else
+inline UnsignedInt loadIndex(std::atomic<UnsignedInt> &index) { return index.load(std::memory_order_acquire); }
+inline void storeIndex(std::atomic<UnsignedInt> &index, UnsignedInt value) { index.store(value, std::memory_order_release); }
+inline UnsignedInt incrementIndex(std::atomic<UnsignedInt> &index) { return index.fetch_add(1, std::memory_order_acq_rel); }
+#endif
+} // namespace
+
+Bool Tracer::enable(const char *fileName)
+{
+	if (s_isEnabled)
+		return TRUE;
+
+	s_file = fopen(fileName, "wt");
+	if (s_file == NULL)
+	{
+		DEBUG_LOG(("Tracer - cannot open %s", fileName));
+		return FALSE;
+	}
+
+	// The JSON array form of the Chrome trace format may end without its closing bracket, so the
+	// file stays readable when the game does not exit normally.
+	fprintf(s_file, "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Game\"}}");
+	atexit(close);
+
+	s_startTime = ProfileUtil::getTime();
+	s_isEnabled = TRUE;
+
+	// The main thread takes the first buffer.
+	getThreadBuffer();
+	return TRUE;
+}
+
+Tracer::ThreadBuffer *Tracer::getThreadBuffer()
+{
+	if (t_threadIndex >= 0)
+		return t_threadIndex < MAX_THREADS ? &s_threadBuffers[t_threadIndex] : NULL;
+
+	// First event of this thread, take the next free buffer.
+	const UnsignedInt index = incrementIndex(s_threadCount);
+	if (index >= MAX_THREADS)
+	{
+		DEBUG_CRASH(("Tracer - more than %d threads record events, the events of the others are dropped", (Int)MAX_THREADS));
+		t_threadIndex = MAX_THREADS;
+		return NULL;
+	}
+
+	ThreadBuffer *buffer = &s_threadBuffers[index];
+	buffer->events = new Event[EVENTS_PER_THREAD];
+	t_threadIndex = (Int)index;
+	return buffer;
+}
+
+void Tracer::addEvent(const char *name, Int64 startTime, Int64 endTime)
+{
+	if (!s_isEnabled)
+		return;
+
+	ThreadBuffer *buffer = getThreadBuffer();
+	if (buffer == NULL)
+		return;
+
+	const UnsignedInt writeIndex = loadIndex(buffer->writeIndex);
+	if (writeIndex - loadIndex(buffer->readIndex) >= EVENTS_PER_THREAD)
+	{
+		// The main thread makes room itself, the other threads wait for the next flush.
+		if (t_threadIndex == 0)
+		{
+			flushThread(0);
+		}
+		else
+		{
+			incrementIndex(buffer->droppedCount);
+			return;
+		}
+	}
+
+	Event &event = buffer->events[writeIndex & (EVENTS_PER_THREAD - 1)];
+	event.name = name;
+	event.startTime = startTime;
+	event.endTime = endTime;
+	storeIndex(buffer->writeIndex, writeIndex + 1);
+}
+
+void Tracer::flushThread(Int threadIndex)
+{
+	ThreadBuffer &buffer = s_threadBuffers[threadIndex];
+	if (buffer.events == NULL)
+		return;
+
+	const UnsignedInt writeIndex = loadIndex(buffer.writeIndex);
+	UnsignedInt readIndex = loadIndex(buffer.readIndex);
+	if (readIndex == writeIndex)
+		return;
+
+	if (readIndex == 0)
+	{
+		fprintf(s_file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s %d\"}}",
+			threadIndex, threadIndex == 0 ? "Main" : "Worker", threadIndex);
+	}
+
+	const double microsecondsPerTick = ProfileUtil::ticksToMicroseconds(1);
+	for (; readIndex != writeIndex; ++readIndex)
+	{
+		const Event &event = buffer.events[readIndex & (EVENTS_PER_THREAD - 1)];
+		fprintf(s_file, ",\n{\"name\":");
+		ProfileUtil::writeJsonString(s_file, event.name);
+		fprintf(s_file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+			threadIndex,
+			(double)(event.startTime - s_startTime) * microsecondsPerTick,
+			(double)(event.endTime - event.startTime) * microsecondsPerTick);
+		++s_flushedCount;
+	}
+
+	// The owner thread may reuse the slots from here on.
+	storeIndex(buffer.readIndex, readIndex);
+}
+
+void Tracer::flush()
+{
+	if (!s_isEnabled)
+		return;
+
+	const UnsignedInt threadCount = MIN(loadIndex(s_threadCount), (UnsignedInt)MAX_THREADS);
+	for (UnsignedInt t = 0; t < threadCount; ++t)
+	{
+		flushThread((Int)t);
+	}
+	fflush(s_file);
+
+	UnsignedInt droppedCount = 0;
+	for (UnsignedInt t = 0; t < threadCount; ++t)
+	{
+		droppedCount += loadIndex(s_threadBuffers[t].droppedCount);
+	}
+	DEBUG_ASSERTLOG(droppedCount == s_droppedCount, ("Tracer - %u events were dropped because a thread filled its buffer between two flushes", droppedCount - s_droppedCount));
+	s_droppedCount = droppedCount;
+}
+
+void Tracer::close()
+{
+	if (!s_isEnabled)
+		return;
+
+	flush();
+	fprintf(s_file, "\n]\n");
+	fclose(s_file);
+	s_file = NULL;
+	s_isEnabled = FALSE;
+
+	DEBUG_LOG(("Tracer - wrote %u events, dropped %u events", s_flushedCount, s_droppedCount));
+}
@@ -0,0 +1,437 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: ShroudMap.cpp ////////////////////////////////////////////////////////////////////////////
+// The shroud levels of all partition cells for all players
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "GameLogic/ShroudMap.h"
+
+#include "Common/ProfileUtil.h"
+
+enum
+{
+	MAX_RECORDED_SPANS = 16 * 1024 * 1024
+};
+
+//-------------------------------------------------------------------------------------------------
+static inline Bool isClearLevel( Short currentShroud )
+{
+	return currentShroud != 1 && currentShroud != 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+ShroudMap::ShroudMap() :
+	m_cellCountX(0),
+	m_cellCountY(0),
+	m_totalCellCount(0),
+	m_edgeFunc(NULL),
+	m_isRecording(FALSE)
+{
+	for (Int i = 0; i < MAX_PLAYER_COUNT; ++i)
+	{
+		m_currentShroud[i] = NULL;
+		m_activeShroud[i] = NULL;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+ShroudMap::~ShroudMap()
+{
+	clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+void ShroudMap::init( Int cellCountX, Int cellCountY, ShroudEdgeFunc edgeFunc )
+{
+	clear();
+
+	m_cellCountX = cellCountX;
+	m_cellCountY = cellCountY;
+	m_totalCellCount = cellCountX * cellCountY;
+	m_edgeFunc = edgeFunc;
+
+	/*
+		The shroud is modeled for all players, rather than just the local player,
+		so that it can be checksummed in net games to catch "shroud cheaters".
+	*/
+	for (Int i = 0; i < MAX_PLAYER_COUNT; ++i)
+	{
+		m_currentShroud[i] = MSGNEW("ShroudMap_Planes") Short[m_totalCellCount];
+		m_activeShroud[i] = MSGNEW("ShroudMap_Planes") Short[m_totalCellCount];
+
+		// Default is "passive shroud".  1,0.
+		for (Int cell = 0; cell < m_totalCellCount; ++cell)
+		{
+			m_currentShroud[i][cell] = 1;
+			m_activeShroud[i][cell] = 0;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void ShroudMap::clear()
+{
+	for (Int i = 0; i < MAX_PLAYER_COUNT; ++i)
+	{
+		delete [] m_currentShroud[i];
+		delete [] m_activeShroud[i];
+		m_currentShroud[i] = NULL;
+		m_activeShroud[i] = NULL;
+	}
+
+	m_cellCountX = 0;
+	m_cellCountY = 0;
+	m_totalCellCount = 0;
+	m_edgeFunc = NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ShroudMap::fireEdge( Int playerIndex, Int x, Int y )
+{
+	if (m_edgeFunc)
+		m_edgeFunc(playerIndex, x, y, getShroudStatus(playerIndex, x, y));
+}
+
+//-------------------------------------------------------------------------------------------------
+/**
+	The span updates first check whether any cell of the span changes status. Mostly none does,
+	as a look moving by one cell overlaps the area it already sees, and then the counts are updated
+	in a plain loop without any edge triggers that the compiler can vectorize. Otherwise every cell
+	is done on its own, the same as PartitionCell always did.
+*/
+void ShroudMap::addLookers( Int playerIndex, Int x1, Int x2, Int y )
+{
+	DEBUG_ASSERTCRASH(x1 >= 0 && x2 < m_cellCountX && y >= 0 && y < m_cellCountY, ("shroud span off the map"));
+
+	if (m_isRecording)
+		recordSpan(SHROUD_ADD_LOOKERS, playerIndex, x1, x2, y);
+
+	const Int rowIndex = getCellIndex(0, y);
+	Short *currentShroud = m_currentShroud[playerIndex] + rowIndex;
+	Int x;
+
+	// A cell that is already looked at just counts another looker.
+	Short highest = -1;
+	for (x = x1; x <= x2; ++x)
+		highest = currentShroud[x] > highest ? currentShroud[x] : highest;
+
+	if (highest < 0)
+	{
+		for (x = x1; x <= x2; ++x)
+			--currentShroud[x];
+		return;
+	}
+
+	for (x = x1; x <= x2; ++x)
+	{
+		const Short oldShroud = currentShroud[x];
+		// The decreasing Algorithm: A 1 will go straight to -1, otherwise it just gets decremented
+		currentShroud[x] = min( oldShroud - 1, -1 );
+
+		// Always clear now, so it is an edge if it wasn't before.
+		if (!isClearLevel(oldShroud))
+			fireEdge(playerIndex, x, y);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void ShroudMap::removeLookers( Int playerIndex, Int x1, Int x2, Int y )
+{
+	DEBUG_ASSERTCRASH(x1 >= 0 && x2 < m_cellCountX && y >= 0 && y < m_cellCountY, ("shroud span off the map"));
+
+	if (m_isRecording)
+		recordSpan(SHROUD_REMOVE_LOOKERS, playerIndex, x1, x2, y);
+
+	const Int rowIndex = getCellIndex(0, y);
+	Short *currentShroud = m_currentShroud[playerIndex] + rowIndex;
+	const Short *activeShroud = m_activeShroud[playerIndex] + rowIndex;
+	Int x;
+
+	// A cell with more than one looker stays clear.
+	Short highest = -2;
+	for (x = x1; x <= x2; ++x)
+		highest = currentShroud[x] > highest ? currentShroud[x] : highest;
+
+	if (highest <= -2)
+	{
+		for (x = x1; x <= x2; ++x)
+			++currentShroud[x];
+		return;
+	}
+
+	for (x = x1; x <= x2; ++x)
+	{
+		const CellShroudStatus oldStatus = getShroudStatus(playerIndex, x, y);
+		// the increasing Algorithm: a -1 goes up to min(1,activeLevel), otherwise it just gets incremented
+		if( currentShroud[x] == -1 )
+			currentShroud[x] = min( activeShroud[x], (Short)1 );
+		else
+		{
+			DEBUG_ASSERTCRASH( currentShroud[x] < 0, ("Someone is RemoveLooker-ing on a cell that is not looked at.  This will make a permanent shroud blob.") );
+			currentShroud[x]++;
+		}
+
+		if (oldStatus != getShroudStatus(playerIndex, x, y))
+			fireEdge(playerIndex, x, y);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void ShroudMap::addShrouders( Int playerIndex, Int x1, Int x2, Int y )
+{
+	DEBUG_ASSERTCRASH(x1 >= 0 && x2 < m_cellCountX && y >= 0 && y < m_cellCountY, ("shroud span off the map"));
+
+	if (m_isRecording)
+		recordSpan(SHROUD_ADD_SHROUDERS, playerIndex, x1, x2, y);
+
+	const Int rowIndex = getCellIndex(0, y);
+	Short *currentShroud = m_currentShroud[playerIndex] + rowIndex;
+	Short *activeShroud = m_activeShroud[playerIndex] + rowIndex;
+	Int x;
+
+	// Increasing active shroud: activeLevel gets incremented, and CS is set to 1 if at zero
+	Int foggedCount = 0;
+	for (x = x1; x <= x2; ++x)
+	{
+		++activeShroud[x];
+		foggedCount += (currentShroud[x] == 0);
+	}
+
+	if (foggedCount == 0)
+		return;
+
+	for (x = x1; x <= x2; ++x)
+	{
+		if( currentShroud[x] == 0 )
+		{
+			currentShroud[x] = 1;
+			fireEdge(playerIndex, x, y);
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void ShroudMap::removeShrouders( Int playerIndex, Int x1, Int x2, Int y )
+{
+	DEBUG_ASSERTCRASH(x1 >= 0 && x2 < m_cellCountX && y >= 0 && y < m_cellCountY, ("shroud span off the map"));
+
+	if (m_isRecording)
+		recordSpan(SHROUD_REMOVE_SHROUDERS, playerIndex, x1, x2, y);
+
+	// Decreasing active shroud: just decrement activeLevel.  This will never result in a client change.
+	// Either it was passive shroud and is now active, or it was being looked at and still is.
+	Short *activeShroud = m_activeShroud[playerIndex] + getCellIndex(0, y);
+	for (Int x = x1; x <= x2; ++x)
+		--activeShroud[x];
+
+#ifdef DEBUG_CRASHING
+	for (Int check = x1; check <= x2; ++check)
+		DEBUG_ASSERTCRASH( activeShroud[check] >= 0, ("Shroud generation has gone negative.  This can't happen.") );
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+void ShroudMap::getShroudLevels( Int x, Int y, ShroudLevel *levels ) const
+{
+	const Int cellIndex = getCellIndex(x, y);
+	for (Int i = 0; i < MAX_PLAYER_COUNT; ++i)
+	{
+		levels[i].m_currentShroud = m_currentShroud[i][cellIndex];
+		levels[i].m_activeShroudLevel = m_activeShroud[i][cellIndex];
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void ShroudMap::setShroudLevels( Int x, Int y, const ShroudLevel *levels )
+{
+	// A recording can only be played back from a fresh map.
+	if (m_isRecording)
+	{
+		DEBUG_LOG(("ShroudMap - shroud was loaded, discarding the benchmark recording"));
+		stopRecording();
+		m_recording.clear();
+	}
+
+	const Int cellIndex = getCellIndex(x, y);
+	for (Int i = 0; i < MAX_PLAYER_COUNT; ++i)
+	{
+		m_currentShroud[i][cellIndex] = levels[i].m_currentShroud;
+		m_activeShroud[i][cellIndex] = levels[i].m_activeShroudLevel;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void ShroudMap::startRecording()
+{
+	m_recording.clear();
+	m_isRecording = TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ShroudMap::stopRecording()
+{
+	m_isRecording = FALSE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void ShroudMap::recordSpan( ShroudSpanOpType type, Int playerIndex, Int x1, Int x2, Int y )
+{
+	if (m_recording.size() >= MAX_RECORDED_SPANS)
+	{
+		DEBUG_LOG(("ShroudMap - benchmark recording is full, stopping it"));
+		stopRecording();
+		return;
+	}
+
+	ShroudSpanOp op;
+	op.m_type = (UnsignedByte)type;
+	op.m_playerIndex = (UnsignedByte)playerIndex;
+	op.m_y = (Short)y;
+	op.m_x1 = (Short)x1;
+	op.m_x2 = (Short)x2;
+	m_recording.push_back(op);
+}
+
+//-------------------------------------------------------------------------------------------------
+/// The per cell layout the shroud used to be kept in, for comparison. Returns the number of edges.
+static UnsignedInt playBackPerCell( const ShroudSpanOpVec &ops, ShroudLevel *cells, Int cellCountX )
+{
+	UnsignedInt edges = 0;
+	for (ShroudSpanOpVec::const_iterator it = ops.begin(); it != ops.end(); ++it)
+	{
+		ShroudLevel *level = cells + (it->m_y * cellCountX + it->m_x1) * MAX_PLAYER_COUNT + it->m_playerIndex;
+		for (Int x = it->m_x1; x <= it->m_x2; ++x, level += MAX_PLAYER_COUNT)
+		{
+			const Bool oldClear = isClearLevel(level->m_currentShroud);
+			switch (it->m_type)
+			{
+				case SHROUD_ADD_LOOKERS:
+					level->m_currentShroud = min( level->m_currentShroud - 1, -1 );
+					break;
+				case SHROUD_REMOVE_LOOKERS:
+					if( level->m_currentShroud == -1 )
+						level->m_currentShroud = min( level->m_activeShroudLevel, (Short)1 );
+					else
+						level->m_currentShroud++;
+					break;
+				case SHROUD_ADD_SHROUDERS:
+					level->m_activeShroudLevel++;
+					if( level->m_currentShroud == 0 )
+					{
+						level->m_currentShroud = 1;
+						++edges;
+					}
+					break;
+				case SHROUD_REMOVE_SHROUDERS:
+					level->m_activeShroudLevel--;
+					break;
+			}
+			if (oldClear != isClearLevel(level->m_currentShroud))
+				++edges;
+		}
+	}
+	return edges;
+}
+
+//-------------------------------------------------------------------------------------------------
+/**
+	Plays a recorded stream of span updates back against the player planes and against the per
+	cell layout, and reports the time taken by each. Both have to end up with the same shroud.
+*/
+void ShroudMap::runBenchmark( const ShroudSpanOpVec &ops, Int cellCountX, Int cellCountY, Int repeats )
+{
+	if (ops.empty() || cellCountX <= 0 || cellCountY <= 0)
+		return;
+
+	if (repeats < 1)
+		repeats = 1;
+
+	UnsignedInt64 cellsPerPass = 0;
+	for (ShroudSpanOpVec::const_iterator it = ops.begin(); it != ops.end(); ++it)
+		cellsPerPass += it->m_x2 - it->m_x1 + 1;
+
+	ShroudMap map;
+	Int64 planeTicks = 0;
+	Int r;
+	for (r = 0; r < repeats; ++r)
+	{
+		map.init(cellCountX, cellCountY, NULL);
+
+		const Int64 start = ProfileUtil::getTime();
+		for (ShroudSpanOpVec::const_iterator it = ops.begin(); it != ops.end(); ++it)
+		{
+			switch (it->m_type)
+			{
+				case SHROUD_ADD_LOOKERS:			map.addLookers(it->m_playerIndex, it->m_x1, it->m_x2, it->m_y); break;
+				case SHROUD_REMOVE_LOOKERS:		map.removeLookers(it->m_playerIndex, it->m_x1, it->m_x2, it->m_y); break;
+				case SHROUD_ADD_SHROUDERS:		map.addShrouders(it->m_playerIndex, it->m_x1, it->m_x2, it->m_y); break;
+				case SHROUD_REMOVE_SHROUDERS:	map.removeShrouders(it->m_playerIndex, it->m_x1, it->m_x2, it->m_y); break;
+			}
+		}
+		planeTicks += ProfileUtil::getTime() - start;
+	}
+
+	const Int totalCellCount = cellCountX * cellCountY;
+	std::vector<ShroudLevel> cells(totalCellCount * MAX_PLAYER_COUNT);
+	Int64 perCellTicks = 0;
+	UnsignedInt edges = 0;
+	for (r = 0; r < repeats; ++r)
+	{
+		for (size_t i = 0; i < cells.size(); ++i)
+		{
+			cells[i].m_currentShroud = 1;
+			cells[i].m_activeShroudLevel = 0;
+		}
+
+		const Int64 start = ProfileUtil::getTime();
+		edges = playBackPerCell(ops, &cells[0], cellCountX);
+		perCellTicks += ProfileUtil::getTime() - start;
+	}
+
+	Int mismatches = 0;
+	ShroudLevel levels[MAX_PLAYER_COUNT];
+	for (Int y = 0; y < cellCountY; ++y)
+	{
+		for (Int x = 0; x < cellCountX; ++x)
+		{
+			map.getShroudLevels(x, y, levels);
+			const ShroudLevel *expected = &cells[(y * cellCountX + x) * MAX_PLAYER_COUNT];
+			for (Int i = 0; i < MAX_PLAYER_COUNT; ++i)
+			{
+				if (levels[i].m_currentShroud != expected[i].m_currentShroud || levels[i].m_activeShroudLevel != expected[i].m_activeShroudLevel)
+					++mismatches;
+			}
+		}
+	}
+
+	const double planeMs = ProfileUtil::ticksToMilliseconds(planeTicks) / repeats;
+	const double perCellMs = ProfileUtil::ticksToMilliseconds(perCellTicks) / repeats;
+
+	ProfileUtil::print("Shroud benchmark: %u spans, %u cells, %u edges on a %dx%d map, %d passes\n",
+		(UnsignedInt)ops.size(), (UnsignedInt)cellsPerPass, edges, cellCountX, cellCountY, repeats);
+	ProfileUtil::print("  player planes: %.3f ms per pass\n", planeMs);
+	ProfileUtil::print("  per cell:      %.3f ms per pass\n", perCellMs);
+	if (mismatches != 0)
+		ProfileUtil::print("  MISMATCH: %d cell levels differ between the two layouts\n", mismatches);
+
+	DEBUG_LOG(("ShroudMap - benchmark of %u spans: planes %.3f ms, per cell %.3f ms, %d mismatches",
+		(UnsignedInt)ops.size(), planeMs, perCellMs, mismatches));
+}
@@ -67,10 +67,12 @@ struct PlayingAudio
 	Bool m_requestStop;
 	Bool m_cleanupAudioEventRTS;
 	Int m_framesFaded;
+	AudioVoice *m_voice;	// Set while this is a sound effect known to the voice scheduler.
 
 	PlayingAudio() :
 		m_type(PAT_INVALID),
 		m_audioEventRTS(NULL),
+		m_voice(NULL),
 		m_requestStop(false),
 		m_cleanupAudioEventRTS(true),
 		m_sample(NULL),
@@ -96,11 +98,28 @@ struct OpenAudioFile
 
 	// Note: OpenAudioFile does not own this m_eventInfo, and should not delete it.
 	const AudioEventInfo *m_eventInfo;	// Not mutable, unlike the one on AudioEventRTS.
+
+	std::list<AsciiString>::iterator m_lruIt;	///< position in the cache's use order
+	Bool m_prefetched;	///< loaded by the prefetch thread and not played yet
 };
 
 typedef std::hash_map< AsciiString, OpenAudioFile, rts::hash<AsciiString>, rts::equal_to<AsciiString> > OpenFilesHash;
 typedef OpenFilesHash::iterator OpenFilesHashIt;
 
+struct AudioFileCacheStats
+{
+	UnsignedInt m_hits;
+	UnsignedInt m_misses;					///< files that had to be loaded while starting the sample
+	UnsignedInt m_prefetchHits;		///< hits on files the prefetch thread loaded
+	UnsignedInt m_prefetched;
+	UnsignedInt m_evictions;
+	Int64 m_loadTicks;						///< time spent loading on misses
+	Int64 m_ticksPerSec;
+
+	Real getHitRate() const;
+	Real getLoadMilliseconds() const;
+};
+
 class AudioFileCache
 {
 	public:
@@ -111,6 +130,15 @@ class AudioFileCache
 		void *openFile( AudioEventRTS *eventToOpenFrom );
 		void closeFile( void *fileToClose );
 		void setMaxSize( UnsignedInt size );
+
+		// Queue a file to be loaded on the prefetch thread. It is only kept if it fits in the cache
+		// without stopping any playing samples.
+		void prefetchFile( const AsciiString& fileName, const AudioEventInfo *eventInfo );
+		// Drop the queued files, their event infos may be about to go away.
+		void cancelPrefetches();
+
+		void resetStats();
+		void reportStats();
 		// End Protected by mutex
 
 		// Note: These functions should be used for informational purposes only. For speed reasons,
@@ -118,18 +146,47 @@ class AudioFileCache
 		// outside the audio cache. They should be used as a rough estimate only.
 		UnsignedInt getCurrentlyUsedSize() const { return m_currentlyUsedSize; }
 		UnsignedInt getMaxSize() const { return m_maxSize; }
+		const AudioFileCacheStats& getStats() const { return m_stats; }
 
 	protected:
+		// Reads and decodes the file. Does not touch the cache, so it doesn't need the mutex.
+		static Bool loadAudioFile( const AsciiString& fileName, OpenAudioFile& openedAudioFile );
+
+		void insertOpenAudioFile( const AsciiString& fileName, OpenAudioFile& openedAudioFile );
+		void eraseOpenAudioFile( OpenFilesHashIt it );
 		void releaseOpenAudioFile( OpenAudioFile *fileToRelease );
 
 		// This function will return TRUE if it was able to free enough space, and FALSE otherwise.
 		Bool freeEnoughSpaceForSample(const OpenAudioFile& sampleThatNeedsSpace);
+		// For prefetches. Only frees files that are not playing, least recently used first.
+		Bool freeUnusedSpace( UnsignedInt spaceRequired );
+
+		void startPrefetchThread();
+		void stopPrefetchThread();
+		void prefetchThreadLoop();
+		// Called with the mutex held, once the prefetch thread has loaded a file.
+		void storePrefetchedFile( const AsciiString& fileName, const AudioEventInfo *eventInfo, UnsignedInt generation, Bool loaded, OpenAudioFile& openedAudioFile );
+		static DWORD WINAPI prefetchThreadProc( LPVOID param );
+
+		typedef std::map<const void *, AsciiString> FilesByBufferMap;
+		typedef std::hash_map< AsciiString, const AudioEventInfo *, rts::hash<AsciiString>, rts::equal_to<AsciiString> > PrefetchInfoHash;
 
 		OpenFilesHash m_openFiles;
+		std::list<AsciiString> m_lru;					///< front is the least recently used file
+		FilesByBufferMap m_filesByBuffer;			///< for closeFile
 		UnsignedInt m_currentlyUsedSize;
 		UnsignedInt m_maxSize;
 		HANDLE m_mutex;
 		const char *m_mutexName;
+
+		std::list<AsciiString> m_prefetchQueue;
+		PrefetchInfoHash m_prefetchInfos;			///< event info of every queued file
+		UnsignedInt m_prefetchGeneration;			///< bumped by cancelPrefetches, so a load in flight is dropped
+		HANDLE m_prefetchThread;
+		HANDLE m_prefetchEvent;
+		volatile Bool m_prefetchQuit;
+
+		AudioFileCacheStats m_stats;
 };
 
 class MilesAudioManager : public AudioManager
@@ -257,6 +314,7 @@ class MilesAudioManager : public AudioManager
 
 		void *loadFileForRead( AudioEventRTS *eventToLoadFrom );
 		void closeFile( void *fileRead );
+		virtual void prefetchAudioFile( const AsciiString& fileName, const AudioEventInfo *eventInfo );
 
 		PlayingAudio *allocatePlayingAudio( void );
 		void releaseMilesHandles( PlayingAudio *release );
@@ -73,6 +73,8 @@ public:
 
 protected:
 
+	virtual void refreshTerrainArea( TerrainLogic *terrain, const IRegion2D *region );
+
 	void drawSingleBeaconEvent( Int pixelX, Int pixelY, Int width, Int height, Int index );
 	void drawSingleGenericEvent( Int pixelX, Int pixelY, Int width, Int height, Int index );
 
@@ -81,15 +83,11 @@ protected:
 	void drawEvents( Int pixelX, Int pixelY, Int width, Int height);		///< draw all of the radar events
 	void drawHeroIcon( Int pixelX, Int pixelY, Int width, Int height, const Coord3D *pos );	//< draw a hero icon
 	void drawViewBox( Int pixelX, Int pixelY, Int width, Int height );  ///< draw view box
-	void buildTerrainTexture( TerrainLogic *terrain );	 ///< create the terrain texture of the radar
+	void updateTerrainTexture( const IRegion2D *region );	 ///< copy the terrain colors of the region, or of all cells when NULL, to the texture
 	void drawIcons( Int pixelX, Int pixelY, Int width, Int height );	///< draw all of the radar icons
 	void updateObjectTexture(TextureClass *texture);
-	void renderObjectList( const RadarObject *listHead, TextureClass *texture, Bool calcHero = FALSE );			 ///< render an object list to the texture
-	void interpolateColorForHeight( RGBColor *color,
-																	Real height,
-																	Real hiZ,
-																	Real midZ,
-																	Real loZ );		///< "shade" color according to height value
+	void collectObjectBlips( const RadarObject *listHead, RadarBlipVec &blips, Bool calcHero = FALSE );	///< add the blips of the visible objects of a list
+	void copyPixelsToTexture( const Color *pixels, TextureClass *texture );	///< copy the colors of all radar cells to the texture
 	void reconstructViewBox( void );							///< remake the view box
 	void radarToPixel( const ICoord2D *radar, ICoord2D *pixel,
 										 Int radarUpperLeftX, Int radarUpperLeftY,
@@ -122,5 +120,10 @@ protected:
 	Real m_viewZoom;															///< camera zoom used for the view box we have
 	ICoord2D m_viewBox[ 4 ];											///< radar cell points for the 4 corners of view box
 
+	RadarBlipVec m_objectBlips;										///< blips of the visible objects, collected for the overlay
+	RadarBlipVec m_drawnObjectBlips;							///< blips the overlay texture shows now
+	Bool m_objectBlipsDrawn;											///< true when the overlay texture shows m_drawnObjectBlips
+	Color m_objectPixels[ RADAR_CELL_WIDTH * RADAR_CELL_HEIGHT ];	///< overlay colors before they are copied to the texture
+
 	std::vector<const Object *> m_cachedHeroObjectList; //< cache of hero objects for drawing icons in radar overlay
 };
@@ -32,6 +32,8 @@
 #include "Common/AsciiString.h"
 #include "Common/List.h"
 
+#include "mutex.h"
+
 class Win32BIGFile : public ArchiveFile
 {
 	public:
@@ -50,4 +52,5 @@ class Win32BIGFile : public ArchiveFile
 
 		AsciiString		m_name;		///< BIG file name
 		AsciiString		m_path;		///< BIG file path
+		FastCriticalSectionClass m_archiveMutex;	///< Guards the seek and read on the shared archive file, files are opened from worker threads too
 };
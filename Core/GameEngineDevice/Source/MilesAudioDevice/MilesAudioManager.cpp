@@ -46,6 +46,7 @@
 #include "Common/AudioHandleSpecialValues.h"
 #include "Common/AudioRequest.h"
 #include "Common/AudioSettings.h"
+#include "Common/AudioVoiceScheduler.h"
 #include "Common/AsciiString.h"
 #include "Common/AudioEventInfo.h"
 #include "Common/FileSystem.h"
@@ -53,6 +54,7 @@
 #include "Common/GameSounds.h"
 #include "Common/CRCDebug.h"
 #include "Common/GlobalData.h"
+#include "Common/ProfileUtil.h"
 #include "Common/ScopedMutex.h"
 
 #include "GameClient/DebugDisplay.h"
@@ -159,7 +161,9 @@ void MilesAudioManager::audioDebugDisplay(DebugDisplayInterface *dd, void *, FIL
 	if( dd )
 	{
 		dd->printf("Miles Sound System version: %s    ", buffer);
-		dd->printf("Memory Usage : %d/%d\n", m_audioCache->getCurrentlyUsedSize(), m_audioCache->getMaxSize());
+		dd->printf("Memory Usage : %d/%d    ", m_audioCache->getCurrentlyUsedSize(), m_audioCache->getMaxSize());
+		dd->printf("Cache Hit Rate: %d%% (%d prefetched)    ", REAL_TO_INT(m_audioCache->getStats().getHitRate() * 100.0f), m_audioCache->getStats().m_prefetchHits);
+		dd->printf("Load Time: %d ms\n", REAL_TO_INT(m_audioCache->getStats().getLoadMilliseconds()));
 		dd->printf("Sound: %s    ", (isOn(AudioAffect_Sound) ? "Yes" : "No"));
 		dd->printf("3DSound: %s    ", (isOn(AudioAffect_Sound3D) ? "Yes" : "No"));
 		dd->printf("Speech: %s    ", (isOn(AudioAffect_Speech) ? "Yes" : "No"));
@@ -190,7 +194,9 @@ void MilesAudioManager::audioDebugDisplay(DebugDisplayInterface *dd, void *, FIL
 	if( fp )
 	{
 		fprintf( fp, "Miles Sound System version: %s    ", buffer );
-		fprintf( fp, "Memory Usage : %d/%d\n", m_audioCache->getCurrentlyUsedSize(), m_audioCache->getMaxSize() );
+		fprintf( fp, "Memory Usage : %d/%d    ", m_audioCache->getCurrentlyUsedSize(), m_audioCache->getMaxSize() );
+		fprintf( fp, "Cache Hit Rate: %d%% (%d prefetched)    ", REAL_TO_INT(m_audioCache->getStats().getHitRate() * 100.0f), m_audioCache->getStats().m_prefetchHits );
+		fprintf( fp, "Load Time: %d ms\n", REAL_TO_INT(m_audioCache->getStats().getLoadMilliseconds()) );
 		fprintf( fp, "Sound: %s    ", (isOn(AudioAffect_Sound) ? "Yes" : "No") );
 		fprintf( fp, "3DSound: %s    ", (isOn(AudioAffect_Sound3D) ? "Yes" : "No") );
 		fprintf( fp, "Speech: %s    ", (isOn(AudioAffect_Speech) ? "Yes" : "No") );
@@ -471,6 +477,9 @@ void MilesAudioManager::reset()
 	AudioManager::reset();
 	stopAllAudioImmediately();
   removeAllAudioRequests();
+	m_audioCache->cancelPrefetches();
+	m_audioCache->reportStats();
+	m_audioCache->resetStats();
   // This must come after stopAllAudioImmediately() and removeAllAudioRequests(), to ensure that
   // sounds pointing to the temporary AudioEventInfo handles are deleted before their info is deleted
   removeLevelSpecificAudioEventInfos();
@@ -593,6 +602,7 @@ void MilesAudioManager::pauseAudio( AudioAffect which )
 		AudioRequest *req = (*ait);
 		if( req && req->m_request == AR_Play )
 		{
+			m_voiceScheduler->removeRequest(req);
 			deleteInstance(req);
 			ait = m_audioRequests.erase(ait);
 		}
@@ -808,6 +818,7 @@ void MilesAudioManager::playAudioEvent( AudioEventRTS *event )
 				}
 				else
 				{
+					audio->m_voice = m_voiceScheduler->addVoice(event, audio);
 					audio = NULL;
 					#ifdef INTENSIVE_AUDIO_DEBUG
 						DEBUG_LOG((" Playing."));
@@ -876,6 +887,7 @@ void MilesAudioManager::playAudioEvent( AudioEventRTS *event )
 					#endif
 					m_playingSounds.pop_back();
 				} else {
+					audio->m_voice = m_voiceScheduler->addVoice(event, audio);
 					audio = NULL;
 				}
 
@@ -979,6 +991,7 @@ void MilesAudioManager::killAudioEventImmediately( AudioHandle audioEvent )
 		AudioRequest *req = (*ait);
 		if( req && req->m_request == AR_Play && req->m_handleToInteractOn == audioEvent )
 		{
+			m_voiceScheduler->removeRequest(req);
 			deleteInstance(req);
 			ait = m_audioRequests.erase(ait);
 			return;
@@ -1058,6 +1071,12 @@ void MilesAudioManager::closeFile( void *fileRead )
 	m_audioCache->closeFile(fileRead);
 }
 
+//-------------------------------------------------------------------------------------------------
+void MilesAudioManager::prefetchAudioFile( const AsciiString& fileName, const AudioEventInfo *eventInfo )
+{
+	m_audioCache->prefetchFile(fileName, eventInfo);
+}
+
 
 //-------------------------------------------------------------------------------------------------
 PlayingAudio *MilesAudioManager::allocatePlayingAudio( void )
@@ -1106,6 +1125,11 @@ void MilesAudioManager::releaseMilesHandles( PlayingAudio *release )
 //-------------------------------------------------------------------------------------------------
 void MilesAudioManager::releasePlayingAudio( PlayingAudio *release )
 {
+	if (release->m_voice) {
+		m_voiceScheduler->removeVoice(release->m_voice);
+		release->m_voice = NULL;
+	}
+
 	if (release->m_audioEventRTS->getAudioEventInfo()->m_soundType == AT_SoundEffect) {
 		if (release->m_type == PAT_Sample) {
 			if (release->m_sample) {
@@ -1821,192 +1845,30 @@ UnsignedInt MilesAudioManager::getNumStreams( void ) const
 //-------------------------------------------------------------------------------------------------
 Bool MilesAudioManager::doesViolateLimit( AudioEventRTS *event ) const
 {
-	Int limit = event->getAudioEventInfo()->m_limit;
-	if (limit == 0) {
-		return false;
-	}
-
-	Int totalCount = 0;
-	Int totalRequestCount = 0;
-
-	std::list<PlayingAudio *>::const_iterator it;
-	if (!event->isPositionalAudio()) {
-		// 2-D
-		for ( it = m_playingSounds.begin(); it != m_playingSounds.end(); ++it ) {
-			if ((*it)->m_audioEventRTS->getEventName() == event->getEventName()) {
-				if (totalCount == 0) {
-					// This is the oldest audio of this type playing.
-					event->setHandleToKill((*it)->m_audioEventRTS->getPlayingHandle());
-				}
-				++totalCount;
-			}
-		}
-	} else {
-		// 3-D
-		for ( it = m_playing3DSounds.begin(); it != m_playing3DSounds.end(); ++it ) {
-			if ((*it)->m_audioEventRTS->getEventName() == event->getEventName()) {
-				if (totalCount == 0) {
-					// This is the oldest audio of this type playing.
-					event->setHandleToKill((*it)->m_audioEventRTS->getPlayingHandle());
-				}
-				++totalCount;
-			}
-		}
-	}
-
-	// Also check the request list in case we've requested to play this sound.
-	std::list<AudioRequest*>::const_iterator arIt;
-	for (arIt = m_audioRequests.begin(); arIt != m_audioRequests.end(); ++arIt) {
-		AudioRequest *req = (*arIt);
-		if (req == NULL) {
-			continue;
-		}
-		if( req->m_usePendingEvent )
-		{
-			if( req->m_pendingEvent->getEventName() == event->getEventName() )
-			{
-				totalRequestCount++;
-				totalCount++;
-			}
-		}
-	}
-
-	//If our event is an interrupting type, then normally we would always add it. The exception is when we have requested
-	//multiple sounds in the same frame and those requests violate the limit. Because we don't have any "old" sounds to
-	//remove in the case of an interrupt, we need to catch it early and prevent the sound from being added if we already
-	//reached the limit
-	if( event->getAudioEventInfo()->m_control & AC_INTERRUPT )
-	{
-		if( totalRequestCount < limit )
-		{
-			Int totalPlayingCount = totalCount - totalRequestCount;
-			if( totalRequestCount + totalPlayingCount < limit )
-			{
-				//We aren't exceeding the actual limit, then clear the kill handle.
-				event->setHandleToKill(0);
-				return false;
-			}
-
-			//We are exceeding the limit - the kill handle will kill the
-			//oldest playing sound to enforce the actual limit.
-			return false;
-		}
-	}
-
-	if( totalCount < limit )
-	{
-		event->setHandleToKill(0);
-		return false;
-	}
-
-	return true;
+	return m_voiceScheduler->doesViolateLimit(event);
 }
 
 //-------------------------------------------------------------------------------------------------
 Bool MilesAudioManager::isPlayingAlready( AudioEventRTS *event ) const
 {
-	std::list<PlayingAudio *>::const_iterator it;
-	if (!event->isPositionalAudio()) {
-		// 2-D
-		for ( it = m_playingSounds.begin(); it != m_playingSounds.end(); ++it ) {
-			if ((*it)->m_audioEventRTS->getEventName() == event->getEventName()) {
-				return true;
-			}
-		}
-	} else {
-		// 3-D
-		for ( it = m_playing3DSounds.begin(); it != m_playing3DSounds.end(); ++it ) {
-			if ((*it)->m_audioEventRTS->getEventName() == event->getEventName()) {
-				return true;
-			}
-		}
-	}
-
-	return false;
+	return m_voiceScheduler->isPlayingAlready(event);
 }
 
 //-------------------------------------------------------------------------------------------------
 Bool MilesAudioManager::isObjectPlayingVoice( UnsignedInt objID ) const
 {
-	if (objID == 0) {
-		return false;
-	}
-
-	std::list<PlayingAudio *>::const_iterator it;
-		// 2-D
-	for ( it = m_playingSounds.begin(); it != m_playingSounds.end(); ++it ) {
-		if ((*it)->m_audioEventRTS->getObjectID() == objID && (*it)->m_audioEventRTS->getAudioEventInfo()->m_type & ST_VOICE) {
-			return true;
-		}
-	}
-
-	// 3-D
-	for ( it = m_playing3DSounds.begin(); it != m_playing3DSounds.end(); ++it ) {
-		if ((*it)->m_audioEventRTS->getObjectID() == objID && (*it)->m_audioEventRTS->getAudioEventInfo()->m_type & ST_VOICE) {
-			return true;
-		}
-	}
-
-	return false;
+	return m_voiceScheduler->isObjectPlayingVoice((ObjectID)objID);
 }
 
 //-------------------------------------------------------------------------------------------------
 AudioEventRTS* MilesAudioManager::findLowestPrioritySound( AudioEventRTS *event )
 {
-	AudioPriority priority = event->getAudioEventInfo()->m_priority;
-	if( priority == AP_LOWEST )
+	AudioVoice *voice = m_voiceScheduler->findLowestPriorityVoice( event );
+	if( !voice )
 	{
-		//If the event we pass in is the lowest priority, don't bother checking because
-		//there is nothing lower priority than lowest.
 		return NULL;
 	}
-	AudioEventRTS *lowestPriorityEvent = NULL;
-	AudioPriority lowestPriority;
-
-	std::list<PlayingAudio *>::const_iterator it;
-	if( event->isPositionalAudio() )
-	{
-		//3D
-		for( it = m_playing3DSounds.begin(); it != m_playing3DSounds.end(); ++it )
-		{
-			AudioEventRTS *itEvent = (*it)->m_audioEventRTS;
-			AudioPriority itPriority = itEvent->getAudioEventInfo()->m_priority;
-			if( itPriority < priority )
-			{
-				if( !lowestPriorityEvent || lowestPriority > itPriority )
-				{
-					lowestPriorityEvent = itEvent;
-					lowestPriority = itPriority;
-					if( lowestPriority == AP_LOWEST )
-					{
-						return lowestPriorityEvent;
-					}
-				}
-			}
-		}
-	}
-	else
-	{
-		//2D
-		for( it = m_playingSounds.begin(); it != m_playingSounds.end(); ++it )
-		{
-			AudioEventRTS *itEvent = (*it)->m_audioEventRTS;
-			AudioPriority itPriority = itEvent->getAudioEventInfo()->m_priority;
-			if( itPriority < priority )
-			{
-				if( !lowestPriorityEvent || lowestPriority > itPriority )
-				{
-					lowestPriorityEvent = itEvent;
-					lowestPriority = itPriority;
-					if( lowestPriority == AP_LOWEST )
-					{
-						return lowestPriorityEvent;
-					}
-				}
-			}
-		}
-	}
-	return lowestPriorityEvent;
+	return ((PlayingAudio *)voice->m_userData)->m_audioEventRTS;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -2014,33 +1876,7 @@ Bool MilesAudioManager::isPlayingLowerPriority( AudioEventRTS *event ) const
 {
 	//We don't actually want to do anything to this CONST function. Remember, we're
 	//just checking to see if there is a lower priority sound.
-	AudioPriority priority = event->getAudioEventInfo()->m_priority;
-	if( priority == AP_LOWEST )
-	{
-		//If the event we pass in is the lowest priority, don't bother checking because
-		//there is nothing lower priority than lowest.
-		return false;
-	}
-	std::list<PlayingAudio *>::const_iterator it;
-	if (!event->isPositionalAudio()) {
-		// 2-D
-		for ( it = m_playingSounds.begin(); it != m_playingSounds.end(); ++it ) {
-			if ((*it)->m_audioEventRTS->getAudioEventInfo()->m_priority < priority) {
-				//event->setHandleToKill((*it)->m_audioEventRTS->getPlayingHandle());
-				return true;
-			}
-		}
-	} else {
-		// 3-D
-		for ( it = m_playing3DSounds.begin(); it != m_playing3DSounds.end(); ++it ) {
-			if ((*it)->m_audioEventRTS->getAudioEventInfo()->m_priority < priority) {
-				//event->setHandleToKill((*it)->m_audioEventRTS->getPlayingHandle());
-				return true;
-			}
-		}
-	}
-
-	return false;
+	return m_voiceScheduler->isPlayingLowerPriority(event);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -2250,6 +2086,8 @@ void MilesAudioManager::processRequestList( void )
 			continue;
 		}
 
+		// Processing the request may release its event.
+		m_voiceScheduler->removeRequest(req);
 		if (!req->m_requiresCheckForSample || checkForSample(req)) {
 			processRequest(req);
 		}
@@ -3091,14 +2929,31 @@ U32 AILCALLBACK streamingFileRead(void *file_handle, void *buffer, U32 bytes)
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
-AudioFileCache::AudioFileCache() : m_maxSize(0), m_currentlyUsedSize(0), m_mutexName("AudioFileCacheMutex")
+Real AudioFileCacheStats::getHitRate() const
+{
+	UnsignedInt total = m_hits + m_misses;
+	return total ? (Real)m_hits / (Real)total : 0.0f;
+}
+
+//-------------------------------------------------------------------------------------------------
+Real AudioFileCacheStats::getLoadMilliseconds() const
+{
+	return m_ticksPerSec ? (Real)((double)m_loadTicks * 1000.0 / (double)m_ticksPerSec) : 0.0f;
+}
+
+//-------------------------------------------------------------------------------------------------
+AudioFileCache::AudioFileCache() : m_maxSize(0), m_currentlyUsedSize(0), m_mutexName("AudioFileCacheMutex"),
+	m_prefetchGeneration(0), m_prefetchThread(NULL), m_prefetchEvent(NULL), m_prefetchQuit(FALSE)
 {
 	m_mutex = CreateMutex(NULL, FALSE, m_mutexName);
+	resetStats();
 }
 
 //-------------------------------------------------------------------------------------------------
 AudioFileCache::~AudioFileCache()
 {
+	stopPrefetchThread();
+
 	{
 		ScopedMutex mut(m_mutex);
 
@@ -3144,57 +2999,48 @@ void *AudioFileCache::openFile( AudioEventRTS *eventToOpenFrom )
 	it = m_openFiles.find(strToFind);
 
 	if (it != m_openFiles.end()) {
-		++it->second.m_openCount;
-		return it->second.m_file;
+		OpenAudioFile &cachedFile = it->second;
+		if (eventToOpenFrom->isPositionalAudio() && cachedFile.m_soundInfo.channels > 1) {
+			// Prefetched files don't know yet how they are going to be played.
+			DEBUG_CRASH(("Requested Positional Play of audio '%s', but it is in stereo.", strToFind.str()));
+			return NULL;
+		}
+
+		++m_stats.m_hits;
+		if (cachedFile.m_prefetched) {
+			++m_stats.m_prefetchHits;
+			cachedFile.m_prefetched = FALSE;
+		}
+
+		// The event info of an unused file may be from a previous map, take the current one.
+		cachedFile.m_eventInfo = eventToOpenFrom->getAudioEventInfo();
+		m_lru.splice(m_lru.end(), m_lru, cachedFile.m_lruIt);
+		++cachedFile.m_openCount;
+		return cachedFile.m_file;
 	}
 
 	// Couldn't find the file, so actually open it.
-	File *file = TheFileSystem->openFile(strToFind.str());
-	if (!file) {
-		DEBUG_ASSERTLOG(strToFind.isEmpty(), ("Missing Audio File: '%s'", strToFind.str()));
+	Int64 start = ProfileUtil::getTime();
+
+	OpenAudioFile openedAudioFile;
+	if (!loadAudioFile(strToFind, openedAudioFile)) {
 		return NULL;
 	}
 
-	UnsignedInt fileSize = file->size();
-	char* buffer = file->readEntireAndClose();
+	++m_stats.m_misses;
+	m_stats.m_loadTicks += ProfileUtil::getTime() - start;
 
-	OpenAudioFile openedAudioFile;
 	openedAudioFile.m_eventInfo = eventToOpenFrom->getAudioEventInfo();
-
-	AILSOUNDINFO soundInfo;
-	AIL_WAV_info(buffer, &soundInfo);
+	openedAudioFile.m_openCount = 1;
 
 	if (eventToOpenFrom->isPositionalAudio()) {
-		if (soundInfo.channels > 1) {
+		if (openedAudioFile.m_soundInfo.channels > 1) {
 			DEBUG_CRASH(("Requested Positional Play of audio '%s', but it is in stereo.", strToFind.str()));
-			delete [] buffer;
+			releaseOpenAudioFile(&openedAudioFile);
 			return NULL;
 		}
 	}
 
-	if (soundInfo.format == WAVE_FORMAT_IMA_ADPCM) {
-		void *decompressFileBuffer;
-		U32 newFileSize;
-		AIL_decompress_ADPCM(&soundInfo, &decompressFileBuffer, &newFileSize);
-		fileSize = newFileSize;
-		openedAudioFile.m_compressed = TRUE;
-		delete [] buffer;
-		openedAudioFile.m_file = decompressFileBuffer;
-		openedAudioFile.m_soundInfo = soundInfo;
-		openedAudioFile.m_openCount = 1;
-	} else if (soundInfo.format == WAVE_FORMAT_PCM) {
-		openedAudioFile.m_compressed = FALSE;
-		openedAudioFile.m_file = buffer;
-		openedAudioFile.m_soundInfo = soundInfo;
-		openedAudioFile.m_openCount = 1;
-	} else {
-		DEBUG_CRASH(("Unexpected compression type in '%s'", strToFind.str()));
-		// prevent leaks
-		delete [] buffer;
-		return NULL;
-	}
-
-	openedAudioFile.m_fileSize = fileSize;
 	m_currentlyUsedSize += openedAudioFile.m_fileSize;
 	if (m_currentlyUsedSize > m_maxSize) {
 		// We need to free some samples, or we're not going to be able to play this sound.
@@ -3205,7 +3051,7 @@ void *AudioFileCache::openFile( AudioEventRTS *eventToOpenFrom )
 		}
 	}
 
-	m_openFiles[strToFind] = openedAudioFile;
+	insertOpenAudioFile(strToFind, openedAudioFile);
 	return openedAudioFile.m_file;
 }
 
@@ -3219,12 +3065,16 @@ void AudioFileCache::closeFile( void *fileToClose )
 	// Protect the entire closeFile function
 	ScopedMutex mut(m_mutex);
 
-	OpenFilesHash::iterator it;
-	for ( it = m_openFiles.begin(); it != m_openFiles.end(); ++it ) {
-		if ( it->second.m_file == fileToClose ) {
-			--it->second.m_openCount;
-			return;
-		}
+	FilesByBufferMap::iterator bit = m_filesByBuffer.find(fileToClose);
+	if (bit == m_filesByBuffer.end()) {
+		return;
+	}
+
+	OpenFilesHashIt it = m_openFiles.find(bit->second);
+	if (it != m_openFiles.end()) {
+		--it->second.m_openCount;
+		// Count from the last use, a long sample shouldn't be the first to go once it finishes.
+		m_lru.splice(m_lru.end(), m_lru, it->second.m_lruIt);
 	}
 }
 
@@ -3237,6 +3087,136 @@ void AudioFileCache::setMaxSize( UnsignedInt size )
 	m_maxSize = size;
 }
 
+//-------------------------------------------------------------------------------------------------
+void AudioFileCache::prefetchFile( const AsciiString& fileName, const AudioEventInfo *eventInfo )
+{
+	if (fileName.isEmpty()) {
+		return;
+	}
+
+	ScopedMutex mut(m_mutex);
+
+	if (m_openFiles.find(fileName) != m_openFiles.end() || m_prefetchInfos.find(fileName) != m_prefetchInfos.end()) {
+		return;
+	}
+
+	// The caller's string shares its buffer with the event info, and the prefetch thread releases
+	// queued names. AsciiString reference counts are not atomic, so the cache keeps its own copy.
+	AsciiString queuedName(fileName.str());
+	m_prefetchInfos[queuedName] = eventInfo;
+	m_prefetchQueue.push_back(queuedName);
+
+	if (!m_prefetchThread) {
+		startPrefetchThread();
+	}
+	if (m_prefetchEvent) {
+		SetEvent(m_prefetchEvent);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioFileCache::cancelPrefetches()
+{
+	ScopedMutex mut(m_mutex);
+
+	m_prefetchQueue.clear();
+	m_prefetchInfos.clear();
+	++m_prefetchGeneration;
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioFileCache::resetStats()
+{
+	ScopedMutex mut(m_mutex);
+
+	m_stats.m_hits = 0;
+	m_stats.m_misses = 0;
+	m_stats.m_prefetchHits = 0;
+	m_stats.m_prefetched = 0;
+	m_stats.m_evictions = 0;
+	m_stats.m_loadTicks = 0;
+	m_stats.m_ticksPerSec = ProfileUtil::getFrequency();
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioFileCache::reportStats()
+{
+	ScopedMutex mut(m_mutex);
+
+	if (m_stats.m_hits + m_stats.m_misses + m_stats.m_prefetched == 0) {
+		return;
+	}
+
+	DEBUG_LOG(("AudioFileCache: %u hits (%u prefetched), %u misses, hit rate %.1f%%, %.2f ms loading on misses",
+		m_stats.m_hits, m_stats.m_prefetchHits, m_stats.m_misses, m_stats.getHitRate() * 100.0f, m_stats.getLoadMilliseconds()));
+	DEBUG_LOG(("AudioFileCache: %u files prefetched, %u evicted, %u/%u bytes in use",
+		m_stats.m_prefetched, m_stats.m_evictions, m_currentlyUsedSize, m_maxSize));
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool AudioFileCache::loadAudioFile( const AsciiString& fileName, OpenAudioFile& openedAudioFile )
+{
+	File *file = TheFileSystem->openFile(fileName.str());
+	if (!file) {
+		DEBUG_ASSERTLOG(fileName.isEmpty(), ("Missing Audio File: '%s'", fileName.str()));
+		return FALSE;
+	}
+
+	UnsignedInt fileSize = file->size();
+	char* buffer = file->readEntireAndClose();
+
+	AILSOUNDINFO soundInfo;
+	AIL_WAV_info(buffer, &soundInfo);
+
+	if (soundInfo.format == WAVE_FORMAT_IMA_ADPCM) {
+		void *decompressFileBuffer;
+		U32 newFileSize;
+		AIL_decompress_ADPCM(&soundInfo, &decompressFileBuffer, &newFileSize);
+		fileSize = newFileSize;
+		openedAudioFile.m_compressed = TRUE;
+		delete [] buffer;
+		openedAudioFile.m_file = decompressFileBuffer;
+		openedAudioFile.m_soundInfo = soundInfo;
+	} else if (soundInfo.format == WAVE_FORMAT_PCM) {
+		openedAudioFile.m_compressed = FALSE;
+		openedAudioFile.m_file = buffer;
+		openedAudioFile.m_soundInfo = soundInfo;
+	} else {
+		DEBUG_CRASH(("Unexpected compression type in '%s'", fileName.str()));
+		// prevent leaks
+		delete [] buffer;
+		return FALSE;
+	}
+
+	openedAudioFile.m_fileSize = fileSize;
+	openedAudioFile.m_openCount = 0;
+	openedAudioFile.m_eventInfo = NULL;
+	openedAudioFile.m_prefetched = FALSE;
+	return TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioFileCache::insertOpenAudioFile( const AsciiString& fileName, OpenAudioFile& openedAudioFile )
+{
+	// The prefetch thread evicts files too. Keep a copy that is only ever referenced under the mutex,
+	// rather than sharing the buffer of the event info that the main thread copies freely.
+	AsciiString cachedName(fileName.str());
+	openedAudioFile.m_lruIt = m_lru.insert(m_lru.end(), cachedName);
+	m_filesByBuffer[openedAudioFile.m_file] = cachedName;
+	m_openFiles[cachedName] = openedAudioFile;
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioFileCache::eraseOpenAudioFile( OpenFilesHashIt it )
+{
+	m_filesByBuffer.erase(it->second.m_file);
+	m_lru.erase(it->second.m_lruIt);
+	releaseOpenAudioFile(&it->second);
+	m_currentlyUsedSize -= it->second.m_fileSize;
+	m_openFiles.erase(it);
+	++m_stats.m_evictions;
+}
+
 //-------------------------------------------------------------------------------------------------
 void AudioFileCache::releaseOpenAudioFile( OpenAudioFile *fileToRelease )
 {
@@ -3258,6 +3238,36 @@ void AudioFileCache::releaseOpenAudioFile( OpenAudioFile *fileToRelease )
 	}
 }
 
+//-------------------------------------------------------------------------------------------------
+Bool AudioFileCache::freeUnusedSpace( UnsignedInt spaceRequired )
+{
+	UnsignedInt runningTotal = 0;
+	std::list<AsciiString> filesToClose;
+
+	std::list<AsciiString>::iterator lit;
+	for (lit = m_lru.begin(); lit != m_lru.end() && runningTotal < spaceRequired; ++lit) {
+		OpenFilesHashIt it = m_openFiles.find(*lit);
+		// Don't let prefetches push out other prefetches that haven't had their chance to play yet.
+		if (it != m_openFiles.end() && it->second.m_openCount == 0 && !it->second.m_prefetched) {
+			filesToClose.push_back(*lit);
+			runningTotal += it->second.m_fileSize;
+		}
+	}
+
+	if (runningTotal < spaceRequired) {
+		return FALSE;
+	}
+
+	for (lit = filesToClose.begin(); lit != filesToClose.end(); ++lit) {
+		OpenFilesHashIt itToErase = m_openFiles.find(*lit);
+		if (itToErase != m_openFiles.end()) {
+			eraseOpenAudioFile(itToErase);
+		}
+	}
+
+	return TRUE;
+}
+
 //-------------------------------------------------------------------------------------------------
 Bool AudioFileCache::freeEnoughSpaceForSample(const OpenAudioFile& sampleThatNeedsSpace)
 {
@@ -3267,10 +3277,11 @@ Bool AudioFileCache::freeEnoughSpaceForSample(const OpenAudioFile& sampleThatNee
 
 	std::list<AsciiString> filesToClose;
 	// First, search for any samples that have ref counts of 0. They are low-hanging fruit, and
-	// should be considered immediately.
-	OpenFilesHashIt it;
-	for (it = m_openFiles.begin(); it != m_openFiles.end(); ++it) {
-		if (it->second.m_openCount == 0) {
+	// should be considered immediately. The least recently used ones go first.
+	std::list<AsciiString>::iterator lit;
+	for (lit = m_lru.begin(); lit != m_lru.end(); ++lit) {
+		OpenFilesHashIt it = m_openFiles.find(*lit);
+		if (it != m_openFiles.end() && it->second.m_openCount == 0) {
 			// This is said low-hanging fruit.
 			filesToClose.push_back(it->first);
 
@@ -3287,8 +3298,9 @@ Bool AudioFileCache::freeEnoughSpaceForSample(const OpenAudioFile& sampleThatNee
 	// Mical said that at this point, sounds shouldn't care if other sounds are interruptable or not.
 	// Kill any files of lower priority necessary to clear our the buffer.
 	if (runningTotal < spaceRequired) {
-		for (it = m_openFiles.begin(); it != m_openFiles.end(); ++it) {
-			if (it->second.m_openCount > 0) {
+		for (lit = m_lru.begin(); lit != m_lru.end(); ++lit) {
+			OpenFilesHashIt it = m_openFiles.find(*lit);
+			if (it != m_openFiles.end() && it->second.m_openCount > 0) {
 				if (it->second.m_eventInfo->m_priority < sampleThatNeedsSpace.m_eventInfo->m_priority) {
 					filesToClose.push_back(it->first);
 					runningTotal += it->second.m_fileSize;
@@ -3310,15 +3322,126 @@ Bool AudioFileCache::freeEnoughSpaceForSample(const OpenAudioFile& sampleThatNee
 	for (ait = filesToClose.begin(); ait != filesToClose.end(); ++ait) {
 		OpenFilesHashIt itToErase = m_openFiles.find(*ait);
 		if (itToErase != m_openFiles.end()) {
-			releaseOpenAudioFile(&itToErase->second);
-			m_currentlyUsedSize -= itToErase->second.m_fileSize;
-			m_openFiles.erase(itToErase);
+			eraseOpenAudioFile(itToErase);
 		}
 	}
 
 	return TRUE;
 }
 
+//-------------------------------------------------------------------------------------------------
+void AudioFileCache::startPrefetchThread()
+{
+	m_prefetchQuit = FALSE;
+	m_prefetchEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+	if (!m_prefetchEvent) {
+		return;
+	}
+
+	m_prefetchThread = CreateThread(NULL, 0, prefetchThreadProc, this, 0, NULL);
+	if (!m_prefetchThread) {
+		// Without the thread the files are simply loaded the first time they play.
+		CloseHandle(m_prefetchEvent);
+		m_prefetchEvent = NULL;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioFileCache::stopPrefetchThread()
+{
+	if (!m_prefetchThread) {
+		return;
+	}
+
+	m_prefetchQuit = TRUE;
+	SetEvent(m_prefetchEvent);
+	WaitForSingleObject(m_prefetchThread, INFINITE);
+
+	CloseHandle(m_prefetchThread);
+	CloseHandle(m_prefetchEvent);
+	m_prefetchThread = NULL;
+	m_prefetchEvent = NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+DWORD WINAPI AudioFileCache::prefetchThreadProc( LPVOID param )
+{
+	((AudioFileCache *)param)->prefetchThreadLoop();
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioFileCache::prefetchThreadLoop()
+{
+	while (!m_prefetchQuit) {
+		AsciiString fileName;
+		const AudioEventInfo *eventInfo = NULL;
+		UnsignedInt generation;
+		{
+			ScopedMutex mut(m_mutex);
+			if (!m_prefetchQueue.empty()) {
+				// Take a private copy, so the load below doesn't hold a reference to a buffer the main thread uses.
+				fileName = AsciiString(m_prefetchQueue.front().str());
+				m_prefetchQueue.pop_front();
+				PrefetchInfoHash::iterator it = m_prefetchInfos.find(fileName);
+				if (it != m_prefetchInfos.end()) {
+					eventInfo = it->second;
+				}
+			}
+			generation = m_prefetchGeneration;
+		}
+
+		if (fileName.isEmpty()) {
+			WaitForSingleObject(m_prefetchEvent, INFINITE);
+			continue;
+		}
+
+		// The expensive part, reading and decoding, happens without holding the mutex.
+		OpenAudioFile openedAudioFile;
+		Bool loaded = loadAudioFile(fileName, openedAudioFile);
+
+		ScopedMutex mut(m_mutex);
+		storePrefetchedFile(fileName, eventInfo, generation, loaded, openedAudioFile);
+
+		// Release our copy while still holding the mutex, AsciiString reference counts are not atomic.
+		fileName.clear();
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void AudioFileCache::storePrefetchedFile( const AsciiString& fileName, const AudioEventInfo *eventInfo, UnsignedInt generation, Bool loaded, OpenAudioFile& openedAudioFile )
+{
+	if (generation == m_prefetchGeneration) {
+		m_prefetchInfos.erase(fileName);
+	}
+
+	if (!loaded) {
+		return;
+	}
+
+	if (generation != m_prefetchGeneration || m_openFiles.find(fileName) != m_openFiles.end()) {
+		// Cancelled, or the sample started playing while we were loading it.
+		releaseOpenAudioFile(&openedAudioFile);
+		return;
+	}
+
+	UnsignedInt spaceRequired = 0;
+	if (m_currentlyUsedSize + openedAudioFile.m_fileSize > m_maxSize) {
+		spaceRequired = m_currentlyUsedSize + openedAudioFile.m_fileSize - m_maxSize;
+	}
+
+	if (spaceRequired > 0 && !freeUnusedSpace(spaceRequired)) {
+		releaseOpenAudioFile(&openedAudioFile);
+		return;
+	}
+
+	openedAudioFile.m_eventInfo = eventInfo;
+	openedAudioFile.m_prefetched = TRUE;
+	m_currentlyUsedSize += openedAudioFile.m_fileSize;
+	insertOpenAudioFile(fileName, openedAudioFile);
+	++m_stats.m_prefetched;
+}
+
 
 #if defined(RTS_DEBUG)
 //-------------------------------------------------------------------------------------------------
@@ -615,31 +615,66 @@ void W3DRadar::drawIcons( Int pixelX, Int pixelY, Int width, Int height )
 //-------------------------------------------------------------------------------------------------
 void W3DRadar::updateObjectTexture(TextureClass *texture)
 {
-	// reset the overlay texture
+	// TheSuperHackers @performance 18/10/2026 Collect what is drawn of the visible objects first,
+	// and leave the overlay alone when that is the same as last time.
+	m_objectBlips.clear();
+	collectObjectBlips( getObjectList(), m_objectBlips );
+	collectObjectBlips( getLocalObjectList(), m_objectBlips, TRUE );
+
+	if( m_objectBlipsDrawn && m_objectBlips == m_drawnObjectBlips )
+		return;
+
+	// rebuild the object overlay in memory and copy it to the texture in one go
+	rasterizeBlips( m_objectBlips, m_objectPixels );
+	copyPixelsToTexture( m_objectPixels, texture );
+
+	m_drawnObjectBlips.swap( m_objectBlips );
+	m_objectBlipsDrawn = TRUE;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Copy RADAR_CELL_WIDTH * RADAR_CELL_HEIGHT colors to the texture passed in, the same way
+	* SurfaceClass::DrawPixel would write each of them */
+//-------------------------------------------------------------------------------------------------
+void W3DRadar::copyPixelsToTexture( const Color *pixels, TextureClass *texture )
+{
 	SurfaceClass *surface = texture->Get_Surface_Level();
-	surface->Clear();
-	REF_PTR_RELEASE(surface);
+	const UnsignedInt bytesPerPixel = Get_Bytes_Per_Pixel( surface->Get_Surface_Format() );
+
+	Int pitch;
+	UnsignedByte *bits = (UnsignedByte *)surface->Lock( &pitch );
+	for( Int y = 0; y < RADAR_CELL_HEIGHT; y++ )
+	{
+		UnsignedByte *row = bits + y * pitch;
+		const Color *source = pixels + y * RADAR_CELL_WIDTH;
 
-	// rebuild the object overlay
-	renderObjectList( getObjectList(), texture );
-	renderObjectList( getLocalObjectList(), texture, TRUE );
+		if( bytesPerPixel == 4 )
+		{
+			memcpy( row, source, RADAR_CELL_WIDTH * sizeof( Color ) );
+		}
+		else if( bytesPerPixel == 2 )
+		{
+			UnsignedShort *shortRow = (UnsignedShort *)row;
+			for( Int x = 0; x < RADAR_CELL_WIDTH; x++ )
+				shortRow[ x ] = (UnsignedShort)( source[ x ] & 0xFFFF );
+		}
+	}
+	surface->Unlock();
+	REF_PTR_RELEASE(surface);
 }
 
 //-------------------------------------------------------------------------------------------------
-/** Render an object list into the texture passed in */
+/** Add the blips of the visible objects of an object list */
 //-------------------------------------------------------------------------------------------------
-void W3DRadar::renderObjectList( const RadarObject *listHead, TextureClass *texture, Bool calcHero )
+void W3DRadar::collectObjectBlips( const RadarObject *listHead, RadarBlipVec &blips, Bool calcHero )
 {
 
 	// sanity
-	if( listHead == NULL || texture == NULL )
+	if( listHead == NULL )
 		return;
 
-	// get surface for texture to render into
-	SurfaceClass *surface = texture->Get_Surface_Level();
-
 	// loop through all objects and draw
-	ICoord2D radarPoint;
+	RadarBlip blip;
 
 	Player *player = rts::getObservedOrLocalPlayer();
 	const Int playerIndex = player->getPlayerIndex();
@@ -677,8 +712,8 @@ void W3DRadar::renderObjectList( const RadarObject *listHead, TextureClass *text
 		const Coord3D *pos = obj->getPosition();
 
 		// compute object position as a radar blip
-		radarPoint.x = pos->x / (m_mapExtent.width() / RADAR_CELL_WIDTH);
-		radarPoint.y = pos->y / (m_mapExtent.height() / RADAR_CELL_HEIGHT);
+		blip.x = pos->x / (m_mapExtent.width() / RADAR_CELL_WIDTH);
+		blip.y = pos->y / (m_mapExtent.height() / RADAR_CELL_HEIGHT);
 
     // get the color we're going to draw in
 		Color c = rObj->getColor();
@@ -716,98 +751,12 @@ void W3DRadar::renderObjectList( const RadarObject *listHead, TextureClass *text
 			m_cachedHeroObjectList.push_back(obj);
 		}
 
-		// draw the blip, but make sure the points are legal
-		if( legalRadarPoint( radarPoint.x, radarPoint.y ) )
-			surface->DrawPixel( radarPoint.x, radarPoint.y, c );
-
-		radarPoint.y++;
-		if( legalRadarPoint( radarPoint.x, radarPoint.y ) )
-			surface->DrawPixel( radarPoint.x, radarPoint.y, c );
-
-		radarPoint.x++;
-		if( legalRadarPoint( radarPoint.x, radarPoint.y ) )
-			surface->DrawPixel( radarPoint.x, radarPoint.y, c );
-
-		radarPoint.y--;
-		if( legalRadarPoint( radarPoint.x, radarPoint.y ) )
-			surface->DrawPixel( radarPoint.x, radarPoint.y, c );
-
-	}
-	REF_PTR_RELEASE(surface);
-
-}
-
-//-------------------------------------------------------------------------------------------------
-/** Shade the color passed in using the height parameter to lighten and darken it.  Colors
-	* will be interpolated using the value "height" across the range from loZ to hiZ.  The
-	* midZ is the "middle" point, height values above it will be lightened, while
-	* lower ones are darkened. */
-//-------------------------------------------------------------------------------------------------
-void W3DRadar::interpolateColorForHeight( RGBColor *color,
-																					Real height,
-																					Real hiZ,
-																					Real midZ,
-																					Real loZ )
-{
-	const Real howBright = 0.95f;  // bigger is brighter (0.0 to 1.0)
-	const Real howDark   = 0.60f;  // bigger is darker (0.0 to 1.0)
-
-	// sanity on map height (flat maps bomb)
-	if (hiZ == midZ)
-		hiZ = midZ+0.1f;
-	if (midZ == loZ)
-		loZ = midZ-0.1f;
-	if (hiZ == loZ)
-		hiZ = loZ+0.2f;
-
-	Real t;
-	RGBColor colorTarget;
-
-	// if "over" the middle height, interpolate lighter
-	if( height >= midZ )
-	{
-
-		// how far are we from the middleZ towards the hi Z
-		t = (height - midZ) / (hiZ - midZ);
-
-		// compute what our "lightest" color possible we want to use is
-		colorTarget.red = color->red + (1.0f - color->red) * howBright;
-		colorTarget.green = color->green + (1.0f - color->green) * howBright;
-		colorTarget.blue = color->blue + (1.0f - color->blue) * howBright;
-
-	}
-	else  // interpolate darker
-	{
-
-		// how far are we from the middleZ towards the low Z
-		t = (midZ - height) / (midZ - loZ);
-
-		// compute what the "darkest" color possible we want to use is
-		colorTarget.red = color->red + (0.0f - color->red) * howDark;
-		colorTarget.green = color->green + (0.0f - color->green) * howDark;
-		colorTarget.blue = color->blue + (0.0f - color->blue) * howDark;
+		// draw the blip, rasterizeBlips keeps the points legal
+		blip.color = c;
+		blips.push_back( blip );
 
 	}
 
-	// interpolate toward the target color
-	color->red = color->red + (colorTarget.red - color->red) * t;
-	color->green = color->green + (colorTarget.green - color->green) * t;
-	color->blue = color->blue + (colorTarget.blue - color->blue) * t;
-
-	// keep the color real
-	if( color->red < 0.0f )
-		color->red = 0.0f;
-	if( color->red > 1.0f )
-		color->red = 1.0f;
-	if( color->green < 0.0f )
-		color->green = 0.0f;
-	if( color->green > 1.0f )
-		color->green = 1.0f;
-	if( color->blue < 0.0f )
-		color->blue = 0.0f;
-	if( color->blue > 1.0f )
-		color->blue = 1.0f;
-
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -831,6 +780,8 @@ W3DRadar::W3DRadar( void )
 	m_shroudImage = NULL;
 	m_shroudTexture = NULL;
 
+	m_objectBlipsDrawn = FALSE;
+
 	m_textureWidth = RADAR_CELL_WIDTH;
 	m_textureHeight = RADAR_CELL_HEIGHT;
 
@@ -965,6 +916,8 @@ void W3DRadar::reset( void )
 	Radar::reset();
 
 	m_cachedHeroObjectList.clear();
+	m_drawnObjectBlips.clear();
+	m_objectBlipsDrawn = FALSE;
 
 	// clear our texture data, but do not delete the resources
 	SurfaceClass *surface;
@@ -1048,235 +1001,48 @@ void W3DRadar::newMap( TerrainLogic *terrain )
 		return;
 
 	// build terrain texture
-	buildTerrainTexture( terrain );
+	rasterizeTerrain( terrain, NULL );
+	updateTerrainTexture( NULL );
 
 }
 
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
-void W3DRadar::buildTerrainTexture( TerrainLogic *terrain )
+void W3DRadar::updateTerrainTexture( const IRegion2D *region )
 {
 	SurfaceClass *surface;
-	RGBColor waterColor;
 
 	// we will want to reconstruct our new view box now
 	m_reconstructViewBox = TRUE;
 
-	// setup our water color
-	waterColor.red = TheWaterTransparency->m_radarColor.red;
-	waterColor.green = TheWaterTransparency->m_radarColor.green;
-	waterColor.blue = TheWaterTransparency->m_radarColor.blue;
-
 	// get the terrain surface to draw in
 	surface = m_terrainTexture->Get_Surface_Level();
 	DEBUG_ASSERTCRASH( surface, ("W3DRadar: Can't get surface for terrain texture") );
 
-	// build the terrain
-	RGBColor sampleColor;
-	RGBColor color;
-	Int i, j, samples;
-	Int x, y;
-	ICoord2D radarPoint;
-	Coord3D worldPoint;
-	Bridge *bridge;
-	for( y = 0; y < m_textureHeight; y++ )
+	IRegion2D cells;
+	if( region != NULL )
+		cells = *region;
+	else
 	{
+		cells.lo.x = 0;
+		cells.lo.y = 0;
+		cells.hi.x = m_textureWidth - 1;
+		cells.hi.y = m_textureHeight - 1;
+	}
 
-		for( x = 0; x < m_textureWidth; x++ )
-		{
-
-			// what point are we inspecting
-			radarPoint.x = x;
-			radarPoint.y = y;
-			radarToWorld2D( &radarPoint, &worldPoint );
-
-			// check to see if this point is part of a working bridge
-			Bool workingBridge = FALSE;
-			bridge = TheTerrainLogic->findBridgeAt( &worldPoint );
-			if( bridge != NULL )
-			{
-				Object *obj = TheGameLogic->findObjectByID( bridge->peekBridgeInfo()->bridgeObjectID );
-
-				if( obj )
-				{
-					BodyModuleInterface *body = obj->getBodyModule();
-
-					if( body->getDamageState() != BODY_RUBBLE )
-						workingBridge = TRUE;
-
-				}
-
-			}
-
-			// create a color based on the Z height of the map
-			Real waterZ;
-			if( workingBridge == FALSE && terrain->isUnderwater( worldPoint.x, worldPoint.y, &waterZ ) )
-			{
-				const Int waterSamplesAway = 1;		// how many "tiles" from the center tile we will sample away
-																					// to average a color for the tile color
-
-				sampleColor.red = sampleColor.green = sampleColor.blue = 0.0f;
-				samples = 0;
-
-				for( j = y - waterSamplesAway; j <= y + waterSamplesAway; j++ )
-				{
-
-					if( j >= 0 && j < m_textureHeight )
-					{
-
-						for( i = x - waterSamplesAway; i <= x + waterSamplesAway; i++ )
-						{
-
-							if( i >= 0 && i < m_textureWidth )
-							{
-
-								// the the world point we are concerned with
-								radarPoint.x = i;
-								radarPoint.y = j;
-								radarToWorld2D( &radarPoint, &worldPoint );
-
-								// get color for this Z and add to our sample color
-								Real underwaterZ;
-								if( terrain->isUnderwater( worldPoint.x, worldPoint.y, NULL, &underwaterZ ) )
-								{
-									// this is our "color" for water
-									color = waterColor;
-
-									// interpolate the water color for height in the water table
-									interpolateColorForHeight( &color, underwaterZ, waterZ,
-																						 waterZ,
-																						 m_mapExtent.lo.z );
-
-									// add color to our samples
-									sampleColor.red += color.red;
-									sampleColor.green += color.green;
-									sampleColor.blue += color.blue;
-									samples++;
-
-								}
-
-							}
-
-						}
-
-					}
-
-				}
-
-				// prevent divide by zeros
-				if( samples == 0 )
-					samples = 1;
-
-				// set the color to an average of the colors read
-				color.red = sampleColor.red / (Real)samples;
-				color.green = sampleColor.green / (Real)samples;
-				color.blue = sampleColor.blue / (Real)samples;
-
-			}
-			else  // regular terrain ...
-			{
-				const Int samplesAway = 1;  // how many "tiles" from the center tile we will sample away
-																		// to average a color for the tile color
-
-				sampleColor.red = sampleColor.green = sampleColor.blue = 0.0f;
-				samples = 0;
-
-				for( j = y - samplesAway; j <= y + samplesAway; j++ )
-				{
-
-					if( j >= 0 && j < m_textureHeight )
-					{
-
-						for( i = x - samplesAway; i <= x + samplesAway; i++ )
-						{
-
-							if( i >= 0 && i < m_textureWidth )
-							{
-
-								// the the world point we are concerned with
-								radarPoint.x = i;
-								radarPoint.y = j;
-								radarToWorld( &radarPoint, &worldPoint );
-
-								// get the color we're going to use here
-								if( workingBridge )
-								{
-									AsciiString bridgeTName = bridge->getBridgeTemplateName();
-									TerrainRoadType *bridgeTemplate = TheTerrainRoads->findBridge( bridgeTName );
-
-									// sanity
-									DEBUG_ASSERTCRASH( bridgeTemplate, ("W3DRadar::buildTerrainTexture - Can't find bridge template for '%s'", bridgeTName.str()) );
-
-									// use bridge color
-									if ( bridgeTemplate )
-										color = bridgeTemplate->getRadarColor();
-									else
-										color.setFromInt(0xffffffff);
-									//
-									// we won't use the height of the terrain at this sample point, we will
-									// instead use the height for the entire bridge
-									//
-									Real bridgeHeight = (bridge->peekBridgeInfo()->fromLeft.z +
-																			 bridge->peekBridgeInfo()->fromRight.z +
-																			 bridge->peekBridgeInfo()->toLeft.z +
-																			 bridge->peekBridgeInfo()->toRight.z) / 4.0f;
-
-									// interpolate the color, but use the bridge height, not the terrain height
-									interpolateColorForHeight( &color, bridgeHeight,
-																						 getTerrainAverageZ(),
-																						 m_mapExtent.hi.z, m_mapExtent.lo.z );
-
-								}
-								else
-								{
-
-									// get the color at this point
-									TheTerrainVisual->getTerrainColorAt( worldPoint.x, worldPoint.y, &color );
-
-									// interpolate the color for height
-									interpolateColorForHeight( &color, worldPoint.z, getTerrainAverageZ(),
-																						 m_mapExtent.hi.z, m_mapExtent.lo.z );
-
-								}
-
-								// add color to our samples
-								sampleColor.red += color.red;
-								sampleColor.green += color.green;
-								sampleColor.blue += color.blue;
-								samples++;
-
-							}
-
-						}
-
-					}
-
-				}
-
-				// prevent divide by zeros
-				if( samples == 0 )
-					samples = 1;
-
-				// set the color to an average of the colors read
-				color.red = sampleColor.red / (Real)samples;
-				color.green = sampleColor.green / (Real)samples;
-				color.blue = sampleColor.blue / (Real)samples;
+	// copy the terrain colors of the radar cells, these are computed by rasterizeTerrain
+	const Color *colors = getTerrainColors();
+	for( Int y = cells.lo.y; y <= cells.hi.y; y++ )
+	{
 
-			}
+		for( Int x = cells.lo.x; x <= cells.hi.x; x++ )
+		{
 
 			//
 			// draw the pixel for the terrain at this point, note that because of the orientation
 			// of our world we draw it with positive y in the "up" direction
 			//
-			// FYI: I tried making this faster by pulling out all the code inside DrawPixel
-			// and locking only once ... but it made absolutely *no* performance difference,
-			// the sampling and interpolation algorithm for generating pretty looking terrain
-			// and water for the radar is just, well, expensive.
-			//
-			surface->DrawPixel( x, y, GameMakeColor( color.red * 255,
-																							 color.green * 255,
-																							 color.blue * 255,
-																							 255 ) );
+			surface->DrawPixel( x, y, colors[ y * RADAR_CELL_WIDTH + x ] );
 
 		}
 
@@ -1475,7 +1241,22 @@ void W3DRadar::refreshTerrain( TerrainLogic *terrain )
 	Radar::refreshTerrain( terrain );
 
 	// rebuild the entire terrain texture
-	buildTerrainTexture( terrain );
+	rasterizeTerrain( terrain, NULL );
+	updateTerrainTexture( NULL );
+
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DRadar::refreshTerrainArea( TerrainLogic *terrain, const IRegion2D *region )
+{
+
+	// extend base class
+	Radar::refreshTerrainArea( terrain, region );
+
+	// TheSuperHackers @performance 18/10/2026 Rebuild only the changed part of the terrain texture.
+	rasterizeTerrain( terrain, region );
+	updateTerrainTexture( region );
 
 }
 
@@ -74,7 +74,12 @@ File* Win32BIGFile::openFile( const Char *filename, Int access )
 		ramFile = newInstance( RAMFile );
 
 	ramFile->deleteOnClose();
-	if (ramFile->openFromArchive(m_file, fileInfo->m_filename, fileInfo->m_offset, fileInfo->m_size) == FALSE) {
+	Bool opened;
+	{
+		FastCriticalSectionClass::LockClass lock(m_archiveMutex);
+		opened = ramFile->openFromArchive(m_file, fileInfo->m_filename, fileInfo->m_offset, fileInfo->m_size);
+	}
+	if (opened == FALSE) {
 		ramFile->close();
 		ramFile = NULL;
 		return NULL;
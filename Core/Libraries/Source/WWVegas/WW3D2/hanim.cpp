@@ -46,6 +46,26 @@
 #include <nstrdup.h>
 
 
+/*
+**
+**	HAnimCursorClass
+**
+**
+*/
+
+void HAnimCursorClass::Init(const HAnimClass * anim, int count)
+{
+	if (count > NumCursors) {
+		delete [] Cursors;
+		Cursors = W3DNEWARRAY uint32[count];
+		NumCursors = count;
+	}
+	if (NumCursors > 0) {
+		memset(Cursors, 0, NumCursors * sizeof(uint32));
+	}
+	Anim = anim;
+}
+
 
 /*
 **
@@ -52,8 +52,54 @@ class HTreeClass;
 class ChunkLoadClass;
 class ChunkSaveClass;
 class HTreeClass;
+class HAnimClass;
 
 
+/**********************************************************************************
+
+	HAnimCursorClass
+
+	The per-object lookup state of an animation. The time coded channels of a
+	compressed animation remember the packet they used last, but the channels are
+	shared by every object that plays the animation. Objects that play it at
+	different frames keep resetting that memory and fall back to a binary search
+	for every channel. An object that owns one of these keeps its own packet
+	cursors instead.
+
+**********************************************************************************/
+class HAnimCursorClass
+{
+public:
+
+	HAnimCursorClass(void) : Anim(NULL), Cursors(NULL), NumCursors(0)	{ }
+	HAnimCursorClass(const HAnimCursorClass &) : Anim(NULL), Cursors(NULL), NumCursors(0)	{ }
+	~HAnimCursorClass(void)	{ delete [] Cursors; }
+
+	HAnimCursorClass & operator = (const HAnimCursorClass &)	{ Reset(); return *this; }
+
+	// Forget the cursors, must be called when the object switches animations
+	void					Reset(void)	{ Anim = NULL; }
+
+	// Returns count cursors for the given animation, they start at zero when the animation changes
+	WWINLINE uint32 *	Get_Cursors(const HAnimClass * anim, int count);
+
+private:
+
+	void					Init(const HAnimClass * anim, int count);
+
+	const HAnimClass *	Anim;
+	uint32 *				Cursors;
+	int					NumCursors;
+};
+
+WWINLINE uint32 * HAnimCursorClass::Get_Cursors(const HAnimClass * anim, int count)
+{
+	if (anim != Anim || count > NumCursors) {
+		Init(anim, count);
+	}
+	return Cursors;
+}
+
 
 #define EMBEDDED_SOUND_BONE_INDEX_NOT_SET -1
 /**********************************************************************************
@@ -71,6 +117,7 @@ public:
 	{
 		CLASSID_UNKNOWNANIM	= 0xFFFFFFFF,
 		CLASSID_HRAWANIM		= 0,
+		CLASSID_HCOMPRESSEDANIM	= 1,
 		CLASSID_LASTANIM		= 0x0000FFFF
 	};
 
@@ -93,6 +140,11 @@ public:
 	virtual void				Get_Transform(Matrix3D&, int pividx, float frame) const = 0;
 	virtual bool				Get_Visibility(int pividx,float frame) = 0;
 
+	// Variants that look up the motion through the cursors of a single object. Animations
+	// without per-object lookup state ignore the cursor.
+	virtual void				Get_Translation_With_Cursor(Vector3& translation, int pividx,float frame, HAnimCursorClass & cursor) const	{ Get_Translation(translation,pividx,frame); }
+	virtual void				Get_Orientation_With_Cursor(Quaternion& orientation, int pividx,float frame, HAnimCursorClass & cursor) const	{ Get_Orientation(orientation,pividx,frame); }
+
 	virtual int					Get_Num_Pivots(void) const = 0;
 	virtual bool				Is_Node_Motion_Present(int pividx) = 0;
 
@@ -579,6 +579,61 @@ void HCompressedAnimClass::Get_Orientation(Quaternion& q, int pividx,float frame
 	}
 }
 
+/***********************************************************************************************
+ * HCompressedAnimClass::Get_Translation_With_Cursor -- translation from the object's cursors  *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Only the time coded channels have per-object cursors, adaptive delta channels keep          *
+ * decompressing into their own cache.                                                         *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void HCompressedAnimClass::Get_Translation_With_Cursor( Vector3& trans, int pividx, float frame, HAnimCursorClass & cursor ) const
+{
+	if (Flavor != ANIM_FLAVOR_TIMECODED) {
+		Get_Translation(trans, pividx, frame);
+		return;
+	}
+
+	struct NodeCompressedMotionStruct * motion = &NodeMotion[pividx];
+	uint32 * cursors = cursor.Get_Cursors(this, NumNodes * CURSORS_PER_NODE) + pividx * CURSORS_PER_NODE;
+
+	trans=Vector3(0,0,0);
+
+	if (motion->tc.X) motion->tc.X->Get_Vector(frame, &(trans[0]), cursors[0]);
+	if (motion->tc.Y) motion->tc.Y->Get_Vector(frame, &(trans[1]), cursors[1]);
+	if (motion->tc.Z) motion->tc.Z->Get_Vector(frame, &(trans[2]), cursors[2]);
+}
+
+/***********************************************************************************************
+ * HCompressedAnimClass::Get_Orientation_With_Cursor -- orientation from the object's cursors  *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+void HCompressedAnimClass::Get_Orientation_With_Cursor(Quaternion& q, int pividx,float frame, HAnimCursorClass & cursor) const
+{
+	if (Flavor != ANIM_FLAVOR_TIMECODED) {
+		Get_Orientation(q, pividx, frame);
+		return;
+	}
+
+	if (NodeMotion[pividx].tc.Q) {
+		uint32 * cursors = cursor.Get_Cursors(this, NumNodes * CURSORS_PER_NODE) + pividx * CURSORS_PER_NODE;
+		q = NodeMotion[pividx].tc.Q->Get_QuatVector(frame, cursors[3]);
+	}
+	else q.Make_Identity();
+}
+
 /***********************************************************************************************
  * HCompressedAnimClass::Get_Transform -- returns the transform matrix for the given frame	  *
  *                                                                                             *
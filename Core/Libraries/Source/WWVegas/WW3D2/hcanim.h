@@ -91,6 +91,9 @@ public:
 	void							Get_Transform(Matrix3D& transform, int pividx,float frame) const;
 	bool							Get_Visibility(int pividx,float frame);
 
+	void							Get_Translation_With_Cursor(Vector3& translation, int pividx,float frame, HAnimCursorClass & cursor) const;
+	void							Get_Orientation_With_Cursor(Quaternion& orientation, int pividx,float frame, HAnimCursorClass & cursor) const;
+
 	bool							Is_Node_Motion_Present(int pividx);
 	int							Get_Num_Pivots(void)	const	{ return NumNodes; }
 
@@ -100,9 +103,14 @@ public:
 	bool							Has_Z_Translation (int pividx);
 	bool							Has_Rotation (int pividx);
 	bool							Has_Visibility (int pividx);
+	int							Class_ID(void) const	{ return CLASSID_HCOMPRESSEDANIM; }
 
 private:
 
+	// Every node keeps a cursor for each of its X, Y, Z and Q channels
+	enum { CURSORS_PER_NODE = 4 };
+
+
 	char							Name[2*W3D_NAME_LEN];
 	char							HierarchyName[W3D_NAME_LEN];
 
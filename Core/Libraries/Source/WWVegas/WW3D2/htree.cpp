@@ -549,6 +549,7 @@ void HTreeClass::Base_Update(const Matrix3D & root)
  * HTreeClass::Anim_Update -- Computes the transform for each pivot with motion                *
  *                                                                                             *
  * INPUT:                                                                                      *
+ * cursor - optional channel cursors of the object that is animated                            *
  *                                                                                             *
  * OUTPUT:                                                                                     *
  *                                                                                             *
@@ -557,7 +558,7 @@ void HTreeClass::Base_Update(const Matrix3D & root)
  * HISTORY:                                                                                    *
  *   08/11/1997 GH  : Created.                                                                 *
  *=============================================================================================*/
-void HTreeClass::Anim_Update(const Matrix3D & root,HAnimClass * motion,float frame)
+void HTreeClass::Anim_Update(const Matrix3D & root,HAnimClass * motion,float frame,HAnimCursorClass * cursor)
 {
 	PivotClass *pivot;
 	Matrix3D mtx;
@@ -579,11 +580,15 @@ void HTreeClass::Anim_Update(const Matrix3D & root,HAnimClass * motion,float fra
 
 			// animation
 			Vector3 trans;
-			motion->Get_Translation(trans,piv_idx,frame);
-			pivot->Transform.Translate(trans * ScaleFactor);
-
 			Quaternion q;
-			motion->Get_Orientation(q,piv_idx,frame);
+			if (cursor != NULL) {
+				motion->Get_Translation_With_Cursor(trans,piv_idx,frame,*cursor);
+				motion->Get_Orientation_With_Cursor(q,piv_idx,frame,*cursor);
+			} else {
+				motion->Get_Translation(trans,piv_idx,frame);
+				motion->Get_Orientation(q,piv_idx,frame);
+			}
+			pivot->Transform.Translate(trans * ScaleFactor);
 			::Build_Matrix3D(q,mtx);
 
 #ifdef ALLOW_TEMPORARIES
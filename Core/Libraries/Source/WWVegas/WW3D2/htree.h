@@ -46,6 +46,7 @@
 #include "wwdebug.h"
 
 class HAnimClass;
+class HAnimCursorClass;
 class HAnimComboClass;
 class MeshClass;
 class ChunkLoadClass;
@@ -94,7 +95,8 @@ public:
 
 	void					Anim_Update(		const Matrix3D &		root,
 													HAnimClass *			motion,
-													float						frame);
+													float						frame,
+													HAnimCursorClass *	cursor = NULL);
 	void					Anim_Update_Without_Interpolation(const Matrix3D & root,HRawAnimClass * motion,float frame);
 
 	void					Blend_Update(		const Matrix3D &		root,
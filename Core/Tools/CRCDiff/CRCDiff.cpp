@@ -16,16 +16,32 @@
 **	along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+// ---------------------------------------------------------------------------
+// File: CRCDiff.cpp
+// Description: Finds where two CRC debug logs diverge. Both logs are memory
+//              mapped and indexed by frame in parallel, identical frames are
+//              skipped wholesale and only the first mismatches are reported
+//              with a bounded amount of surrounding context.
+// ---------------------------------------------------------------------------
+
 #include "debug.h"
 #include "expander.h"
 #include "KVPair.h"
+#include "LogIndex.h"
+#include "MappedFile.h"
 #include "misc.h"
 #include <Utility/iostream_adapter.h>
-#include <list>
+#include <algorithm>
+#include <string>
+#include <vector>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
 //=============================================================================
 
 std::string tableRow;
@@ -40,28 +56,6 @@ static void exitWait(void)
 //=============================================================================
 
 #define LINESIZE 1024
-static bool getNextLine(FILE *fp, char *line, int& frame, int& index) {
-	if (!fp)
-		return false;
-
-	char buf[LINESIZE];
-	while (fgets(buf, LINESIZE-1, fp) != NULL)
-	{
-		int len = strlen(buf);
-		if (buf[len-1] == '\n')
-			buf[len-1] = '\0';
-		if (sscanf(buf, "%d:%d ", &frame, &index) == 2)
-		{
-			strcpy(line, buf);
-			return true;
-		}
-	}
-
-	fclose(fp);
-	return false;
-}
-
-//=============================================================================
 
 static std::string readInFile(const char *fname) {
 	FILE *fp = fopen(fname, "rt");
@@ -81,14 +75,23 @@ static std::string readInFile(const char *fname) {
 
 //=============================================================================
 
-static FILE *ofp = NULL;
+static unsigned int getWallMilliseconds(void)
+{
+#ifdef _WIN32
+	return GetTickCount();
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (unsigned int)(tv.tv_sec * 1000 + tv.tv_usec / 1000);
+#endif
+}
 
-void dumpQueued(void);
+//=============================================================================
+
+static FILE *ofp = NULL;
 
 static void outputLine(const char *line)
 {
-	dumpQueued();
-	//cout << line << endl;
 	if (ofp)
 	{
 		fputs(line, ofp);
@@ -97,11 +100,10 @@ static void outputLine(const char *line)
 
 //=============================================================================
 
-static void outputLine(int frame, int index, int linkNum,
+static void outputLine(int linkNum,
 											 const char *class1, const char *line1,
 											 const char *class2, const char *line2, bool same = false)
 {
-	dumpQueued();
 	if (!line1)
 		line1 = "&nbsp;";
 	if (!line2)
@@ -133,7 +135,6 @@ static void outputLine(int frame, int index, int linkNum,
 	e.expand(tableRow, out);
 	const char *buf = out.c_str();
 
-	//cout << buf << endl;
 	if (ofp)
 	{
 		fputs(buf, ofp);
@@ -142,227 +143,511 @@ static void outputLine(int frame, int index, int linkNum,
 
 //=============================================================================
 
-std::list<std::string> queuedLines;
-static void queueLine(int frame, int index, const char *line1)
+class DiffReport
 {
-	if (!line1)
-		line1 = "&nbsp;";
-
-	Expander e("((", "))");
-	e.addExpansion("LEFTCLASS", "leftHistory");
-	e.addExpansion("LEFTLINE", line1);
-	e.addExpansion("RIGHTCLASS", "rightHistory");
-	e.addExpansion("RIGHTLINE", line1);
-	e.addExpansion("NAME", "");
-	e.addExpansion("PREV", intToString(0));
-	e.addExpansion("NEXT", intToString(1));
-
-	std::string out;
-	e.expand(tableRow, out);
-
-	queuedLines.push_back(out);
-	if (queuedLines.size() > 150)
-		queuedLines.pop_front();
-
-	//cout << buf << endl;
-}
-
-void dumpQueued(void)
+public:
+	virtual ~DiffReport() {}
+
+	virtual void begin(void) {}
+	virtual void context(const LogLine& line, bool history) = 0;
+	virtual void differ(const LogLine& left, const LogLine& right) = 0;
+	virtual void leftOnly(const LogLine& left) = 0;
+	virtual void rightOnly(const LogLine& right) = 0;
+	virtual void skipped(unsigned int count) = 0;
+	virtual void end(void) {}
+};
+
+// Unified diff style report: ' ' matching, '-' left, '+' right.
+class TextDiffReport : public DiffReport
 {
-	while (!queuedLines.empty())
+public:
+	TextDiffReport(const char *leftName, const char *rightName) : m_leftName(leftName), m_rightName(rightName) {}
+
+	virtual void begin(void)
 	{
-		std::list<std::string>::iterator it = queuedLines.begin();
-		const char *buf = (*it).c_str();
-		//cout << buf << endl;
-		if (ofp)
-		{
-			fputs(buf, ofp);
-		}
+		fprintf(ofp, "--- %s\n+++ %s\n", m_leftName, m_rightName);
+	}
+	virtual void context(const LogLine& line, bool history)
+	{
+		writeLine(' ', line);
+	}
+	virtual void differ(const LogLine& left, const LogLine& right)
+	{
+		writeLine('-', left);
+		writeLine('+', right);
+	}
+	virtual void leftOnly(const LogLine& left)
+	{
+		writeLine('-', left);
+	}
+	virtual void rightOnly(const LogLine& right)
+	{
+		writeLine('+', right);
+	}
+	virtual void skipped(unsigned int count)
+	{
+		fprintf(ofp, "... %u matching lines\n", count);
+	}
 
-		queuedLines.pop_front();
+protected:
+	void writeLine(char prefix, const LogLine& line)
+	{
+		fputc(prefix, ofp);
+		fwrite(line.text, 1, line.length, ofp);
+		fputc('\n', ofp);
 	}
-}
 
-//=============================================================================
+	const char *m_leftName;
+	const char *m_rightName;
+};
 
-int main(int argc, char *argv[])
+// The original side by side HTML report built from the row template.
+class HtmlDiffReport : public DiffReport
 {
-	atexit(exitWait);
-	const char *inFname[2];
-	const char *outFname = "out.html";
-	FILE *ifp[2] = {NULL, NULL};
-	std::string header, footer;
-
-	if (argc != 7)
-	{
-		cout << "Usage: munkeeDiff top.html row.html bottom.html in1.txt in2.txt out.txt" << endl;
-		header = readInFile("top.html");
-		tableRow = readInFile("row.html");
-		footer = readInFile("bottom.html");
-		inFname[0] = "test1.txt";
-		inFname[1] = "test2.txt";
-		//return 0;
+public:
+	HtmlDiffReport(const std::string& header, const std::string& footer) : m_header(header), m_footer(footer), m_linkNum(1) {}
+
+	virtual void begin(void)
+	{
+		outputLine(m_header.c_str());
 	}
-	else
+	virtual void context(const LogLine& line, bool history)
 	{
-		header = readInFile(argv[1]);
-		tableRow = readInFile(argv[2]);
-		footer = readInFile(argv[3]);
-		inFname[0] = argv[4];
-		inFname[1] = argv[5];
-		outFname = argv[6];
+		std::string text(line.text, line.length);
+		if (history)
+			outputLine(0, "leftHistory", text.c_str(), "rightHistory", text.c_str(), true);
+		else
+			outputLine(m_linkNum, "leftSame", text.c_str(), "rightSame", text.c_str(), true);
 	}
-
-	ifp[0] = fopen(inFname[0], "rt");
-	if (!ifp[0])
+	virtual void differ(const LogLine& left, const LogLine& right)
+	{
+		std::string leftText(left.text, left.length);
+		std::string rightText(right.text, right.length);
+		outputLine(m_linkNum++, "leftDiff", leftText.c_str(), "rightDiff", rightText.c_str());
+	}
+	virtual void leftOnly(const LogLine& left)
+	{
+		std::string text(left.text, left.length);
+		outputLine(m_linkNum++, "leftOnly", text.c_str(), NULL, NULL);
+	}
+	virtual void rightOnly(const LogLine& right)
 	{
-		cout << "could not open " << inFname[0] << endl;
-		return 1;
+		std::string text(right.text, right.length);
+		outputLine(m_linkNum++, NULL, NULL, "rightOnly", text.c_str());
 	}
-	ifp[1] = fopen(inFname[1], "rt");
-	if (!ifp[1])
+	virtual void skipped(unsigned int count)
 	{
-		fclose(ifp[0]);
-		cout << "could not open " << inFname[1] << endl;
-		return 1;
+		std::string text = "... " + intToString((int)count) + " matching lines";
+		outputLine(m_linkNum, "leftSame", text.c_str(), "rightSame", text.c_str(), true);
+	}
+	virtual void end(void)
+	{
+		Expander e("((", "))");
+		e.addExpansion("LAST", intToString(m_linkNum-1));
+		e.addExpansion("BOTTOM", intToString(m_linkNum));
+		std::string out;
+		e.expand(m_footer, out);
+		outputLine(out.c_str());
 	}
 
-	ofp = fopen(outFname, "wt");
+protected:
+	std::string m_header;
+	std::string m_footer;
+	int m_linkNum;
+};
 
-	char lastLine[2][LINESIZE];
-	int lastFrame[2] = {-1, -1};
-	int lastIndex[2] = {-1, -1};
-	bool fileOk[2] = {true, true};
+//=============================================================================
 
-	outputLine(header.c_str());
+struct DiffOptions
+{
+	int maxDiffs;		///< stop after this many mismatching entries
+	int context;		///< matching lines shown before the first and after each mismatch
+	int threads;		///< workers used to index each log
+};
 
-	int linkNum = 1;
-	int numDiffs = 0;
+static int compareKeys(const LogLine& a, const LogLine& b)
+{
+	if (a.frame != b.frame)
+		return a.frame < b.frame ? -1 : 1;
+	if (a.index != b.index)
+		return a.index < b.index ? -1 : 1;
+	return 0;
+}
+
+static bool sameText(const LogLine& a, const LogLine& b)
+{
+	return a.length == b.length && memcmp(a.text, b.text, a.length) == 0;
+}
+
+// Do two index entries of the same frame contain a "frame:index" line with different text?
+// Lines present on only one side don't count, just like they didn't in the original diff.
+static bool framesDiffer(const MappedFile files[2], MappedView& leftView, MappedView& rightView,
+	const FrameEntry& left, const FrameEntry& right)
+{
+	// Byte identical frames are by far the common case, compare them in bulk.
+	if (left.end - left.begin == right.end - right.begin)
+	{
+		FileOffset remaining = left.end - left.begin;
+		FileOffset done = 0;
+		bool same = true;
+		while (same && remaining > 0)
+		{
+			size_t want = remaining > (FileOffset)LINESIZE * 1024 ? LINESIZE * 1024 : (size_t)remaining;
+			size_t leftAvailable, rightAvailable;
+			const char *l = leftView.map(left.begin + done, want, leftAvailable);
+			const char *r = rightView.map(right.begin + done, want, rightAvailable);
+			if (!l || !r || leftAvailable < want || rightAvailable < want)
+			{
+				same = false;
+				break;
+			}
+			same = (memcmp(l, r, want) == 0);
+			done += want;
+			remaining -= want;
+		}
+		if (same)
+			return false;
+	}
 
-	bool seenRight = false;
-	bool seenLeft = false;
+	LogReader leftReader(files[0], left.begin, left.end);
+	LogReader rightReader(files[1], right.begin, right.end);
+	LogLine l, r;
+	bool haveLeft = leftReader.next(l);
+	bool haveRight = rightReader.next(r);
+	while (haveLeft && haveRight)
+	{
+		int cmp = compareKeys(l, r);
+		if (cmp < 0)
+			haveLeft = leftReader.next(l);
+		else if (cmp > 0)
+			haveRight = rightReader.next(r);
+		else
+		{
+			if (!sameText(l, r))
+				return true;
+			haveLeft = leftReader.next(l);
+			haveRight = rightReader.next(r);
+		}
+	}
+	return false;
+}
 
-	while (fileOk[0] || fileOk[1])
+// Walks both frame indices in step and returns the positions of the first frame that differs.
+static bool findFirstDivergentFrame(const MappedFile files[2], const FrameIndex index[2], size_t& leftPos, size_t& rightPos)
+{
+	MappedView leftView(files[0]);
+	MappedView rightView(files[1]);
+	size_t a = 0, b = 0;
+	while (a < index[0].size() && b < index[1].size())
 	{
-		for (int i=0; i<2; ++i)
+		const FrameEntry& left = index[0][a];
+		const FrameEntry& right = index[1][b];
+		if (left.frame < right.frame)
+			++a;
+		else if (right.frame < left.frame)
+			++b;
+		else
 		{
-			if (fileOk[i] == true && lastFrame[i] < 0)
+			if (framesDiffer(files, leftView, rightView, left, right))
 			{
-				fileOk[i] = getNextLine(ifp[i], lastLine[i],
-					lastFrame[i], lastIndex[i]);
+				leftPos = a;
+				rightPos = b;
+				return true;
 			}
+			++a;
+			++b;
 		}
+	}
+	return false;
+}
+
+struct HistoryLine
+{
+	int frame;
+	int index;
+	std::string text;
+};
+
+// Merges the logs from the given offsets and reports mismatches. Matching lines before the
+// first mismatch are kept in a ring of 'context' lines, so memory stays bounded.
+static int reportDiffs(const MappedFile files[2], FileOffset leftBegin, FileOffset rightBegin,
+	const DiffOptions& options, DiffReport& report)
+{
+	LogReader leftReader(files[0], leftBegin, files[0].size());
+	LogReader rightReader(files[1], rightBegin, files[1].size());
+
+	std::vector<HistoryLine> history(options.context > 0 ? options.context : 1);
+	size_t historyCount = 0;
+	size_t historyNext = 0;
 
-		if (fileOk[0] && fileOk[1])
+	LogLine l, r;
+	bool haveLeft = leftReader.next(l);
+	bool haveRight = rightReader.next(r);
+	bool diverged = false;
+	int numDiffs = 0;
+	int trailing = 0;
+	unsigned int skipped = 0;
+
+	while (haveLeft || haveRight)
+	{
+		int cmp;
+		if (haveLeft && haveRight)
+			cmp = compareKeys(l, r);
+		else
+			cmp = haveLeft ? -1 : 1;
+
+		if (cmp == 0 && sameText(l, r))
 		{
-			if (lastFrame[0] < lastFrame[1] ||
-				(lastFrame[0]==lastFrame[1] && lastIndex[0] < lastIndex[1]))
+			if (!diverged)
 			{
-				//if (!seenLeft)
-					//cout << "Seen left on " << lastFrame[0] << ":" << lastIndex[0] << endl;
-				//seenLeft = true;
-				if (seenRight && seenLeft)
+				if (options.context > 0)
 				{
-					outputLine(lastFrame[0], lastIndex[0], linkNum++,
-						"leftOnly", lastLine[0], NULL, NULL);
-					++numDiffs;
+					HistoryLine& h = history[historyNext];
+					h.frame = l.frame;
+					h.index = l.index;
+					h.text.assign(l.text, l.length);
+					historyNext = (historyNext + 1) % history.size();
+					if (historyCount < history.size())
+						++historyCount;
 				}
-				lastFrame[0] = -1;
 			}
-			else if (lastFrame[1] < lastFrame[0] ||
-				(lastFrame[1]==lastFrame[0] && lastIndex[1] < lastIndex[0]))
+			else if (trailing > 0)
 			{
-				//if (!seenRight)
-					//cout << "Seen right on " << lastFrame[1] << ":" << lastIndex[1] << endl;
-				//seenRight = true;
-				if (seenRight && seenLeft)
+				if (skipped)
 				{
-					outputLine(lastFrame[1], lastIndex[1], linkNum++,
-						NULL, NULL, "rightOnly", lastLine[1]);
-					++numDiffs;
+					report.skipped(skipped);
+					skipped = 0;
 				}
-				lastFrame[1] = -1;
+				report.context(l, false);
+				--trailing;
 			}
 			else
 			{
-				int res = strcmp(lastLine[0], lastLine[1]);
-				if (res!=0)
-				{
-					if (!seenLeft || !seenRight)
-						cout << "Seen both on " << lastFrame[0] << ":" << lastIndex[0] << endl;
-					seenLeft = seenRight = true;
-					outputLine(lastFrame[0], lastIndex[0], linkNum++,
-						"leftDiff", lastLine[0], "rightDiff", lastLine[1]);
-					++numDiffs;
-				}
-				else
-				{
-					//if (!seenLeft || !seenRight)
-					//	cout << "Seen both on " << lastFrame[0] << ":" << lastIndex[0] << endl;
-					//seenLeft = seenRight = true;
-					static bool printedFirst = false;
-					if (!printedFirst)
-					{
-						outputLine(lastFrame[0], lastIndex[0], linkNum,
-							"leftSame", lastLine[0], "rightSame", lastLine[1], true);
-						printedFirst = true;
-					}
-					else if (seenLeft && seenRight)
-					{
-						outputLine(lastFrame[0], lastIndex[0], linkNum,
-							"leftSame", lastLine[0], "rightSame", lastLine[1], true);
-						++numDiffs;
-					}
-					else
-						queueLine(lastFrame[0], lastIndex[0], lastLine[0]);
-					//++numDiffs;
-				}
-				lastFrame[0] = -1;
-				lastFrame[1] = -1;
+				++skipped;
 			}
+			haveLeft = leftReader.next(l);
+			haveRight = rightReader.next(r);
 		}
-		else if (fileOk[0])
+		else if (cmp == 0 || diverged)
 		{
-			//if (!seenLeft)
-				//cout << "Seen left on " << lastFrame[0] << ":" << lastIndex[0] << endl;
-			//seenLeft = true;
-			if (seenRight && seenLeft)
+			if (!diverged)
+			{
+				diverged = true;
+				cout << "First mismatch at " << l.frame << ":" << l.index << endl;
+
+				size_t first = (historyNext + history.size() - historyCount) % history.size();
+				for (size_t i = 0; i < historyCount; ++i)
+				{
+					const HistoryLine& h = history[(first + i) % history.size()];
+					LogLine line;
+					line.frame = h.frame;
+					line.index = h.index;
+					line.text = h.text.c_str();
+					line.length = h.text.length();
+					line.offset = 0;
+					report.context(line, true);
+				}
+			}
+
+			if (skipped)
+			{
+				report.skipped(skipped);
+				skipped = 0;
+			}
+
+			if (cmp == 0)
 			{
-				outputLine(lastFrame[0], lastIndex[0], linkNum++,
-					"leftOnly", lastLine[0], NULL, NULL);
-				++numDiffs;
+				report.differ(l, r);
+				haveLeft = leftReader.next(l);
+				haveRight = rightReader.next(r);
 			}
-			lastFrame[0] = -1;
+			else if (cmp < 0)
+			{
+				report.leftOnly(l);
+				haveLeft = leftReader.next(l);
+			}
+			else
+			{
+				report.rightOnly(r);
+				haveRight = rightReader.next(r);
+			}
+			++numDiffs;
+			trailing = options.context;
+		}
+		else
+		{
+			// Lines on one side only don't count until the logs have disagreed on a line.
+			if (cmp < 0)
+				haveLeft = leftReader.next(l);
+			else
+				haveRight = rightReader.next(r);
+		}
+
+		if (numDiffs >= options.maxDiffs && trailing == 0)
+		{
+			cout << "Stopped after " << numDiffs << " mismatches" << endl;
+			break;
 		}
-		else if (fileOk[1])
+	}
+
+	return numDiffs;
+}
+
+//=============================================================================
+
+static void usage(void)
+{
+	cout << "Usage: crcdiff [options] in1.txt in2.txt" << endl;
+	cout << "  -n <count>        report the first <count> mismatching entries (default 20)" << endl;
+	cout << "  -context <lines>  matching lines shown around mismatches (default 10)" << endl;
+	cout << "  -threads <count>  workers used to index each log (default: one per core)" << endl;
+	cout << "  -o <file>         write the report to <file> instead of the console" << endl;
+	cout << "  -html <top.html> <row.html> <bottom.html>  write the report as HTML" << endl;
+	cout << "   or: crcdiff top.html row.html bottom.html in1.txt in2.txt out.html" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *inFname[2] = {NULL, NULL};
+	const char *outFname = NULL;
+	const char *templateFname[3] = {NULL, NULL, NULL};
+	bool html = false;
+
+	DiffOptions options;
+	options.maxDiffs = 20;
+	options.context = 10;
+	options.threads = getDefaultThreadCount();
+
+	if (argc == 7 && argv[1][0] != '-')
+	{
+		// The original interface, a full HTML report
+		atexit(exitWait);
+		html = true;
+		templateFname[0] = argv[1];
+		templateFname[1] = argv[2];
+		templateFname[2] = argv[3];
+		inFname[0] = argv[4];
+		inFname[1] = argv[5];
+		outFname = argv[6];
+		options.maxDiffs = 1000;
+		options.context = 150;
+	}
+	else
+	{
+		int numInputs = 0;
+		for (int i = 1; i < argc; ++i)
 		{
-			//if (!seenRight)
-				//cout << "Seen right on " << lastFrame[1] << ":" << lastIndex[1] << endl;
-			//seenRight = true;
-			if (seenRight && seenLeft)
+			if (!strcmp(argv[i], "-n") && i+1 < argc)
+				options.maxDiffs = atoi(argv[++i]);
+			else if (!strcmp(argv[i], "-context") && i+1 < argc)
+				options.context = atoi(argv[++i]);
+			else if (!strcmp(argv[i], "-threads") && i+1 < argc)
+				options.threads = atoi(argv[++i]);
+			else if (!strcmp(argv[i], "-o") && i+1 < argc)
+				outFname = argv[++i];
+			else if (!strcmp(argv[i], "-html") && i+3 < argc)
 			{
-				outputLine(lastFrame[1], lastIndex[1], linkNum++,
-					NULL, NULL, "rightOnly", lastLine[1]);
-				++numDiffs;
+				html = true;
+				templateFname[0] = argv[++i];
+				templateFname[1] = argv[++i];
+				templateFname[2] = argv[++i];
 			}
-			lastFrame[1] = -1;
+			else if (argv[i][0] != '-' && numInputs < 2)
+				inFname[numInputs++] = argv[i];
+			else
+			{
+				usage();
+				return 1;
+			}
+		}
+		if (numInputs != 2)
+		{
+			usage();
+			return 1;
 		}
+		if (options.maxDiffs < 1)
+			options.maxDiffs = 1;
+		if (options.context < 0)
+			options.context = 0;
+		if (html && !outFname)
+			outFname = "out.html";
+	}
 
-		if (numDiffs > 1000)
-			break;
+	MappedFile files[2];
+	for (int i = 0; i < 2; ++i)
+	{
+		if (!files[i].open(inFname[i]))
+		{
+			cout << "could not open " << inFname[i] << endl;
+			return 1;
+		}
 	}
 
-	Expander e("((", "))");
-	e.addExpansion("LAST", intToString(linkNum-1));
-	e.addExpansion("BOTTOM", intToString(linkNum));
-	std::string out;
-	e.expand(footer, out);
-	outputLine(out.c_str());
+	unsigned int startTime = getWallMilliseconds();
+	FrameIndex index[2];
+	buildFrameIndex(files[0], options.threads, index[0]);
+	buildFrameIndex(files[1], options.threads, index[1]);
+	unsigned int indexTime = getWallMilliseconds();
+	cout << "Indexed " << (int)index[0].size() << " and " << (int)index[1].size() << " frames in "
+		<< (int)(indexTime - startTime) << " ms" << endl;
 
-	if (ofp)
+	size_t leftPos = 0, rightPos = 0;
+	if (!findFirstDivergentFrame(files, index, leftPos, rightPos))
+	{
+		cout << "No mismatches found in " << (int)(getWallMilliseconds() - startTime) << " ms" << endl;
+		return 0;
+	}
+
+	// Back up whole frames until there are enough lines before the mismatch for the context.
+	size_t contextPos = leftPos;
+	unsigned int contextLines = 0;
+	while (contextPos > 0 && contextLines < (unsigned int)options.context)
+	{
+		--contextPos;
+		contextLines += index[0][contextPos].lineCount;
+	}
+	int contextFrame = index[0][contextPos].frame;
+	while (rightPos > 0 && index[1][rightPos-1].frame >= contextFrame)
+		--rightPos;
+
+	if (outFname)
+	{
+		ofp = fopen(outFname, html ? "wt" : "w");
+		if (!ofp)
+		{
+			cout << "could not open " << outFname << endl;
+			return 1;
+		}
+	}
+	else
+	{
+		ofp = stdout;
+	}
+
+	DiffReport *report;
+	if (html)
+	{
+		std::string header = readInFile(templateFname[0]);
+		tableRow = readInFile(templateFname[1]);
+		std::string footer = readInFile(templateFname[2]);
+		report = new HtmlDiffReport(header, footer);
+	}
+	else
+	{
+		report = new TextDiffReport(inFname[0], inFname[1]);
+	}
+
+	report->begin();
+	int numDiffs = reportDiffs(files, index[0][contextPos].begin, index[1][rightPos].begin, options, *report);
+	report->end();
+	delete report;
+
+	if (ofp != stdout)
 	{
 		fclose(ofp);
 	}
+	ofp = NULL;
 
-	return 0;
+	cout << numDiffs << " mismatches reported in " << (int)(getWallMilliseconds() - startTime) << " ms" << endl;
+	return numDiffs ? 2 : 0;
 }
@@ -0,0 +1,320 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ---------------------------------------------------------------------------
+// File: LogIndex.cpp
+// Description: Streaming reader and frame boundary index for CRC logs
+// ---------------------------------------------------------------------------
+
+#include "LogIndex.h"
+#include "debug.h"
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+//=============================================================================
+
+enum
+{
+	LINE_LOOKAHEAD = 4096,					///< bytes requested per line, grown for longer lines
+	MIN_CHUNK_SIZE = 1024 * 1024,		///< don't bother splitting the log finer than this
+	MAX_INDEX_THREADS = 32,
+};
+
+//=============================================================================
+
+static inline bool isSpace( char c )
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+static bool parseInt( const char *& p, const char *end, int& val )
+{
+	while (p < end && isSpace(*p))
+		++p;
+
+	bool neg = false;
+	if (p < end && (*p == '-' || *p == '+'))
+	{
+		neg = (*p == '-');
+		++p;
+	}
+
+	if (p >= end || *p < '0' || *p > '9')
+		return false;
+
+	int v = 0;
+	while (p < end && *p >= '0' && *p <= '9')
+	{
+		v = v * 10 + (*p - '0');
+		++p;
+	}
+	val = neg ? -v : v;
+	return true;
+}
+
+bool parseFrameIndex( const char *text, size_t length, int& frame, int& index )
+{
+	const char *p = text;
+	const char *end = text + length;
+
+	if (!parseInt(p, end, frame))
+		return false;
+	if (p >= end || *p != ':')
+		return false;
+	++p;
+	return parseInt(p, end, index);
+}
+
+//=============================================================================
+
+LogReader::LogReader( const MappedFile& file, FileOffset begin, FileOffset end ) :
+	m_file(file), m_view(file), m_pos(begin), m_end(end)
+{
+	if (m_end > m_file.size())
+		m_end = m_file.size();
+}
+
+void LogReader::alignToLineStart( void )
+{
+	if (m_pos == 0 || m_pos >= m_end)
+		return;
+
+	// The start is a line start if the byte before it ends a line.
+	FileOffset pos = m_pos - 1;
+	size_t available;
+	const char *p = m_view.map(pos, LINE_LOOKAHEAD, available);
+	while (p)
+	{
+		const char *nl = (const char *)memchr(p, '\n', available);
+		if (nl)
+		{
+			m_pos = pos + (nl - p) + 1;
+			return;
+		}
+		pos += available;
+		p = m_view.map(pos, LINE_LOOKAHEAD, available);
+	}
+	m_pos = m_file.size();
+}
+
+bool LogReader::nextRawLine( const char *& text, size_t& length, FileOffset& lineStart )
+{
+	if (m_pos >= m_end)
+		return false;
+
+	size_t want = LINE_LOOKAHEAD;
+	for (;;)
+	{
+		size_t available;
+		const char *p = m_view.map(m_pos, want, available);
+		if (!p)
+			return false;
+
+		const char *nl = (const char *)memchr(p, '\n', available);
+		bool atEof = (m_pos + available >= m_file.size());
+		if (nl || atEof)
+		{
+			size_t len = nl ? (size_t)(nl - p) : available;
+			text = p;
+			lineStart = m_pos;
+			m_pos += len + (nl ? 1 : 0);
+
+			// Match the text mode reads of the original tool.
+			if (len > 0 && p[len-1] == '\r')
+				--len;
+			length = len;
+			return true;
+		}
+
+		// Very long line that runs past the end of the current view, map more of it.
+		want = available * 2;
+	}
+}
+
+bool LogReader::next( LogLine& line )
+{
+	const char *text;
+	size_t length;
+	FileOffset lineStart;
+
+	while (nextRawLine(text, length, lineStart))
+	{
+		if (parseFrameIndex(text, length, line.frame, line.index))
+		{
+			line.text = text;
+			line.length = length;
+			line.offset = lineStart;
+			return true;
+		}
+	}
+	return false;
+}
+
+//=============================================================================
+
+int getDefaultThreadCount( void )
+{
+	int count;
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo( &info );
+	count = (int)info.dwNumberOfProcessors;
+#else
+	count = (int)sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+	if (count < 1)
+		count = 1;
+	if (count > MAX_INDEX_THREADS)
+		count = MAX_INDEX_THREADS;
+	return count;
+}
+
+//=============================================================================
+
+struct IndexJob
+{
+	const MappedFile *file;
+	FileOffset begin;
+	FileOffset end;
+	FrameIndex result;
+};
+
+static void indexChunk( IndexJob *job )
+{
+	LogReader reader(*job->file, job->begin, job->end);
+	reader.alignToLineStart();
+
+	LogLine line;
+	while (reader.next(line))
+	{
+		FileOffset lineEnd = reader.tell();
+		if (job->result.empty() || job->result.back().frame != line.frame)
+		{
+			FrameEntry entry;
+			entry.frame = line.frame;
+			entry.begin = line.offset;
+			entry.end = lineEnd;
+			entry.lineCount = 1;
+			job->result.push_back(entry);
+		}
+		else
+		{
+			FrameEntry& entry = job->result.back();
+			entry.end = lineEnd;
+			++entry.lineCount;
+		}
+	}
+}
+
+#ifdef _WIN32
+static DWORD WINAPI indexChunkThread( LPVOID param )
+{
+	indexChunk( (IndexJob *)param );
+	return 0;
+}
+#else
+static void *indexChunkThread( void *param )
+{
+	indexChunk( (IndexJob *)param );
+	return NULL;
+}
+#endif
+
+void buildFrameIndex( const MappedFile& file, int numThreads, FrameIndex& index )
+{
+	index.clear();
+
+	if (numThreads < 1)
+		numThreads = 1;
+	if (numThreads > MAX_INDEX_THREADS)
+		numThreads = MAX_INDEX_THREADS;
+
+	FileOffset size = file.size();
+	FileOffset chunkSize = size / numThreads + 1;
+	if (chunkSize < MIN_CHUNK_SIZE)
+		chunkSize = MIN_CHUNK_SIZE;
+
+	int numJobs = (int)((size + chunkSize - 1) / chunkSize);
+	if (numJobs < 1)
+		numJobs = 1;
+
+	std::vector<IndexJob> jobs(numJobs);
+	int i;
+	for (i = 0; i < numJobs; ++i)
+	{
+		jobs[i].file = &file;
+		jobs[i].begin = chunkSize * i;
+		jobs[i].end = (i == numJobs - 1) ? size : chunkSize * (i + 1);
+	}
+
+	// The calling thread takes the first chunk itself.
+#ifdef _WIN32
+	std::vector<HANDLE> threads;
+	for (i = 1; i < numJobs; ++i)
+	{
+		HANDLE h = CreateThread( NULL, 0, indexChunkThread, &jobs[i], 0, NULL );
+		if (h)
+			threads.push_back(h);
+		else
+			indexChunk(&jobs[i]);
+	}
+	indexChunk(&jobs[0]);
+	for (i = 0; i < (int)threads.size(); ++i)
+	{
+		WaitForSingleObject( threads[i], INFINITE );
+		CloseHandle( threads[i] );
+	}
+#else
+	std::vector<pthread_t> threads;
+	for (i = 1; i < numJobs; ++i)
+	{
+		pthread_t t;
+		if (pthread_create( &t, NULL, indexChunkThread, &jobs[i] ) == 0)
+			threads.push_back(t);
+		else
+			indexChunk(&jobs[i]);
+	}
+	indexChunk(&jobs[0]);
+	for (i = 0; i < (int)threads.size(); ++i)
+		pthread_join( threads[i], NULL );
+#endif
+
+	// Stitch the chunks together, a frame can straddle a chunk boundary.
+	for (i = 0; i < numJobs; ++i)
+	{
+		const FrameIndex& chunk = jobs[i].result;
+		for (size_t j = 0; j < chunk.size(); ++j)
+		{
+			if (!index.empty() && index.back().frame == chunk[j].frame)
+			{
+				index.back().end = chunk[j].end;
+				index.back().lineCount += chunk[j].lineCount;
+			}
+			else
+			{
+				index.push_back(chunk[j]);
+			}
+		}
+	}
+
+	DEBUG_LOG(("Indexed %d frames using %d chunks", (int)index.size(), numJobs));
+}
@@ -0,0 +1,78 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ---------------------------------------------------------------------------
+// File: LogIndex.h
+// Description: Streaming reader and frame boundary index for CRC logs
+// ---------------------------------------------------------------------------
+
+#pragma once
+
+#include "MappedFile.h"
+#include <vector>
+
+// Parses the "frame:index " prefix of a CRC log line, the same lines sscanf("%d:%d ") accepts.
+bool parseFrameIndex( const char *text, size_t length, int& frame, int& index );
+
+struct LogLine
+{
+	int frame;
+	int index;
+	const char *text;		///< not terminated, valid until the next call to LogReader::next
+	size_t length;			///< without the line end
+	FileOffset offset;	///< of the line start
+};
+
+// Walks the "frame:index" lines of a log between two offsets, other lines are skipped.
+class LogReader
+{
+public:
+	LogReader( const MappedFile& file, FileOffset begin, FileOffset end );
+
+	// Moves the start forward to the beginning of the next line, unless it already is one.
+	void alignToLineStart( void );
+
+	bool next( LogLine& line );
+
+	FileOffset tell( void ) const { return m_pos; }
+
+protected:
+	bool nextRawLine( const char *& text, size_t& length, FileOffset& lineStart );
+
+	const MappedFile& m_file;
+	MappedView m_view;
+	FileOffset m_pos;
+	FileOffset m_end;
+};
+
+// One entry per run of lines with the same frame number.
+struct FrameEntry
+{
+	int frame;
+	FileOffset begin;				///< start of the first line of the frame
+	FileOffset end;					///< end of the last line of the frame, including its line end
+	unsigned int lineCount;	///< number of "frame:index" lines in the frame
+};
+
+typedef std::vector<FrameEntry> FrameIndex;
+
+int getDefaultThreadCount( void );
+
+// Builds the frame index of a whole log, splitting the file into line aligned chunks
+// that are scanned by 'numThreads' workers and merged in file order.
+void buildFrameIndex( const MappedFile& file, int numThreads, FrameIndex& index );
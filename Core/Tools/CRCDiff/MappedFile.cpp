@@ -0,0 +1,201 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ---------------------------------------------------------------------------
+// File: MappedFile.cpp
+// Description: Read only memory mapped file with sliding views
+// ---------------------------------------------------------------------------
+
+#include "MappedFile.h"
+#include "debug.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//=============================================================================
+
+static size_t getMapGranularity( void )
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo( &info );
+	return info.dwAllocationGranularity;
+#else
+	return (size_t)sysconf( _SC_PAGESIZE );
+#endif
+}
+
+//=============================================================================
+
+MappedFile::MappedFile( void ) : m_isOpen(false), m_size(0)
+{
+#ifdef _WIN32
+	m_file = INVALID_HANDLE_VALUE;
+	m_mapping = NULL;
+#else
+	m_fd = -1;
+#endif
+}
+
+MappedFile::~MappedFile( void )
+{
+	close();
+}
+
+bool MappedFile::open( const char *fname )
+{
+	close();
+
+#ifdef _WIN32
+	m_file = CreateFile( fname, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+	if (m_file == INVALID_HANDLE_VALUE)
+		return false;
+
+	DWORD sizeHigh = 0;
+	DWORD sizeLow = GetFileSize( m_file, &sizeHigh );
+	m_size = ((FileOffset)sizeHigh << 32) | sizeLow;
+
+	// Empty files cannot be mapped, but they are still valid (empty) logs.
+	if (m_size > 0)
+	{
+		m_mapping = CreateFileMapping( m_file, NULL, PAGE_READONLY, 0, 0, NULL );
+		if (m_mapping == NULL)
+		{
+			close();
+			return false;
+		}
+	}
+#else
+	m_fd = ::open( fname, O_RDONLY );
+	if (m_fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat( m_fd, &st ) != 0)
+	{
+		close();
+		return false;
+	}
+	m_size = (FileOffset)st.st_size;
+#endif
+
+	m_isOpen = true;
+	DEBUG_LOG(("Mapped %s (%u MB)", fname, (unsigned int)(m_size / (1024*1024))));
+	return true;
+}
+
+void MappedFile::close( void )
+{
+#ifdef _WIN32
+	if (m_mapping != NULL)
+	{
+		CloseHandle( m_mapping );
+		m_mapping = NULL;
+	}
+	if (m_file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle( m_file );
+		m_file = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (m_fd >= 0)
+	{
+		::close( m_fd );
+		m_fd = -1;
+	}
+#endif
+	m_isOpen = false;
+	m_size = 0;
+}
+
+//=============================================================================
+
+MappedView::MappedView( const MappedFile& file, size_t windowSize ) :
+	m_file(file), m_windowSize(windowSize), m_viewOffset(0), m_viewLength(0), m_view(NULL)
+{
+}
+
+MappedView::~MappedView( void )
+{
+	unmap();
+}
+
+void MappedView::unmap( void )
+{
+	if (m_view)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile( m_view );
+#else
+		munmap( m_view, m_viewLength );
+#endif
+		m_view = NULL;
+	}
+	m_viewOffset = 0;
+	m_viewLength = 0;
+}
+
+const char *MappedView::map( FileOffset offset, size_t length, size_t& available )
+{
+	available = 0;
+	if (!m_file.isOpen() || offset >= m_file.size())
+		return NULL;
+
+	if (offset + length > m_file.size())
+		length = (size_t)(m_file.size() - offset);
+
+	// Reuse the current window if it already covers the request.
+	if (m_view && offset >= m_viewOffset && offset + length <= m_viewOffset + m_viewLength)
+	{
+		available = (size_t)(m_viewOffset + m_viewLength - offset);
+		return m_view + (size_t)(offset - m_viewOffset);
+	}
+
+	unmap();
+
+	static size_t granularity = getMapGranularity();
+	FileOffset viewOffset = offset - (offset % granularity);
+	size_t lead = (size_t)(offset - viewOffset);
+	size_t viewLength = m_windowSize;
+	if (viewLength < lead + length)
+		viewLength = lead + length;
+	if (viewOffset + viewLength > m_file.size())
+		viewLength = (size_t)(m_file.size() - viewOffset);
+
+#ifdef _WIN32
+	m_view = (char *)MapViewOfFile( m_file.m_mapping, FILE_MAP_READ,
+		(DWORD)(viewOffset >> 32), (DWORD)(viewOffset & 0xffffffff), viewLength );
+#else
+	void *view = mmap( NULL, viewLength, PROT_READ, MAP_SHARED, m_file.m_fd, (off_t)viewOffset );
+	m_view = (view == MAP_FAILED) ? NULL : (char *)view;
+	if (m_view)
+		madvise( m_view, viewLength, MADV_SEQUENTIAL );
+#endif
+	if (!m_view)
+		return NULL;
+
+	m_viewOffset = viewOffset;
+	m_viewLength = viewLength;
+	available = viewLength - lead;
+	return m_view + lead;
+}
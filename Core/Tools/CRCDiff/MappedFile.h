@@ -0,0 +1,90 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 TheSuperHackers
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ---------------------------------------------------------------------------
+// File: MappedFile.h
+// Description: Read only memory mapped file with sliding views, so logs
+//              larger than the address space can be walked in 32 bit builds
+// ---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Utility/stdint_adapter.h>
+#include <stddef.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+typedef uint64_t FileOffset;
+
+class MappedFile
+{
+public:
+	MappedFile( void );
+	~MappedFile( void );
+
+	bool open( const char *fname );
+	void close( void );
+
+	bool isOpen( void ) const { return m_isOpen; }
+	FileOffset size( void ) const { return m_size; }
+
+protected:
+	friend class MappedView;
+
+	bool m_isOpen;
+	FileOffset m_size;
+#ifdef _WIN32
+	HANDLE m_file;
+	HANDLE m_mapping;
+#else
+	int m_fd;
+#endif
+
+private:
+	MappedFile( const MappedFile& );
+	MappedFile& operator=( const MappedFile& );
+};
+
+// A window onto a MappedFile. Each thread walking the file uses its own view.
+class MappedView
+{
+public:
+	enum { DEFAULT_WINDOW_SIZE = 32 * 1024 * 1024 };
+
+	MappedView( const MappedFile& file, size_t windowSize = DEFAULT_WINDOW_SIZE );
+	~MappedView( void );
+
+	// Returns a pointer to at least 'length' bytes at 'offset', clamped to the end of the
+	// file. 'available' receives how many bytes can be read from the returned pointer.
+	const char *map( FileOffset offset, size_t length, size_t& available );
+
+protected:
+	void unmap( void );
+
+	const MappedFile& m_file;
+	size_t m_windowSize;
+	FileOffset m_viewOffset;
+	size_t m_viewLength;
+	char *m_view;
+
+private:
+	MappedView( const MappedView& );
+	MappedView& operator=( const MappedView& );
+};
@@ -71,6 +71,12 @@ public:
 		GAP_METHOD_GUTTER			= 0x00000002,  ///< put transparent gutter on right and bottom side of image
 	};
 
+	enum
+	{
+		PACK_METHOD_CANVAS		= 0,  ///< slide images across a per pixel canvas (original method)
+		PACK_METHOD_MAXRECTS	= 1,  ///< best short side fit into maximal free rectangles
+	};
+
 public:
 
 	ImagePacker( void );
@@ -79,6 +85,8 @@ public:
 	Bool init( void );  ///< initialize the system
 	Bool process( void );  ///< run the process
 	Bool getSettingsFromDialog( HWND dialog );  ///< get the options for exection
+	Bool getSettingsFromCommandLine( char *cmdLine );  ///< get the options for batch execution
+	Bool isBatchMode( void );  ///< running headless from the command line
 
 	void setWindowHandle( HWND hWnd );  ///< set window handle for 'dialog' app
 	HWND getWindowHandle( void );  ///< get window handle for 'dialog' app
@@ -122,6 +130,9 @@ public:
 	void setCompressTextures( Bool compress );  ///< set compress textures option
 	Bool getCompressTextures( void );  ///< get compress textures option
 
+	void setPackMethod( UnsignedInt method );  ///< set the packing method
+	UnsignedInt getPackMethod( void );  ///< get the packing method
+
 protected:
 
 	void setTargetSize( Int width, Int height );  ///< set the size of the output target image
@@ -135,6 +146,9 @@ protected:
 	void addImage( char *path );  ///< add image to image list
 	Bool validateImages( void );  ///< validate that the loaded images can all be processed
 	Bool packImages( void );  ///< do the packing
+	void resetImagePlacement( void );  ///< clear the packing results of all images
+	Real getFillRatio( void );  ///< ratio of image pixels to texture page pixels
+	void reportPackingStats( void );  ///< status message with page count, fill ratio and pack time
 	void writeFinalTextures( void );  ///< write the packed textures
 
 	Bool generateINIFile( void );  ///< generate the INI file for this image set
@@ -170,6 +184,12 @@ protected:
 	Targa *m_targa;  ///< targa for loading file headers
 	Bool m_compressTextures;  ///< compress the final textures
 
+	UnsignedInt m_packMethod;  ///< method used to fit images on texture pages
+	Bool m_comparePackMethods;  ///< also pack with the other method and report both
+	Bool m_batchMode;  ///< running from the command line without the dialog
+	Bool m_cleanOutput;  ///< batch mode may delete the files already in the output directory
+	double m_packTimeMS;  ///< time spent fitting images in the last pack
+
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -201,6 +221,9 @@ inline char *ImagePacker::getOutputFile( void ) { return m_outputFile; }
 inline char *ImagePacker::getOutputDirectory( void ) { return m_outputDirectory; }
 inline void ImagePacker::setCompressTextures( Bool compress ) { m_compressTextures = compress; }
 inline Bool ImagePacker::getCompressTextures( void ) { return m_compressTextures; }
+inline void ImagePacker::setPackMethod( UnsignedInt method ) { m_packMethod = method; }
+inline UnsignedInt ImagePacker::getPackMethod( void ) { return m_packMethod; }
+inline Bool ImagePacker::isBatchMode( void ) { return m_batchMode; }
 inline void ImagePacker::setGapMethod( UnsignedInt methodBit ) { BitSet( m_gapMethod, methodBit ); }
 inline void ImagePacker::clearGapMethod( UnsignedInt methodBit ) { BitClear( m_gapMethod, methodBit ); }
 inline UnsignedInt ImagePacker::getGapMethod( void ) { return m_gapMethod; }
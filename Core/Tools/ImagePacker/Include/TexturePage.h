@@ -42,6 +42,7 @@
 
 // SYSTEM INCLUDES ////////////////////////////////////////////////////////////
 #include <stdlib.h>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 // USER INCLUDES //////////////////////////////////////////////////////////////
@@ -106,6 +107,9 @@ public:
 
 protected:
 
+	Bool addImageCanvas( ImageInfo *image );  ///< fit image by probing canvas pixels
+	Bool addImageMaxRects( ImageInfo *image );  ///< fit image into the best free rectangle
+
 	Bool spotUsed( Int x, Int y );  ///< is this spot used
 	Bool lineUsed( Int sx, Int sy, Int ex, Int ey );  ///< is any spot on the line used
 
@@ -116,7 +120,20 @@ protected:
 															Int *xGutter, Int *yGutter,
 															Bool allSidesBorder );
 
+	/// build a fit region at the location, shrinking gutters that run off the page edge
+	UnsignedInt buildPageFitRegion( IRegion2D *region,
+																	Int startX, Int startY,
+																	Int imageWidth, Int imageHeight,
+																	Int *xGutter, Int *yGutter,
+																	Bool useGutter, Bool allSidesBorder );
+
+	/// record the image as placed in the region on this page
+	void placeImage( ImageInfo *image, IRegion2D *region, UnsignedInt fitBits,
+									 Int xGutter, Int yGutter, Bool rotated );
+
 	void markRegionUsed( IRegion2D *region );  ///< mark this region as used
+	void splitFreeRects( const IRegion2D *used );  ///< carve used region out of free rect list
+	void pruneFreeRects( void );  ///< remove free rects contained in other free rects
 
 	/// add the actual image data of 'image' to the destination buffer
 	Bool addImageData( Byte *destBuffer,
@@ -148,6 +165,7 @@ protected:
 	UnsignedByte *m_canvas;  ///< as big as the texture page, a used spot is non zero
 
 	ImageInfo *m_imageList;  ///< list of images packed on this page
+	std::vector< IRegion2D > m_freeRects;  ///< maximal free rectangles for MaxRects packing
 
 	Byte *m_packedImage;  ///< final generated image data
 	Targa *m_targa;  ///< final packed image all in a nice little targa file
@@ -71,6 +71,102 @@ ImagePacker *TheImagePacker = NULL;
 // PRIVATE FUNCTIONS //////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+// nextCommandLineToken ======================================================
+/** Return the next whitespace separated token from the command line,
+	* double quotes group a token containing spaces.  The command line is
+	* modified in place, 'cursor' is advanced past the token returned */
+//=============================================================================
+static char *nextCommandLineToken( char **cursor )
+{
+	char *c = *cursor;
+	char *token;
+
+	// skip leading whitespace
+	while( *c == ' ' || *c == '\t' )
+		c++;
+
+	if( *c == '\0' )
+	{
+
+		*cursor = c;
+		return NULL;
+
+	}
+
+	if( *c == '"' )
+	{
+
+		// quoted token runs to the closing quote
+		token = ++c;
+		while( *c != '\0' && *c != '"' )
+			c++;
+
+	}
+	else
+	{
+
+		token = c;
+		while( *c != '\0' && *c != ' ' && *c != '\t' )
+			c++;
+
+	}
+
+	if( *c != '\0' )
+		*c++ = '\0';
+
+	*cursor = c;
+	return token;
+
+}
+
+// hasCommandLineArgument =====================================================
+/** Return TRUE when one of the arguments of the command line is exactly
+	* 'argument'.  The command line is not modified */
+//=============================================================================
+static Bool hasCommandLineArgument( const char *cmdLine, const char *argument )
+{
+
+	// tokenizing writes into the string, so work on a copy
+	char *copy = new char[ strlen( cmdLine ) + 1 ];
+	strcpy( copy, cmdLine );
+
+	Bool found = FALSE;
+	char *token;
+	char *cursor = copy;
+	while( found == FALSE && (token = nextCommandLineToken( &cursor )) != NULL )
+		if( stricmp( token, argument ) == 0 )
+			found = TRUE;
+
+	delete [] copy;
+	return found;
+
+}
+
+// attachConsole ==============================================================
+/** The packer is a windows application, so it has no console of its own.
+	* Batch builds report through printf and are usually started by a script,
+	* so use the console of the parent process, or open a new one when there
+	* is none.  AttachConsole is looked up at runtime because older SDKs do
+	* not declare it */
+//=============================================================================
+static void attachConsole( void )
+{
+	typedef BOOL (WINAPI *AttachConsoleFunc)( DWORD processId );
+	const DWORD ATTACH_TO_PARENT_PROCESS = (DWORD)-1;
+
+	Bool attached = FALSE;
+	HMODULE kernel = GetModuleHandle( "kernel32.dll" );
+	AttachConsoleFunc attachConsoleFunc = kernel ? (AttachConsoleFunc)GetProcAddress( kernel, "AttachConsole" ) : NULL;
+	if( attachConsoleFunc != NULL && attachConsoleFunc( ATTACH_TO_PARENT_PROCESS ) )
+		attached = TRUE;
+	if( attached == FALSE && AllocConsole() == FALSE )
+		return;
+
+	freopen( "CONOUT$", "w", stdout );
+	freopen( "CONOUT$", "w", stderr );
+
+}
+
 // ImagePacker::createNewTexturePage ==========================================
 /** Create a new texture page and add to the list */
 //=============================================================================
@@ -177,10 +273,34 @@ Bool ImagePacker::validateImages( void )
 	if( errors == TRUE )
 	{
 
-		proceed = DialogBox( ApplicationHInstance,
-												 (LPCTSTR)IMAGE_ERRORS,
-												 TheImagePacker->getWindowHandle(),
-												 (DLGPROC)ImageErrorProc );
+		if( m_batchMode )
+		{
+
+			// there is nobody to ask, list the images and skip them
+			for( i = 0; i < m_imageCount; i++ )
+			{
+
+				image = m_imageList[ i ];
+				if( image == NULL || BitIsSet( image->m_status, ImageInfo::CANTPROCESS ) == FALSE )
+					continue;
+
+				sprintf( m_statusBuffer, "Skipping image '%s': %s.", image->m_path,
+								 BitIsSet( image->m_status, ImageInfo::TOOBIG ) ?
+									"too big for the target page size" : "unsupported color depth" );
+				statusMessage( m_statusBuffer );
+
+			}
+
+		}
+		else
+		{
+
+			proceed = DialogBox( ApplicationHInstance,
+													 (LPCTSTR)IMAGE_ERRORS,
+													 TheImagePacker->getWindowHandle(),
+													 (DLGPROC)ImageErrorProc );
+
+		}
 
 	}
 
@@ -213,13 +333,23 @@ Bool ImagePacker::packImages( void )
 
 	}
 
+	// time just the fitting, not the user responding to the dialogs above
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency( &frequency );
+	QueryPerformanceCounter( &start );
+
 	// loop through all images
 	for( i = 0; i < m_imageCount; i++ )
 	{
 
 		// update status
-		sprintf( m_statusBuffer, "Fitting Image %d of %d.", i, m_imageCount );
-		statusMessage( m_statusBuffer );
+		if( m_batchMode == FALSE )
+		{
+
+			sprintf( m_statusBuffer, "Fitting Image %d of %d.", i, m_imageCount );
+			statusMessage( m_statusBuffer );
+
+		}
 
 		// get this image out of the list
 		image = m_imageList[ i ];
@@ -252,7 +382,10 @@ Bool ImagePacker::packImages( void )
 
 				sprintf( buffer, "Unable to add image '%s' to a brand new page!\n", image->m_path );
 				DEBUG_ASSERTCRASH( 0, (buffer) );
-				MessageBox( NULL, buffer, "Internal Error", MB_OK | MB_ICONERROR );
+				if( m_batchMode )
+					statusMessage( buffer );
+				else
+					MessageBox( NULL, buffer, "Internal Error", MB_OK | MB_ICONERROR );
 				return FALSE;
 
 			}
@@ -261,10 +394,84 @@ Bool ImagePacker::packImages( void )
 
 	}
 
+	QueryPerformanceCounter( &end );
+	m_packTimeMS = (double)(end.QuadPart - start.QuadPart) * 1000.0 / (double)frequency.QuadPart;
+
 	return TRUE;  // success
 
 }
 
+// ImagePacker::resetImagePlacement ===========================================
+/** Clear the results of packing from all the images in the image list so
+	* they can be packed again from scratch */
+//=============================================================================
+void ImagePacker::resetImagePlacement( void )
+{
+	UnsignedInt i;
+	ImageInfo *image;
+
+	for( i = 0; i < m_imageCount; i++ )
+	{
+
+		image = m_imageList[ i ];
+		if( image == NULL )
+			continue;
+
+		BitClear( image->m_status, ImageInfo::PACKED );
+		BitClear( image->m_status, ImageInfo::ROTATED90C );
+		if( BitIsSet( image->m_status, ImageInfo::CANTPROCESS ) == FALSE )
+			BitSet( image->m_status, ImageInfo::UNPACKED );
+		image->m_page = NULL;
+		image->m_nextPageImage = NULL;
+		image->m_prevPageImage = NULL;
+		image->m_fitBits = 0;
+		image->m_gutterUsed.x = 0;
+		image->m_gutterUsed.y = 0;
+
+	}
+
+}
+
+// ImagePacker::getFillRatio ==================================================
+/** How much of the generated texture pages is covered by actual image
+	* pixels, gutters and borders count as wasted space */
+//=============================================================================
+Real ImagePacker::getFillRatio( void )
+{
+	TexturePage *page;
+	ImageInfo *image;
+	double imagePixels = 0.0;
+	double pagePixels = 0.0;
+
+	for( page = m_pageList; page; page = page->m_next )
+	{
+
+		pagePixels += (double)page->getWidth() * (double)page->getHeight();
+		for( image = page->getFirstImage(); image; image = image->m_nextPageImage )
+			imagePixels += (double)image->m_area;
+
+	}
+
+	if( pagePixels == 0.0 )
+		return 0.0f;
+
+	return (Real)(imagePixels / pagePixels);
+
+}
+
+// ImagePacker::reportPackingStats ============================================
+/** Status message describing the result of the last pack */
+//=============================================================================
+void ImagePacker::reportPackingStats( void )
+{
+
+	sprintf( m_statusBuffer, "%s: '%d' Texture Pages, %.1f%% Fill, %.1f ms",
+					 m_packMethod == PACK_METHOD_CANVAS ? "Canvas" : "MaxRects",
+					 m_pageCount, getFillRatio() * 100.0f, m_packTimeMS );
+	statusMessage( m_statusBuffer );
+
+}
+
 // ImagePacker::writeFinalTextures ============================================
 /** Generate and write the final textures to the output directory
 	* of the packed images along with a definition file for which images
@@ -315,10 +522,32 @@ void ImagePacker::writeFinalTextures( void )
 	if( errors == TRUE )
 	{
 
-		DialogBox( ApplicationHInstance,
-							 (LPCTSTR)PAGE_ERRORS,
-							 TheImagePacker->getWindowHandle(),
-							 (DLGPROC)PageErrorProc );
+		if( m_batchMode )
+		{
+
+			for( page = m_pageTail; page; page = page->m_prev )
+			{
+
+				if( BitIsSet( page->m_status, TexturePage::PAGE_ERROR ) )
+				{
+
+					sprintf( buffer, "Error generating or writing texture page #%d.", page->getID() );
+					statusMessage( buffer );
+
+				}
+
+			}
+
+		}
+		else
+		{
+
+			DialogBox( ApplicationHInstance,
+								 (LPCTSTR)PAGE_ERRORS,
+								 TheImagePacker->getWindowHandle(),
+								 (DLGPROC)PageErrorProc );
+
+		}
 
 	}
 
@@ -502,15 +731,38 @@ Bool ImagePacker::checkOutputDirectory( void )
 		char buffer[ 256 ];
 		Int response;
 
-		sprintf( buffer, "The output directory (%s) must be empty before proceeding.  Delete '%d' files and continue with build process?",
-						 m_outputDirectory, fileCount );
-		response = MessageBox( NULL, buffer,
-													 "Delete files to continue?",
-													 MB_YESNO | MB_ICONWARNING );
+		if( m_batchMode )
+		{
 
-		// if they said no, do not delete the files and abort the pack process
-		if( response == IDNO )
-			return FALSE;
+			// never delete files without being asked to, there is nobody to confirm it
+			if( m_cleanOutput == FALSE )
+			{
+
+				sprintf( m_statusBuffer, "The output directory (%s) contains '%d' files, use -clean to delete them.",
+								 m_outputDirectory, fileCount );
+				statusMessage( m_statusBuffer );
+				return FALSE;
+
+			}
+
+			sprintf( buffer, "Deleting '%d' files from the output directory.", fileCount );
+			statusMessage( buffer );
+
+		}
+		else
+		{
+
+			sprintf( buffer, "The output directory (%s) must be empty before proceeding.  Delete '%d' files and continue with build process?",
+							 m_outputDirectory, fileCount );
+			response = MessageBox( NULL, buffer,
+														 "Delete files to continue?",
+														 MB_YESNO | MB_ICONWARNING );
+
+			// if they said no, do not delete the files and abort the pack process
+			if( response == IDNO )
+				return FALSE;
+
+		}
 
 		//
 		// they said yes, delete all the files in the output directory
@@ -677,8 +929,13 @@ void ImagePacker::addDirectory( char *path, Bool subDirs )
 	m_dirCount++;
 
 	// update status
-	sprintf( m_statusBuffer, "Folder Added: %d.", m_dirCount );
-	statusMessage( m_statusBuffer );
+	if( m_batchMode == FALSE )
+	{
+
+		sprintf( m_statusBuffer, "Folder Added: %d.", m_dirCount );
+		statusMessage( m_statusBuffer );
+
+	}
 
 	// count how many image files are in this directory
 	hFile = FindFirstFile( "*", &item);
@@ -850,9 +1107,14 @@ void ImagePacker::addImage( char *path )
 	m_imageList[ m_imageCount++ ] = info;
 
 	// update status
-	sprintf( m_statusBuffer, "Loading Image %d of %d.",
-					 m_imageCount, m_imagesInDirs );
-	statusMessage( m_statusBuffer );
+	if( m_batchMode == FALSE )
+	{
+
+		sprintf( m_statusBuffer, "Loading Image %d of %d.",
+						 m_imageCount, m_imagesInDirs );
+		statusMessage( m_statusBuffer );
+
+	}
 
 }
 
@@ -874,7 +1136,10 @@ Bool ImagePacker::generateINIFile( void )
 		char buffer[ _MAX_PATH + 64 ];
 
 		sprintf( buffer, "Cannot open INI file '%s' for writing.", filename );
-		MessageBox( NULL, buffer, "Error Opening File", MB_OK | MB_ICONERROR );
+		if( m_batchMode )
+			statusMessage( buffer );
+		else
+			MessageBox( NULL, buffer, "Error Opening File", MB_OK | MB_ICONERROR );
 		return FALSE;
 
 	}
@@ -1089,6 +1354,174 @@ Bool ImagePacker::getSettingsFromDialog( HWND dialog )
 
 }
 
+// ImagePacker::getSettingsFromCommandLine ====================================
+/** Get the settings for a batch run from the command line, this is the
+	* headless equivalent of getSettingsFromDialog.  When the command line
+	* does not contain -batch nothing is done and the dialog is used instead.
+	*
+	* -batch               run without the dialog
+	* -dir <path>          image folder to pack, may be given more than once
+	* -out <name>          output name for the texture pages and INI file
+	* -size <n>            power of 2 target texture page size
+	* -gutter <n>          use a transparent gutter of n pixels
+	* -noextend            do not extend image edges into a border
+	* -nosubdirs           do not pack images in sub folders
+	* -noalpha             output texture pages without alpha
+	* -noini               do not generate the INI file
+	* -compress            compress the output texture pages
+	* -canvas              pack with the original canvas method instead of MaxRects
+	* -compare             also pack with the other method and report both
+	* -clean               delete the files already in the output directory
+	*/
+//=============================================================================
+Bool ImagePacker::getSettingsFromCommandLine( char *cmdLine )
+{
+
+	// sanity
+	if( cmdLine == NULL || hasCommandLineArgument( cmdLine, "-batch" ) == FALSE )
+		return FALSE;
+
+	m_batchMode = TRUE;
+	attachConsole();
+
+	// batch builds pack with MaxRects unless -canvas is given, the dialog keeps the canvas
+	setPackMethod( PACK_METHOD_MAXRECTS );
+
+	const Int MAX_BATCH_DIRS = 64;
+	char *dirs[ MAX_BATCH_DIRS ];
+	Int dirCount = 0;
+	Bool success = TRUE;
+	char *token;
+	char *cursor = cmdLine;
+
+	strcpy( m_outputFile, "" );
+	while( (token = nextCommandLineToken( &cursor )) != NULL )
+	{
+
+		if( stricmp( token, "-batch" ) == 0 )
+			continue;
+		else if( stricmp( token, "-dir" ) == 0 )
+		{
+
+			token = nextCommandLineToken( &cursor );
+			if( token && dirCount < MAX_BATCH_DIRS )
+				dirs[ dirCount++ ] = token;
+
+		}
+		else if( stricmp( token, "-out" ) == 0 )
+		{
+
+			token = nextCommandLineToken( &cursor );
+			if( token )
+				strlcpy( m_outputFile, token, MAX_OUTPUT_FILE_LEN );
+
+		}
+		else if( stricmp( token, "-size" ) == 0 )
+		{
+
+			token = nextCommandLineToken( &cursor );
+			Int size = token ? atoi( token ) : 0;
+
+			// the target size must be a power of 2
+			if( size <= 0 || (size & (size - 1)) != 0 )
+			{
+
+				statusMessage( "The target image size must be a power of 2." );
+				success = FALSE;
+
+			}
+			else
+				setTargetSize( size, size );
+
+		}
+		else if( stricmp( token, "-gutter" ) == 0 )
+		{
+
+			token = nextCommandLineToken( &cursor );
+			Int gutter = token ? atoi( token ) : 0;
+			if( gutter < 0 )
+				gutter = 0;
+			setGutter( gutter );
+			setGapMethod( GAP_METHOD_GUTTER );
+
+		}
+		else if( stricmp( token, "-noextend" ) == 0 )
+			clearGapMethod( GAP_METHOD_EXTEND_RGB );
+		else if( stricmp( token, "-nosubdirs" ) == 0 )
+			m_useSubFolders = FALSE;
+		else if( stricmp( token, "-noalpha" ) == 0 )
+			setOutputAlpha( FALSE );
+		else if( stricmp( token, "-noini" ) == 0 )
+			setINICreate( FALSE );
+		else if( stricmp( token, "-compress" ) == 0 )
+			setCompressTextures( TRUE );
+		else if( stricmp( token, "-canvas" ) == 0 )
+			setPackMethod( PACK_METHOD_CANVAS );
+		else if( stricmp( token, "-compare" ) == 0 )
+			m_comparePackMethods = TRUE;
+		else if( stricmp( token, "-clean" ) == 0 )
+			m_cleanOutput = TRUE;
+		else
+		{
+
+			sprintf( m_statusBuffer, "Unknown command line option '%s'.", token );
+			statusMessage( m_statusBuffer );
+			success = FALSE;
+
+		}
+
+	}
+
+	if( strlen( m_outputFile ) == 0 )
+	{
+
+		statusMessage( "No output name given, use -out <name>." );
+		success = FALSE;
+
+	}
+	if( dirCount == 0 )
+	{
+
+		statusMessage( "No image folders given, use -dir <path>." );
+		success = FALSE;
+
+	}
+	if( success == FALSE )
+		return FALSE;
+
+	// clear our list of image directories
+	resetImageDirectoryList();
+
+	//
+	// the image folders are walked by changing into them, so they must be
+	// absolute paths and end in a separator just like the dialog gives us
+	//
+	Int i;
+	char path[ _MAX_PATH ];
+	for( i = 0; i < dirCount; i++ )
+	{
+
+		if( GetFullPathName( dirs[ i ], _MAX_PATH - 1, path, NULL ) == 0 )
+		{
+
+			sprintf( m_statusBuffer, "Invalid image folder '%s'.", dirs[ i ] );
+			statusMessage( m_statusBuffer );
+			return FALSE;
+
+		}
+
+		Int len = strlen( path );
+		if( len > 0 && path[ len - 1 ] != '\\' )
+			strlcat( path, "\\", ARRAY_SIZE( path ) );
+
+		addDirectory( path, m_useSubFolders );
+
+	}
+
+	return TRUE;
+
+}
+
 // ImagePacker::ImagePacker ===================================================
 /** */
 //=============================================================================
@@ -1121,6 +1554,11 @@ ImagePacker::ImagePacker( void )
 
 	m_targa = NULL;
 	m_compressTextures = FALSE;
+	m_packMethod = PACK_METHOD_CANVAS;
+	m_comparePackMethods = FALSE;
+	m_batchMode = FALSE;
+	m_cleanOutput = FALSE;
+	m_packTimeMS = 0.0;
 
 }
 
@@ -1168,6 +1606,16 @@ Bool ImagePacker::init( void )
 void ImagePacker::statusMessage( const char *message )
 {
 
+	// there is no dialog in batch mode, status goes to the console instead
+	if( m_batchMode )
+	{
+
+		printf( "%s\n", message );
+		fflush( stdout );
+		return;
+
+	}
+
 	SetDlgItemText( getWindowHandle(), STATIC_STATUS, message );
 
 }
@@ -1219,10 +1667,36 @@ Bool ImagePacker::process( void )
 	// sort the images with the largest biggest images at the top of the list
 	sortImageList();
 
+	//
+	// when comparing packing methods, pack everything with the other method
+	// first and report how it did, then throw those pages away
+	//
+	if( m_comparePackMethods )
+	{
+		UnsignedInt packMethod = m_packMethod;
+
+		if( packMethod == PACK_METHOD_CANVAS )
+			m_packMethod = PACK_METHOD_MAXRECTS;
+		else
+			m_packMethod = PACK_METHOD_CANVAS;
+
+		if( packImages() )
+			reportPackingStats();
+
+		resetPageList();
+		resetImagePlacement();
+		m_packMethod = packMethod;
+
+	}
+
 	// pack all images
-	if( packImages() )
+	Bool packed = packImages();
+	if( packed )
 	{
 
+		if( m_comparePackMethods )
+			reportPackingStats();
+
 		// generate the actual final textures and write them out to the file
 		writeFinalTextures();
 
@@ -1234,13 +1708,14 @@ Bool ImagePacker::process( void )
 		UpdatePreviewWindow();
 
 		// all done
-		sprintf( m_statusBuffer, "Image Packing Complete: '%d' Texture Pages Generated from '%d' Images in '%d' Folder(s)",
-						 m_pageCount, m_imageCount, m_dirCount );
+		sprintf( m_statusBuffer, "Image Packing Complete: '%d' Texture Pages Generated from '%d' Images in '%d' Folder(s), %.1f%% Fill in %.1f ms",
+						 m_pageCount, m_imageCount, m_dirCount,
+						 getFillRatio() * 100.0f, m_packTimeMS );
 		statusMessage( m_statusBuffer );
 
 	}
 
-	return TRUE;
+	return packed;
 
 }
 
@@ -841,66 +841,267 @@ UnsignedInt TexturePage::buildFitRegion( IRegion2D *region,
 
 }
 
-///////////////////////////////////////////////////////////////////////////////
-// PUBLIC FUNCTIONS ///////////////////////////////////////////////////////////
-///////////////////////////////////////////////////////////////////////////////
+// TexturePage::placeImage ====================================================
+/** Record that 'image' has been fit on this page in 'region', the region
+	* includes any gutters and borders described by 'fitBits' */
+//=============================================================================
+void TexturePage::placeImage( ImageInfo *image, IRegion2D *region,
+															UnsignedInt fitBits,
+															Int xGutter, Int yGutter,
+															Bool rotated )
+{
 
-// TexturePage::TexturePage ===================================================
-/** */
-//============================================================================
-TexturePage::TexturePage( Int width, Int height )
+	BitClear( image->m_status, ImageInfo::TOOBIG );
+	BitClear( image->m_status, ImageInfo::UNPACKED );
+	BitSet( image->m_status, ImageInfo::PACKED );
+	image->m_page = this;
+
+	//
+	// store the properties of the region that was used to fit this
+	// image
+	//
+	image->m_fitBits = fitBits;
+
+	// store the gutter sizes used in fitting this image
+	image->m_gutterUsed.x = xGutter;
+	image->m_gutterUsed.y = yGutter;
+
+	//
+	// if we packed this image rotated, set a flag telling us we
+	// need to swap the size dimension in the image structure
+	// when copying the image data
+	//
+	if( rotated == TRUE )
+		BitSet( image->m_status, ImageInfo::ROTATED90C );
+
+	//
+	// save the page position of this image, but do not include
+	// the gutter or padding borders which is incorporated into the region,
+	// we're interested in just the bounding rectangle of the image itself
+	// on the texture page
+	//
+	image->m_pagePos = *region;
+	if( BitIsSet( fitBits, ImageInfo::FIT_XBORDER_LEFT ) )
+		image->m_pagePos.lo.x++;
+	if( BitIsSet( fitBits, ImageInfo::FIT_YBORDER_TOP ) )
+		image->m_pagePos.lo.y++;
+	if( BitIsSet( fitBits, ImageInfo::FIT_XBORDER_RIGHT ) )
+		image->m_pagePos.hi.x--;
+	if( BitIsSet( fitBits, ImageInfo::FIT_YBORDER_BOTTOM ) )
+		image->m_pagePos.hi.y--;
+	if( BitIsSet( fitBits, ImageInfo::FIT_XGUTTER ) )
+		image->m_pagePos.hi.x -= xGutter;
+	if( BitIsSet( fitBits, ImageInfo::FIT_YGUTTER ) )
+		image->m_pagePos.hi.y -= yGutter;
+
+	// link this image to the texture page
+	image->m_prevPageImage = NULL;
+	image->m_nextPageImage = m_imageList;
+	if( m_imageList )
+		m_imageList->m_prevPageImage = image;
+	m_imageList = image;
+
+}
+
+// TexturePage::buildPageFitRegion ============================================
+/** Build the fit region for an image at the location given using the
+	* gutter and border options of the packer.  If the gutter would run off
+	* the right or bottom edge of the page but the image itself would not, the
+	* gutter is shrunk to end at the page edge, that space is never sampled
+	* from anyway.  The region returned may still be off the page when the
+	* image does not fit at this location at all */
+//=============================================================================
+UnsignedInt TexturePage::buildPageFitRegion( IRegion2D *region,
+																						 Int startX, Int startY,
+																						 Int imageWidth, Int imageHeight,
+																						 Int *xGutter, Int *yGutter,
+																						 Bool useGutter, Bool allSidesBorder )
 {
-	Int canvasSize;
+	UnsignedInt fitBits;
 
-	m_id = -1;
-	m_next = NULL;
-	m_prev = NULL;
-	m_size.x = width;
-	m_size.y = height;
-	m_packedImage = NULL;
-	m_targa = NULL;
+	// get the gutter size
+	if( useGutter )
+	{
 
-	// create a "canvas" to represent used and unused areas
-	canvasSize = m_size.x * m_size.y;
-	m_canvas = new UnsignedByte[ canvasSize ];
-	DEBUG_ASSERTCRASH( m_canvas, ("Cannot allocate canvas for texture page") );
-	memset( m_canvas, FREE, sizeof( UnsignedByte ) * canvasSize );
+		*xGutter = TheImagePacker->getGutter();
+		*yGutter = TheImagePacker->getGutter();
+
+	}
+	else
+	{
+
+		*xGutter = 0;
+		*yGutter = 0;
+
+	}
+
+	fitBits = buildFitRegion( region, startX, startY, imageWidth, imageHeight,
+														xGutter, yGutter, allSidesBorder );
+
+	// shrink the x gutter to the page edge if that lets the image stay on the page
+	if( region->hi.x >= m_size.x )
+	{
+		Int overflow = region->hi.x - (m_size.x - 1);
+
+		if( overflow <= *xGutter )
+		{
+
+			*xGutter -= overflow;
+			fitBits = buildFitRegion( region, startX, startY, imageWidth, imageHeight,
+																xGutter, yGutter, allSidesBorder );
+
+		}
+
+	}
+
+	// shrink the y gutter to the page edge if that lets the image stay on the page
+	if( region->hi.y >= m_size.y )
+	{
+		Int overflow = region->hi.y - (m_size.y - 1);
+
+		if( overflow <= *yGutter )
+		{
+
+			*yGutter -= overflow;
+			fitBits = buildFitRegion( region, startX, startY, imageWidth, imageHeight,
+																xGutter, yGutter, allSidesBorder );
+
+		}
+
+	}
+
+	return fitBits;
 
 }
 
-// TexturePage::~TexturePage ==================================================
-/**  */
+// TexturePage::splitFreeRects ================================================
+/** Remove the used region from every free rectangle it overlaps.  Each
+	* overlapped free rectangle is replaced by up to four maximal rectangles
+	* made from the space left on each side of the used region */
 //=============================================================================
-TexturePage::~TexturePage( void )
+void TexturePage::splitFreeRects( const IRegion2D *used )
 {
+	std::vector< IRegion2D > result;
+	IRegion2D piece;
+	size_t i;
 
-	// delete the canvas
-	delete [] m_canvas;
+	result.reserve( m_freeRects.size() + 4 );
+	for( i = 0; i < m_freeRects.size(); i++ )
+	{
+		const IRegion2D &freeRect = m_freeRects[ i ];
 
-	// delete targa if present, this will NOT delete a user assigned image buffer
-	delete m_targa;
+		// keep free rects that the used region doesn't touch
+		if( used->lo.x > freeRect.hi.x || used->hi.x < freeRect.lo.x ||
+				used->lo.y > freeRect.hi.y || used->hi.y < freeRect.lo.y )
+		{
 
-	// delete the final image buffer if present
-	delete [] m_packedImage;
+			result.push_back( freeRect );
+			continue;
+
+		}
+
+		// space left of the used region
+		if( used->lo.x > freeRect.lo.x )
+		{
+
+			piece = freeRect;
+			piece.hi.x = used->lo.x - 1;
+			result.push_back( piece );
+
+		}
+
+		// space right of the used region
+		if( used->hi.x < freeRect.hi.x )
+		{
+
+			piece = freeRect;
+			piece.lo.x = used->hi.x + 1;
+			result.push_back( piece );
+
+		}
+
+		// space above the used region
+		if( used->lo.y > freeRect.lo.y )
+		{
+
+			piece = freeRect;
+			piece.hi.y = used->lo.y - 1;
+			result.push_back( piece );
+
+		}
+
+		// space below the used region
+		if( used->hi.y < freeRect.hi.y )
+		{
+
+			piece = freeRect;
+			piece.lo.y = used->hi.y + 1;
+			result.push_back( piece );
+
+		}
+
+	}
+
+	m_freeRects.swap( result );
 
 }
 
-// TexturePage::addImage ======================================================
-/** If this image will fit on this page, add it */
+// regionContains =============================================================
+/** Is region 'b' entirely inside region 'a' */
 //=============================================================================
-Bool TexturePage::addImage( ImageInfo *image )
+static Bool regionContains( const IRegion2D &a, const IRegion2D &b )
 {
-	IRegion2D region;
 
-	// santiy
-	if( image == NULL )
+	return b.lo.x >= a.lo.x && b.lo.y >= a.lo.y &&
+				 b.hi.x <= a.hi.x && b.hi.y <= a.hi.y;
+
+}
+
+// TexturePage::pruneFreeRects ================================================
+/** Remove any free rectangle that is fully contained by another one, they
+	* can never produce a better fit and only slow down the search */
+//=============================================================================
+void TexturePage::pruneFreeRects( void )
+{
+	Int i, j;
+
+	for( i = 0; i < (Int)m_freeRects.size(); i++ )
 	{
 
-		DEBUG_ASSERTCRASH( image, ("TexturePage::addImage: NULL image!") );
-		return TRUE;  // say it was added
+		for( j = i + 1; j < (Int)m_freeRects.size(); j++ )
+		{
+
+			if( regionContains( m_freeRects[ j ], m_freeRects[ i ] ) )
+			{
+
+				m_freeRects.erase( m_freeRects.begin() + i );
+				i--;
+				break;
+
+			}
+			if( regionContains( m_freeRects[ i ], m_freeRects[ j ] ) )
+			{
+
+				m_freeRects.erase( m_freeRects.begin() + j );
+				j--;
+
+			}
+
+		}
 
 	}
 
+}
+
+// TexturePage::addImageCanvas ================================================
+/** Try to fit the image by sliding a candidate region across the page canvas
+	* pixel by pixel until a spot is found where no used pixels are touched.
+	* This is the original packing method */
+//=============================================================================
+Bool TexturePage::addImageCanvas( ImageInfo *image )
+{
+	IRegion2D region;
+
 	// get our options for fitting
 	Bool useGutter, useRGBExtend;
 	useGutter = BitIsSet( TheImagePacker->getGapMethod(),
@@ -1103,57 +1304,100 @@ Bool TexturePage::addImage( ImageInfo *image )
 				// we passed all tests, take up this spot
 				//
 				markRegionUsed( &region );  // marks region AND gutter used
-				BitClear( image->m_status, ImageInfo::TOOBIG );
-				BitClear( image->m_status, ImageInfo::UNPACKED );
-				BitSet( image->m_status, ImageInfo::PACKED );
-				image->m_page = this;
+				placeImage( image, &region, fitBits, xGutter, yGutter, tryRotate );
 
-				//
-				// store the properties of the region that was used to fit this
-				// image
-				//
-				image->m_fitBits = fitBits;
+				return TRUE;  // success
 
-				// store the gutter sizes used in fitting this image
-				image->m_gutterUsed.x = xGutter;
-				image->m_gutterUsed.y = yGutter;
+			}
 
-				//
-				// if we packed this image rotated, set a flag telling us we
-				// need to swap the size dimension in the image structure
-				// when copying the image data
-				//
-				if( tryRotate == TRUE )
-					BitSet( image->m_status, ImageInfo::ROTATED90C );
+		}
 
-				//
-				// save the page position of this image, but do not include
-				// the gutter or padding borders which is incorporated into the region,
-				// we're interested in just the bounding rectangle of the image itself
-				// on the texture page
-				//
-				image->m_pagePos = region;
-				if( BitIsSet( fitBits, ImageInfo::FIT_XBORDER_LEFT ) )
-					image->m_pagePos.lo.x++;
-				if( BitIsSet( fitBits, ImageInfo::FIT_YBORDER_TOP ) )
-					image->m_pagePos.lo.y++;
-				if( BitIsSet( fitBits, ImageInfo::FIT_XBORDER_RIGHT ) )
-					image->m_pagePos.hi.x--;
-				if( BitIsSet( fitBits, ImageInfo::FIT_YBORDER_BOTTOM ) )
-					image->m_pagePos.hi.y--;
-				if( BitIsSet( fitBits, ImageInfo::FIT_XGUTTER ) )
-					image->m_pagePos.hi.x -= xGutter;
-				if( BitIsSet( fitBits, ImageInfo::FIT_YGUTTER ) )
-					image->m_pagePos.hi.y -= yGutter;
-
-				// link this image to the texture page
-				image->m_prevPageImage = NULL;
-				image->m_nextPageImage = m_imageList;
-				if( m_imageList )
-					m_imageList->m_prevPageImage = image;
-				m_imageList = image;
+	}
 
-				return TRUE;  // success
+	// no space
+	return FALSE;
+
+}
+
+// TexturePage::addImageMaxRects ==============================================
+/** Try to fit the image into the list of maximal free rectangles on this
+	* page.  Every free rectangle is tried with the image both normal and
+	* rotated 90 degrees clockwise and the placement that leaves the smallest
+	* short side leftover in its free rectangle wins (best short side fit) */
+//=============================================================================
+Bool TexturePage::addImageMaxRects( ImageInfo *image )
+{
+	Bool useGutter, useRGBExtend;
+	useGutter = BitIsSet( TheImagePacker->getGapMethod(),
+											 ImagePacker::GAP_METHOD_GUTTER );
+	useRGBExtend = BitIsSet( TheImagePacker->getGapMethod(),
+													ImagePacker::GAP_METHOD_EXTEND_RGB );
+
+	Bool found = FALSE;
+	IRegion2D bestRegion;
+	UnsignedInt bestFitBits = 0;
+	Int bestXGutter = 0, bestYGutter = 0;
+	Bool bestRotated = FALSE;
+	Int bestShortSide = 0, bestLongSide = 0;
+
+	size_t i;
+	for( i = 0; i < m_freeRects.size(); i++ )
+	{
+		const IRegion2D &freeRect = m_freeRects[ i ];
+
+		Int tries;
+		for( tries = 0; tries < 2; tries++ )
+		{
+			Bool tryRotate = (tries == 1);
+			Int imageWidth, imageHeight;
+
+			// a square image is the same both ways, don't bother rotating
+			if( tryRotate && image->m_size.x == image->m_size.y )
+				break;
+
+			if( tryRotate == FALSE )
+			{
+
+				imageWidth = image->m_size.x;
+				imageHeight = image->m_size.y;
+
+			}
+			else
+			{
+
+				imageWidth = image->m_size.y;
+				imageHeight = image->m_size.x;
+
+			}
+
+			IRegion2D region;
+			Int xGutter, yGutter;
+			UnsignedInt fitBits = buildPageFitRegion( &region, freeRect.lo.x, freeRect.lo.y,
+																								imageWidth, imageHeight,
+																								&xGutter, &yGutter,
+																								useGutter, useRGBExtend );
+
+			// the free rects are all on the page, so this also rejects off page regions
+			if( region.hi.x > freeRect.hi.x || region.hi.y > freeRect.hi.y )
+				continue;
+
+			Int leftoverX = freeRect.hi.x - region.hi.x;
+			Int leftoverY = freeRect.hi.y - region.hi.y;
+			Int shortSide = min( leftoverX, leftoverY );
+			Int longSide = max( leftoverX, leftoverY );
+
+			if( found == FALSE || shortSide < bestShortSide ||
+					(shortSide == bestShortSide && longSide < bestLongSide) )
+			{
+
+				found = TRUE;
+				bestRegion = region;
+				bestFitBits = fitBits;
+				bestXGutter = xGutter;
+				bestYGutter = yGutter;
+				bestRotated = tryRotate;
+				bestShortSide = shortSide;
+				bestLongSide = longSide;
 
 			}
 
@@ -1162,7 +1406,94 @@ Bool TexturePage::addImage( ImageInfo *image )
 	}
 
 	// no space
-	return FALSE;
+	if( found == FALSE )
+		return FALSE;
+
+	// take up the spot and carve it out of the free space
+	markRegionUsed( &bestRegion );  // marks region AND gutter used
+	splitFreeRects( &bestRegion );
+	pruneFreeRects();
+
+	placeImage( image, &bestRegion, bestFitBits, bestXGutter, bestYGutter, bestRotated );
+
+	return TRUE;  // success
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS ///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// TexturePage::TexturePage ===================================================
+/** */
+//============================================================================
+TexturePage::TexturePage( Int width, Int height )
+{
+	Int canvasSize;
+
+	m_id = -1;
+	m_next = NULL;
+	m_prev = NULL;
+	m_size.x = width;
+	m_size.y = height;
+	m_packedImage = NULL;
+	m_targa = NULL;
+	m_imageList = NULL;
+	m_status = 0;
+
+	// create a "canvas" to represent used and unused areas
+	canvasSize = m_size.x * m_size.y;
+	m_canvas = new UnsignedByte[ canvasSize ];
+	DEBUG_ASSERTCRASH( m_canvas, ("Cannot allocate canvas for texture page") );
+	memset( m_canvas, FREE, sizeof( UnsignedByte ) * canvasSize );
+
+	// the whole page starts out as one free rectangle
+	IRegion2D all;
+	all.lo.x = 0;
+	all.lo.y = 0;
+	all.hi.x = m_size.x - 1;
+	all.hi.y = m_size.y - 1;
+	m_freeRects.push_back( all );
+
+}
+
+// TexturePage::~TexturePage ==================================================
+/**  */
+//=============================================================================
+TexturePage::~TexturePage( void )
+{
+
+	// delete the canvas
+	delete [] m_canvas;
+
+	// delete targa if present, this will NOT delete a user assigned image buffer
+	delete m_targa;
+
+	// delete the final image buffer if present
+	delete [] m_packedImage;
+
+}
+
+// TexturePage::addImage ======================================================
+/** If this image will fit on this page, add it */
+//=============================================================================
+Bool TexturePage::addImage( ImageInfo *image )
+{
+
+	// santiy
+	if( image == NULL )
+	{
+
+		DEBUG_ASSERTCRASH( image, ("TexturePage::addImage: NULL image!") );
+		return TRUE;  // say it was added
+
+	}
+
+	// fit the image using the packing method selected
+	if( TheImagePacker->getPackMethod() == ImagePacker::PACK_METHOD_CANVAS )
+		return addImageCanvas( image );
+
+	return addImageMaxRects( image );
 
 }
 
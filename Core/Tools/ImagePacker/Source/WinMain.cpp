@@ -105,9 +105,22 @@ Int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
 
 	}
 
+	//
+	// run headless when the command line asks for a batch build, otherwise
 	// load the dialog box
-	DialogBox( hInstance, (LPCTSTR)IMAGE_PACKER_DIALOG,
-						 NULL, (DLGPROC)ImagePackerProc );
+	//
+	Int exitCode = 0;
+	Bool batchSettings = TheImagePacker->getSettingsFromCommandLine( lpCmdLine );
+	if( TheImagePacker->isBatchMode() )
+	{
+
+		if( batchSettings == FALSE || TheImagePacker->process() == FALSE )
+			exitCode = 1;
+
+	}
+	else
+		DialogBox( hInstance, (LPCTSTR)IMAGE_PACKER_DIALOG,
+							 NULL, (DLGPROC)ImagePackerProc );
 
 	// delete the image packer
 	delete TheImagePacker;
@@ -116,6 +129,6 @@ Int APIENTRY WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
 	shutdownMemoryManager();
 
 	// all done
-	return 0;
+	return exitCode;
 
 }
@@ -134,6 +134,7 @@ private:
 public: \
 	static Module* friend_newModuleInstance( Thing *thing, const ModuleData* moduleData ) { return newInstance( cls )( thing, moduleData ); } \
 	virtual NameKeyType getModuleNameKey() const { static NameKeyType nk = NAMEKEY(#cls); return nk; } \
+	virtual const char* getModuleName() const { return #cls; } \
 protected: \
 	virtual void crc( Xfer *xfer ); \
 	virtual void xfer( Xfer *xfer ); \
@@ -188,6 +189,7 @@ public:
 	static ModuleData* friend_newModuleData(INI* ini);
 
 	virtual NameKeyType getModuleNameKey() const = 0;
+	virtual const char* getModuleName() const = 0;		///< the class name, for the trace of -trace
 
 	inline NameKeyType getModuleTagNameKey() const { return getModuleData()->getModuleTagNameKey(); }
 
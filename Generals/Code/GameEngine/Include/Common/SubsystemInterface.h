@@ -31,6 +31,7 @@
 
 #include "Common/INI.h"
 #include "Common/STLTypedefs.h"
+#include "Common/Tracer.h"
 
 class Xfer;
 
@@ -124,8 +125,8 @@ protected:
 	Real m_startDrawTimeConsumed;
 	Real m_curDrawTime;
 #else
-	inline void UPDATE(void) {update();}
-	inline void DRAW(void) {draw();}
+	inline void UPDATE(void) {TRACE_SCOPE(m_name.str()); update();}
+	inline void DRAW(void) {TRACE_SCOPE(m_name.str()); draw();}
 #endif
 protected:
 	AsciiString m_name;
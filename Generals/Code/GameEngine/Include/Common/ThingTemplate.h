@@ -513,6 +513,9 @@ public:
 
 	void validate();
 
+	// Queue our sounds to be loaded by the audio device, once per game.
+	void prefetchAudio() const;
+
 // The version that does not take an Object argument is labeled friend for use by WorldBuilder.  All game requests
 // for CommandSet must use Object::getCommandSetString, as we have two different sources for dynamic answers.
 	const AsciiString& friend_getCommandSetString() const { return m_commandSetString; }
@@ -723,6 +726,7 @@ private:
 	Int						m_energyBonus;								///< how much extra Energy this produces due to the upgrade
 	Color					m_displayColor;								///< for the editor display color
 	UnsignedInt		m_occlusionDelay;							///< delay after object creation before building occlusion is allowed.
+	mutable UnsignedInt m_audioPrefetchGeneration;	///< TheAudio's prefetch generation when we last prefetched
 
 	// ---- Short-sized things
 	UnsignedShort		m_templateID;									///< id for net (etc.) transmission purposes
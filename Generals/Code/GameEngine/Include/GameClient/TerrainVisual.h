@@ -155,6 +155,9 @@ public:
 	//
 	virtual void setRawMapHeight(const ICoord2D *gridPos, Int height)=0;
 
+	/// Time the rebuild of the terrain render data and print it, for -benchmarkTerrainRebuild.
+	virtual void runRebuildBenchmark( Int repeats ) { }
+
 	/// Replace the skybox texture
 	virtual void replaceSkyboxTextures(const AsciiString *oldTexName[NumSkyboxTextures], const AsciiString *newTexName[NumSkyboxTextures])=0;
 
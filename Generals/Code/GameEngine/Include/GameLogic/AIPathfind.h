@@ -455,6 +455,8 @@ public:
 	~ZoneBlock();  // not virtual, please don't override without making virtual.  jba.
 
 	void blockCalculateZones(	PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds);	///< Does zone calculations.
+	void blockPrepareZones(PathfindCell **map, const IRegion2D &bounds);	///< Allocates the zone range of the block, first half of blockCalculateZones.
+	void blockResolveZones(PathfindCell **map, const IRegion2D &bounds);	///< Resolves the block zones, second half of blockCalculateZones.
 	zoneStorageType getEffectiveZone(LocomotorSurfaceTypeMask acceptableSurfaces, Bool crusher, zoneStorageType zone) const;
 
 	void clearMarkedPassable(void) {m_markedPassable = false;}
@@ -530,6 +532,9 @@ protected:
 	void allocateZones(void);
 	void freeZones(void);
 	void freeBlocks(void);
+	Bool floodZoneBlocks(PathfindCell **map, const IRegion2D &globalBounds, Int xCount, Int yCount,
+		zoneStorageType *zoneEquivalency, Int maxZones);	///< Parallel zone flood, returns false if the serial flood must be used.
+	void resolveZoneBlocks(PathfindCell **map, const IRegion2D &globalBounds, Int xCount, Int yCount);	///< Parallel block resolve.
 
 protected:
 	ZoneBlock			*m_blockOfZoneBlocks;			///< Zone blocks - Info for hierarchical pathfinding at a "blocky" level.
@@ -547,6 +552,64 @@ protected:
 	zoneStorageType *m_hierarchicalZones;
 };
 
+/**
+ * The integrated cost from the cells around a group move order to the group goal. The members of
+ * a large group take their paths from it instead of each running its own search. A field is built
+ * for every kind of mover in the group, as the passable cells depend on the locomotor surfaces and
+ * crusher ability of the member. The field only knows the terrain. The units in the way are checked
+ * with the footprint of the member when it takes its path, and a member whose path runs into one of
+ * them falls back to the regular search. The integration runs on the pathfind queue and shares its
+ * cell budget with the searches, so a large field may take a few frames to complete.
+ */
+struct PathfindFlowField
+{
+	enum { UNREACHED = 0xffffffff, NO_NEXT_CELL = 0xff };
+
+	struct OpenEntry
+	{
+		UnsignedInt m_cost;
+		Int m_index;
+	};
+
+	PathfindFlowField();
+	~PathfindFlowField();
+
+	Bool contains( Int x, Int y ) const { return x >= m_bounds.lo.x && x <= m_bounds.hi.x && y >= m_bounds.lo.y && y <= m_bounds.hi.y; }
+	Int getIndex( Int x, Int y ) const { return (y - m_bounds.lo.y) * m_width + (x - m_bounds.lo.x); }
+
+	LocomotorSurfaceTypeMask m_surfaces;
+	Bool m_isCrusher;
+	Bool m_isHuman;
+
+	ICoord2D m_goalCell;
+	IRegion2D m_bounds;							///< cells covered by the field, inclusive
+	Int m_width;
+	Int m_height;
+	UnsignedInt *m_cost;						///< cost from the cell to the goal, UNREACHED if the search didn't get there
+	UnsignedByte *m_next;						///< neighbor index of the next cell towards the goal
+
+	// The state of the integration, released once the field is complete.
+	Bool m_isComplete;
+	std::vector<OpenEntry> m_open;					///< heap of the cells to expand, cheapest first
+	std::vector<UnsignedByte> m_cellState;	///< passability and start flags of every cell
+	Int m_startsLeft;												///< start cells of the members that are not expanded yet
+
+	std::vector<ObjectID> m_members;	///< members that have not asked for their path yet
+	UnsignedInt m_expireFrame;
+};
+
+struct GroupPathStats
+{
+	UnsignedInt m_groupOrders;			///< group move orders that built flow fields
+	UnsignedInt m_members;					///< members of those orders
+	UnsignedInt m_fields;
+	UnsignedInt m_fieldCells;				///< cells expanded building the flow fields
+	UnsignedInt m_fieldPaths;				///< member paths that could be taken from a flow field
+	UnsignedInt m_blockedFieldPaths;	///< member paths of a flow field that ran into units and were searched instead
+	UnsignedInt m_searchPaths;			///< member paths that went through the regular search
+	UnsignedInt m_searchCells;			///< cells expanded by those searches
+};
+
 /**
  * The pathfinding services interface provides access to the 3 expensive path find calls:
  * findPath, findClosestPath, and findAttackPath.
@@ -649,10 +712,19 @@ public:
 
 	Path *getMoveAwayFromPath(Object *obj, Object *otherObj, Path *pathToAvoid, Object *otherObj2, Path *pathToAvoid2);
 
+	/// Record or check a path query for -recordPaths and -verifyPaths, queryType is a PathQueryLog::QueryType.
+	void logPathQuery( Int queryType, const Object *obj, const Coord3D *from, const Coord3D *to, Path *path );
+
 	void changeBridgeState( PathfindLayerEnum layer, Bool repaired );
 
 	Bool findBrokenBridge(const LocomotorSet &locomotorSet, const Coord3D *from, const Coord3D *to, ObjectID *bridgeID);
 
+	void buildGroupFlowFields( const std::vector<Object *> &members, const Coord3D *goal );	///< Share flow fields between the members of a group move order
+	void clearFlowFields( void );
+	const GroupPathStats &getGroupPathStats( void ) const { return m_groupPathStats; }
+	void resetGroupPathStats( void );
+	void reportGroupPathStats( void ) const;
+
 	void newMap(void);
 
 	PathfindCell *getCell( PathfindLayerEnum layer, Int x, Int y );							///< Return the cell at grid coords (x,y)
@@ -822,6 +894,15 @@ protected:
 
 	void checkChangeLayers(PathfindCell *parentCell);
 
+	PathfindFlowField *takeFlowField( const Object *obj );	///< Find the flow field of a group member and take the member off it
+	Bool isFlowFieldCellPassable( const PathfindFlowField *field, Int x, Int y );
+	Bool isFlowFieldCellOpen( PathfindFlowField *field, Int x, Int y );
+	Bool startFlowField( PathfindFlowField *field, const std::vector<ICoord2D> &starts );
+	Bool integrateFlowField( PathfindFlowField *field );	///< Expand cells within the cell budget, returns true once the field is complete
+	void integrateFlowFields( void );
+	Path *buildFlowFieldPath( const PathfindFlowField *field, Object *obj, const LocomotorSet& locomotorSet,
+		const Coord3D *from, const Coord3D *to );	///< Derive a member path from its flow field
+
 	bool checkCellOutsideExtents(ICoord2D& cell);
 
 #if defined(RTS_DEBUG)
@@ -864,6 +945,10 @@ private:
 	Int						m_queuePRHead;
 	Int						m_queuePRTail;
 	Int						m_cumulativeCellsAllocated;
+
+	// Group move orders
+	std::vector<PathfindFlowField *> m_flowFields;	///< newest last
+	GroupPathStats m_groupPathStats;
 };
 
 
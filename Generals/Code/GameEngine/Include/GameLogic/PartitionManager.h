@@ -56,6 +56,7 @@
 #include "Common/Snapshot.h"
 #include "Common/Geometry.h"
 #include "GameClient/Display.h"	// for ShroudLevel
+#include "GameLogic/ShroudMap.h"
 
 //-----------------------------------------------------------------------------
 //           defines
@@ -292,7 +293,6 @@ class PartitionCell : public Snapshot	// not MPO: allocated in an array
 {
 private:
 	CellAndObjectIntersection*		m_firstCoiInCell;	///< list of COIs in this cell (may be null).
-	ShroudLevel										m_shroudLevel[MAX_PLAYER_COUNT];
 #ifdef PM_CACHE_TERRAIN_HEIGHT
 	Real													m_loTerrainZ;			///< lowest terrain-pt in this cell
 	Real													m_hiTerrainZ;			///< highest terrain-pt in this cell
@@ -1200,6 +1200,9 @@ private:
 	typedef std::vector<OffsetVec>	RadiusVec;
 #endif
 
+	struct CircleTable;
+	struct CircleUpdate;
+
 	PartitionData		*m_moduleList;		///< master partition module list
 
 	Region3D				m_worldExtents;		///< should be same as TheTerrainLogic->getExtents()
@@ -1213,6 +1216,9 @@ private:
 	Bool						m_updatedSinceLastReset;	///< Used to force a return of OBJECTSHROUD_INVALID before update has been called.
 
 	std::queue<SightingInfo *> m_pendingUndoShroudReveals;	///< Anything can queue up an Undo to happen later. This is a queue, because "later" is a constant
+	std::vector<CircleTable *> m_circleTables;	///< the circles drawn for shroud, threat and value, by cell radius
+	std::vector<ObjectRangeBuffer *> m_freeRangeBuffers;	///< buffers for range queries that nobody holds right now
+	ShroudMap				m_shroudMap;			///< shroud levels of all cells, kept apart from the cells by player
 
 #ifdef FASTER_GCO
 	Int							m_maxGcoRadius;
@@ -1231,7 +1237,7 @@ protected:
 		Real maxDist,
 		DistanceCalculationType dc,
 		PartitionFilter **filters,
-		SimpleObjectIterator *iter,	// if nonnull, append ALL satisfactory objects to the iterator (not just the single closest)
+		ObjectRangeBuffer *buffer,	// if nonnull, append ALL satisfactory objects to the buffer (not just the single closest)
 		Real *closestDistArg,
 		Coord3D *closestVecArg
 	);
@@ -1256,17 +1262,12 @@ protected:
 	void calcRadiusVec();
 #endif
 
-	// These are all friend functions now. They will continue to function as before, but can be passed into
-	// the DiscreteCircle::drawCircle function.
-	friend void hLineAddLooker(Int x1, Int x2, Int y, void *playerIndex);
-	friend void hLineRemoveLooker(Int x1, Int x2, Int y, void *playerIndex);
-	friend void hLineAddShrouder(Int x1, Int x2, Int y, void *playerIndex);
-	friend void hLineRemoveShrouder(Int x1, Int x2, Int y, void *playerIndex);
+	const CircleTable *getCircleTable(Int cellRadius);	///< spans and falloff of the circle, built on first use
+	template <class CellOp> void drawCircleSpans(Int cellCenterX, Int cellCenterY, Int cellRadius, const CellOp &op);
 
-	friend void hLineAddThreat(Int x1, Int x2, Int y, void *threatValueParms);
-	friend void hLineRemoveThreat(Int x1, Int x2, Int y, void *threatValueParms);
-	friend void hLineAddValue(Int x1, Int x2, Int y, void *threatValueParms);
-	friend void hLineRemoveValue(Int x1, Int x2, Int y, void *threatValueParms);
+	static void hLineVerifyCircle(Int x1, Int x2, Int y, void *parmsVoid);	///< draws a circle span the way it was done before the span tables
+	void applyCircleUpdate(const CircleUpdate &update, Bool useSpanTables);
+	void getCircleCellStates(std::vector<Int> &states);
 
 	void processPendingUndoShroudRevealQueue(Bool considerTimestamp = TRUE);				///< keep popping and processing untill you get to one that is in the future
 	void resetPendingUndoShroudRevealQueue();					///< Just delete everything in the queue without doing anything with them
@@ -1306,6 +1307,8 @@ public:
 	PartitionCell *getCellAt(Int x, Int y);
 	const PartitionCell *getCellAt(Int x, Int y) const;
 
+	ShroudMap *friend_getShroudMap() { return &m_shroudMap; }	///< intended only for PartitionCell
+
 	/// A convenience funtion to reveal shroud at some location
 	// Queueing does not give you control of the timestamp to enforce the queue.  I own the delay, you don't.
 	void doShroudReveal( Real centerX, Real centerY, Real radius, PlayerMaskType playerMask);
@@ -1329,6 +1332,15 @@ public:
 	// given a distance in world coords, return the number of cells needed to cover that distance (rounding up)
 	Int worldToCellDist(Real w);
 
+	// true if the threat or value circles at these two spots would touch the same cells by the same amounts
+	Bool isSameThreatValueCircle(const Coord3D *posA, Real radiusA, const Coord3D *posB, Real radiusB);
+
+	// apply random circles through the span tables and through DiscreteCircle and print how many cells differ
+	void verifyCircles(UnsignedInt seed, Int updateCount);
+
+	// play back the shroud updates recorded since the map was loaded, for -benchmarkShroud
+	void runShroudBenchmark();
+
 	Object *getClosestObject(
 		const Object *obj,
 		Real maxDist,
@@ -1387,6 +1399,32 @@ public:
 		IterOrderType order = ITER_FASTEST
 	);
 
+	/**
+		Same as iterateObjectsInRange, but the objects are written into the given buffer, in the
+		same order, instead of into a newly allocated iterator. The buffer is emptied first.
+	*/
+	void getObjectsInRange(
+		const Object *obj,
+		Real maxDist,
+		DistanceCalculationType dc,
+		ObjectRangeBuffer *buffer,
+		PartitionFilter **filters = NULL,
+		IterOrderType order = ITER_FASTEST
+	);
+
+	void getObjectsInRange(
+		const Coord3D *pos,
+		Real maxDist,
+		DistanceCalculationType dc,
+		ObjectRangeBuffer *buffer,
+		PartitionFilter **filters = NULL,
+		IterOrderType order = ITER_FASTEST
+	);
+
+	/// lend out a range query buffer, which keeps its storage from earlier queries. Use ObjectRangeBufferHolder.
+	ObjectRangeBuffer *acquireRangeBuffer();
+	void releaseRangeBuffer(ObjectRangeBuffer *buffer);
+
 	SimpleObjectIterator *iterateAllObjects(PartitionFilter **filters = NULL);
 
 	/**
@@ -1556,3 +1594,26 @@ public:
 //           Externals
 //-----------------------------------------------------------------------------
 extern PartitionManager *ThePartitionManager;  ///< object manager singleton
+
+//-----------------------------------------------------------------------------
+/**
+	Holds a range query buffer of ThePartitionManager for the current scope. Every holder has
+	its own buffer, so a query made while the objects of another one are processed is fine.
+*/
+class ObjectRangeBufferHolder
+{
+public:
+	ObjectRangeBufferHolder() : m_buffer(ThePartitionManager->acquireRangeBuffer()) { }
+	~ObjectRangeBufferHolder() { ThePartitionManager->releaseRangeBuffer(m_buffer); }
+
+	ObjectRangeBuffer *get() const { return m_buffer; }
+	ObjectRangeBuffer *operator->() const { return m_buffer; }
+	operator ObjectRangeBuffer *() const { return m_buffer; }
+
+private:
+	ObjectRangeBuffer *m_buffer;
+
+	// not copyable
+	ObjectRangeBufferHolder(const ObjectRangeBufferHolder &);
+	ObjectRangeBufferHolder &operator=(const ObjectRangeBufferHolder &);
+};
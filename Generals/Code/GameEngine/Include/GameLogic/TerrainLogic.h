@@ -235,6 +235,7 @@ public:
 	virtual Coord3D findClosestEdgePoint( const Coord3D *closestTo ) const ;
 	virtual Coord3D findFarthestEdgePoint( const Coord3D *farthestFrom ) const ;
 	virtual Bool isClearLineOfSight(const Coord3D& pos, const Coord3D& posOther) const;
+	virtual void verifyLineOfSight( UnsignedInt seed, Int rayCount ) const { }	///< for -verifyLOS
 
 	virtual AsciiString getSourceFilename( void ) { return m_filenameString; }
 
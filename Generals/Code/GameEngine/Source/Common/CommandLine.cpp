@@ -26,10 +26,14 @@
 #include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
 
 #include "Common/ArchiveFileSystem.h"
+#include "Common/AsyncFileWriter.h"
 #include "Common/CommandLine.h"
 #include "Common/CRCDebug.h"
+#include "Common/GameEndChecks.h"
 #include "Common/LocalFileSystem.h"
+#include "Common/PathQueryLog.h"
 #include "Common/Recorder.h"
+#include "Common/Tracer.h"
 #include "Common/version.h"
 #include "GameClient/ClientInstance.h"
 #include "GameClient/TerrainVisual.h" // for TERRAIN_LOD_MIN definition
@@ -458,6 +462,171 @@ Int parseJobs(char *args[], int num)
 	return 1;
 }
 
+Int parseRecordPaths(char *args[], int num)
+{
+	if (num > 1)
+	{
+		PathQueryLog::startRecording(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseVerifyPaths(char *args[], int num)
+{
+	if (num > 1)
+	{
+		PathQueryLog::startVerifying(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkFrameTime(char *args[], int)
+{
+	TheWritableGlobalData->m_benchmarkFrameTime = TRUE;
+	return 1;
+}
+
+Int parseGameEndCheck(char *args[], int num)
+{
+	return GameEndChecks::parseFlag(args, num);
+}
+
+Int parseBenchmarkGameText(char *args[], int)
+{
+	TheWritableGlobalData->m_benchmarkGameText = TRUE;
+	return 1;
+}
+
+Int parseBenchmarkReplays(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkReplaysFile = args[1];
+		TheWritableGlobalData->m_headless = TRUE;
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_afterIntro = TRUE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		return 2;
+	}
+	return 1;
+}
+
+Int parseTrace(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_traceFile = args[1];
+		Tracer::enable(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkLoad(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkLoadMap = args[1];
+		ConvertShortMapPathToLongMapPath(TheWritableGlobalData->m_benchmarkLoadMap);
+
+		TheWritableGlobalData->m_headless = TRUE;
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_afterIntro = TRUE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+
+		// Make load benchmarks possible while other clients are running
+		rts::ClientInstance::setMultiInstance(TRUE);
+		rts::ClientInstance::skipPrimaryInstance();
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkLoadRuns(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkLoadRuns = atoi(args[1]);
+		if (TheGlobalData->m_benchmarkLoadRuns < 1)
+		{
+			printf("Invalid number of load runs: %d\n", TheGlobalData->m_benchmarkLoadRuns);
+			exit(1);
+		}
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayCheckpoints(char *args[], int num)
+{
+	if (num > 1)
+	{
+		const Int seconds = atoi(args[1]);
+		if (seconds < 1)
+		{
+			printf("Invalid replay checkpoint interval: %d\n", seconds);
+			exit(1);
+		}
+		TheWritableGlobalData->m_replayCheckpointInterval = seconds * LOGICFRAMES_PER_SECOND;
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayFlush(char *args[], int num)
+{
+	if (num > 1)
+	{
+		static const char *const policyNames[AsyncFileWriter::FLUSH_POLICY_COUNT] = { "blocks", "frames", "disk" };
+		for (Int i = 0; i < AsyncFileWriter::FLUSH_POLICY_COUNT; ++i)
+		{
+			if (stricmp(args[1], policyNames[i]) == 0)
+			{
+				TheWritableGlobalData->m_replayFlushPolicy = i;
+				return 2;
+			}
+		}
+		printf("Invalid replay flush policy: %s\n", args[1]);
+		exit(1);
+	}
+	return 1;
+}
+
+Int parseListReplays(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_listReplays = args[1];
+		TheWritableGlobalData->m_headless = TRUE;
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_afterIntro = TRUE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		return 2;
+	}
+	return 1;
+}
+
+Int parseReplayFilter(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_replayFilter = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseVerifyReplayCheckpoints(char *args[], int)
+{
+	TheWritableGlobalData->m_verifyReplayCheckpoints = TRUE;
+	if (TheGlobalData->m_replayCheckpointInterval == 0)
+		TheWritableGlobalData->m_replayCheckpointInterval = 60 * LOGICFRAMES_PER_SECOND;
+	return 1;
+}
+
 Int parseXRes(char *args[], int num)
 {
 	if (num > 1)
@@ -1163,6 +1332,102 @@ static CommandLineParam paramsForStartup[] =
 	// (If you have 4 cores, call it with -jobs 4)
 	// If you do not call this, all replays will be simulated in sequence in the same process.
 	{ "-jobs", parseJobs },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Record all shroud updates of a game and play them back as a benchmark when it ends.
+	// Combine it with -replay and -headless.
+	{ "-benchmarkShroud", parseGameEndCheck },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Count the pathfind cells that group move orders cost, with flow fields against one search per member.
+	// Combine it with -replay and -headless.
+	{ "-benchmarkGroupPath", parseGameEndCheck },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Animate many instances of every compressed animation of a game when it ends, with the shared channel caches and with per instance cursors.
+	// Combine it with -replay, the animations are only loaded when the game is drawn.
+	{ "-benchmarkAnim", parseGameEndCheck },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Time the client and the logic part of every update and print the frame time distribution as JSON when a game ends,
+	// next to the frame times of a pipeline that overlaps the logic of the next frame with the client of the current one.
+	{ "-benchmarkFrameTime", parseBenchmarkFrameTime },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Time the radar terrain rasterization of the whole map against the rasterization of a crater sized area when a game ends.
+	{ "-benchmarkRadarTerrain", parseGameEndCheck },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Time collecting and rasterizing the radar blips of all objects on the map when a game ends.
+	{ "-benchmarkRadarObjects", parseGameEndCheck },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Print the load time of the string file and how many strings per second can be fetched by label and by key.
+	{ "-benchmarkGameText", parseBenchmarkGameText },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Simulate the replays of -replay without graphics and one after another, and write the logic frames per second,
+	// the frame time distribution and the time of each GameLogic::update phase of every replay to the given JSON file.
+	// Compare several runs of two builds with scripts/benchmark/compare_replay_benchmarks.py.
+	{ "-benchmarkReplays", parseBenchmarkReplays },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Record the time of the engine subsystems, update modules, pathfinder, script engine and map load phases
+	// and stream them to the given file as a Chrome trace. Open it in chrome://tracing or ui.perfetto.dev.
+	{ "-trace", parseTrace },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Load a map without graphics a number of times and print how long each load phase took as JSON, then exit.
+	// Pass the map path afterwards. Use -benchmarkLoadRuns to set the number of loads, the default is 3.
+	{ "-benchmarkLoad", parseBenchmarkLoad },
+	{ "-benchmarkLoadRuns", parseBenchmarkLoadRuns },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Keep a compressed checkpoint of the game state every N seconds of game time during replay playback,
+	// so that seeking to an earlier frame only simulates the frames since the nearest checkpoint.
+	{ "-replayCheckpoints", parseReplayCheckpoints },
+
+	// TheSuperHackers @feature 18/10/2026
+	// At each new replay checkpoint, seek back to the previous one and check that the game state reaches the same CRC again.
+	// Combine it with -replay and -headless. Checkpoints are kept every 60 seconds unless -replayCheckpoints is given.
+	{ "-verifyReplayCheckpoints", parseVerifyReplayCheckpoints },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Choose when the recorded replay is flushed: "blocks" writes it in large blocks, "frames" flushes every frame
+	// with commands so the replay survives a crash of the game (default), "disk" also waits until it reached the disk.
+	{ "-replayFlush", parseReplayFlush },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Write the path queries of the pathfind queue and their paths to the given file, or compare them with such a file.
+	// Record with a build before a pathfinder change and verify with a build after it, both with -replay on the same
+	// replays. Every returned path must match the recording cell by cell.
+	{ "-recordPaths", parseRecordPaths },
+	{ "-verifyPaths", parseVerifyPaths },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Apply random look, shroud, threat and value circles of the given seed through the span tables of the partition
+	// manager and through DiscreteCircle when a game ends, and print how many cells differ. Combine it with -replay.
+	{ "-verifyShroudCircles", parseGameEndCheck },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Time rebuilding all terrain blocks and a small block of the loaded map when a game ends, each with the static
+	// lighting cache cleared and filled. It needs the renderer, so combine it with -replay but not with -headless.
+	{ "-benchmarkTerrainRebuild", parseGameEndCheck },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Cast 100000 random rays of the given seed over the map when a game ends, each through the max height pyramid
+	// and through the cell by cell walk of the terrain line of sight, and print how many results differ.
+	{ "-verifyLOS", parseGameEndCheck },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Print the replays that match the wildcard, for example -listReplays *.rep, with their version, duration and map,
+	// and exit. The replay headers are kept in ReplayIndex.dat in the replay directory, so only new replays are read.
+	{ "-listReplays", parseListReplays },
+
+	// TheSuperHackers @feature 18/10/2026
+	// Only list or simulate the replays whose header matches the filter, for example -replayFilter "map=tournament;minMinutes=10".
+	// The keys are map, version, minMinutes and maxMinutes. Combine it with -listReplays or -replay.
+	{ "-replayFilter", parseReplayFilter },
 };
 
 // These Params are parsed during Engine Init before INI data is loaded
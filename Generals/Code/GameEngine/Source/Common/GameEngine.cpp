@@ -33,6 +33,7 @@
 #include "Common/BuildAssistant.h"
 #include "Common/CRCDebug.h"
 #include "Common/FramePacer.h"
+#include "Common/FrameTimeProfiler.h"
 #include "Common/Radar.h"
 #include "Common/PlayerTemplate.h"
 #include "Common/Team.h"
@@ -66,6 +67,7 @@
 #include "Common/TerrainTypes.h"
 #include "Common/Upgrade.h"
 #include "Common/UserPreferences.h"
+#include "Common/WorkerPool.h"
 #include "Common/Xfer.h"
 #include "Common/XferCRC.h"
 #include "Common/GameLOD.h"
@@ -288,6 +290,9 @@ GameEngine::~GameEngine()
 	delete TheNameKeyGenerator;
 	TheNameKeyGenerator = NULL;
 
+	delete TheWorkerPool;
+	TheWorkerPool = NULL;
+
 	delete TheFileSystem;
 	TheFileSystem = NULL;
 
@@ -406,6 +411,10 @@ void GameEngine::init()
 		TheGameLODManager = MSGNEW("GameEngineSubsystem") GameLODManager;
 		TheGameLODManager->init();
 
+		// TheSuperHackers @performance Worker threads for the loops that can run in parallel, such as the pathfind map classification.
+		TheWorkerPool = MSGNEW("GameEngineSubsystem") WorkerPool;
+		TheWorkerPool->init();
+
 		// after parsing the command line, we may want to perform dds stuff. Do that here.
 		if (TheGlobalData->m_shouldUpdateTGAToDDS) {
 			// update any out of date targas here.
@@ -718,6 +727,9 @@ void GameEngine::update( void )
 {
 	USE_PERF_TIMER(GameEngine_update)
 	{
+		// TheSuperHackers @performance 18/10/2026 Time the client and the logic part of the update, see FrameTimeProfiler.
+		FrameTimeProfiler::beginFrame();
+
 		{
 			// VERIFY CRC needs to be in this code block.  Please to not pull TheGameLogic->update() inside this block.
 			VERIFY_CRC
@@ -738,14 +750,19 @@ void GameEngine::update( void )
 			TheCDManager->UPDATE();
 		}
 
+		FrameTimeProfiler::markClientDone();
+
 		const Bool canUpdate = canUpdateGameLogic();
 		const Bool canUpdateLogic = canUpdate && !TheFramePacer->isGameHalted() && !TheFramePacer->isTimeFrozen();
 		const Bool canUpdateScript = canUpdate && !TheFramePacer->isGameHalted();
 
 		if (canUpdateLogic)
 		{
+			// TheSuperHackers @feature 18/10/2026 Keep the replay checkpoints between two logic frames.
+			TheRecorder->updateCheckpoints();
 			TheGameClient->step();
 			TheGameLogic->UPDATE();
+			FrameTimeProfiler::endFrame();
 		}
 		else if (canUpdateScript)
 		{
@@ -41,6 +41,7 @@
 #define DEFINE_PANNING_NAMES
 
 #include "Common/AddonCompat.h"
+#include "Common/AsyncFileWriter.h"
 #include "Common/crc.h"
 #include "Common/file.h"
 #include "Common/FileSystem.h"
@@ -974,6 +975,17 @@ GlobalData::GlobalData()
 
 	m_simulateReplays.clear();
 	m_simulateReplayJobs = SIMULATE_REPLAYS_SEQUENTIAL;
+	m_benchmarkLoadMap.clear();
+	m_benchmarkLoadRuns = 3;
+	m_replayCheckpointInterval = 0;
+	m_replayFlushPolicy = AsyncFileWriter::FLUSH_COMMITS;
+	m_verifyReplayCheckpoints = FALSE;
+	m_benchmarkFrameTime = FALSE;
+	m_benchmarkGameText = FALSE;
+	m_benchmarkReplaysFile.clear();
+	m_listReplays.clear();
+	m_replayFilter.clear();
+	m_traceFile.clear();
 
 	for (i = LEVEL_FIRST; i <= LEVEL_LAST; ++i)
 		m_healthBonus[i] = 1.0f;
@@ -348,6 +348,9 @@ Drawable *ThingFactory::newDrawable(const ThingTemplate *tmplate, DrawableStatus
 	if (tmplate == NULL)
 		throw ERROR_BAD_ARG;
 
+	// Get the sounds of this kind of thing loading before the first one of them needs to play.
+	tmplate->prefetchAudio();
+
 	Drawable *draw = TheGameClient->friend_createDrawable( tmplate, statusBits );
 
 	/** @todo we should keep track of all the drawables we've allocated here
@@ -858,6 +858,7 @@ ThingTemplate::ThingTemplate() :
 	m_shroudClearingRange = -1.0f;
 
 	m_buildCost = 0;
+	m_audioPrefetchGeneration = 0;
 	m_buildTime = 1;
 	m_refundValue = 0;
 	m_energyProduction = 0;
@@ -994,6 +995,34 @@ void ThingTemplate::validateAudio()
 #endif
 }
 
+//-------------------------------------------------------------------------------------------------
+void ThingTemplate::prefetchAudio() const
+{
+	if (!TheAudio || m_audioPrefetchGeneration == TheAudio->getPrefetchGeneration())
+		return;
+
+	m_audioPrefetchGeneration = TheAudio->getPrefetchGeneration();
+
+	for (Int i = 0; i < TTAUDIO_COUNT; ++i)
+	{
+		if (m_audioarray.m_audio[i])
+			TheAudio->prefetchAudioEvent(&m_audioarray.m_audio[i]->m_event);
+	}
+
+	for (PerUnitSoundMap::const_iterator it = m_perUnitSounds.begin(); it != m_perUnitSounds.end(); ++it)
+		TheAudio->prefetchAudioEvent(&it->second);
+
+	for (WeaponTemplateSetVector::const_iterator it = m_weaponTemplateSets.begin(); it != m_weaponTemplateSets.end(); ++it)
+	{
+		for (Int slot = 0; slot < WEAPONSLOT_COUNT; ++slot)
+		{
+			const WeaponTemplate *weapon = it->getNth((WeaponSlotType)slot);
+			if (weapon)
+				TheAudio->prefetchAudioEvent(&weapon->getFireSound());
+		}
+	}
+}
+
 //-------------------------------------------------------------------------------------------------
 void ThingTemplate::validate()
 {
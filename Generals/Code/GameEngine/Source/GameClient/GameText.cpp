@@ -47,6 +47,7 @@
 
 #include "GameClient/GameText.h"
 #include "Common/Language.h"
+#include "Common/ProfileUtil.h"
 #include "Common/Registry.h"
 #include "GameClient/LanguageFilter.h"
 #include "Common/Debug.h"
@@ -57,6 +58,7 @@
 #include "Common/FileSystem.h"
 #include "Common/version.h"
 
+#include <algorithm>
 
 
 
@@ -97,10 +99,63 @@ struct StringInfo
 	AsciiString			speech;
 };
 
-struct StringLookUp
+//===============================
+// StringHash
+//===============================
+/** Finds the index of a label in a StringInfo array without any string allocation. The labels
+	* are hashed case insensitive into an open addressed table, the same way stricmp compares them.
+	*/
+//===============================
+
+class StringHash
 {
-	AsciiString		*label;
-	StringInfo		*info;
+	public:
+
+		StringHash() : m_slots(NULL), m_mask(0), m_info(NULL) {}
+		~StringHash() { clear(); }
+
+		void						build( const StringInfo *info, Int count );
+		void						clear( void );
+		Int							find( const Char *label ) const;	///< Returns the index of the label, or -1
+
+		static UnsignedInt	hashLabel( const Char *label );
+
+	private:
+
+		struct Slot
+		{
+			UnsignedInt	hash;
+			Int					index;	///< -1 for an empty slot
+		};
+
+		Slot						*m_slots;
+		UnsignedInt			m_mask;
+		const StringInfo	*m_info;
+};
+
+//===============================
+// CSFReader
+//===============================
+/** Reads the compiled string file from memory after it was read with a single file read.
+	*/
+//===============================
+
+struct CSFReader
+{
+	const char	*data;
+	Int					size;
+	Int					pos;
+
+	Bool read( void *buffer, Int bytes )
+	{
+		if ( bytes < 0 || pos + bytes > size )
+		{
+			return FALSE;
+		}
+		memcpy( buffer, data + pos, bytes );
+		pos += bytes;
+		return TRUE;
+	}
 };
 
 //===============================
@@ -148,6 +203,8 @@ class GameTextManager : public GameTextInterface
 		virtual UnicodeString fetch( const Char *label, Bool *exists = NULL );		///< Returns the associated labeled unicode text
 		virtual UnicodeString fetch( AsciiString label, Bool *exists = NULL );		///< Returns the associated labeled unicode text
 		virtual UnicodeString fetchFormat( const Char *label, ... );
+		virtual GameTextKey findKey( const Char *label );
+		virtual UnicodeString fetchByKey( GameTextKey key, Bool *exists = NULL );
 		virtual UnicodeString fetchOrSubstitute( const Char *label, const WideChar *substituteText );
 		virtual UnicodeString fetchOrSubstituteFormat( const Char *label, const WideChar *substituteFormat, ... );
 		virtual UnicodeString fetchOrSubstituteFormatVA( const Char *label, const WideChar *substituteFormat, va_list args );
@@ -166,7 +223,7 @@ class GameTextManager : public GameTextInterface
 		WideChar				m_tbuffer[MAX_UITEXT_LENGTH*2];
 
 		StringInfo			*m_stringInfo;
-		StringLookUp		*m_stringLUT;
+		StringHash			m_stringHash;
 		Bool						m_initialized;
 #if defined(RTS_DEBUG)
 		Bool						m_jabberWockie;
@@ -178,7 +235,7 @@ class GameTextManager : public GameTextInterface
 		UnicodeString		m_failed;
 
 		StringInfo			*m_mapStringInfo;
-		StringLookUp		*m_mapStringLUT;
+		StringHash			m_mapStringHash;
 		Int							m_mapTextCount;
 
 		/// m_asciiStringVec will be altered every time that getStringsWithLabelPrefix is called,
@@ -197,9 +254,11 @@ class GameTextManager : public GameTextInterface
 		Bool						parseMapStringFile( const char *filename );
 		Bool						readLine( char *buffer, Int max, File *file );
 		Char						readChar( File *file );
+		UnicodeString		missingString( const Char *label );
+		void						runBenchmark( Real loadMilliseconds, Int repeats );
 };
 
-static int _cdecl			compareLUT ( const void *,  const void*);
+static bool					isLabelLess ( const AsciiString& a, const AsciiString& b );
 //----------------------------------------------------------------------------
 //         Private Data
 //----------------------------------------------------------------------------
@@ -246,7 +305,6 @@ GameTextManager::GameTextManager()
 :	m_textCount(0),
 	m_maxLabelLen(0),
 	m_stringInfo(NULL),
-	m_stringLUT(NULL),
 	m_initialized(FALSE),
 	m_noStringList(NULL),
 #if defined(RTS_DEBUG)
@@ -257,7 +315,6 @@ GameTextManager::GameTextManager()
 	m_useStringFile(TRUE),
 #endif
 	m_mapStringInfo(NULL),
-	m_mapStringLUT(NULL),
 	m_failed(L"***FATAL*** String Manager failed to initilaize properly")
 {
 	// Added By Sadullah Nader
@@ -290,6 +347,8 @@ extern const Char *g_csfFile;
 
 void GameTextManager::init( void )
 {
+	const Int64 start = ProfileUtil::getTime();
+
 	AsciiString csfFile;
 	csfFile.format(g_csfFile, GetRegistryLanguage().str());
 	Int format;
@@ -355,21 +414,15 @@ void GameTextManager::init( void )
 		}
 	}
 
-	m_stringLUT = NEW StringLookUp[m_textCount];
+	m_stringHash.build( m_stringInfo, m_textCount );
 
-	StringLookUp *lut = m_stringLUT;
-	StringInfo *info = m_stringInfo;
+	const Real loadMilliseconds = (Real)ProfileUtil::ticksToMilliseconds( ProfileUtil::getTime() - start );
+	DEBUG_LOG(( "GameTextManager - loaded %d strings in %.3f ms", m_textCount, loadMilliseconds ));
 
-	for ( Int i = 0; i < m_textCount; i++ )
+	if ( TheGlobalData && TheGlobalData->m_benchmarkGameText )
 	{
-		lut->info = info;
-		lut->label = &info->label;
-		lut++;
-		info++;
+		runBenchmark( loadMilliseconds, 100 );
 	}
-
-	qsort( m_stringLUT, m_textCount, sizeof(StringLookUp), compareLUT  );
-
 }
 
 //============================================================================
@@ -382,8 +435,7 @@ void GameTextManager::deinit( void )
 	delete [] m_stringInfo;
 	m_stringInfo = NULL;
 
-	delete [] m_stringLUT;
-	m_stringLUT = NULL;
+	m_stringHash.clear();
 
 	m_textCount = 0;
 
@@ -415,8 +467,7 @@ void GameTextManager::reset( void )
 	delete [] m_mapStringInfo;
 	m_mapStringInfo = NULL;
 
-	delete [] m_mapStringLUT;
-	m_mapStringLUT = NULL;
+	m_mapStringHash.clear();
 }
 
 
@@ -899,12 +950,20 @@ Bool GameTextManager::parseCSF( const Char *filename )
 		return FALSE;
 	}
 
-	if (  file->read ( &header, sizeof ( CSFHeader)) != sizeof ( CSFHeader) )
+	// TheSuperHackers @performance 18/10/2026 Read the whole file at once instead of every field on its own.
+	CSFReader reader;
+	reader.size = file->size();
+	reader.data = file->readEntireAndClose();
+	reader.pos = 0;
+	file = NULL;
+
+	if ( !reader.read ( &header, sizeof ( CSFHeader) ) )
 	{
+		delete [] reader.data;
 		return FALSE;
 	}
 
-	while( file->read ( &id, sizeof (id)) == sizeof ( id) )
+	while( reader.read ( &id, sizeof (id) ) )
 	{
 		Int num;
 		Int num_strings;
@@ -914,13 +973,19 @@ Bool GameTextManager::parseCSF( const Char *filename )
 			goto quit;
 		}
 
-		file->read ( &num_strings, sizeof ( Int ));
+		if ( listCount >= m_textCount )
+		{
+			break;
+		}
 
-		file->read ( &len, sizeof ( Int ) );
+		if ( !reader.read ( &num_strings, sizeof ( Int ) ) || !reader.read ( &len, sizeof ( Int ) ) || len < 0 || len >= MAX_UITEXT_LENGTH )
+		{
+			goto quit;
+		}
 
-		if ( len )
+		if ( len && !reader.read ( m_buffer, len ) )
 		{
-			file->read ( m_buffer, len );
+			goto quit;
 		}
 
 		m_buffer[len] = 0;
@@ -937,18 +1002,24 @@ Bool GameTextManager::parseCSF( const Char *filename )
 
 		while ( num < num_strings )
 		{
-		 	file->read ( &id, sizeof ( Int ) );
+			if ( !reader.read ( &id, sizeof ( Int ) ) )
+			{
+				goto quit;
+			}
 
 			if ( id != CSF_STRING && id != CSF_STRINGWITHWAVE )
 			{
 				goto quit;
 			}
 
-		 	file->read ( &len, sizeof ( Int ) );
+			if ( !reader.read ( &len, sizeof ( Int ) ) || len < 0 || len >= MAX_UITEXT_LENGTH*2 )
+			{
+				goto quit;
+			}
 
-			if ( len )
+			if ( len && !reader.read ( m_tbuffer, len*sizeof(WideChar) ) )
 			{
-				file->read ( m_tbuffer, len*sizeof(WideChar) );
+				goto quit;
 			}
 
 			if ( num == 0 )
@@ -974,10 +1045,13 @@ Bool GameTextManager::parseCSF( const Char *filename )
 
 			if ( id == CSF_STRINGWITHWAVE )
 			{
-			 	file->read ( &len, sizeof ( Int ) );
-				if ( len )
+				if ( !reader.read ( &len, sizeof ( Int ) ) || len < 0 || len >= MAX_UITEXT_LENGTH )
+				{
+					goto quit;
+				}
+				if ( len && !reader.read ( m_buffer, len ) )
 				{
-					file->read ( m_buffer, len );
+					goto quit;
 				}
 				m_buffer[len] = 0;
 
@@ -999,8 +1073,7 @@ Bool GameTextManager::parseCSF( const Char *filename )
 
 quit:
 
-	file->close();
-	file = NULL;
+	delete [] reader.data;
 
 	return ok;
 }
@@ -1120,20 +1193,7 @@ void GameTextManager::initMapStringFile( const AsciiString& filename )
 
 	parseMapStringFile( filename.str() );
 
-	m_mapStringLUT = NEW StringLookUp[m_mapTextCount];
-
-	StringLookUp *lut = m_mapStringLUT;
-	StringInfo *info = m_mapStringInfo;
-
-	for ( Int i = 0; i < m_mapTextCount; i++ )
-	{
-		lut->info = info;
-		lut->label = &info->label;
-		lut++;
-		info++;
-	}
-
-	qsort( m_mapStringLUT, m_mapTextCount, sizeof(StringLookUp), compareLUT  );
+	m_mapStringHash.build( m_mapStringInfo, m_mapTextCount );
 }
 
 //============================================================================
@@ -1257,52 +1317,97 @@ UnicodeString GameTextManager::fetch( const Char *label, Bool *exists )
 		return m_failed;
 	}
 
-	StringLookUp *lookUp;
-	StringLookUp key;
-	AsciiString lb;
-	lb = label;
-	key.info = NULL;
-	key.label = &lb;
+	// TheSuperHackers @performance 18/10/2026 Look the label up in the hash tables instead of a binary search.
+	Int index = m_stringHash.find( label );
 
-	lookUp = (StringLookUp *) bsearch( &key, (void*) m_stringLUT, m_textCount, sizeof(StringLookUp), compareLUT );
+	if ( index >= 0 )
+	{
+		if( exists )
+			*exists = TRUE;
+		return m_stringInfo[index].text;
+	}
 
-	if ( lookUp == NULL && m_mapStringLUT && m_mapTextCount )
+	if ( m_mapStringInfo && m_mapTextCount )
 	{
-		lookUp = (StringLookUp *) bsearch( &key, (void*) m_mapStringLUT, m_mapTextCount, sizeof(StringLookUp), compareLUT );
+		index = m_mapStringHash.find( label );
+
+		if ( index >= 0 )
+		{
+			if( exists )
+				*exists = TRUE;
+			return m_mapStringInfo[index].text;
+		}
 	}
 
-	if( lookUp == NULL )
+	// string not found
+	if( exists )
+		*exists = FALSE;
+
+	return missingString( label );
+}
+
+//============================================================================
+// GameTextManager::missingString
+//============================================================================
+
+UnicodeString GameTextManager::missingString( const Char *label )
+{
+	// See if we already have the missing string
+	UnicodeString missingString;
+	missingString.format(L"MISSING: '%hs'", label);
+
+	NoString *noString = m_noStringList;
+
+	while ( noString )
 	{
+		if (noString->text == missingString)
+			return missingString;
 
-		// string not found
-		if( exists )
-			*exists = FALSE;
+		noString = noString->next;
+	}
 
-		// See if we already have the missing string
-		UnicodeString missingString;
-		missingString.format(L"MISSING: '%hs'", label);
+	//DEBUG_LOG(("*** MISSING:'%s' ***", label));
+	// Remember file could have been altered at this point.
+	noString = NEW NoString;
+	noString->text = missingString;
+	noString->next = m_noStringList;
+	m_noStringList = noString;
+	return noString->text;
+}
 
-		NoString *noString = m_noStringList;
+//============================================================================
+// GameTextManager::findKey
+//============================================================================
 
-		while ( noString )
-		{
-			if (noString->text == missingString)
-				return missingString;
+GameTextKey GameTextManager::findKey( const Char *label )
+{
+	if( m_stringInfo == NULL )
+	{
+		return GAMETEXTKEY_INVALID;
+	}
 
-			noString = noString->next;
-		}
+	const Int index = m_stringHash.find( label );
+
+	return index >= 0 ? (GameTextKey)index : GAMETEXTKEY_INVALID;
+}
 
-		//DEBUG_LOG(("*** MISSING:'%s' ***", label));
-		// Remember file could have been altered at this point.
-		noString = NEW NoString;
-		noString->text = missingString;
-		noString->next = m_noStringList;
-		m_noStringList = noString;
-		return noString->text;
+//============================================================================
+// GameTextManager::fetchByKey
+//============================================================================
+
+UnicodeString GameTextManager::fetchByKey( GameTextKey key, Bool *exists )
+{
+	if( m_stringInfo == NULL || key < 0 || key >= m_textCount )
+	{
+		DEBUG_CRASH(( "GameTextManager::fetchByKey - invalid key %d", key ));
+		if( exists )
+			*exists = FALSE;
+		return m_failed;
 	}
+
 	if( exists )
 		*exists = TRUE;
-	return lookUp->info->text;
+	return m_stringInfo[key].text;
 }
 
 //============================================================================
@@ -1392,23 +1497,81 @@ UnicodeString GameTextManager::fetchOrSubstituteFormatVA( const Char *label, con
 AsciiStringVec& GameTextManager::getStringsWithLabelPrefix(AsciiString label)
 {
 	m_asciiStringVec.clear();
-	if (m_stringLUT) {
+	if (m_stringInfo) {
 		for (int i = 0; i < m_textCount; ++i) {
-			if (strstr(m_stringLUT[i].label->str(), label.str()) == m_stringLUT[i].label->str()) {
-				m_asciiStringVec.push_back(*m_stringLUT[i].label);
+			if (strstr(m_stringInfo[i].label.str(), label.str()) == m_stringInfo[i].label.str()) {
+				m_asciiStringVec.push_back(m_stringInfo[i].label);
 			}
 		}
 	}
-	if (m_mapStringLUT) {
+	// Sort the labels of each file, as the sorted lookup tables used to list them.
+	const size_t mapBegin = m_asciiStringVec.size();
+	std::sort(m_asciiStringVec.begin(), m_asciiStringVec.end(), isLabelLess);
+	if (m_mapStringInfo) {
 		for (int i = 0; i < m_mapTextCount; ++i) {
-			if (strstr(m_mapStringLUT[i].label->str(), label.str()) == m_mapStringLUT[i].label->str()) {
-				m_asciiStringVec.push_back(*m_mapStringLUT[i].label);
+			if (strstr(m_mapStringInfo[i].label.str(), label.str()) == m_mapStringInfo[i].label.str()) {
+				m_asciiStringVec.push_back(m_mapStringInfo[i].label);
 			}
 		}
 	}
+	std::sort(m_asciiStringVec.begin() + mapBegin, m_asciiStringVec.end(), isLabelLess);
 	return m_asciiStringVec;
 }
 
+//============================================================================
+// GameTextManager::runBenchmark
+//============================================================================
+
+void GameTextManager::runBenchmark( Real loadMilliseconds, Int repeats )
+{
+	if ( m_textCount == 0 )
+	{
+		return;
+	}
+
+	// fetch every label of the string file by label and by key
+	std::vector<GameTextKey> keys( m_textCount );
+	Int i, r;
+	for ( i = 0; i < m_textCount; i++ )
+	{
+		keys[i] = findKey( m_stringInfo[i].label.str() );
+	}
+
+	Int found = 0;
+	Int64 start = ProfileUtil::getTime();
+	for ( r = 0; r < repeats; r++ )
+	{
+		for ( i = 0; i < m_textCount; i++ )
+		{
+			Bool exists;
+			fetch( m_stringInfo[i].label.str(), &exists );
+			found += exists ? 1 : 0;
+		}
+	}
+	const double labelSeconds = ProfileUtil::ticksToMilliseconds( ProfileUtil::getTime() - start ) / 1000.0;
+
+	start = ProfileUtil::getTime();
+	for ( r = 0; r < repeats; r++ )
+	{
+		for ( i = 0; i < m_textCount; i++ )
+		{
+			fetchByKey( keys[i] );
+		}
+	}
+	const double keySeconds = ProfileUtil::ticksToMilliseconds( ProfileUtil::getTime() - start ) / 1000.0;
+
+	const double fetchCount = (double)m_textCount * repeats;
+
+	ProfileUtil::print( "Game text benchmark: %d strings, loaded in %.3f ms, %d passes\n", m_textCount, loadMilliseconds, repeats );
+	ProfileUtil::print( "  fetch by label: %.0f fetches per second\n", labelSeconds > 0.0 ? fetchCount / labelSeconds : 0.0 );
+	ProfileUtil::print( "  fetch by key:   %.0f fetches per second\n", keySeconds > 0.0 ? fetchCount / keySeconds : 0.0 );
+	if ( found != m_textCount * repeats )
+		ProfileUtil::print( "  MISMATCH: %d of %d labels were not found\n", m_textCount * repeats - found, m_textCount * repeats );
+
+	DEBUG_LOG(( "GameTextManager - benchmark of %d strings: load %.3f ms, %.0f fetches by label and %.0f fetches by key per second",
+		m_textCount, loadMilliseconds, labelSeconds > 0.0 ? fetchCount / labelSeconds : 0.0, keySeconds > 0.0 ? fetchCount / keySeconds : 0.0 ));
+}
+
 //============================================================================
 // GameTextManager::readLine
 //============================================================================
@@ -1452,13 +1615,106 @@ Char	GameTextManager::readChar( File *file )
 }
 
 //============================================================================
-// compareLUT
+// isLabelLess
+//============================================================================
+
+static bool isLabelLess ( const AsciiString& a, const AsciiString& b )
+{
+	return stricmp( a.str(), b.str() ) < 0;
+}
+
+//============================================================================
+// StringHash::hashLabel
+//============================================================================
+
+UnsignedInt StringHash::hashLabel( const Char *label )
+{
+	// FNV-1a of the lower case label
+	UnsignedInt hash = 2166136261u;
+	for ( ; *label; ++label )
+	{
+		hash ^= (UnsignedInt)tolower( (UnsignedByte)*label );
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+//============================================================================
+// StringHash::build
+//============================================================================
+
+void StringHash::build( const StringInfo *info, Int count )
+{
+	clear();
+
+	// keep the table at most half full
+	UnsignedInt slotCount = 16;
+	while ( slotCount < (UnsignedInt)count * 2 )
+	{
+		slotCount <<= 1;
+	}
+
+	m_slots = NEW Slot[slotCount];
+	m_mask = slotCount - 1;
+	m_info = info;
+
+	UnsignedInt i;
+	for ( i = 0; i < slotCount; i++ )
+	{
+		m_slots[i].hash = 0;
+		m_slots[i].index = -1;
+	}
+
+	for ( Int index = 0; index < count; index++ )
+	{
+		const Char *label = info[index].label.str();
+
+		// the first of duplicate labels wins
+		if ( find( label ) >= 0 )
+		{
+			continue;
+		}
+
+		const UnsignedInt hash = hashLabel( label );
+		for ( i = hash & m_mask; m_slots[i].index >= 0; i = ( i + 1 ) & m_mask )
+		{
+		}
+		m_slots[i].hash = hash;
+		m_slots[i].index = index;
+	}
+}
+
+//============================================================================
+// StringHash::clear
 //============================================================================
 
-static int __cdecl compareLUT ( const void *i1,  const void*i2)
+void StringHash::clear( void )
 {
-	StringLookUp *lut1 = (StringLookUp*) i1;
-	StringLookUp *lut2 = (StringLookUp*) i2;
+	delete [] m_slots;
+	m_slots = NULL;
+	m_mask = 0;
+	m_info = NULL;
+}
+
+//============================================================================
+// StringHash::find
+//============================================================================
+
+Int StringHash::find( const Char *label ) const
+{
+	if ( m_slots == NULL || label == NULL )
+	{
+		return -1;
+	}
+
+	const UnsignedInt hash = hashLabel( label );
+	for ( UnsignedInt i = hash & m_mask; m_slots[i].index >= 0; i = ( i + 1 ) & m_mask )
+	{
+		if ( m_slots[i].hash == hash && stricmp( m_info[m_slots[i].index].label.str(), label ) == 0 )
+		{
+			return m_slots[i].index;
+		}
+	}
 
-	return stricmp( lut1->label->str(), lut2->label->str());
+	return -1;
 }
@@ -1886,9 +1886,11 @@ void InGameUI::update( void )
 			UnsignedInt currentMoney = money->countMoney();
 			if( lastMoney != currentMoney )
 			{
+				// TheSuperHackers @performance 18/10/2026 Fetch the money format by its key instead of looking up the label every time.
+				static StaticGameTextLabel s_moneyDisplayLabel( "GUI:ControlBarMoneyDisplay" );
 				UnicodeString buffer;
 
-				buffer.format(TheGameText->fetch( "GUI:ControlBarMoneyDisplay" ), currentMoney );
+				buffer.format(s_moneyDisplayLabel.fetch(), currentMoney );
 				GadgetStaticTextSetText( moneyWin, buffer );
 				lastMoney = currentMoney;
 
@@ -31,6 +31,7 @@
 #include "Common/ActionManager.h"
 #include "Common/BuildAssistant.h"
 #include "Common/CRCDebug.h"
+#include "Common/PathQueryLog.h"
 #include "Common/Player.h"
 #include "Common/SpecialPower.h"
 #include "Common/ThingTemplate.h"
@@ -670,6 +671,7 @@ Bool AIGroup::friend_computeGroundPath( const Coord3D *pos, CommandSourceType cm
 	if (!closeEnough) return false;
 
 	m_groundPath = TheAI->pathfinder()->findGroundPath(&center, pos, PATH_DIAMETER_IN_CELLS, false);
+	TheAI->pathfinder()->logPathQuery(PathQueryLog::GROUND_PATH, NULL, &center, pos, m_groundPath);
 	return m_groundPath!=NULL;
 
 }
@@ -1694,6 +1696,14 @@ void AIGroup::groupMoveToPosition( const Coord3D *pos, Bool addWaypoint, Command
 	// Works better if you let the near units get the first paths... jba.
 	// Move the ones nearest the goal first.  Reduces collision problems later.
 	Object *theUnit;
+	if (!addWaypoint) {
+		// Large groups share flow fields from the goal instead of searching a path for every member.
+		std::vector<Object *> members;
+		for (theUnit = iter->first(); theUnit; theUnit = iter->next()) {
+			members.push_back(theUnit);
+		}
+		TheAI->pathfinder()->buildGroupFlowFields(members, &goalPos);
+	}
 	Bool firstUnit = true;
 	for (theUnit = iter->first(); theUnit; theUnit = iter->next())
 	{
@@ -4257,6 +4257,13 @@ void Object::handleShroud()
 //-------------------------------------------------------------------------------------------------
 void Object::handleValueMap()
 {
+	if( canKeepThreatOrValue( m_partitionLastValue, getTemplate()->friend_getBuildCost() ) )
+	{
+		m_partitionLastValue->m_where = *getPosition();
+		m_partitionLastValue->m_howFar = getVisionRange();
+		return;
+	}
+
 	removeValue();
 	addValue();
 }
@@ -4264,10 +4271,37 @@ void Object::handleValueMap()
 //-------------------------------------------------------------------------------------------------
 void Object::handleThreatMap()
 {
+	if( canKeepThreatOrValue( m_partitionLastThreat, getTemplate()->getThreatValue() ) )
+	{
+		m_partitionLastThreat->m_where = *getPosition();
+		m_partitionLastThreat->m_howFar = getVisionRange();
+		return;
+	}
+
 	removeThreat();
 	addThreat();
 }
 
+//-------------------------------------------------------------------------------------------------
+/**
+	Removing and adding back the threat or value is a waste when it would go on the very same cells
+	with the very same amounts, as it does whenever the cell maintenance wasn't about a cell change.
+*/
+Bool Object::canKeepThreatOrValue( const SightingInfo *lastAffect, UnsignedInt data )
+{
+	if( lastAffect->isInvalid() || lastAffect->m_data != data )
+		return FALSE;
+
+	// Same checks as in addThreat and addValue.
+	if( !getControllingPlayer() || getControllingPlayer()->getPlayerMask() != lastAffect->m_forWhom )
+		return FALSE;
+
+	if( getStatusBits().test( OBJECT_STATUS_UNDER_CONSTRUCTION ) || isEffectivelyDead() || getShroudClearingRange() <= 0.0f )
+		return FALSE;
+
+	return ThePartitionManager->isSameThreatValueCircle( &lastAffect->m_where, lastAffect->m_howFar, getPosition(), getVisionRange() );
+}
+
 //-------------------------------------------------------------------------------------------------
 void Object::addValue()
 {
@@ -36,6 +36,7 @@
 #include "Common/GameState.h"
 #include "Common/CRCDebug.h"
 #include "Common/GlobalData.h"
+#include "Common/PathQueryLog.h"
 #include "Common/Player.h"
 #include "Common/PlayerList.h"
 #include "Common/RandomValue.h"
@@ -1617,6 +1618,7 @@ Bool AIUpdateInterface::computeQuickPath( const Coord3D *destination )
 	destroyPath();
 	if (getObject()->isKindOf(KINDOF_AIRCRAFT) && !getObject()->isKindOf(KINDOF_PROJECTILE)) {
 		m_path = TheAI->pathfinder()->getAircraftPath(getObject(), destination);
+		TheAI->pathfinder()->logPathQuery(PathQueryLog::AIRCRAFT_PATH, getObject(), getObject()->getPosition(), destination, m_path);
 	} else {
 		m_path = newInstance(Path);
 		m_path->prependNode( destination, LAYER_GROUND );
@@ -3104,9 +3106,11 @@ void AIUpdateInterface::privateMoveAwayFromUnit( Object *unit, CommandSourceType
 	}
 	if (unitPath == NULL) return;
 	Path *newPath = TheAI->pathfinder()->getMoveAwayFromPath(getObject(), unit, unitPath, obj2, path2);
+	TheAI->pathfinder()->logPathQuery(PathQueryLog::MOVE_AWAY_PATH, getObject(), getObject()->getPosition(), unit->getPosition(), newPath);
 	if (newPath==NULL && !canPathThroughUnits())	{
 		setCanPathThroughUnits(TRUE);
 		newPath = TheAI->pathfinder()->getMoveAwayFromPath(getObject(), unit, unitPath, obj2, path2);
+		TheAI->pathfinder()->logPathQuery(PathQueryLog::MOVE_AWAY_PATH, getObject(), getObject()->getPosition(), unit->getPosition(), newPath);
 	}
 
 	if (newPath) {
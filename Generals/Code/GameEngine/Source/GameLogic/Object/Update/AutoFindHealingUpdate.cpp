@@ -155,11 +155,12 @@ Object* AutoFindHealingUpdate::scanClosestTarget()
 	Object *bestTarget = NULL;
 	Real closestDistSqr=0;
 
-	ObjectIterator *iter = ThePartitionManager->iterateObjectsInRange( me->getPosition(), data->m_scanRange, FROM_CENTER_2D );
-	MemoryPoolObjectHolder hold(iter);
+	ObjectRangeBufferHolder candidates;
+	ThePartitionManager->getObjectsInRange( me->getPosition(), data->m_scanRange, FROM_CENTER_2D, candidates );
 
-	for( Object *other = iter->first(); other; other = iter->next() )
+	for( Int i = 0; i < candidates->getCount(); ++i )
 	{
+		Object *other = candidates->getObject( i );
 		if( !other->isKindOf( KINDOF_HEAL_PAD ) )
 		{
 			//Not a valid target.
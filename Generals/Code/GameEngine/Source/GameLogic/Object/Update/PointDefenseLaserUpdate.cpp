@@ -251,11 +251,12 @@ Object* PointDefenseLaserUpdate::scanClosestTarget()
 	bonus.clear();
 	Real fireRange = data->m_weaponTemplate->getAttackRange( bonus );
 
-	ObjectIterator *iter = ThePartitionManager->iterateObjectsInRange( me->getPosition(), data->m_scanRange, FROM_CENTER_2D );
-	MemoryPoolObjectHolder hold(iter);
+	ObjectRangeBufferHolder candidates;
+	ThePartitionManager->getObjectsInRange( me->getPosition(), data->m_scanRange, FROM_CENTER_2D, candidates );
 
-	for( Object *other = iter->first(); other; other = iter->next() )
+	for( Int i = 0; i < candidates->getCount(); ++i )
 	{
+		Object *other = candidates->getObject( i );
 		if( other->isAnyKindOf( data->m_primaryTargetKindOf ) )
 		{
 			//Primary target type
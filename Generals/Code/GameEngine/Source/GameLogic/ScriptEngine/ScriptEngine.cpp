@@ -41,6 +41,7 @@
 #include "Common/Team.h"
 #include "Common/ThingFactory.h"
 #include "Common/ThingTemplate.h"
+#include "Common/Tracer.h"
 #include "Common/Xfer.h"
 
 #include "GameClient/MessageBox.h"
@@ -6952,6 +6953,7 @@ void ScriptEngine::executeActions( ScriptAction *pActionHead )
 //-------------------------------------------------------------------------------------------------
 void ScriptEngine::executeScripts( Script *pScriptHead )
 {
+	TRACE_SCOPE("ScriptEngine::executeScripts");
 
 	// Evaluate the scripts.
 	Script *pCurScript;
@@ -40,6 +40,9 @@
 #include "Common/GameUtility.h"
 #include "Common/INI.h"
 #include "Common/LatchRestore.h"
+#include "Common/LoadProfiler.h"
+#include "Common/LogicProfiler.h"
+#include "Common/Tracer.h"
 #include "Common/MapObject.h"
 #include "Common/MultiplayerSettings.h"
 #include "Common/OSDisplay.h"
@@ -227,6 +230,7 @@ GameLogic::GameLogic( void )
 	//
 
 	m_frame = 0;
+	m_frameAllocationCount = 0;
 	m_hasUpdated = FALSE;
 	m_frameObjectsChangedTriggerAreas = 0;
 	m_width = 0;
@@ -1078,6 +1082,9 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	}
 
+	// TheSuperHackers @performance Time every phase of the map load, see LoadProfiler.
+	LoadProfiler::beginLoad();
+
 	m_rankLevelLimit = 1000;	// this is reset every game.
 	setDefaults( saveGame );
 	TheWritableGlobalData->m_loadScreenRender = TRUE;	///< mark it so only a few select things are rendered during load
@@ -1175,6 +1182,7 @@ void GameLogic::startNewGame( Bool saveGame )
 	// update the loadscreen
 	if(m_loadScreen)
 		updateLoadProgress(LOAD_PROGRESS_POST_PARTICLE_INI_LOAD);
+	LoadProfiler::markPhase("gameSetup");
 
 	DEBUG_ASSERTCRASH(m_frame == 0, ("framecounter expected to be 0 here"));
 
@@ -1188,6 +1196,7 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_LOAD_MAP);
+	LoadProfiler::markPhase("loadMap");
 
 	#ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
@@ -1377,6 +1386,7 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_SIDE_LIST_INIT);
+	LoadProfiler::markPhase("sideList");
 
 	// update the player list to match the new map.
 	TheTeamFactory->reset();
@@ -1384,12 +1394,14 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_PLAYER_LIST_RESET);
+	LoadProfiler::markPhase("playerList");
 
 	// Tell the script engine that a newe set of scripts is loaded.
 	TheScriptEngine->newMap();
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_SCRIPT_ENGINE_NEW_MAP);
+	LoadProfiler::markPhase("scriptEngine");
 
 	if (TheGameEngine->isMultiplayerSession() || isSkirmishOrSkirmishReplay)
 	{
@@ -1514,6 +1526,7 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_VICTORY_CONDITION_SETUP);
+	LoadProfiler::markPhase("victoryConditionSetup");
 
 	Player *localPlayer = ThePlayerList->getLocalPlayer();
 	Player *observerPlayer = ThePlayerList->findPlayerWithNameKey(TheNameKeyGenerator->nameToKey("ReplayObserver"));
@@ -1539,6 +1552,7 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_VICTORY_CONDITION_SET_VICTORY_CONDITION);
+	LoadProfiler::markPhase("radar");
 
 	// set the world extents to that of the map
 	Region3D extent;
@@ -1556,12 +1570,14 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_GHOST_OBJECT_MANAGER_RESET);
+	LoadProfiler::markPhase("partitionManager");
 
 	// update the terrain logic now that all is loaded
 	TheTerrainLogic->newMap( saveGame );
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_TERRAIN_LOGIC_NEW_MAP);
+	LoadProfiler::markPhase("terrainLogic");
 
 	#ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
@@ -1614,6 +1630,7 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_BRIDGE_LOAD);
+	LoadProfiler::markPhase("bridges");
 
 	// refresh the radar to reflect loaded bridges
 	TheRadar->refreshTerrain( TheTerrainLogic );
@@ -1624,6 +1641,7 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_PATHFINDER_NEW_MAP);
+	LoadProfiler::markPhase("pathfinder");
 
 	// reveal the map for the permanent observer
 	ThePartitionManager->revealMapForPlayerPermanently( observerPlayer->getPlayerIndex() );
@@ -1759,6 +1777,8 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	}
 
+	LoadProfiler::markPhase("objects");
+
 	#ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
 	sprintf(Buf,"After loading objects=%f",((double)(endTime64-startTime64)/(double)(freq64)*1000.0));
@@ -1811,6 +1831,7 @@ void GameLogic::startNewGame( Bool saveGame )
 	}
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_INITIAL_NETWORK_BUILDINGS);
+	LoadProfiler::markPhase("networkBuildings");
 
 	//
 	// tell the client to pre-load some assets that we will use such as faction things we
@@ -1835,6 +1856,7 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_PRELOAD_ASSETS);
+	LoadProfiler::markPhase("preloadAssets");
 
 	TheTacticalView->setAngleAndPitchToDefault();
 	TheTacticalView->setZoomToDefault();
@@ -1887,6 +1909,7 @@ void GameLogic::startNewGame( Bool saveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_STARTING_CAMERA_2);
+	LoadProfiler::markPhase("camera");
 
 	// update partition info - We need to do the initial update so that it can be queried
 	// during the first frame.  jba.
@@ -1922,6 +1945,7 @@ void GameLogic::startNewGame( Bool saveGame )
 	}
 
 	updateLoadProgress(LOAD_PROGRESS_END);
+	LoadProfiler::markPhase("finishSetup");
 
 	if(isInMultiplayerGame() && TheNetwork)
 	{
@@ -1975,6 +1999,8 @@ void GameLogic::startNewGame( Bool saveGame )
 	DEBUG_LOG(("%s", Buf));
 	#endif
 
+	LoadProfiler::endLoad("loadScreen");
+
 	if(m_gameMode == GAME_SHELL)
 	{
 		if (!TheGlobalData->m_headless)
@@ -3170,14 +3196,20 @@ void GameLogic::update( void )
 	UnsignedInt now = TheGameLogic->getFrame();
 	TheGameClient->setFrame(now);
 
+	// TheSuperHackers @performance Count the memory allocations of the logic update, they show in the debug display.
+	const UnsignedInt allocationCountAtStart = getMemoryAllocationCount();
+
+	// TheSuperHackers @performance 18/10/2026 The phases of the update are timed during replay benchmarks.
 	// update (execute) scripts
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_SCRIPTS);
 		TheScriptEngine->UPDATE();
 	}
 
 	// Note - TerrainLogic update needs to happen after ScriptEngine update, but before object updates.  jba.
 	// This way changes in bridges are noted in the script engine before being cleared in TerrainLogic->update
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_TERRAIN);
 		TheTerrainLogic->UPDATE();
 	}
 
@@ -3195,6 +3227,7 @@ void GameLogic::update( void )
 
 	if (generateForSolo || generateForMP)
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_CRC);
 		m_CRC = getCRC( CRC_RECALC );
 		bool isPlayback = (TheRecorder && TheRecorder->isPlaybackMode());
 
@@ -3226,6 +3259,7 @@ void GameLogic::update( void )
 
 	// process client commands
 	{
+		TRACE_SCOPE("processCommandList");
 		processCommandList( TheCommandList );
 	}
 
@@ -3238,6 +3272,7 @@ void GameLogic::update( void )
 			if (!dis.any() || dis.anyIntersectionWith(u->getDisabledTypesToProcess()))
 			{
 				USE_PERF_TIMER(GameLogic_update_normal)
+				TRACE_SCOPE(u->getModuleName());
 
 				m_curUpdateModule = u;
 
@@ -3255,6 +3290,7 @@ void GameLogic::update( void )
 #endif
 
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_SLEEPY_UPDATES);
 		while (!m_sleepyUpdates.empty())
 		{
 			UpdateModulePtr u = peekSleepyUpdate();
@@ -3278,6 +3314,8 @@ void GameLogic::update( void )
 			if (!dis.any() || dis.anyIntersectionWith(u->getDisabledTypesToProcess()))
 			{
 				USE_PERF_TIMER(GameLogic_update_sleepy)
+				// TheSuperHackers @performance 18/10/2026 Trace the update modules by type.
+				TRACE_SCOPE(u->getModuleName());
 
 				//DEBUG_LOG(("calling update %08lx (%d %d)...",update,update->friend_getNextCallFrame(),update->friend_getNextCallPhase()));
 				m_curUpdateModule = u;
@@ -3301,6 +3339,7 @@ void GameLogic::update( void )
 
 	// update the Artificial Intelligence system
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_AI);
 		TheAI->UPDATE();
 	}
 
@@ -3311,6 +3350,7 @@ void GameLogic::update( void )
 
 	// update partition info
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_PARTITION);
 		ThePartitionManager->UPDATE();
 	}
 
@@ -3319,7 +3359,11 @@ void GameLogic::update( void )
 	//
 
 	// destroy all pending objects
-	processDestroyList();
+	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_DESTROY_LIST);
+		TRACE_SCOPE("processDestroyList");
+		processDestroyList();
+	}
 
 	// reset the command list, destroying all messages
 	TheCommandList->reset();
@@ -3339,12 +3383,19 @@ void GameLogic::update( void )
 		}
 	}
 
+	// the counter wraps around, the unsigned difference is still right.
+	m_frameAllocationCount = getMemoryAllocationCount() - allocationCountAtStart;
+
 	// increment world time
 	if (!m_startNewGame)
 	{
 		m_frame++;
 		m_hasUpdated = TRUE;
 	}
+
+	// TheSuperHackers @performance 18/10/2026 Stream the zones of this frame to the trace file of -trace,
+	// so the buffers of the threads only need to hold a single frame.
+	Tracer::flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -32,7 +32,9 @@
 
 #include "Common/CRCDebug.h"
 #include "Common/FramePacer.h"
+#include "Common/FrameTimeProfiler.h"
 #include "Common/GameAudio.h"
+#include "Common/GameEndChecks.h"
 #include "Common/GameEngine.h"
 #include "Common/GlobalData.h"
 #include "Common/NameKeyGenerator.h"
@@ -42,10 +44,12 @@
 #include "Common/PlayerTemplate.h"
 #include "Common/MessageStream.h"
 #include "Common/MultiplayerSettings.h"
+#include "Common/PathQueryLog.h"
 #include "Common/Recorder.h"
 #include "Common/BuildAssistant.h"
 #include "Common/SpecialPower.h"
 #include "Common/ThingTemplate.h"
+#include "Common/Tracer.h"
 #include "Common/Upgrade.h"
 #include "Common/StatsCollector.h"
 #include "Common/Radar.h"
@@ -56,7 +60,7 @@
 #include "GameLogic/Object.h"
 #include "GameLogic/ObjectCreationList.h"
 #include "GameLogic/ObjectIter.h"
-//#include "GameLogic/PartitionManager.h"
+#include "GameLogic/PartitionManager.h"
 #include "GameLogic/AI.h"
 #include "GameLogic/Module/AIUpdate.h"
 #include "GameLogic/Module/BodyModule.h"
@@ -269,6 +273,18 @@ void GameLogic::clearGameData( Bool showScoreScreen )
 		FixupScoreScreenMovieWindow();
 	}
 
+	// TheSuperHackers @performance 18/10/2026 Print the frame times of the game when -benchmarkFrameTime is given.
+	FrameTimeProfiler::report(TheGlobalData->m_mapName.str());
+
+	// TheSuperHackers @performance 18/10/2026 Write the trace while the names of its zones are still valid.
+	Tracer::flush();
+
+	// TheSuperHackers @feature 18/10/2026 Run the benchmarks and checks given on the command line while the game is still loaded.
+	GameEndChecks::run();
+
+	// TheSuperHackers @feature 18/10/2026 Print whether the paths matched the recording of -verifyPaths.
+	PathQueryLog::endGame();
+
 	TheGameEngine->reset();
 	setGameMode(GAME_NONE);
 //	m_background->bringForward();
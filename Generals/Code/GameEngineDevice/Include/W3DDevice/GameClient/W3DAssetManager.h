@@ -49,6 +49,7 @@
 
 class Vector3;
 class VertexMaterialClass;
+class W3DAssetPreloader;
 
 class W3DAssetManager: public WW3DAssetManager
 {
@@ -60,6 +61,14 @@ public:
 	// unique to W3DAssetManager
 	virtual HAnimClass *	Get_HAnim(const char * name);
 	virtual bool Load_3D_Assets( const char * filename ); // This CANNOT be Bool, as it will not inherit properly if you make Bool == Int
+
+	// TheSuperHackers @performance Files queued between beginPreload and endPreload are read on worker threads,
+	// lower priorities first. Their prototypes are added on the main thread in endPreload.
+	void beginPreload(void);
+	void setPreloadPriority(Int priority);
+	void queuePreload(const char * filename);
+	void endPreload(void);
+	Bool isPreloading(void) const { return m_preloader != NULL; }
 	virtual TextureClass *			Get_Texture(
 		const char * filename,
 		MipCountType mip_level_count=MIP_LEVELS_ALL,
@@ -97,6 +106,9 @@ private:
 	int replaceHLODTexture(RenderObjClass *robj, TextureClass *oldTex, TextureClass *newTex);
 	int replaceMeshTexture(RenderObjClass *robj, TextureClass *oldTex, TextureClass *newTex);
 
+	W3DAssetPreloader *m_preloader;
+	Int m_preloadPriority;
+
 	//'E&B' customizations
 /*	virtual RenderObjClass * Create_Render_Obj(const char * name, float scale, const Vector3 &hsv_shift);
 	TextureClass * Get_Texture_With_HSV_Shift(const char * filename, const Vector3 &hsv_shift, MipCountType mip_level_count = MIP_LEVELS_ALL);
@@ -112,6 +112,8 @@ public:
 	//
 	virtual void setRawMapHeight(const ICoord2D *gridPos, Int height);
 
+	virtual void runRebuildBenchmark( Int repeats );
+
 	/// Replace the skybox texture
 	virtual void replaceSkyboxTextures(const AsciiString *oldTexName[NumSkyboxTextures], const AsciiString *newTexName[NumSkyboxTextures]);
 
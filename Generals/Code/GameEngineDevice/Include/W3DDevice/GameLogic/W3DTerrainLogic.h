@@ -66,6 +66,7 @@ public:
 	virtual void getExtentIncludingBorder( Region3D *extent ) const;
 
 	virtual Bool isClearLineOfSight(const Coord3D& pos, const Coord3D& posOther) const;
+	virtual void verifyLineOfSight( UnsignedInt seed, Int rayCount ) const;
 
 protected:
 
@@ -58,6 +58,7 @@
 #include <d3dx8core.h>
 #include "Common/GlobalData.h"
 #include "Common/PerfTimer.h"
+#include "Common/ProfileUtil.h"
 
 #include "GameClient/TerrainVisual.h"
 #include "GameClient/View.h"
@@ -175,6 +176,10 @@ Int HeightMapRenderObjClass::freeMapResources(void)
 	REF_PTR_RELEASE(m_stageThreeTexture);
 	REF_PTR_RELEASE(m_destAlphaTexture);
 	REF_PTR_RELEASE(m_map);
+	m_staticLighting.clear();
+	m_staticLightingMap = NULL;
+	m_losPyramid.clear();
+	m_losPyramidMap = NULL;
 
 	return 0;
 }
@@ -294,6 +299,204 @@ void HeightMapRenderObjClass::doTheLight(VERTEX_FORMAT *vb, Vector3*light, Vecto
 #endif
 }
 
+//=============================================================================
+// HeightMapRenderObjClass::doTheCachedLight
+//=============================================================================
+/** Calculates the diffuse lighting for a vertex in the terrain, like doTheLight.
+The lighting of the global lights is calculated once and kept in staticLight,
+only the lights of the light list from gatherLightSources are added each time. */
+//=============================================================================
+void HeightMapRenderObjClass::doTheCachedLight(VERTEX_FORMAT *vb, Vector3*light, Vector3*normal, UnsignedInt &staticLight, UnsignedByte alpha)
+{
+#ifdef USE_NORMALS
+	vb->nx = normal->X;
+	vb->ny = normal->Y;
+	vb->nz = normal->Z;
+#else
+	Real shadeR, shadeG, shadeB;
+	Real shade;
+
+	if ((staticLight & STATIC_LIGHTING_VALID) == 0)
+	{
+		shadeR = TheGlobalData->m_terrainAmbient[0].red;	//only the first terrain light contributes to ambient
+		shadeG = TheGlobalData->m_terrainAmbient[0].green;
+		shadeB = TheGlobalData->m_terrainAmbient[0].blue;
+
+		const RGBColor *terrainDiffuse;
+		for (Int lightIndex=0; lightIndex < TheGlobalData->m_numGlobalLights; lightIndex++)
+		{
+			shade = Vector3::Dot_Product(light[lightIndex], *normal);
+			if (shade > 1.0) shade = 1.0;
+			if(shade < 0.0f) shade = 0.0f;
+			terrainDiffuse=&TheGlobalData->m_terrainDiffuse[lightIndex];
+			shadeR += shade*terrainDiffuse->red;
+			shadeG += shade*terrainDiffuse->green;
+			shadeB += shade*terrainDiffuse->blue;
+		}
+
+		if (shadeR > 1.0) shadeR = 1.0;
+		if(shadeR < 0.0f) shadeR = 0.0f;
+		if (shadeG > 1.0) shadeG = 1.0;
+		if(shadeG < 0.0f) shadeG = 0.0f;
+		if (shadeB > 1.0) shadeB = 1.0;
+		if(shadeB < 0.0f) shadeB = 0.0f;
+
+		staticLight = STATIC_LIGHTING_VALID | REAL_TO_INT(shadeB*255.0f) | (REAL_TO_INT(shadeG*255.0f) << 8) | (REAL_TO_INT(shadeR*255.0f) << 16);
+	}
+
+	const Bool isUnderWater = m_useDepthFade && vb->z <= TheGlobalData->m_waterPositionZ;
+	if (m_lightSources.empty() && !isUnderWater)
+	{	// Lit by the global lights only, which is exactly the cached value.
+		vb->diffuse = (staticLight & ~STATIC_LIGHTING_VALID) | ((Int)alpha << 24);
+		return;
+	}
+
+	// Start from the middle of the cached steps, so that a vertex without other light rounds back to the cached value.
+	shadeR = (((staticLight >> 16) & 0xff) + 0.5f) / 255.0f;
+	shadeG = (((staticLight >> 8) & 0xff) + 0.5f) / 255.0f;
+	shadeB = ((staticLight & 0xff) + 0.5f) / 255.0f;
+
+	for (size_t sourceIndex = 0; sourceIndex < m_lightSources.size(); ++sourceIndex)
+	{
+		const LightSource &source = m_lightSources[sourceIndex];
+		Vector3 lightRay;
+		Real factor = 1.0f;
+		if (source.isDirectional)
+		{
+			lightRay = source.lightRay;
+		}
+		else
+		{
+			if (vb->x < source.position.X-source.range) continue;
+			if (vb->x > source.position.X+source.range) continue;
+			if (vb->y < source.position.Y-source.range) continue;
+			if (vb->y > source.position.Y+source.range) continue;
+			Vector3 lightDirection(vb->x - source.position.X, vb->y - source.position.Y, vb->z - source.position.Z);
+			Real dist = lightDirection.Length();
+			if (dist >= source.range) continue;
+			factor = 1.0f - (dist - source.midRange) / (source.range - source.midRange);
+			factor = WWMath::Clamp(factor,0.0f,1.0f);
+			lightDirection.Normalize();
+			lightRay.Set(-lightDirection.X, -lightDirection.Y, -lightDirection.Z);
+		}
+		shade = Vector3::Dot_Product(lightRay, *normal);
+		shade *= factor;
+		if (shade > 1.0) shade = 1.0;
+		if(shade < 0.0f) shade = 0.0f;
+		shadeR += shade*source.diffuse.X;
+		shadeG += shade*source.diffuse.Y;
+		shadeB += shade*source.diffuse.Z;
+		shadeR += factor*source.ambient.X;
+		shadeG += factor*source.ambient.Y;
+		shadeB += factor*source.ambient.Z;
+	}
+
+	if (shadeR > 1.0) shadeR = 1.0;
+	if(shadeR < 0.0f) shadeR = 0.0f;
+	if (shadeG > 1.0) shadeG = 1.0;
+	if(shadeG < 0.0f) shadeG = 0.0f;
+	if (shadeB > 1.0) shadeB = 1.0;
+	if(shadeB < 0.0f) shadeB = 0.0f;
+
+	if (isUnderWater)
+	{	//height is below water level
+		//reduce lighting values based on light fall off as it travels through water.
+		float depthScale = (1.4f - vb->z)/TheGlobalData->m_waterPositionZ;
+		shadeR *= 1.0f - depthScale * (1.0f-m_depthFade.X);
+		shadeG *= 1.0f - depthScale * (1.0f-m_depthFade.Y);
+		shadeB *= 1.0f - depthScale * (1.0f-m_depthFade.Z);
+	}
+
+	shadeR*=255.0f;
+	shadeG*=255.0f;
+	shadeB*=255.0f;
+	vb->diffuse = REAL_TO_INT(shadeB) | (REAL_TO_INT(shadeG) << 8) | (REAL_TO_INT(shadeR) << 16) | ((Int)alpha << 24);
+#endif
+}
+
+//=============================================================================
+// HeightMapRenderObjClass::gatherLightSources
+//=============================================================================
+/** Reads the lights of the light list for doTheCachedLight, so that the light
+properties are looked up once per update instead of once per vertex. */
+//=============================================================================
+void HeightMapRenderObjClass::gatherLightSources(RefRenderObjListIterator *pLightsIterator)
+{
+	m_lightSources.clear();
+	if (pLightsIterator == NULL)
+		return;
+
+	for (pLightsIterator->First(); !pLightsIterator->Is_Done(); pLightsIterator->Next())
+	{
+		LightClass *pLight = (LightClass*)pLightsIterator->Peek_Obj();
+		LightSource source;
+		switch(pLight->Get_Type()) {
+		case LightClass::POINT:
+		case LightClass::SPOT: {
+				double range, midRange;
+				pLight->Get_Far_Attenuation_Range(midRange, range);
+				if (midRange < 0.1) continue;	// doTheLight skips these lights for every vertex.
+				source.position = pLight->Get_Position();
+				source.midRange = (Real)midRange;
+				source.range = (Real)range;
+				source.isDirectional = false;
+			}
+			break;
+		case LightClass::DIRECTIONAL: {
+				Vector3 lightDirection = pLight->Get_Transform().Get_Z_Vector();
+				lightDirection.Normalize();
+				source.lightRay.Set(-lightDirection.X, -lightDirection.Y, -lightDirection.Z);
+				source.midRange = 0.0f;
+				source.range = 0.0f;
+				source.isDirectional = true;
+			}
+			break;
+		default:
+			continue;
+		};
+		pLight->Get_Diffuse(&source.diffuse);
+		pLight->Get_Ambient(&source.ambient);
+		m_lightSources.push_back(source);
+	}
+}
+
+//=============================================================================
+// HeightMapRenderObjClass::prepareStaticLighting
+//=============================================================================
+/** Resets the static lighting cache if it was calculated for another map. */
+//=============================================================================
+void HeightMapRenderObjClass::prepareStaticLighting(WorldHeightMap *pMap)
+{
+	if (pMap == m_staticLightingMap && pMap->getXExtent() == m_staticLightingWidth && pMap->getYExtent() == m_staticLightingHeight)
+		return;
+
+	m_staticLightingMap = pMap;
+	m_staticLightingWidth = pMap->getXExtent();
+	m_staticLightingHeight = pMap->getYExtent();
+	m_staticLighting.assign(m_staticLightingWidth*m_staticLightingHeight, 0);
+}
+
+//=============================================================================
+// HeightMapRenderObjClass::invalidateStaticLighting
+//=============================================================================
+/** Recalculates the static lighting of the given map cells on their next update.
+The coordinates are map cell coordinates, relative to the entire map. */
+//=============================================================================
+void HeightMapRenderObjClass::invalidateStaticLighting(const IRegion2D &range)
+{
+	// The normal of a vertex uses the heights up to 2 cells away on the half resolution mesh.
+	const Int border = 2;
+	Int minX = MAX(range.lo.x - border, 0);
+	Int minY = MAX(range.lo.y - border, 0);
+	Int maxX = MIN(range.hi.x + border, m_staticLightingWidth - 1);
+	Int maxY = MIN(range.hi.y + border, m_staticLightingHeight - 1);
+	for (Int y = minY; y <= maxY; y++)
+	{
+		for (Int x = minX; x <= maxX; x++)
+			m_staticLighting[x + y*m_staticLightingWidth] = 0;
+	}
+}
+
 //=============================================================================
 // HeightMapRenderObjClass::doTheDynamicLight
 //=============================================================================
@@ -445,6 +648,7 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 	Int xCoord, yCoord;
 	Int vn0,un0,vp1,up1;
 	Vector3 l2r,n2f,normalAtTexel;
+	UnsignedInt *staticLight;
 	Int	vertsPerRow=(VERTEX_BUFFER_TILE_LENGTH)*4;	//vertices per row of VB
 
 	Int cellOffset = 1;
@@ -459,6 +663,10 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 		assert(x0 >= originX && y0 >= originY && x1>x0 && y1>y0 && x1<=originX+VERTEX_BUFFER_TILE_LENGTH && y1<=originY+VERTEX_BUFFER_TILE_LENGTH);
 #endif
 
+		// TheSuperHackers @performance The global lights come from the static lighting cache, so only the light list is evaluated per vertex.
+		prepareStaticLighting(pMap);
+		gatherLightSources(pLightsIterator);
+
 		DX8VertexBufferClass::WriteLockClass lockVtxBuffer(pVB);
 		VERTEX_FORMAT *vbHardware = (VERTEX_FORMAT*)lockVtxBuffer.Get_Vertex_Array();
 		VERTEX_FORMAT *vBase = (VERTEX_FORMAT*)data;
@@ -517,14 +725,17 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 				}
 
 				//top-left sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset, getYWithOrigin(j)) - pMap->getDisplayHeight(un0, getYWithOrigin(j))));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i), (getYWithOrigin(j)+cellOffset)) - pMap->getDisplayHeight(getXWithOrigin(i), vn0)));
-
+				staticLight = &getStaticLighting(getXWithOrigin(i)+pMap->getDrawOrgX(), getYWithOrigin(j)+pMap->getDrawOrgY());
+				if (needsLightNormal(*staticLight))
+				{
+					l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset, getYWithOrigin(j)) - pMap->getDisplayHeight(un0, getYWithOrigin(j))));
+					n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i), (getYWithOrigin(j)+cellOffset)) - pMap->getDisplayHeight(getXWithOrigin(i), vn0)));
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+					normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+					Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
 #endif
+				}
 
 				vb->x=xCoord;
 				vb->y=yCoord;
@@ -535,18 +746,21 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 				vb->v1=V[0];
 				vb->u2=UA[0];
 				vb->v2=VA[0];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[0]);
+				doTheCachedLight(vb, lightRay, &normalAtTexel, *staticLight, alpha[0]);
 				vb++;
 
 				//top-right sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , getYWithOrigin(j) ) - pMap->getDisplayHeight(getXWithOrigin(i) , getYWithOrigin(j) )));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , vn0 )));
-
+				staticLight = &getStaticLighting(getXWithOrigin(i)+cellOffset+pMap->getDrawOrgX(), getYWithOrigin(j)+pMap->getDrawOrgY());
+				if (needsLightNormal(*staticLight))
+				{
+					l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , getYWithOrigin(j) ) - pMap->getDisplayHeight(getXWithOrigin(i) , getYWithOrigin(j) )));
+					n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , vn0 )));
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+					normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+					Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
 #endif
+				}
 
 				vb->x=xCoord+cellOffset;
 				vb->y=yCoord;
@@ -557,18 +771,21 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 				vb->v1=V[1];
 				vb->u2=UA[1];
 				vb->v2=VA[1];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[1]);
+				doTheCachedLight(vb, lightRay, &normalAtTexel, *staticLight, alpha[1]);
 				vb++;
 
 				//bottom-right sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(getXWithOrigin(i) , (getYWithOrigin(j)+cellOffset) )));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , vp1 ) - pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , getYWithOrigin(j) )));
-
+				staticLight = &getStaticLighting(getXWithOrigin(i)+cellOffset+pMap->getDrawOrgX(), getYWithOrigin(j)+cellOffset+pMap->getDrawOrgY());
+				if (needsLightNormal(*staticLight))
+				{
+					l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(getXWithOrigin(i) , (getYWithOrigin(j)+cellOffset) )));
+					n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , vp1 ) - pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , getYWithOrigin(j) )));
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+					normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+					Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
 #endif
+				}
 
 				vb->x=xCoord+cellOffset;
 				if (yCoord + 1 == pMap->getDrawOrgY() + m_y - 1) {
@@ -583,18 +800,21 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 				vb->v1=V[2];
 				vb->u2=UA[2];
 				vb->v2=VA[2];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[2]);
+				doTheCachedLight(vb, lightRay, &normalAtTexel, *staticLight, alpha[2]);
 				vb++;
 
 				//bottom-left sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(un0 , (getYWithOrigin(j)+cellOffset) )));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i) , vp1 ) - pMap->getDisplayHeight(getXWithOrigin(i) , getYWithOrigin(j) )));
-
+				staticLight = &getStaticLighting(getXWithOrigin(i)+pMap->getDrawOrgX(), getYWithOrigin(j)+cellOffset+pMap->getDrawOrgY());
+				if (needsLightNormal(*staticLight))
+				{
+					l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(un0 , (getYWithOrigin(j)+cellOffset) )));
+					n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i) , vp1 ) - pMap->getDisplayHeight(getXWithOrigin(i) , getYWithOrigin(j) )));
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+					normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+					Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
 #endif
+				}
 
 				if (xCoord == pMap->getDrawOrgX()) {
 					vb->x=xCoord;
@@ -614,7 +834,7 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 				vb->v1=V[3];
 				vb->u2=UA[3];
 				vb->v2=VA[3];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[3]);
+				doTheCachedLight(vb, lightRay, &normalAtTexel, *staticLight, alpha[3]);
 				vb++;
 
 				VERTEX_FORMAT *pCurVertices = vb-4;
@@ -1052,6 +1272,8 @@ The vertex coordinates and texture coordinates, as well as static lighting are u
 */
 void HeightMapRenderObjClass::doPartialUpdate(const IRegion2D &partialRange, WorldHeightMap *htMap, RefRenderObjListIterator *pLightsIterator)
 {
+	invalidateStaticLighting(partialRange);
+
 	// Adjust range into the current drawn map range.
 	Int minX = partialRange.lo.x - htMap->getDrawOrgX();
 	Int maxX = partialRange.hi.x - htMap->getDrawOrgX();
@@ -1136,6 +1358,8 @@ void HeightMapRenderObjClass::doPartialUpdate(const IRegion2D &partialRange, Wor
 	updateViewImpassableAreas(TRUE, minX, maxX, minY, maxY);
 }
 
+DECLARE_PERF_TIMER(Terrain_UpdateBlock)
+
 //=============================================================================
 // HeightMapRenderObjClass::updateBlock
 //=============================================================================
@@ -1144,6 +1368,8 @@ The vertex coordinates and texture coordinates, as well as static lighting are u
 */
 Int HeightMapRenderObjClass::updateBlock(Int x0, Int y0, Int x1, Int y1,  WorldHeightMap *pMap, RefRenderObjListIterator *pLightsIterator)
 {
+	USE_PERF_TIMER(Terrain_UpdateBlock)
+
 #ifdef RTS_DEBUG
 	DEBUG_ASSERTCRASH(x0>=0&&y0>=0 && x1<m_x && y1<m_y && x0<=x1 && y0<=y1, ("Invalid updates."));
 #endif
@@ -1290,6 +1516,11 @@ HeightMapRenderObjClass::HeightMapRenderObjClass(void)
 	m_x=0;
 	m_y=0;
 	m_needFullUpdate = false;
+	m_staticLightingWidth = 0;
+	m_staticLightingHeight = 0;
+	m_staticLightingMap = NULL;
+	m_losPyramidLevels = 0;
+	m_losPyramidMap = NULL;
 	m_showImpassableAreas = false;
 	m_originX = 0;
 	m_originY = 0;
@@ -1931,15 +2162,154 @@ Bool HeightMapRenderObjClass::isClearLineOfSight(const Coord3D& pos, const Coord
 		return false;	// doh. should not happen.
 
 #define DO_BRESENHAM
+//#define DEBUG_LOS_PYRAMID	// check the result of the max height pyramid against the cell by cell walk
 #ifdef DO_BRESENHAM
+	Bool result = isClearLineOfSightOnMap(m_map, pos, posOther, true);
+#ifdef DEBUG_LOS_PYRAMID
+	DEBUG_ASSERTCRASH(result == isClearLineOfSightOnMap(m_map, pos, posOther, false), ("The max height pyramid changed the line of sight result"));
+#endif
+	return result;
+
+#else
+
+	// walk a line from obj to objOther and
+	// find the highest point in between 'em. while
+	// we're doing this, also estimate the point on the
+	// line at the same x,y as the high-terrain-point.
+
+	Real fx = pos.x;
+	Real fy = pos.y;
+	Real fz = pos.z;
+	Real fdx = posOther.x - fx;
+	Real fdy = posOther.y - fy;
+	Real fdz = posOther.z - fz;
 
+	// What's the largest step size that will be accurate enough?
+	// Currently we use a step size of about 2 "feet", which
+	// seems acceptable accuracy. If performance here is inadequate,
+	// we can try increasing the step size, but be sure to retest
+	// accuracy.
+	Real len = ceilf(sqrtf(fdx*fdx + fdy*fdy));
+	const Real STEP_LEN = 2.0f;
+	Int numSteps = REAL_TO_INT_CEIL(len / STEP_LEN);
+	if (numSteps < 1) numSteps = 1;
+	Real fnsInv = 1.0f / numSteps;
+	Real fxinc = fdx * fnsInv;
+	Real fyinc = fdy * fnsInv;
+	Real fzinc = fdz * fnsInv;
+	while (numSteps--)
+	{
+		Real terrainHeight = getHeightMapHeight( fx, fy, NULL );
+
+		// if terrainHeight > fz, we can't see, so punt.
+		// add a little fudge to account for slop.
+		const Real LOS_FUDGE = 0.5f;
+		if (terrainHeight > fz + LOS_FUDGE)
+		{
+			return false;
+		}
+
+		// we're above the max height of the terrain and still looking up, so we're done.
+		// (don't bother for reverse test, since that doesn't generally happen)
+		if (fz >= getMaxHeight() && fzinc > 0.0f)
+		{
+			return true;
+		}
+
+		fx += fxinc;
+		fy += fyinc;
+		fz += fzinc;
+
+	}
+
+	return true;
+#endif
+}
+
+//=============================================================================
+// HeightMapRenderObjClass::verifyLineOfSight
+//=============================================================================
+/** Casts random rays over the map, each once with the max height pyramid and
+once with the cell by cell walk, and prints how many results differ. This is
+the check of DEBUG_LOS_PYRAMID, on rays of every length and height. */
+//=============================================================================
+void HeightMapRenderObjClass::verifyLineOfSight(UnsignedInt seed, Int rayCount) const
+{
+	if (m_map == NULL)
+		return;
+
+	WorldHeightMap *losMap = m_map;
+	const Int borderSize = losMap->getBorderSizeInline();
+	const Real width = (losMap->getXExtent() - 2*borderSize) * MAP_XY_FACTOR;
+	const Real height = (losMap->getYExtent() - 2*borderSize) * MAP_XY_FACTOR;
+	if (width <= 0.0f || height <= 0.0f)
+		return;
+
+	// A local generator, so that the game's random numbers stay untouched.
+	UnsignedInt random = seed != 0 ? seed : 1;
+	#define VERIFY_LOS_RANDOM() (random ^= random << 13, random ^= random >> 17, random ^= random << 5, random)
+	#define VERIFY_LOS_RANDOM_REAL(lo, hi) ((lo) + ((hi) - (lo)) * (VERIFY_LOS_RANDOM() % 10000) / 10000.0f)
+
+	Int clearCount = 0;
+	Int mismatchCount = 0;
+	Int64 pyramidTicks = 0;
+	Int64 walkTicks = 0;
+	for (Int i = 0; i < rayCount; ++i)
+	{
+		// Half of the rays are as long as weapon ranges, the others cross the map.
+		const Real maxLength = (i & 1) ? MAX(width, height) : 400.0f;
+		Coord3D pos, posOther;
+		pos.x = VERIFY_LOS_RANDOM_REAL(0.0f, width);
+		pos.y = VERIFY_LOS_RANDOM_REAL(0.0f, height);
+		posOther.x = MIN(MAX(pos.x + VERIFY_LOS_RANDOM_REAL(-maxLength, maxLength), 0.0f), width);
+		posOther.y = MIN(MAX(pos.y + VERIFY_LOS_RANDOM_REAL(-maxLength, maxLength), 0.0f), height);
+		pos.z = getHeightMapHeight(pos.x, pos.y, NULL) + VERIFY_LOS_RANDOM_REAL(-5.0f, 100.0f);
+		posOther.z = getHeightMapHeight(posOther.x, posOther.y, NULL) + VERIFY_LOS_RANDOM_REAL(-5.0f, 100.0f);
+
+		Int64 start = ProfileUtil::getTime();
+		const Bool pyramidResult = isClearLineOfSightOnMap(losMap, pos, posOther, true);
+		pyramidTicks += ProfileUtil::getTime() - start;
+
+		start = ProfileUtil::getTime();
+		const Bool walkResult = isClearLineOfSightOnMap(losMap, pos, posOther, false);
+		walkTicks += ProfileUtil::getTime() - start;
+
+		if (walkResult)
+			++clearCount;
+		if (pyramidResult != walkResult)
+		{
+			if (mismatchCount < 10)
+			{
+				ProfileUtil::print("Line of sight mismatch: (%.2f, %.2f, %.2f) to (%.2f, %.2f, %.2f) is %s with the pyramid, %s with the cell walk\n",
+					pos.x, pos.y, pos.z, posOther.x, posOther.y, posOther.z, pyramidResult ? "clear" : "blocked", walkResult ? "clear" : "blocked");
+			}
+			++mismatchCount;
+		}
+	}
+	#undef VERIFY_LOS_RANDOM_REAL
+	#undef VERIFY_LOS_RANDOM
+
+	ProfileUtil::print("Line of sight: %d rays of seed %u, %d clear, %d mismatches, %.3f us per ray with the pyramid, %.3f us with the cell walk\n",
+		rayCount, seed, clearCount, mismatchCount,
+		ProfileUtil::ticksToMicroseconds(pyramidTicks) / MAX(rayCount, 1), ProfileUtil::ticksToMicroseconds(walkTicks) / MAX(rayCount, 1));
+}
+
+//=============================================================================
+// HeightMapRenderObjClass::isClearLineOfSightOnMap
+//=============================================================================
+/** Walks the cells from pos to posOther and checks them against the height
+of the line. With usePyramid, blocks of cells that are lower than the line
+are passed without checking every cell. */
+//=============================================================================
+Bool HeightMapRenderObjClass::isClearLineOfSightOnMap(WorldHeightMap *map, const Coord3D& pos, const Coord3D& posOther, Bool usePyramid) const
+{
 	/*
 		this is WAY faster, though not quite as accurate... however, the inaccuracy
 		is pretty minimal, so we really should force other code to live with it. (srj)
 	*/
 	const Real MAP_XY_FACTOR_INV = 1.0f / MAP_XY_FACTOR;
 
-	Int borderSize = m_map->getBorderSize();
+	Int borderSize = map->getBorderSize();
 	Int start_x = REAL_TO_INT_FLOOR(pos.x * MAP_XY_FACTOR_INV) + borderSize;
 	Int start_y = REAL_TO_INT_FLOOR(pos.y * MAP_XY_FACTOR_INV) + borderSize;
 	Int end_x = REAL_TO_INT_FLOOR(posOther.x * MAP_XY_FACTOR_INV) + borderSize;
@@ -1996,15 +2366,25 @@ Bool HeightMapRenderObjClass::isClearLineOfSight(const Coord3D& pos, const Coord
 		numpixels = delta_y;							// There are more y-values than x-values
 	}
 
+	const Bool majorIsX = (delta_x >= delta_y);	// x changes on every step
+	const Int majorInc = majorIsX ? xinc2 : yinc2;
+	const Int minorInc = majorIsX ? yinc1 : xinc1;
+
 	Real nsInv = 1.0f / numpixels;
 	Real z = pos.z;
 	Real dz = posOther.z - z;
 	Real zinc = dz * nsInv;
 
+	// add a little fudge to account for slop.
+	const Real LOS_FUDGE = 0.5f;
+
 	Bool result = true;
-	const UnsignedByte* data = m_map->getDataPtr();
-	Int xExtent = m_map->getXExtent();
-	Int yExtent = m_map->getYExtent();
+	const UnsignedByte* data = map->getDataPtr();
+	Int xExtent = map->getXExtent();
+	Int yExtent = map->getYExtent();
+	if (usePyramid)
+		updateLineOfSightPyramid(map);
+
 	for (Int curpixel = 0; curpixel < numpixels; curpixel++)
 	{
 		if (x < 0 ||
@@ -2016,6 +2396,74 @@ Bool HeightMapRenderObjClass::isClearLineOfSight(const Coord3D& pos, const Coord
 			break;
 		}
 
+		// TheSuperHackers @performance Take all steps inside a block of the max height pyramid at once
+		// when the whole block is below the ray. The steps are still taken one by one for z and the early out,
+		// only the heights are not read, so the result is identical to checking every cell.
+		if (usePyramid)
+		{
+			Int skipSteps = 0;
+			const Int major = majorIsX ? x : y;
+			const Int minor = majorIsX ? y : x;
+			for (Int level = m_losPyramidLevels-1; level >= 1; --level)
+			{
+				const Int blockMask = (1 << level) - 1;
+				Int steps = (majorInc > 0) ? (blockMask + 1) - (major & blockMask) : (major & blockMask) + 1;
+				steps = MIN(steps, numpixels - curpixel);
+				if (steps < 2)
+					break;	// smaller blocks do not help either
+
+				// Every cell on the way lies between the first and the last one, so they must be in the same block.
+				const Int majorEnd = major + majorInc*(steps-1);
+				const Int minorEnd = minor + minorInc*((num + (steps-1)*numadd) / den);
+				if ((minorEnd >> level) != (minor >> level))
+					continue;
+				const Int endX = majorIsX ? majorEnd : minorEnd;
+				const Int endY = majorIsX ? minorEnd : majorEnd;
+				if (endX < 0 || endY < 0 || endX >= xExtent-1 || endY >= yExtent-1)
+					continue;
+
+				Real lowestZ = z;
+				if (zinc < 0.0f)
+				{
+					for (Int step = 1; step < steps; ++step)
+						lowestZ += zinc;
+				}
+				const Int blockIndex = m_losPyramidOffset[level] + (x >> level) + (y >> level)*m_losPyramidWidth[level];
+				if (m_losPyramid[blockIndex]*MAP_HEIGHT_SCALE > lowestZ + LOS_FUDGE)
+					continue;
+
+				skipSteps = steps;
+				break;
+			}
+
+			if (skipSteps > 0)
+			{
+				Bool aboveTerrain = false;
+				for (Int step = 0; step < skipSteps; ++step)
+				{
+					if (z >= getMaxHeight() && zinc > 0.0f)
+					{
+						aboveTerrain = true;
+						break;
+					}
+					z += zinc;
+					num += numadd;
+					if (num >= den)
+					{
+						num -= den;
+						x += xinc1;
+						y += yinc1;
+					}
+					x += xinc2;
+					y += yinc2;
+				}
+				if (aboveTerrain)
+					break;
+				curpixel += skipSteps - 1;
+				continue;
+			}
+		}
+
 		Int idx = x + y*xExtent;
 		float height = data[idx];
 		height = __max(height, data[idx + 1]);
@@ -2024,8 +2472,6 @@ Bool HeightMapRenderObjClass::isClearLineOfSight(const Coord3D& pos, const Coord
 		height *= MAP_HEIGHT_SCALE;
 
 		// if terrainHeight > z, we can't see, so punt.
-		// add a little fudge to account for slop.
-		const Real LOS_FUDGE = 0.5f;
 		if (height > z + LOS_FUDGE)
 		{
 			result = false;
@@ -2054,61 +2500,80 @@ Bool HeightMapRenderObjClass::isClearLineOfSight(const Coord3D& pos, const Coord
 	}
 
 	return result;
+}
 
-#else
-
-	// walk a line from obj to objOther and
-	// find the highest point in between 'em. while
-	// we're doing this, also estimate the point on the
-	// line at the same x,y as the high-terrain-point.
+//=============================================================================
+// HeightMapRenderObjClass::updateLineOfSightPyramid
+//=============================================================================
+/** Builds the max height pyramid of the given map, unless it is already built.
+Level 0 holds the maximum height of the 4 corners of every cell, every next
+level the maximum of 2x2 entries of the level below it. */
+//=============================================================================
+void HeightMapRenderObjClass::updateLineOfSightPyramid(WorldHeightMap *map) const
+{
+	if (map == m_losPyramidMap)
+		return;
 
-	Real fx = pos.x;
-	Real fy = pos.y;
-	Real fz = pos.z;
-	Real fdx = posOther.x - fx;
-	Real fdy = posOther.y - fy;
-	Real fdz = posOther.z - fz;
+	m_losPyramidMap = map;
 
-	// What's the largest step size that will be accurate enough?
-	// Currently we use a step size of about 2 "feet", which
-	// seems acceptable accuracy. If performance here is inadequate,
-	// we can try increasing the step size, but be sure to retest
-	// accuracy.
-	Real len = ceilf(sqrtf(fdx*fdx + fdy*fdy));
-	const Real STEP_LEN = 2.0f;
-	Int numSteps = REAL_TO_INT_CEIL(len / STEP_LEN);
-	if (numSteps < 1) numSteps = 1;
-	Real fnsInv = 1.0f / numSteps;
-	Real fxinc = fdx * fnsInv;
-	Real fyinc = fdy * fnsInv;
-	Real fzinc = fdz * fnsInv;
-	while (numSteps--)
+	const UnsignedByte* data = map->getDataPtr();
+	const Int xExtent = map->getXExtent();
+	Int levelHeight[MAX_LOS_PYRAMID_LEVELS];
+	Int width = xExtent - 1;
+	Int height = map->getYExtent() - 1;
+	Int size = 0;
+	Int level;
+	for (level = 0; level < MAX_LOS_PYRAMID_LEVELS && width > 0 && height > 0; ++level)
 	{
-		Real terrainHeight = getHeightMapHeight( fx, fy, NULL );
+		m_losPyramidOffset[level] = size;
+		m_losPyramidWidth[level] = width;
+		levelHeight[level] = height;
+		size += width*height;
+		width = (width + 1) / 2;
+		height = (height + 1) / 2;
+	}
+	m_losPyramidLevels = level;
+	m_losPyramid.resize(size);
+	if (m_losPyramidLevels == 0)
+		return;
 
-		// if terrainHeight > fz, we can't see, so punt.
-		// add a little fudge to account for slop.
-		const Real LOS_FUDGE = 0.5f;
-		if (terrainHeight > fz + LOS_FUDGE)
+	Int x, y;
+	UnsignedByte *cells = &m_losPyramid[0];
+	for (y = 0; y < levelHeight[0]; ++y)
+	{
+		for (x = 0; x < m_losPyramidWidth[0]; ++x)
 		{
-			return false;
+			Int idx = x + y*xExtent;
+			UnsignedByte cellHeight = data[idx];
+			cellHeight = MAX(cellHeight, data[idx + 1]);
+			cellHeight = MAX(cellHeight, data[idx + xExtent]);
+			cellHeight = MAX(cellHeight, data[idx + xExtent + 1]);
+			cells[x + y*m_losPyramidWidth[0]] = cellHeight;
 		}
+	}
 
-		// we're above the max height of the terrain and still looking up, so we're done.
-		// (don't bother for reverse test, since that doesn't generally happen)
-		if (fz >= getMaxHeight() && fzinc > 0.0f)
+	for (level = 1; level < m_losPyramidLevels; ++level)
+	{
+		const UnsignedByte *below = &m_losPyramid[m_losPyramidOffset[level-1]];
+		const Int belowWidth = m_losPyramidWidth[level-1];
+		const Int belowHeight = levelHeight[level-1];
+		UnsignedByte *blocks = &m_losPyramid[m_losPyramidOffset[level]];
+		for (y = 0; y < levelHeight[level]; ++y)
 		{
-			return true;
+			const Int y0 = 2*y;
+			const Int y1 = MIN(y0 + 1, belowHeight - 1);
+			for (x = 0; x < m_losPyramidWidth[level]; ++x)
+			{
+				const Int x0 = 2*x;
+				const Int x1 = MIN(x0 + 1, belowWidth - 1);
+				UnsignedByte blockHeight = below[x0 + y0*belowWidth];
+				blockHeight = MAX(blockHeight, below[x1 + y0*belowWidth]);
+				blockHeight = MAX(blockHeight, below[x0 + y1*belowWidth]);
+				blockHeight = MAX(blockHeight, below[x1 + y1*belowWidth]);
+				blocks[x + y*m_losPyramidWidth[level]] = blockHeight;
+			}
 		}
-
-		fx += fxinc;
-		fy += fyinc;
-		fz += fzinc;
-
 	}
-
-	return true;
-#endif
 }
 
 //=============================================================================
@@ -2590,6 +3055,8 @@ Int HeightMapRenderObjClass::initHeightData(Int x, Int y, WorldHeightMap *pMap,
 //	Int	vertsPerColumn=y*2-2;
 
 	REF_PTR_SET(m_map,pMap);	//update our heightmap pointer in case it changed since last call.
+	m_staticLightingMap = NULL;	// the heights may have changed, so recalculate the static lighting.
+	m_losPyramidMap = NULL;
 
 	if (m_shroud)
 		m_shroud->init(m_map,TheGlobalData->m_partitionCellSize,TheGlobalData->m_partitionCellSize);
@@ -3445,6 +3912,8 @@ void HeightMapRenderObjClass::staticLightingChanged( void )
 {
 	// Cause the terrain to get updated with new lighting.
 	m_needFullUpdate = true;
+	std::fill(m_staticLighting.begin(), m_staticLighting.end(), 0);
+	m_losPyramidMap = NULL;
 
 	// Cause the scorches to get updated with new lighting.
 	m_scorchesInBuffer = 0; // If we just allocated the buffers, we got no scorches in the buffer.
@@ -3453,6 +3922,65 @@ void HeightMapRenderObjClass::staticLightingChanged( void )
 
 }
 
+//=============================================================================
+// HeightMapRenderObjClass::runRebuildBenchmark
+//=============================================================================
+/** Times rebuilding all terrain blocks and rebuilding a small block, each once
+with the static lighting cache cleared and once with it filled, and prints the
+results. The terrain is rebuilt in full at the end of every run, so that the
+drawn terrain stays correct. */
+//=============================================================================
+void HeightMapRenderObjClass::runRebuildBenchmark(Int repeats)
+{
+	if (m_map == NULL || m_x < 2 || m_y < 2 || repeats <= 0)
+		return;
+
+	// A block of about the size of a height change, in the middle of the drawn area.
+	const Int partialSize = MIN(32, MIN(m_x, m_y) - 1);
+	const Int partialX = (m_x - 1 - partialSize) / 2;
+	const Int partialY = (m_y - 1 - partialSize) / 2;
+	IRegion2D partialRange;
+	partialRange.lo.x = partialX + m_map->getDrawOrgX();
+	partialRange.lo.y = partialY + m_map->getDrawOrgY();
+	partialRange.hi.x = partialRange.lo.x + partialSize;
+	partialRange.hi.y = partialRange.lo.y + partialSize;
+
+	enum { FULL_COLD, FULL_WARM, PARTIAL_COLD, PARTIAL_WARM, REBUILD_COUNT };
+	Int64 ticks[REBUILD_COUNT] = { 0, 0, 0, 0 };
+	Int64 start;
+	for (Int run = 0; run < repeats; ++run)
+	{
+		invalidateStaticLighting(partialRange);
+		start = ProfileUtil::getTime();
+		updateBlock(partialX, partialY, partialX + partialSize, partialY + partialSize, m_map, NULL);
+		ticks[PARTIAL_COLD] += ProfileUtil::getTime() - start;
+
+		start = ProfileUtil::getTime();
+		updateBlock(partialX, partialY, partialX + partialSize, partialY + partialSize, m_map, NULL);
+		ticks[PARTIAL_WARM] += ProfileUtil::getTime() - start;
+
+		staticLightingChanged();
+		start = ProfileUtil::getTime();
+		updateBlock(0, 0, m_x-1, m_y-1, m_map, NULL);
+		ticks[FULL_COLD] += ProfileUtil::getTime() - start;
+
+		start = ProfileUtil::getTime();
+		updateBlock(0, 0, m_x-1, m_y-1, m_map, NULL);
+		ticks[FULL_WARM] += ProfileUtil::getTime() - start;
+	}
+
+	static const char *const rebuildNames[REBUILD_COUNT] = { "full, cold cache", "full, warm cache", "partial, cold cache", "partial, warm cache" };
+	const Int cellCounts[REBUILD_COUNT] = { (m_x-1)*(m_y-1), (m_x-1)*(m_y-1), partialSize*partialSize, partialSize*partialSize };
+	ProfileUtil::print("Terrain rebuild benchmark: %dx%d vertices drawn, %dx%d partial block, %d runs\n",
+		m_x, m_y, partialSize, partialSize, repeats);
+	for (Int i = 0; i < REBUILD_COUNT; ++i)
+	{
+		const double ms = ProfileUtil::ticksToMilliseconds(ticks[i]) / repeats;
+		ProfileUtil::print("  %-20s %9.3f ms per rebuild, %7.1f ns per cell\n",
+			rebuildNames[i], ms, ms * 1000000.0 / cellCounts[i]);
+	}
+}
+
 //=============================================================================
 // HeightMapRenderObjClass::setTimeOfDay
 //=============================================================================
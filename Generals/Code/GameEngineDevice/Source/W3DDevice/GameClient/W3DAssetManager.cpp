@@ -65,8 +65,20 @@
 #include "ffactory.h"
 #include "font3d.h"
 #include "render2dsentence.h"
+#include "chunkio.h"
+#include "htree.h"
+#include "htreemgr.h"
+#include "hanimmgr.h"
+#include "RAMFILE.h"
+#include "thread.h"
+#include "mutex.h"
+#include "w3d_file.h"
+#include "W3DDevice/GameClient/W3DFileSystem.h"
+#include "Common/FileSystem.h"
+#include "Common/file.h"
 #include "Common/PerfTimer.h"
 #include "Common/GlobalData.h"
+#include "Common/STLTypedefs.h"
 
 
 //---------------------------------------------------------------------
@@ -137,18 +149,262 @@ RenderObjClass * W3DPrototypeClass::Create(void)
 	return (RenderObjClass *)( SET_REF_OWNER( Proto->Clone() ) );
 }
 
+//---------------------------------------------------------------------
+// W3DAssetPreloader
+//---------------------------------------------------------------------
+
+//---------------------------------------------------------------------
+// TheSuperHackers @performance Reads queued .w3d files and parses their hierarchy trees on worker threads.
+// A job is taken by whichever thread gets to it first, lowest priority first. The main thread reads
+// jobs itself while it waits for the one it needs next.
+//---------------------------------------------------------------------
+class W3DAssetPreloader
+{
+public:
+
+	enum JobState
+	{
+		JOB_PENDING,
+		JOB_READING,
+		JOB_READY,
+	};
+
+	struct Job
+	{
+		AsciiString filename;
+		char path[_MAX_PATH];							///< resolved on the main thread, empty if the file is missing
+		Int priority;
+		Int sequence;
+		volatile LONG state;
+		char *data;													///< file contents, NULL if the file is missing
+		Int size;
+		std::vector<HTreeClass *> trees;		///< trees parsed on the worker, not added to the manager yet
+	};
+
+	typedef std::vector<Job *> JobList;
+
+	W3DAssetPreloader();
+	~W3DAssetPreloader();
+
+	void queue(const char * filename, Int priority);
+	void waitForJob(Job * job);
+	void releaseJob(Job * job);
+
+	// Returns the queued jobs in the order they should be turned into prototypes.
+	JobList getJobsByPriority() const;
+
+	void readJobs(volatile bool & running);
+
+private:
+
+	class ReaderThreadClass : public ThreadClass
+	{
+	public:
+		ReaderThreadClass(W3DAssetPreloader * preloader) : ThreadClass("W3D asset preloader thread"), Preloader(preloader) {}
+		void Thread_Function() { Preloader->readJobs(running); }
+	private:
+		W3DAssetPreloader * Preloader;
+	};
+
+	struct JobIsLater
+	{
+		bool operator()(const Job * a, const Job * b) const
+		{
+			if (a->priority != b->priority)
+				return a->priority > b->priority;
+			return a->sequence > b->sequence;
+		}
+	};
+
+	typedef std::hash_map<AsciiString, Job *, rts::hash<AsciiString>, rts::equal_to<AsciiString> > JobMap;
+
+	enum { THREAD_COUNT = 2 };
+
+	Job * takePendingJob();
+	void readJob(Job * job);
+
+	JobList m_jobs;								///< all jobs in queue order, main thread only
+	JobMap m_jobsByName;					///< main thread only
+	JobList m_pendingJobs;				///< heap of the jobs not taken yet, guarded by m_mutex
+	FastCriticalSectionClass m_mutex;
+	ReaderThreadClass * m_threads[THREAD_COUNT];
+};
+
+//---------------------------------------------------------------------
+W3DAssetPreloader::W3DAssetPreloader()
+{
+	for (Int i = 0; i < THREAD_COUNT; ++i) {
+		m_threads[i] = NEW ReaderThreadClass(this);
+		m_threads[i]->Execute();
+	}
+}
+
+//---------------------------------------------------------------------
+W3DAssetPreloader::~W3DAssetPreloader()
+{
+	for (Int i = 0; i < THREAD_COUNT; ++i) {
+		m_threads[i]->Stop();
+		delete m_threads[i];
+	}
+
+	for (JobList::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it) {
+		releaseJob(*it);
+		delete *it;
+	}
+}
+
+//---------------------------------------------------------------------
+void W3DAssetPreloader::queue(const char * filename, Int priority)
+{
+	AsciiString name(filename);
+	name.toLower();
+
+	// The first request decides the priority, that is the closest drawable that uses the model.
+	if (m_jobsByName.find(name) != m_jobsByName.end())
+		return;
+
+	Job * job = NEW Job;
+	job->filename = filename;
+	job->priority = priority;
+	job->sequence = (Int)m_jobs.size();
+	job->state = JOB_PENDING;
+	job->data = NULL;
+	job->size = 0;
+
+	// GameFileClass::Set_Name copies the shared language string, so the path is resolved here and the
+	// readers only open the plain path.
+	GameFileClass file(filename);
+	if (file.Is_Available())
+		strlcpy(job->path, file.File_Path(), ARRAY_SIZE(job->path));
+	else
+		job->path[0] = '\0';
+
+	m_jobs.push_back(job);
+	m_jobsByName[name] = job;
+
+	FastCriticalSectionClass::LockClass lock(m_mutex);
+	m_pendingJobs.push_back(job);
+	std::push_heap(m_pendingJobs.begin(), m_pendingJobs.end(), JobIsLater());
+}
+
+//---------------------------------------------------------------------
+W3DAssetPreloader::JobList W3DAssetPreloader::getJobsByPriority() const
+{
+	JobList jobs(m_jobs);
+	std::sort(jobs.begin(), jobs.end(), JobIsLater());
+	std::reverse(jobs.begin(), jobs.end());
+	return jobs;
+}
+
+//---------------------------------------------------------------------
+W3DAssetPreloader::Job * W3DAssetPreloader::takePendingJob()
+{
+	FastCriticalSectionClass::LockClass lock(m_mutex);
+	while (!m_pendingJobs.empty()) {
+		std::pop_heap(m_pendingJobs.begin(), m_pendingJobs.end(), JobIsLater());
+		Job * job = m_pendingJobs.back();
+		m_pendingJobs.pop_back();
+
+		// The main thread may have taken this job out of order already.
+		if (InterlockedCompareExchange(&job->state, JOB_READING, JOB_PENDING) == JOB_PENDING)
+			return job;
+	}
+	return NULL;
+}
+
+//---------------------------------------------------------------------
+void W3DAssetPreloader::readJob(Job * job)
+{
+	File * file = job->path[0] ? TheFileSystem->openFile(job->path, File::READ | File::BINARY) : NULL;
+	if (file) {
+		job->size = file->size();
+		job->data = MSGNEW("W3DAssetPreloader") char[job->size];
+		if (file->read(job->data, job->size) != job->size) {
+			delete [] job->data;
+			job->data = NULL;
+			job->size = 0;
+		}
+		file->close();
+	}
+
+	if (job->data) {
+		// Hierarchy trees do not depend on anything else, so they can be parsed here already.
+		RAMFileClass ramfile(job->data, job->size);
+		ramfile.Open();
+		ChunkLoadClass cload(&ramfile);
+		while (cload.Open_Chunk()) {
+			if (cload.Cur_Chunk_ID() == W3D_CHUNK_HIERARCHY) {
+				HTreeClass * tree = W3DNEW HTreeClass;
+				if (tree->Load_W3D(cload) == HTreeClass::OK)
+					job->trees.push_back(tree);
+				else
+					delete tree;
+			}
+			cload.Close_Chunk();
+		}
+		ramfile.Close();
+	}
+
+	InterlockedExchange(&job->state, JOB_READY);
+}
+
+//---------------------------------------------------------------------
+void W3DAssetPreloader::readJobs(volatile bool & running)
+{
+	while (running) {
+		Job * job = takePendingJob();
+		if (job)
+			readJob(job);
+		else
+			ThreadClass::Switch_Thread();
+	}
+}
+
+//---------------------------------------------------------------------
+void W3DAssetPreloader::waitForJob(Job * job)
+{
+	if (InterlockedCompareExchange(&job->state, JOB_READING, JOB_PENDING) == JOB_PENDING) {
+		readJob(job);
+		return;
+	}
+
+	// A worker is reading this job, help with the others meanwhile.
+	while (job->state != JOB_READY) {
+		Job * other = takePendingJob();
+		if (other)
+			readJob(other);
+		else
+			ThreadClass::Switch_Thread();
+	}
+}
+
+//---------------------------------------------------------------------
+void W3DAssetPreloader::releaseJob(Job * job)
+{
+	for (std::vector<HTreeClass *>::iterator it = job->trees.begin(); it != job->trees.end(); ++it)
+		delete *it;
+	job->trees.clear();
+
+	delete [] job->data;
+	job->data = NULL;
+	job->size = 0;
+}
+
 //---------------------------------------------------------------------
 // W3DAssetManager
 //---------------------------------------------------------------------
 
 //---------------------------------------------------------------------
-W3DAssetManager::W3DAssetManager(void)
+W3DAssetManager::W3DAssetManager(void) :
+	m_preloader(NULL),
+	m_preloadPriority(0)
 {
 }
 
 //---------------------------------------------------------------------
 W3DAssetManager::~W3DAssetManager(void)
 {
+	delete m_preloader;
 }
 
 #ifdef DUMP_PERF_STATS
@@ -927,6 +1183,25 @@ void W3DAssetManager::Recolor_Vertex_Material(VertexMaterialClass *vmat, const i
 	vmat->Set_Diffuse(rgb2);
 }
 
+#if defined(RTS_DEBUG)
+//---------------------------------------------------------------------
+static void reportPreloadedAsset( const char * filename )
+{
+	if (TheGlobalData->m_preloadReport)
+	{
+		//loading a new asset and app is requesting a log of all loaded assets.
+		FILE *logfile=fopen("PreloadedAssets.txt","a+");	//append to log
+		if (logfile)
+		{
+			StringClass lower_case_name(filename,true);
+			_strlwr(lower_case_name.Peek_Buffer());
+			fprintf(logfile,"3D: %s\n",lower_case_name.str());
+			fclose(logfile);
+		}
+	}
+}
+#endif
+
 #ifdef DUMP_PERF_STATS
 __int64 Total_Load_3D_Assets=0;
 static Int Load_3D_Asset_Recursions=0;
@@ -963,18 +1238,8 @@ bool W3DAssetManager::Load_3D_Assets( const char * filename )
 	bool result = WW3DAssetManager::Load_3D_Assets(filename);
 
 #if defined(RTS_DEBUG)
-	if (result && TheGlobalData->m_preloadReport)
-	{
-		//loading a new asset and app is requesting a log of all loaded assets.
-		FILE *logfile=fopen("PreloadedAssets.txt","a+");	//append to log
-		if (logfile)
-		{
-			StringClass lower_case_name(filename,true);
-			_strlwr(lower_case_name.Peek_Buffer());
-			fprintf(logfile,"3D: %s\n",lower_case_name.str());
-			fclose(logfile);
-		}
-	}
+	if (result)
+		reportPreloadedAsset(filename);
 #endif
 #ifdef DUMP_PERF_STATS
 	if (Load_3D_Asset_Recursions == 1)
@@ -987,6 +1252,107 @@ bool W3DAssetManager::Load_3D_Assets( const char * filename )
 
 }
 
+//---------------------------------------------------------------------
+static bool isPrototypeLoaded( WW3DAssetManager * manager, const char * filename )
+{
+	char basename[512];
+	strlcpy(basename, filename, ARRAY_SIZE(basename));
+	char *pext = strrchr(basename, '.');	//find file extension
+	if (pext)
+		*pext = '\0';	//drop the extension
+	return manager->Find_Prototype(basename) != NULL;
+}
+
+//---------------------------------------------------------------------
+void W3DAssetManager::beginPreload(void)
+{
+	if (m_preloader == NULL)
+		m_preloader = NEW W3DAssetPreloader;
+	m_preloadPriority = 0;
+}
+
+//---------------------------------------------------------------------
+void W3DAssetManager::setPreloadPriority(Int priority)
+{
+	m_preloadPriority = priority;
+}
+
+//---------------------------------------------------------------------
+void W3DAssetManager::queuePreload(const char * filename)
+{
+	if (m_preloader == NULL)
+	{
+		Load_3D_Assets(filename);
+		return;
+	}
+
+	if (!isPrototypeLoaded(this, filename))
+		m_preloader->queue(filename, m_preloadPriority);
+}
+
+//---------------------------------------------------------------------
+void W3DAssetManager::endPreload(void)
+{
+	if (m_preloader == NULL)
+		return;
+
+	// Loads made while the prototypes are added, such as the hierarchy of an animation, are done right away.
+	W3DAssetPreloader *preloader = m_preloader;
+	m_preloader = NULL;
+
+	W3DAssetPreloader::JobList jobs = preloader->getJobsByPriority();
+	for (W3DAssetPreloader::JobList::iterator it = jobs.begin(); it != jobs.end(); ++it)
+	{
+		W3DAssetPreloader::Job *job = *it;
+		preloader->waitForJob(job);
+
+		if (job->data == NULL)
+		{
+			WWDEBUG_SAY(("Missing asset '%s'.", job->filename.str()));
+		}
+		else if (!isPrototypeLoaded(this, job->filename.str()))
+		{
+			// The prototypes are only ever added here on the main thread, so Find_Prototype needs no lock.
+			for (std::vector<HTreeClass *>::iterator tit = job->trees.begin(); tit != job->trees.end(); ++tit)
+				HTreeManager.Add_Tree(*tit);
+			job->trees.clear();
+
+			RAMFileClass ramfile(job->data, job->size);
+			ramfile.Open();
+			ChunkLoadClass cload(&ramfile);
+			while (cload.Open_Chunk())
+			{
+				switch (cload.Cur_Chunk_ID())
+				{
+					case W3D_CHUNK_HIERARCHY:
+						// already parsed on the worker thread
+						break;
+
+					case W3D_CHUNK_ANIMATION:
+					case W3D_CHUNK_COMPRESSED_ANIMATION:
+					case W3D_CHUNK_MORPH_ANIMATION:
+						HAnimManager.Load_Anim(cload);
+						break;
+
+					default:
+						Load_Prototype(cload);
+						break;
+				}
+				cload.Close_Chunk();
+			}
+			ramfile.Close();
+
+#if defined(RTS_DEBUG)
+			reportPreloadedAsset(job->filename.str());
+#endif
+		}
+
+		preloader->releaseJob(job);
+	}
+
+	delete preloader;
+}
+
 #ifdef DUMP_PERF_STATS
 __int64 Total_Get_HAnim_Time=0;
 static Int HAnim_Recursions=0;
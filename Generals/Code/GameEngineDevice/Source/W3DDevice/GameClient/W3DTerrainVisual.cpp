@@ -689,6 +689,14 @@ void W3DTerrainVisual::setShoreLineDetail(void)
 		m_terrainRenderObject->setShoreLineDetail();
 }
 
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DTerrainVisual::runRebuildBenchmark( Int repeats )
+{
+	if( m_terrainRenderObject )
+		m_terrainRenderObject->runRebuildBenchmark( repeats );
+}
+
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 /// Replace the skybox texture
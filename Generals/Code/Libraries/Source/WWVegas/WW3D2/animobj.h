@@ -209,6 +209,10 @@ protected:
 
 	};
 
+	// TheSuperHackers @performance Channel cursors of the single animation, so that objects which play
+	// the same compressed animation at different frames don't invalidate each other's channel caches.
+	HAnimCursorClass				AnimCursor;
+
 	friend class SkinClass;
 };
 
@@ -262,7 +266,7 @@ inline void Animatable3DObjClass::Anim_Update(const Matrix3D & root,HAnimClass *
 			HTree->Anim_Update_Without_Interpolation(root,(HRawAnimClass*)motion,frame);
 		else
 #endif
-			HTree->Anim_Update(root,motion,frame);
+			HTree->Anim_Update(root,motion,frame,&AnimCursor);
 	}
 	Set_Hierarchy_Valid(true);
 }
@@ -38,6 +38,7 @@
  *   HTreeManagerClass::Free -- de-allocate all memory in use                                  *
  *   HTreeManagerClass::Free_All_Trees -- de-allocates all hierarchy trees currently loaded    *
  *   HTreeManagerClass::Load_Tree -- load a hierarchy tree from a file                         *
+ *   HTreeManagerClass::Add_Tree -- adds an externally loaded hierarchy tree to the manager    *
  *   HTreeManagerClass::Get_Tree_ID -- look up the ID of a named hierarchy tree                *
  *   HTreeManagerClass::Get_Tree -- get a pointer to the specified hierarchy tree              *
  *   HTreeManagerClass::Get_Tree -- get a pointer to the specified hierarchy tree              *
@@ -192,17 +193,11 @@ int HTreeManagerClass::Load_Tree(ChunkLoadClass & cload)
 		delete newtree;
 		goto Error;
 
-	} else if (Get_Tree_ID(newtree->Get_Name()) != -1) {
+	} else if (!Add_Tree(newtree)) {
 
-		// tree with this name already exists, reject it!
-		delete newtree;
+		// tree with this name already exists, it was rejected
 		goto Error;
 
-	} else {
-
-		// ok, accept this hierarchy tree!
-		TreePtr[NumTrees] = newtree;
-		NumTrees++;
 	}
 
 	return 0;
@@ -213,6 +208,37 @@ Error:
 
 }
 
+/***********************************************************************************************
+ * HTreeManagerClass::Add_Tree -- adds an externally loaded hierarchy tree to the manager      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *  The manager takes ownership of the tree, it is deleted if a tree with this name already    *
+ *  exists.                                                                                    *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *   10/18/2026 TheSuperHackers : Split out of Load_Tree.                                      *
+ *=============================================================================================*/
+bool HTreeManagerClass::Add_Tree(HTreeClass * newtree)
+{
+	if (Get_Tree_ID(newtree->Get_Name()) != -1) {
+
+		// tree with this name already exists, reject it!
+		delete newtree;
+		return false;
+
+	}
+
+	// ok, accept this hierarchy tree!
+	TreePtr[NumTrees] = newtree;
+	NumTrees++;
+
+	return true;
+}
+
 /***********************************************************************************************
  * HTreeManagerClass::Get_Tree_ID -- look up the ID of a named hierarchy tree                  *
  *                                                                                             *
@@ -62,6 +62,7 @@ public:
 	~HTreeManagerClass(void);
 
 	int							Load_Tree(ChunkLoadClass & cload);
+	bool							Add_Tree(HTreeClass * newtree);
 	int							Num_Trees(void) { return NumTrees; }
 	HTreeClass *				Get_Tree(const char * name);
 	HTreeClass *				Get_Tree(int id);
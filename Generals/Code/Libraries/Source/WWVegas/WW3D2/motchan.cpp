@@ -402,13 +402,18 @@ bool TimeCodedMotionChannelClass::Load_W3D(ChunkLoadClass & cload)
  *   08/11/1997 GH  : Created.                                                                 *
  *=============================================================================================*/
 void	TimeCodedMotionChannelClass::Get_Vector(float32 frame,float * setvec)
+{
+	Get_Vector(frame, setvec, CachedIdx);
+}
+
+void	TimeCodedMotionChannelClass::Get_Vector(float32 frame,float * setvec,uint32 & cursor) const
 {
 
   uint32	tc0;
 
   tc0 = frame;
 
-  uint32 pidx = get_index( tc0 );
+  uint32 pidx = get_index( tc0, cursor );
   uint32 p2idx;
 
   if (pidx == ((NumTimeCodes - 1) * PacketSize))  {
@@ -456,6 +461,11 @@ void	TimeCodedMotionChannelClass::Get_Vector(float32 frame,float * setvec)
 
 
 Quaternion TimeCodedMotionChannelClass::Get_QuatVector(float32 frame)
+{
+	return Get_QuatVector(frame, CachedIdx);
+}
+
+Quaternion TimeCodedMotionChannelClass::Get_QuatVector(float32 frame, uint32 & cursor) const
 {
 
 	assert(VectorLen == 4);
@@ -466,7 +476,7 @@ Quaternion TimeCodedMotionChannelClass::Get_QuatVector(float32 frame)
 
 	tc0 = frame;
 
-	uint32 pidx = get_index( tc0 );
+	uint32 pidx = get_index( tc0, cursor );
 	uint32 p2idx;
 
 	if (pidx == ((NumTimeCodes - 1) * PacketSize))  {
@@ -528,7 +538,7 @@ Quaternion TimeCodedMotionChannelClass::Get_QuatVector(float32 frame)
  *   01/27/2000 JGA  : Created.                                                                *
  *=============================================================================================*/
 // New version that uses a binary search, and no cache
-uint32 TimeCodedMotionChannelClass::binary_search_index(uint32 timecode)
+uint32 TimeCodedMotionChannelClass::binary_search_index(uint32 timecode) const
 {
 	int leftIdx = 0;
 	int rightIdx = NumTimeCodes - 2;
@@ -597,32 +607,33 @@ uint32 TimeCodedMotionChannelClass::binary_search_index(uint32 timecode)
  * HISTORY:                                                                                    *
  *   01/27/2000 JGA  : Created.                                                                *
  *=============================================================================================*/
-uint32 TimeCodedMotionChannelClass::get_index(uint32 timecode)
+uint32 TimeCodedMotionChannelClass::get_index(uint32 timecode, uint32 & cursor) const
 {
-	assert(CachedIdx <= LastTimeCodeIdx);
+	// TheSuperHackers @performance The cursor can come from an object that played another animation before.
+	if (cursor > LastTimeCodeIdx) cursor = 0;
 
 	uint32	time;
 
-	time = Data[CachedIdx] & ~W3D_TIMECODED_BINARY_MOVEMENT_FLAG;
+	time = Data[cursor] & ~W3D_TIMECODED_BINARY_MOVEMENT_FLAG;
 
 	if (timecode >= time) {
 		// possibly in the current packet
 
 		// special case for end packets
-		if (CachedIdx == LastTimeCodeIdx) return(CachedIdx);
-		time = Data[CachedIdx + PacketSize]	& ~W3D_TIMECODED_BINARY_MOVEMENT_FLAG;
-		if (timecode < time) return(CachedIdx);
+		if (cursor == LastTimeCodeIdx) return(cursor);
+		time = Data[cursor + PacketSize]	& ~W3D_TIMECODED_BINARY_MOVEMENT_FLAG;
+		if (timecode < time) return(cursor);
 
 		// Do one time look-ahead before reverting to a search
-		CachedIdx+=PacketSize;
-		if (CachedIdx == LastTimeCodeIdx) return(CachedIdx);
-		time = Data[CachedIdx + PacketSize]	& ~W3D_TIMECODED_BINARY_MOVEMENT_FLAG;
-		if (timecode < time) return(CachedIdx);
+		cursor+=PacketSize;
+		if (cursor == LastTimeCodeIdx) return(cursor);
+		time = Data[cursor + PacketSize]	& ~W3D_TIMECODED_BINARY_MOVEMENT_FLAG;
+		if (timecode < time) return(cursor);
 	}
 
-	CachedIdx = binary_search_index( timecode );
+	cursor = binary_search_index( timecode );
 
-	return(CachedIdx);
+	return(cursor);
 
 }
 
@@ -219,6 +219,12 @@ public:
 
 	Quaternion Get_QuatVector(float32 frame);
 
+	// Same as above, but the packet lookup starts at and updates the given cursor instead of
+	// the cache of this channel, which is shared by every object that plays the animation.
+	void	Get_Vector(float32 frame, float * setvec, uint32 & cursor) const;
+
+	Quaternion Get_QuatVector(float32 frame, uint32 & cursor) const;
+
 private:
 
 	uint32	PivotIdx;			// what pivot is this channel applied to
@@ -235,8 +241,8 @@ private:
 
 	void 		Free(void);
 	void 		set_identity(float * setvec);
-	uint32	get_index(uint32 timecode);
-	uint32	binary_search_index(uint32 timecode);
+	uint32	get_index(uint32 timecode, uint32 & cursor) const;
+	uint32	binary_search_index(uint32 timecode) const;
 
 	friend class HCompressedAnimClass;
 };
@@ -173,6 +173,8 @@ public:
 	void getSaveGameInfoFromFile( AsciiString filename, SaveGameInfo *saveGameInfo );		///< get save game info from file
 
 	void friend_xferSaveDataForCRC( Xfer *xfer, SnapshotType which );		///< This should only be called to DeepCRC sanity checking
+	void friend_saveCheckpoint( Xfer *xfer );										///< This should only be called by the replay checkpoints
+	Bool friend_loadCheckpoint( Xfer *xfer );										///< This should only be called by the replay checkpoints, after the engine was reset
 
 	Bool isInLoadGame(void) { return m_isInLoadGame; } // Brutal hack to allow bone pos validation while loading games
 
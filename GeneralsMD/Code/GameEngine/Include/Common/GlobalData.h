@@ -351,6 +351,17 @@ public:
 
 	std::vector<AsciiString> m_simulateReplays; ///< If not empty, simulate this list of replays and exit.
 	Int m_simulateReplayJobs; ///< Maximum number of processes to use for simulation, or SIMULATE_REPLAYS_SEQUENTIAL for sequential simulation
+	AsciiString m_benchmarkLoadMap; ///< If not empty, load this map a number of times, print the load phase timings and exit.
+	Int m_benchmarkLoadRuns; ///< How many times to load the map of m_benchmarkLoadMap
+	Int m_replayCheckpointInterval; ///< If not 0, keep a compressed checkpoint of the game state every this many frames during replay playback
+	Int m_replayFlushPolicy; ///< When the recorded replay commands are flushed to the file, one of AsyncFileWriter::FlushPolicy
+	Bool m_verifyReplayCheckpoints; ///< Seek back to the previous checkpoint at each new one and check that the game state reaches the same CRC again
+	Bool m_benchmarkFrameTime; ///< Time the client and logic part of every update and print the frame time distribution when a game ends
+	Bool m_benchmarkGameText; ///< Print the load time of the string file and the throughput of fetching its strings at startup
+	AsciiString m_benchmarkReplaysFile; ///< If not empty, write the logic frame times and update phase times of each simulated replay to this JSON file
+	AsciiString m_traceFile; ///< If not empty, record the trace zones and stream them to this Chrome trace file
+	AsciiString m_listReplays; ///< If not empty, print the replays of this wildcard that match m_replayFilter and exit.
+	AsciiString m_replayFilter; ///< If not empty, only list or simulate the replays whose header matches this filter
 
 	Int m_maxParticleCount;						///< maximum number of particles that can exist
 	Int m_maxFieldParticleCount;			///< maximum number of field-type particles that can exist (roughly)
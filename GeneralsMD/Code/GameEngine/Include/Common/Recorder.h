@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "Common/AsyncFileWriter.h"
 #include "Common/MessageStream.h"
 #include "GameNetwork/GameInfo.h"
 
@@ -84,6 +85,11 @@ public:
 #endif
 	Bool isPlaybackInProgress() const;
 
+	// TheSuperHackers @feature 18/10/2026 Replay checkpoints, see -replayCheckpoints.
+	void updateCheckpoints();													///< Call between two logic frames of a playback. Keeps a checkpoint every so many frames.
+	Bool seekToFrame(UnsignedInt frame);							///< Restores the nearest checkpoint at or before the frame and simulates the frames up to it.
+	UnsignedInt getCheckpointMismatchCount() const { return m_checkpointMismatchCount; }
+
 public:
 	void handleCRCMessage(UnsignedInt newCRC, Int playerIndex, Bool fromPlayback);
 protected:
@@ -112,6 +118,7 @@ public:
 		Int localPlayerIndex;
 	};
 	Bool readReplayHeader( ReplayHeader& header );
+	static Bool readReplayHeaderFields( File *file, ReplayHeader& header ); ///< Reads the header fields without the GameInfo. Does not use TheRecorder, so any thread can call it.
 
 	RecorderModeType getMode();												///< Returns the current operating mode.
 	Bool isPlaybackMode() const { return m_mode == RECORDERMODETYPE_PLAYBACK || m_mode == RECORDERMODETYPE_SIMULATION_PLAYBACK; }
@@ -143,8 +150,8 @@ protected:
 	void logGameStart(AsciiString options);
 	void logGameEnd( void );
 
-	AsciiString readAsciiString();										///< Read the next string from m_file using ascii characters.
-	UnicodeString readUnicodeString();								///< Read the next string from m_file using unicode characters.
+	static AsciiString readAsciiString(File *file);		///< Read the next string from the file using ascii characters.
+	static UnicodeString readUnicodeString(File *file);	///< Read the next string from the file using unicode characters.
 	void readNextFrame();															///< Read the next frame number to execute a command on.
 	void appendNextCommand();													///< Read the next GameMessage and append it to TheCommandList.
 	void writeArgument(GameMessageArgumentDataType type, const GameMessageArgumentType arg);
@@ -158,7 +165,17 @@ protected:
 
 	CullBadCommandsResult cullBadCommands(); ///< prevent the user from giving mouse commands that he shouldn't be able to do during playback.
 
+	struct Checkpoint;
+	typedef std::vector<Checkpoint *> CheckpointList;
+
+	void takeCheckpoint();														///< Save the game state of the current frame into a new checkpoint.
+	Bool restoreCheckpoint(const Checkpoint &checkpoint);	///< Reset the game and load the checkpoint. Returns FALSE if the playback had to stop.
+	const Checkpoint *findCheckpoint(UnsignedInt frame) const;	///< Returns the last checkpoint at or before the frame, or NULL.
+	void clearCheckpoints();
+	Bool openPlaybackFile(ReplayHeader &header);			///< Opens the replay like readReplayHeader() and moves it into memory, keeping the file position.
+
 	File* m_file;
+	AsyncFileWriter m_writer;												///< Appends the recorded commands to m_file on a background thread
 	AsciiString m_fileName;
 	Int m_currentFilePosition;
 	RecorderModeType m_mode;
@@ -174,6 +191,10 @@ protected:
 	Int m_originalGameMode; // valid in replays
 
 	UnsignedInt m_nextFrame;												///< The Frame that the next message is to be executed on.  This can be -1.
+
+	CheckpointList m_checkpoints;										///< Sorted by frame
+	UnsignedInt m_checkpointInterval;								///< Frames between two checkpoints, doubles whenever the list is thinned out
+	UnsignedInt m_checkpointMismatchCount;					///< Seeks that did not reach the CRC of the straight playback
 };
 
 extern RecorderClass *TheRecorder;
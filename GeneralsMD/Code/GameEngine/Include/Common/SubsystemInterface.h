@@ -31,6 +31,7 @@
 
 #include "Common/INI.h"
 #include "Common/STLTypedefs.h"
+#include "Common/Tracer.h"
 
 class Xfer;
 
@@ -128,8 +129,8 @@ protected:
 	Bool m_dumpUpdate;
 	Bool m_dumpDraw;
 #else
-	inline void UPDATE(void) {update();}
-	inline void DRAW(void) {draw();}
+	inline void UPDATE(void) {TRACE_SCOPE(m_name.str()); update();}
+	inline void DRAW(void) {TRACE_SCOPE(m_name.str()); draw();}
 #endif
 protected:
 	AsciiString m_name;
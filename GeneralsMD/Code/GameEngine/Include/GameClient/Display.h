@@ -167,6 +167,9 @@ public:
 #endif
 	virtual void preloadModelAssets( AsciiString model ) = 0;	///< preload model asset
 	virtual void preloadTextureAssets( AsciiString texture ) = 0;	///< preload texture asset
+	virtual void beginModelAssetPreload( void ) { }	///< queue the following model preloads and read them in the background
+	virtual void setModelAssetPreloadPriority( Int priority ) { }	///< queued model preloads with lower priorities are loaded first
+	virtual void endModelAssetPreload( void ) { }	///< finish loading all queued model preloads
 
 	virtual void takeScreenShot(void) = 0;										///< saves screenshot to a file
 	virtual void toggleMovieCapture(void) = 0;							///< starts saving frames to an avi or frame sequence
@@ -58,6 +58,9 @@ class UnicodeString;
 //----------------------------------------------------------------------------
 typedef std::vector<AsciiString> AsciiStringVec;
 
+typedef Int GameTextKey;		///< key of a label of the game string file, see GameTextInterface::findKey
+enum { GAMETEXTKEY_INVALID = -1 };
+
 //===============================
 // GameTextInterface
 //===============================
@@ -76,6 +79,10 @@ class GameTextInterface : public SubsystemInterface
 		virtual UnicodeString fetch( AsciiString label, Bool *exists = NULL ) = 0;		///< Returns the associated labeled unicode text ; TheSuperHackers @todo Remove
 		virtual UnicodeString fetchFormat( const Char *label, ... ) = 0;
 
+		// TheSuperHackers @performance 18/10/2026 Resolve a label once and fetch it by its key from then on.
+		virtual GameTextKey findKey( const Char *label ) = 0;		///< Returns the key of a label of the game string file, or GAMETEXTKEY_INVALID
+		virtual UnicodeString fetchByKey( GameTextKey key, Bool *exists = NULL ) = 0;		///< Returns the unicode text of a key from findKey
+
 		// Do not call this directly, but use the FETCH_OR_SUBSTITUTE macro
 		virtual UnicodeString fetchOrSubstitute( const Char *label, const WideChar *substituteText ) = 0;
 		virtual UnicodeString fetchOrSubstituteFormat( const Char *label, const WideChar *substituteFormat, ... ) = 0;
@@ -102,6 +109,38 @@ class GameTextInterface : public SubsystemInterface
 extern GameTextInterface *TheGameText;
 extern GameTextInterface* CreateGameTextInterface( void );
 
+//===============================
+// StaticGameTextLabel
+//===============================
+/** A label that is fetched again and again, like the text of a display that updates often. It
+	* resolves its key on the first fetch and skips the label look up afterwards.
+	*/
+//===============================
+
+class StaticGameTextLabel
+{
+	public:
+
+		StaticGameTextLabel( const Char *label ) : m_label( label ), m_key( GAMETEXTKEY_INVALID ) {}
+
+		UnicodeString fetch( void )
+		{
+			if ( m_key == GAMETEXTKEY_INVALID )
+				m_key = TheGameText->findKey( m_label );
+
+			// labels of the map string file have no key
+			if ( m_key == GAMETEXTKEY_INVALID )
+				return TheGameText->fetch( m_label );
+
+			return TheGameText->fetchByKey( m_key );
+		}
+
+	private:
+
+		const Char		*m_label;
+		GameTextKey		m_key;
+};
+
 //----------------------------------------------------------------------------
 //           Inlining
 //----------------------------------------------------------------------------
@@ -304,6 +304,9 @@ public:
 
 
 
+	/// Time the rebuild of the terrain render data and print it, for -benchmarkTerrainRebuild.
+	virtual void runRebuildBenchmark( Int repeats ) { }
+
 	/// Replace the skybox texture
 	virtual void replaceSkyboxTextures(const AsciiString *oldTexName[NumSkyboxTextures], const AsciiString *newTexName[NumSkyboxTextures])=0;
 
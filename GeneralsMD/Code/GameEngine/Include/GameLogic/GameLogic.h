@@ -231,6 +231,7 @@ public:
 	void timeOutGameStart( void );
 	void initTimeOutValues( void );
 	UnsignedInt getObjectCount( void );
+	UnsignedInt getFrameAllocationCount( void ) const { return m_frameAllocationCount; }	///< memory allocations made by the last logic update
 
 	Int getRankLevelLimit() const { return m_rankLevelLimit; }
 	void setRankLevelLimit(Int limit)
@@ -306,6 +307,7 @@ private:
 
 	Real m_width, m_height;																	///< Dimensions of the world
 	UnsignedInt m_frame;																		///< Simulation frame number
+	UnsignedInt m_frameAllocationCount;											///< Memory allocations made by the last update
 
 	// CRC cache system -----------------------------------------------------------------------------
 	UnsignedInt	m_CRC;																			///< Cache of previous CRC value
@@ -675,6 +675,7 @@ protected:
 
 	void addThreat();
 	void removeThreat();
+	Bool canKeepThreatOrValue( const SightingInfo *lastAffect, UnsignedInt data );
 
 	virtual void reactToTransformChange(const Matrix3D* oldMtx, const Coord3D* oldPos, Real oldAngle);
 
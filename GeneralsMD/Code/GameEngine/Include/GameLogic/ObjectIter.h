@@ -152,3 +152,67 @@ public:
 	*/
 	Int getCount() { return m_clumpCount; }
 };
+
+
+//-------------------------------------------------------------------------------------------
+/**
+	A list of objects, with their numeric values, that the PartitionManager range queries
+	write into. Unlike a SimpleObjectIterator it is owned by the caller and keeps its
+	storage when it is emptied, so a query into a buffer that was used before does not
+	allocate. Borrow one from the PartitionManager with ObjectRangeBufferHolder.
+
+	typical usage:
+
+	ObjectRangeBufferHolder buffer;
+	ThePartitionManager->getObjectsInRange(pos, range, FROM_CENTER_2D, buffer, filters);
+	for (Int i = 0; i < buffer->getCount(); ++i)
+	{
+		Object *otherObject = buffer->getObject(i);
+		// do something with other
+	}
+*/
+class ObjectRangeBuffer
+{
+public:
+
+	/**
+		throw away all contents of the buffer, but not its storage.
+	*/
+	void makeEmpty() { m_entries.clear(); }
+
+	/**
+		add an object in the same way as SimpleObjectIterator::insert. as with the iterator,
+		the objects come out in the reverse order of insertion until sort() is called.
+	*/
+	void insert(Object *obj, Real numeric = 0.0f);
+
+	/**
+		put the objects into the order that a SimpleObjectIterator filled with the same
+		insert() calls iterates in after its own sort(), including ITER_FASTEST.
+	*/
+	void sort(IterOrderType order);
+
+	Int getCount() const { return (Int)m_entries.size(); }
+	Object *getObject(Int i) const { return m_entries[i].m_obj; }
+	Real getNumeric(Int i) const { return m_entries[i].m_numeric; }
+
+private:
+
+	struct Entry
+	{
+		Object	*m_obj;
+		Real		m_numeric;	// typically, dist-squared
+	};
+	typedef std::vector<Entry> EntryVec;
+
+	typedef Real (*EntryCompareProc)(const Entry &a, const Entry &b);
+	static EntryCompareProc theEntryCompareProcs[];
+
+	static Real sortNearToFar(const Entry &a, const Entry &b);
+	static Real sortFarToNear(const Entry &a, const Entry &b);
+	static Real sortCheapToExpensive(const Entry &a, const Entry &b);
+	static Real sortExpensiveToCheap(const Entry &a, const Entry &b);
+
+	EntryVec	m_entries;
+	EntryVec	m_scratch;	///< merge space for sort(), kept to avoid allocations
+};
@@ -30,6 +30,8 @@
 
 #include "Common/FramePacer.h"
 #include "Common/GameEngine.h"
+#include "Common/LoadProfiler.h"
+#include "Common/ReplayIndex.h"
 #include "Common/ReplaySimulation.h"
 
 
@@ -49,6 +51,14 @@ Int GameMain()
 	{
 		exitcode = ReplaySimulation::simulateReplays(TheGlobalData->m_simulateReplays, TheGlobalData->m_simulateReplayJobs);
 	}
+	else if (TheGlobalData->m_benchmarkLoadMap.isNotEmpty())
+	{
+		exitcode = LoadProfiler::benchmarkLoad(TheGlobalData->m_benchmarkLoadMap, TheGlobalData->m_benchmarkLoadRuns);
+	}
+	else if (TheGlobalData->m_listReplays.isNotEmpty())
+	{
+		exitcode = ReplayIndex::listReplays(TheGlobalData->m_listReplays, TheGlobalData->m_replayFilter);
+	}
 	else
 	{
 		// run it
@@ -31,6 +31,9 @@
 #include "Common/Player.h"
 #include "Common/GlobalData.h"
 #include "Common/GameEngine.h"
+#include "Common/GameState.h"
+#include "Common/XferMemory.h"
+#include "GameClient/GameClient.h"
 #include "GameClient/ClientInstance.h"
 #include "GameClient/GameWindow.h"
 #include "GameClient/GameWindowManager.h"
@@ -47,6 +50,7 @@
 #include "Common/CRCDebug.h"
 #include "Common/UserPreferences.h"
 #include "Common/version.h"
+#include "Compression.h"
 
 constexpr const char s_genrep[] = "GENREP";
 constexpr const UnsignedInt replayBufferBytes = 8192;
@@ -76,6 +80,10 @@ void RecorderClass::logGameStart(AsciiString options)
 	if (!m_file)
 		return;
 
+	// TheSuperHackers @performance 18/10/2026 Write out the recorded commands before patching the header,
+	// so that the file size is right and the writer thread does not touch the file meanwhile.
+	m_writer.flush();
+
 	time(&startTime);
 	UnsignedInt fileSize = m_file->size();
 	// move to appropriate offset
@@ -133,6 +141,8 @@ void RecorderClass::logPlayerDisconnect(UnicodeString player, Int slot)
 	if (!m_file)
 		return;
 
+	m_writer.flush();
+
 	DEBUG_ASSERTCRASH((slot >= 0) && (slot < MAX_SLOTS), ("Attempting to disconnect an invalid slot number"));
 	if ((slot < 0) || (slot >= (MAX_SLOTS)))
 	{
@@ -184,6 +194,8 @@ void RecorderClass::logCRCMismatch( void )
 	if (!m_file)
 		return;
 
+	m_writer.flush();
+
 	UnsignedInt fileSize = m_file->size();
 	// move to appropriate offset
 	if ( m_file->seek(desyncOffset, File::seekMode::START) == desyncOffset )
@@ -230,6 +242,8 @@ void RecorderClass::logGameEnd( void )
 	if (!m_file)
 		return;
 
+	m_writer.flush();
+
 	time_t t;
 	time(&t);
 	UnsignedInt frameCount = TheGameLogic->getFrame();
@@ -285,6 +299,8 @@ void RecorderClass::logGameEnd( void )
 
 void RecorderClass::cleanUpReplayFile( void )
 {
+	m_writer.flush();
+
 #if defined(RTS_DEBUG)
 	if (TheGlobalData->m_saveStats)
 	{
@@ -375,6 +391,8 @@ RecorderClass::RecorderClass()
 	m_nextFrame = 0;
 	m_wasDesync = FALSE;
 	//
+	m_checkpointInterval = 0;
+	m_checkpointMismatchCount = 0;
 
 	init(); // just for the heck of it.
 }
@@ -383,6 +401,7 @@ RecorderClass::RecorderClass()
  * Destructor
  */
 RecorderClass::~RecorderClass() {
+	clearCheckpoints();
 }
 
 /**
@@ -417,11 +436,13 @@ void RecorderClass::init() {
  * Reset the recorder to the "initialized state."
  */
 void RecorderClass::reset() {
+	m_writer.close();
 	if (m_file != NULL) {
 		m_file->close();
 		m_file = NULL;
 	}
 	m_fileName.clear();
+	clearCheckpoints();
 
 	init();
 }
@@ -538,7 +559,8 @@ void RecorderClass::updateRecord()
 
 	if (needFlush) {
 		DEBUG_ASSERTCRASH(m_file != NULL, ("RecorderClass::updateRecord() - unexpected call to fflush(m_file)"));
-		m_file->flush();
+		// TheSuperHackers @performance 18/10/2026 The writer thread flushes the commands of this frame, see -replayFlush.
+		m_writer.commit();
 	}
 }
 
@@ -713,6 +735,9 @@ void RecorderClass::startRecording(GameDifficulty diff, Int originalGameMode, In
 	*/
 
 	/// @todo Need to write game options when there are some to be written.
+
+	// TheSuperHackers @performance 18/10/2026 From here on the commands go through the writer thread.
+	m_writer.open(m_file, (AsyncFileWriter::FlushPolicy)TheGlobalData->m_replayFlushPolicy);
 }
 
 /**
@@ -730,6 +755,7 @@ void RecorderClass::stopRecording() {
 			m_wasDesync = FALSE;
 		}
 	}
+	m_writer.close();
 	if (m_file != NULL) {
 		m_file->close();
 		m_file = NULL;
@@ -771,19 +797,21 @@ void RecorderClass::archiveReplay(AsciiString fileName)
 
 /**
  * Write this game message to the record file. This also writes the game message's execution frame.
+ * TheSuperHackers @performance 18/10/2026 The message is serialized into the memory of m_writer, which
+ * appends it to the file on a background thread. The bytes in the file are the same as before.
  */
 void RecorderClass::writeToFile(GameMessage * msg) {
 	// Write the frame number for this command.
 	UnsignedInt frame = TheGameLogic->getFrame();
-	m_file->write(&frame, sizeof(frame));
+	m_writer.write(&frame, sizeof(frame));
 
 	// Write the command type
 	GameMessage::Type type = msg->getType();
-	m_file->write(&type, sizeof(type));
+	m_writer.write(&type, sizeof(type));
 
 	// Write the player index
 	Int playerIndex = msg->getPlayerIndex();
-	m_file->write(&playerIndex, sizeof(playerIndex));
+	m_writer.write(&playerIndex, sizeof(playerIndex));
 
 #ifdef DEBUG_LOGGING
 	AsciiString commandName = msg->getCommandAsString();
@@ -804,15 +832,15 @@ void RecorderClass::writeToFile(GameMessage * msg) {
 
 	GameMessageParser *parser = newInstance(GameMessageParser)(msg);
 	UnsignedByte numTypes = parser->getNumTypes();
-	m_file->write(&numTypes, sizeof(numTypes));
+	m_writer.write(&numTypes, sizeof(numTypes));
 
 	GameMessageParserArgumentType *argType = parser->getFirstArgumentType();
 	while (argType != NULL) {
 		UnsignedByte type = (UnsignedByte)(argType->getType());
-		m_file->write(&type, sizeof(type));
+		m_writer.write(&type, sizeof(type));
 
 		UnsignedByte argTypeCount = (UnsignedByte)(argType->getArgCount());
-		m_file->write(&argTypeCount, sizeof(argTypeCount));
+		m_writer.write(&argTypeCount, sizeof(argTypeCount));
 
 		argType = argType->getNext();
 	}
@@ -838,37 +866,37 @@ void RecorderClass::writeArgument(GameMessageArgumentDataType type, const GameMe
 	switch (type) {
 
 		case ARGUMENTDATATYPE_INTEGER:
-			m_file->write( &(arg.integer), sizeof(arg.integer) );
+			m_writer.write( &(arg.integer), sizeof(arg.integer) );
 			break;
 		case ARGUMENTDATATYPE_REAL:
-			m_file->write( &(arg.real), sizeof(arg.real) );
+			m_writer.write( &(arg.real), sizeof(arg.real) );
 			break;
 		case ARGUMENTDATATYPE_BOOLEAN:
-			m_file->write( &(arg.boolean), sizeof(arg.boolean) );
+			m_writer.write( &(arg.boolean), sizeof(arg.boolean) );
 			break;
 		case ARGUMENTDATATYPE_OBJECTID:
-			m_file->write( &(arg.objectID), sizeof(arg.objectID) );
+			m_writer.write( &(arg.objectID), sizeof(arg.objectID) );
 			break;
 		case ARGUMENTDATATYPE_DRAWABLEID:
-			m_file->write( &(arg.drawableID), sizeof(arg.drawableID) );
+			m_writer.write( &(arg.drawableID), sizeof(arg.drawableID) );
 			break;
 		case ARGUMENTDATATYPE_TEAMID:
-			m_file->write( &(arg.teamID), sizeof(arg.teamID) );
+			m_writer.write( &(arg.teamID), sizeof(arg.teamID) );
 			break;
 		case ARGUMENTDATATYPE_LOCATION:
-			m_file->write( &(arg.location), sizeof(arg.location) );
+			m_writer.write( &(arg.location), sizeof(arg.location) );
 			break;
 		case ARGUMENTDATATYPE_PIXEL:
-			m_file->write( &(arg.pixel), sizeof(arg.pixel) );
+			m_writer.write( &(arg.pixel), sizeof(arg.pixel) );
 			break;
 		case ARGUMENTDATATYPE_PIXELREGION:
-			m_file->write( &(arg.pixelRegion), sizeof(arg.pixelRegion) );
+			m_writer.write( &(arg.pixelRegion), sizeof(arg.pixelRegion) );
 			break;
 		case ARGUMENTDATATYPE_TIMESTAMP:
-			m_file->write( &(arg.timestamp), sizeof(arg.timestamp) );
+			m_writer.write( &(arg.timestamp), sizeof(arg.timestamp) );
 			break;
 		case ARGUMENTDATATYPE_WIDECHAR:
-			m_file->write( &(arg.wChar), sizeof(arg.wChar) );
+			m_writer.write( &(arg.wChar), sizeof(arg.wChar) );
 			break;
 		default:
 			DEBUG_LOG(("Unknown GameMessageArgumentDataType in RecorderClass::writeArgument"));
@@ -895,47 +923,14 @@ Bool RecorderClass::readReplayHeader(ReplayHeader& header)
 		return FALSE;
 	}
 
-	// Read the GENREP header.
-	char genrep[sizeof(s_genrep) - 1] = {0};
-	m_file->read( &genrep, sizeof(s_genrep) - 1 );
-	if ( strncmp(genrep, s_genrep, sizeof(s_genrep) - 1 ) ) {
+	if (!readReplayHeaderFields(m_file, header)) {
 		DEBUG_LOG(("RecorderClass::readReplayHeader - replay file did not have GENREP at the start."));
 		m_file->close();
 		m_file = NULL;
 		return FALSE;
 	}
 
-	// read in some stats
-	replay_time_t tmp;
-	m_file->read(&tmp, sizeof(tmp));
-	header.startTime = tmp;
-	m_file->read(&tmp, sizeof(tmp));
-	header.endTime = tmp;
-
-	m_file->read(&header.frameCount, sizeof(header.frameCount));
-
-	m_file->read(&header.desyncGame, sizeof(header.desyncGame));
-	m_file->read(&header.quitEarly, sizeof(header.quitEarly));
-	for (Int i=0; i<MAX_SLOTS; ++i)
-	{
-		m_file->read(&(header.playerDiscons[i]), sizeof(Bool));
-	}
-
-	// Read the Replay Name.  We don't actually do anything with it.  Oh well.
-	header.replayName = readUnicodeString();
-
-	// Read the date and time.  We don't really do anything with this either. Oh well.
-	m_file->read(&header.timeVal, sizeof(header.timeVal));
-
-	// Read in the Version info
-	header.versionString = readUnicodeString();
-	header.versionTimeString = readUnicodeString();
-	m_file->read(&header.versionNumber, sizeof(header.versionNumber));
-	m_file->read(&header.exeCRC, sizeof(header.exeCRC));
-	m_file->read(&header.iniCRC, sizeof(header.iniCRC));
-
 	// Read in the GameInfo
-	header.gameOptions = readAsciiString();
 	m_gameInfo.reset();
 	m_gameInfo.enterGame();
 	DEBUG_LOG(("RecorderClass::readReplayHeader - GameInfo = %s", header.gameOptions.str()));
@@ -948,8 +943,6 @@ Bool RecorderClass::readReplayHeader(ReplayHeader& header)
 	}
 	m_gameInfo.startGame(0);
 
-	AsciiString playerIndex = readAsciiString();
-	header.localPlayerIndex = atoi(playerIndex.str());
 	if (header.localPlayerIndex < -1 || header.localPlayerIndex >= MAX_SLOTS)
 	{
 		DEBUG_LOG(("RecorderClass::readReplayHeader - invalid local slot number."));
@@ -976,6 +969,56 @@ Bool RecorderClass::readReplayHeader(ReplayHeader& header)
 	return TRUE;
 }
 
+/**
+ * TheSuperHackers @performance 18/10/2026 Read the fields of a replay header up to the local player index.
+ * This only uses the given file, so that the replay index can read many headers in parallel.
+ */
+Bool RecorderClass::readReplayHeaderFields(File *file, ReplayHeader& header)
+{
+	// Read the GENREP header.
+	char genrep[sizeof(s_genrep) - 1] = {0};
+	file->read( &genrep, sizeof(s_genrep) - 1 );
+	if ( strncmp(genrep, s_genrep, sizeof(s_genrep) - 1 ) ) {
+		return FALSE;
+	}
+
+	// read in some stats
+	replay_time_t tmp;
+	file->read(&tmp, sizeof(tmp));
+	header.startTime = tmp;
+	file->read(&tmp, sizeof(tmp));
+	header.endTime = tmp;
+
+	file->read(&header.frameCount, sizeof(header.frameCount));
+
+	file->read(&header.desyncGame, sizeof(header.desyncGame));
+	file->read(&header.quitEarly, sizeof(header.quitEarly));
+	for (Int i=0; i<MAX_SLOTS; ++i)
+	{
+		file->read(&(header.playerDiscons[i]), sizeof(Bool));
+	}
+
+	// Read the Replay Name.  We don't actually do anything with it.  Oh well.
+	header.replayName = readUnicodeString(file);
+
+	// Read the date and time.  We don't really do anything with this either. Oh well.
+	file->read(&header.timeVal, sizeof(header.timeVal));
+
+	// Read in the Version info
+	header.versionString = readUnicodeString(file);
+	header.versionTimeString = readUnicodeString(file);
+	file->read(&header.versionNumber, sizeof(header.versionNumber));
+	file->read(&header.exeCRC, sizeof(header.exeCRC));
+	file->read(&header.iniCRC, sizeof(header.iniCRC));
+
+	// Read in the GameInfo string, it is parsed by the caller.
+	header.gameOptions = readAsciiString(file);
+
+	AsciiString playerIndex = readAsciiString(file);
+	header.localPlayerIndex = atoi(playerIndex.str());
+	return TRUE;
+}
+
 Bool RecorderClass::simulateReplay(AsciiString filename)
 {
 	Bool success = playbackFile(filename);
@@ -1084,6 +1127,288 @@ UnsignedInt CRCInfo::readCRC(void)
 	return val;
 }
 
+/**
+ * TheSuperHackers @feature 18/10/2026
+ * A replay checkpoint holds the compressed save game of one frame of a playback, together with
+ * everything the save game does not hold but the playback needs to continue from that frame.
+ */
+struct RecorderClass::Checkpoint
+{
+	struct PendingCRC
+	{
+		UnsignedInt crc;
+		Bool isPlayback;
+		Int playerIndex;
+	};
+
+	Checkpoint(const CRCInfo &info) : crcInfo(info) {}
+
+	UnsignedInt frame;
+	Int filePosition;																///< where the replay file continues after m_nextFrame
+	UnsignedInt nextFrame;
+	UnsignedInt randomState[6];											///< the save game does not hold the logic random generator
+	UnsignedInt crc;																///< the logic CRC at the checkpoint, to verify seeks
+	CRCInfo crcInfo;																///< the local CRCs that wait for their replay CRCs
+	std::vector<PendingCRC> pendingCRCs;						///< the MSG_LOGIC_CRC messages waiting in TheCommandList
+	std::vector<UnsignedByte> data;									///< the compressed save game
+};
+
+static const size_t maxReplayCheckpoints = 64;
+static const CompressionType replayCheckpointCompression = COMPRESSION_ZLIB1;
+
+void RecorderClass::clearCheckpoints()
+{
+	for (CheckpointList::iterator it = m_checkpoints.begin(); it != m_checkpoints.end(); ++it)
+		delete *it;
+	m_checkpoints.clear();
+}
+
+const RecorderClass::Checkpoint *RecorderClass::findCheckpoint(UnsignedInt frame) const
+{
+	const Checkpoint *found = NULL;
+	for (CheckpointList::const_iterator it = m_checkpoints.begin(); it != m_checkpoints.end(); ++it)
+	{
+		if ((*it)->frame > frame)
+			break;
+		found = *it;
+	}
+	return found;
+}
+
+void RecorderClass::takeCheckpoint()
+{
+	XferMemorySave xfer;
+	xfer.open("ReplayCheckpoint");
+	try
+	{
+		TheGameState->friend_saveCheckpoint(&xfer);
+	}
+	catch (...)
+	{
+		DEBUG_CRASH(("RecorderClass::takeCheckpoint - Cannot save the game state of frame %d", TheGameLogic->getFrame()));
+		xfer.close();
+		return;
+	}
+	xfer.close();
+
+	Checkpoint *checkpoint = NEW Checkpoint(*m_crcInfo);
+	checkpoint->frame = TheGameLogic->getFrame();
+	checkpoint->filePosition = m_file->position();
+	checkpoint->nextFrame = m_nextFrame;
+	GetGameLogicRandomState(checkpoint->randomState);
+	checkpoint->crc = TheGameLogic->getCRC(CRC_RECALC);
+
+	for (GameMessage *msg = TheCommandList->getFirstMessage(); msg != NULL; msg = msg->next())
+	{
+		if (msg->getType() == GameMessage::MSG_LOGIC_CRC)
+		{
+			Checkpoint::PendingCRC pending;
+			pending.crc = msg->getArgument(0)->integer;
+			pending.isPlayback = msg->getArgument(1)->boolean;
+			pending.playerIndex = msg->getPlayerIndex();
+			checkpoint->pendingCRCs.push_back(pending);
+		}
+	}
+
+	// Compress into a scratch buffer, so that the checkpoint holds no more than the compressed size.
+	// Keep the data uncompressed if it does not compress.
+	const Int maxSize = CompressionManager::getMaxCompressedSize(xfer.getDataSize(), replayCheckpointCompression);
+	std::vector<UnsignedByte> compressed(maxSize);
+	const Int size = CompressionManager::compressData(replayCheckpointCompression,
+		(void *)xfer.getData(), xfer.getDataSize(), &compressed[0], maxSize);
+	if (size > 0)
+		checkpoint->data.assign(compressed.begin(), compressed.begin() + size);
+	else
+		checkpoint->data.assign(xfer.getData(), xfer.getData() + xfer.getDataSize());
+
+	DEBUG_LOG(("RecorderClass::takeCheckpoint - Frame %d, %d bytes compressed to %d, CRC %8.8X",
+		checkpoint->frame, xfer.getDataSize(), (Int)checkpoint->data.size(), checkpoint->crc));
+
+	CheckpointList::iterator it = m_checkpoints.begin();
+	while (it != m_checkpoints.end() && (*it)->frame < checkpoint->frame)
+		++it;
+	m_checkpoints.insert(it, checkpoint);
+
+	// When the list is full, keep every second checkpoint and take them half as often from now on.
+	// This keeps the checkpoints spread over the whole playback. Wait for a frame that survives the
+	// thinning, so that the newest checkpoint is always kept.
+	if (m_checkpoints.size() > maxReplayCheckpoints && checkpoint->frame % (2 * m_checkpointInterval) == 0)
+	{
+		m_checkpointInterval *= 2;
+
+		CheckpointList kept;
+		for (it = m_checkpoints.begin(); it != m_checkpoints.end(); ++it)
+		{
+			if ((*it)->frame % m_checkpointInterval == 0)
+				kept.push_back(*it);
+			else
+				delete *it;
+		}
+		m_checkpoints.swap(kept);
+	}
+
+	// Each checkpoint is a full save game including the map, so keep an eye on the total.
+	size_t checkpointBytes = 0;
+	for (it = m_checkpoints.begin(); it != m_checkpoints.end(); ++it)
+		checkpointBytes += (*it)->data.size();
+	DEBUG_LOG(("RecorderClass::takeCheckpoint - %d checkpoints hold %d bytes",
+		(Int)m_checkpoints.size(), (Int)checkpointBytes));
+}
+
+Bool RecorderClass::restoreCheckpoint(const Checkpoint &checkpoint)
+{
+	// Decompress first, the engine reset below cannot be undone.
+	std::vector<UnsignedByte> uncompressed;
+	const UnsignedByte *data = &checkpoint.data[0];
+	Int dataSize = (Int)checkpoint.data.size();
+	if (CompressionManager::isDataCompressed(data, dataSize))
+	{
+		uncompressed.resize(CompressionManager::getUncompressedSize(data, dataSize));
+		const Int size = CompressionManager::decompressData((void *)data, dataSize, &uncompressed[0], (Int)uncompressed.size());
+		if (size != (Int)uncompressed.size())
+		{
+			DEBUG_CRASH(("RecorderClass::restoreCheckpoint - Cannot decompress the checkpoint of frame %d", checkpoint.frame));
+			return FALSE;
+		}
+		data = &uncompressed[0];
+		dataSize = size;
+	}
+
+	// Keep what the engine reset clears. The checkpoints and m_crcInfo are left alone.
+	const AsciiString filename = m_currentReplayFilename;
+	const RecorderModeType mode = m_mode;
+	const Int originalGameMode = m_originalGameMode;
+	const UnsignedInt playbackFrameCount = m_playbackFrameCount;
+	CheckpointList checkpoints;
+	checkpoints.swap(m_checkpoints);
+
+	TheGameEngine->reset();
+
+	m_checkpoints.swap(checkpoints);
+
+	// Start the playback again where the checkpoint left the replay file, like playbackFile() does.
+	m_mode = mode;
+	ReplayHeader header;
+	header.forPlayback = TRUE;
+	header.filename = filename;
+	Bool success = openPlaybackFile(header);
+	if (success)
+	{
+		m_originalGameMode = originalGameMode;
+		m_playbackFrameCount = playbackFrameCount;
+		m_currentReplayFilename = filename;
+		m_file->seek(checkpoint.filePosition, File::START);
+		m_nextFrame = checkpoint.nextFrame;
+
+		TheCommandList->reset();
+
+		XferMemoryLoad xfer(data, dataSize);
+		xfer.open("ReplayCheckpoint");
+		success = TheGameState->friend_loadCheckpoint(&xfer);
+		xfer.close();
+	}
+
+	if (!success)
+	{
+		DEBUG_CRASH(("RecorderClass::restoreCheckpoint - Cannot load the checkpoint of frame %d", checkpoint.frame));
+
+		// Clear it out like a failed GameState::loadGame(), this also stops the playback.
+		if (TheGameLogic->isInGame())
+			TheGameLogic->clearGameData(FALSE);
+		TheGameEngine->reset();
+		return FALSE;
+	}
+
+	SetGameLogicRandomState(checkpoint.randomState);
+
+	const Bool sawCRCMismatch = m_crcInfo->sawCRCMismatch();
+	*m_crcInfo = checkpoint.crcInfo;
+	if (sawCRCMismatch)
+		m_crcInfo->setSawCRCMismatch();
+
+	for (size_t i = 0; i < checkpoint.pendingCRCs.size(); ++i)
+	{
+		const Checkpoint::PendingCRC &pending = checkpoint.pendingCRCs[i];
+		GameMessage *msg = newInstance(GameMessage)(GameMessage::MSG_LOGIC_CRC);
+		msg->friend_setPlayerIndex(pending.playerIndex);
+		msg->appendIntegerArgument(pending.crc);
+		msg->appendBooleanArgument(pending.isPlayback);
+		TheCommandList->appendMessage(msg);
+	}
+
+	DEBUG_LOG(("RecorderClass::restoreCheckpoint - Restored frame %d", checkpoint.frame));
+	return TRUE;
+}
+
+void RecorderClass::updateCheckpoints()
+{
+	if (m_checkpointInterval == 0 || m_doingAnalysis || !isPlaybackInProgress())
+		return;
+
+	if (!TheGameLogic->isInGame() || TheGameLogic->isLoadingMap())
+		return;
+
+	const UnsignedInt frame = TheGameLogic->getFrame();
+	if (frame == 0 || frame % m_checkpointInterval != 0)
+		return;
+
+	const Checkpoint *existing = findCheckpoint(frame);
+	if (existing != NULL && existing->frame == frame)
+	{
+		// We got here again after a seek, so the game state must be the same as the first time.
+		if (TheGlobalData->m_verifyReplayCheckpoints)
+		{
+			const UnsignedInt crc = TheGameLogic->getCRC(CRC_RECALC);
+			if (crc != existing->crc)
+			{
+				++m_checkpointMismatchCount;
+				DEBUG_LOG(("Replay checkpoint mismatch in frame %d, Seek:%8.8X Playback:%8.8X", frame, crc, existing->crc));
+
+				// Print Mismatch in case we are simulating replays from console.
+				printf("Checkpoint Mismatch in Frame %d\n", frame);
+				fflush(stdout);
+			}
+		}
+		return;
+	}
+
+	takeCheckpoint();
+
+	if (TheGlobalData->m_verifyReplayCheckpoints && m_checkpoints.size() >= 2)
+	{
+		// Seek back to the previous checkpoint. The playback then simulates the frames up to
+		// this one again and compares the CRC above.
+		restoreCheckpoint(*m_checkpoints[m_checkpoints.size() - 2]);
+	}
+}
+
+Bool RecorderClass::seekToFrame(UnsignedInt frame)
+{
+	if (m_doingAnalysis || !isPlaybackInProgress())
+		return FALSE;
+
+	// Restore a checkpoint unless simulating from the current frame is the shortest way.
+	const UnsignedInt currentFrame = TheGameLogic->getFrame();
+	const Checkpoint *checkpoint = findCheckpoint(frame);
+	if (frame < currentFrame || (checkpoint != NULL && checkpoint->frame > currentFrame))
+	{
+		if (checkpoint == NULL || !restoreCheckpoint(*checkpoint))
+			return FALSE;
+	}
+
+	// Simulate the gap without drawing it.
+	while (TheGameLogic->getFrame() < frame && isPlaybackInProgress())
+	{
+		updateCheckpoints();
+		TheGameClient->updateHeadless();
+		if (m_mode == RECORDERMODETYPE_PLAYBACK)
+			TheMessageStream->propagateMessages();
+		TheGameLogic->UPDATE();
+	}
+
+	return TheGameLogic->getFrame() == frame;
+}
+
 Bool RecorderClass::sawCRCMismatch() const
 {
 	return m_crcInfo->sawCRCMismatch();
@@ -1185,6 +1510,23 @@ Bool RecorderClass::replayMatchesGameVersion(const ReplayHeader& header)
 	return true;
 }
 
+/**
+ * TheSuperHackers @performance 18/10/2026 Read the commands from memory instead of issuing a small
+ * file read for every command and argument. The strings of the header are read before, because a
+ * RAMFile cannot read single characters. Positions stay file offsets, as the replay checkpoints need.
+ */
+Bool RecorderClass::openPlaybackFile(ReplayHeader &header)
+{
+	if (!readReplayHeader(header))
+		return FALSE;
+
+	const Int position = m_file->position();
+	m_file->seek(0, File::START);
+	m_file = m_file->convertToRAMFile();
+	m_file->seek(position, File::START);
+	return TRUE;
+}
+
 /**
  * Start playback of the file. Return true or false depending on if the file is
  * a valid replay file or not.
@@ -1204,7 +1546,7 @@ Bool RecorderClass::playbackFile(AsciiString filename)
 	ReplayHeader header;
 	header.forPlayback = TRUE;
 	header.filename = filename;
-	Bool success = readReplayHeader( header );
+	Bool success = openPlaybackFile( header );
 	if (!success)
 	{
 		return FALSE;
@@ -1313,17 +1655,21 @@ Bool RecorderClass::playbackFile(AsciiString filename)
 
 	m_currentReplayFilename = filename;
 	m_playbackFrameCount = header.frameCount;
+
+	clearCheckpoints();
+	m_checkpointInterval = TheGlobalData->m_replayCheckpointInterval;
+	m_checkpointMismatchCount = 0;
 	return TRUE;
 }
 
 /**
  * Read a unicode string from the current file position. The string is assumed to be 0-terminated.
  */
-UnicodeString RecorderClass::readUnicodeString() {
+UnicodeString RecorderClass::readUnicodeString(File *file) {
 	WideChar str[1024] = L"";
 	Int index = 0;
 
-	Int c = m_file->readWideChar();
+	Int c = file->readWideChar();
 	if (c == EOF) {
 		str[index] = 0;
 	}
@@ -1331,7 +1677,7 @@ UnicodeString RecorderClass::readUnicodeString() {
 
 	while (index < 1024 && str[index] != 0) {
 		++index;
-		Int c = m_file->readWideChar();
+		Int c = file->readWideChar();
 		if (c == EOF) {
 			str[index] = 0;
 			break;
@@ -1347,11 +1693,11 @@ UnicodeString RecorderClass::readUnicodeString() {
 /**
  * Read an ascii string from the current file position. The string is assumed to be 0-terminated.
  */
-AsciiString RecorderClass::readAsciiString() {
+AsciiString RecorderClass::readAsciiString(File *file) {
 	char str[1024] = "";
 	Int index = 0;
 
-	Int c =	m_file->readChar();
+	Int c =	file->readChar();
 	if (c == EOF) {
 		str[index] = 0;
 	}
@@ -1359,7 +1705,7 @@ AsciiString RecorderClass::readAsciiString() {
 
 	while (index < 1024 && str[index] != 0) {
 		++index;
-		Int c = m_file->readChar();
+		Int c = file->readChar();
 		if (c == EOF) {
 			str[index] = 0;
 			break;
@@ -1335,6 +1335,62 @@ void GameState::friend_xferSaveDataForCRC( Xfer *xfer, SnapshotType which )
 	xferSaveData(xfer, which);
 }
 
+// ------------------------------------------------------------------------------------------------
+/** TheSuperHackers @feature 18/10/2026 Save a replay checkpoint. Like a normal save, but without
+	* a description and without any messages to the user */
+// ------------------------------------------------------------------------------------------------
+void GameState::friend_saveCheckpoint( Xfer *xfer )
+{
+	SaveGameInfo *gameInfo = getSaveGameInfo();
+	gameInfo->description.clear();
+	gameInfo->saveFileType = SAVE_FILE_TYPE_NORMAL;
+	gameInfo->missionMapName.clear();
+
+	xferSaveData( xfer, SNAPSHOT_SAVELOAD );
+}
+
+// ------------------------------------------------------------------------------------------------
+/** TheSuperHackers @feature 18/10/2026 Load a replay checkpoint. This is the part of loadGame()
+	* that follows the engine reset. Returns FALSE on error, the caller must clean up the game then */
+// ------------------------------------------------------------------------------------------------
+Bool GameState::friend_loadCheckpoint( Xfer *xfer )
+{
+	// the embedded map is extracted to the save directory, make sure it exists
+	CreateDirectory( getSaveDirectory().str(), NULL );
+
+	// the map of the previous checkpoint is no longer needed
+	TheGameStateMap->clearScratchPadMaps();
+
+	// lock creation of new ghost objects
+	TheGhostObjectManager->saveLockGhostObjects( TRUE );
+
+	LatchRestore<Bool> inLoadGame(m_isInLoadGame, TRUE);
+
+	Bool error = FALSE;
+	try
+	{
+		xferSaveData( xfer, SNAPSHOT_SAVELOAD );
+	}
+	catch( ... )
+	{
+		error = TRUE;
+	}
+
+	// un-savelock the ghost objects
+	TheGhostObjectManager->saveLockGhostObjects( FALSE );
+
+	try
+	{
+		gameStatePostProcessLoad();
+	}
+	catch( ... )
+	{
+		error = TRUE;
+	}
+
+	return !error;
+}
+
 // ------------------------------------------------------------------------------------------------
 /** Save game to xfer or load game using xfer */
 // ------------------------------------------------------------------------------------------------
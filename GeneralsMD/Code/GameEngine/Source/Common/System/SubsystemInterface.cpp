@@ -70,7 +70,10 @@ void SubsystemInterface::UPDATE(void)
 	GetPrecisionTimerTicksPerSec(&freq64);
 	GetPrecisionTimer(&startTime64);
 	m_startTimeConsumed = s_msConsumed;
-	update();
+	{
+		TRACE_SCOPE(m_name.str());
+		update();
+	}
 	GetPrecisionTimer(&endTime64);
 	m_curUpdateTime = ((double)(endTime64-startTime64))/((double)(freq64));
 	Real subTime = s_msConsumed - m_startTimeConsumed;
@@ -96,7 +99,10 @@ void SubsystemInterface::DRAW(void)
 	GetPrecisionTimerTicksPerSec(&freq64);
 	GetPrecisionTimer(&startTime64);
 	m_startDrawTimeConsumed = s_msConsumed;
-	draw();
+	{
+		TRACE_SCOPE(m_name.str());
+		draw();
+	}
 	GetPrecisionTimer(&endTime64);
 	m_curDrawTime = ((double)(endTime64-startTime64))/((double)(freq64));
 	Real subTime = s_msConsumed - m_startDrawTimeConsumed;
@@ -36,6 +36,7 @@
 #include "Common/GameEngine.h"
 #include "Common/GameState.h"
 #include "Common/Recorder.h"
+#include "Common/ReplayIndex.h"
 #include "Common/version.h"
 #include "GameClient/WindowLayout.h"
 #include "GameClient/Gadget.h"
@@ -105,6 +106,22 @@ UnicodeString GetReplayFilenameFromListbox(GameWindow *listbox, Int index)
 
 //-------------------------------------------------------------------------------------------------
 
+static Bool parseReplayMapInfo(const RecorderClass::ReplayHeader &header, ReplayGameInfo &info, const MapMetaData *&mapData)
+{
+	if (ParseAsciiStringToGameInfo(&info, header.gameOptions))
+	{
+		if (TheMapCache != NULL)
+			mapData = TheMapCache->findMap(info.getMap());
+		else
+			mapData = NULL;
+
+		return true;
+	}
+	return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+
 static Bool readReplayMapInfo(const AsciiString& filename, RecorderClass::ReplayHeader &header, ReplayGameInfo &info, const MapMetaData *&mapData)
 {
 	header.forPlayback = FALSE;
@@ -112,15 +129,7 @@ static Bool readReplayMapInfo(const AsciiString& filename, RecorderClass::Replay
 
 	if (TheRecorder != NULL && TheRecorder->readReplayHeader(header))
 	{
-		if (ParseAsciiStringToGameInfo(&info, header.gameOptions))
-		{
-			if (TheMapCache != NULL)
-				mapData = TheMapCache->findMap(info.getMap());
-			else
-				mapData = NULL;
-
-			return true;
-		}
+		return parseReplayMapInfo(header, info, mapData);
 	}
 	return false;
 }
@@ -274,17 +283,33 @@ void PopulateReplayFileListbox(GameWindow *listbox)
 
 	TheMapCache->updateCache();
 
+	// TheSuperHackers @performance 18/10/2026 Takes the replay headers from the replay index, which reads
+	// only the new or changed replays again, in parallel, instead of opening every replay each time.
+	std::vector<AsciiString> replayNames;
+	replayNames.reserve(replayFilenames.size());
 	for (it = replayFilenames.begin(); it != replayFilenames.end(); ++it)
 	{
 		// just want the filename
-		asciistr.set((*it).reverseFind('\\') + 1);
+		replayNames.push_back(AsciiString((*it).reverseFind('\\') + 1));
+	}
 
-		RecorderClass::ReplayHeader header;
+	ReplayIndex replayIndex;
+	replayIndex.load();
+	replayIndex.update(replayNames);
+	replayIndex.save();
+
+	for (size_t nameIndex = 0; nameIndex < replayNames.size(); ++nameIndex)
+	{
+		asciistr = replayNames[nameIndex];
+
+		const RecorderClass::ReplayHeader *indexedHeader = replayIndex.findHeader(asciistr);
 		ReplayGameInfo info;
 		const MapMetaData *mapData;
 
-		if (readReplayMapInfo(asciistr, header, info, mapData))
+		if (indexedHeader != NULL && parseReplayMapInfo(*indexedHeader, info, mapData))
 		{
+			const RecorderClass::ReplayHeader &header = *indexedHeader;
+
 			// columns are: name, date, version, map, extra
 
 			// name
@@ -84,6 +84,7 @@
 #include "GameLogic/GhostObject.h"
 #include "GameLogic/Object.h"
 #include "GameLogic/ScriptEngine.h"		// For TheScriptEngine - jkmcd
+#include "GameLogic/TerrainLogic.h"
 
 #define DRAWABLE_HASH_SIZE	8192
 
@@ -1073,6 +1074,55 @@ void GameClient::allocateShadows(void)
 		draw->allocateShadows();
 }
 
+//-------------------------------------------------------------------------------------------------
+/** The model preload priorities. Drawables in the map use their distance to the local player's
+	* start, which is always below the priorities of the preloads that follow */
+//-------------------------------------------------------------------------------------------------
+enum
+{
+	PRELOAD_PRIORITY_LOCAL_SIDE = 0x1000000,	///< faction things of the local player's side
+	PRELOAD_PRIORITY_OTHER_SIDES,							///< faction things of all other sides
+	PRELOAD_PRIORITY_OTHER,										///< debris, particle and control bar models
+};
+
+//-------------------------------------------------------------------------------------------------
+/** Returns the center of the local player's objects, that is where the local player starts.
+	* Falls back to the center of the map if the local player has no objects */
+//-------------------------------------------------------------------------------------------------
+static Coord3D getPreloadFocus( void )
+{
+	Coord3D focus;
+	focus.zero();
+
+	Int count = 0;
+	const Player *localPlayer = ThePlayerList->getLocalPlayer();
+	for( Drawable *draw = TheGameClient->firstDrawable(); draw; draw = draw->getNextDrawable() )
+	{
+		const Object *obj = draw->getObject();
+		if( obj && obj->getControllingPlayer() == localPlayer )
+		{
+			focus.x += obj->getPosition()->x;
+			focus.y += obj->getPosition()->y;
+			++count;
+		}
+	}
+
+	if( count > 0 )
+	{
+		focus.x /= count;
+		focus.y /= count;
+	}
+	else
+	{
+		Region3D extent;
+		TheTerrainLogic->getExtent( &extent );
+		focus.x = (extent.lo.x + extent.hi.x) * 0.5f;
+		focus.y = (extent.lo.y + extent.hi.y) * 0.5f;
+	}
+
+	return focus;
+}
+
 //-------------------------------------------------------------------------------------------------
 /** Preload assets for the currently loaded map.  Those assets include all the damage states
 	* for every building loaded, as well as any faction units/structures we can build and
@@ -1084,16 +1134,28 @@ void GameClient::preloadAssets( TimeOfDay timeOfDay )
 	MEMORYSTATUS before, after;
 	GlobalMemoryStatus(&before);
 
+	// TheSuperHackers @performance The model files are read on worker threads from here on and are
+	// turned into prototypes in endModelAssetPreload, the ones around the local player's start first.
+	TheDisplay->beginModelAssetPreload();
+	const Coord3D focus = getPreloadFocus();
+
 	// first, for every drawable in the map load the assets for all states we care about
 	Drawable *draw;
 	for( draw = firstDrawable(); draw; draw = draw->getNextDrawable() )
+	{
+		const Coord3D *pos = draw->getPosition();
+		const Real dx = pos->x - focus.x;
+		const Real dy = pos->y - focus.y;
+		const Int distance = REAL_TO_INT_FLOOR( sqrtf( dx * dx + dy * dy ) );
+		TheDisplay->setModelAssetPreloadPriority( MIN( distance, PRELOAD_PRIORITY_LOCAL_SIDE - 1 ) );
 		draw->preloadAssets( timeOfDay );
+	}
 
 	//
 	// now create a temporary drawble for each of the faction things we can create, preload
 	// their assets, and dump the drawable
 	//
-	AsciiString side;
+	AsciiString side = ThePlayerList->getLocalPlayer()->getSide();
 	const ThingTemplate *tTemplate;
 	for( tTemplate = TheThingFactory->firstTemplate();
 			 tTemplate;
@@ -1104,6 +1166,11 @@ void GameClient::preloadAssets( TimeOfDay timeOfDay )
 		if( tTemplate->isKindOf( KINDOF_PRELOAD ) == FALSE && !TheGlobalData->m_preloadEverything )
 			continue;
 
+		if( tTemplate->getDefaultOwningSide() == side )
+			TheDisplay->setModelAssetPreloadPriority( PRELOAD_PRIORITY_LOCAL_SIDE );
+		else
+			TheDisplay->setModelAssetPreloadPriority( PRELOAD_PRIORITY_OTHER_SIDES );
+
 		// create the drawable and do the preloading
 		draw = TheThingFactory->newDrawable( tTemplate );
 		if( draw )
@@ -1140,6 +1207,7 @@ void GameClient::preloadAssets( TimeOfDay timeOfDay )
 	*/
 
 	GlobalMemoryStatus(&before);
+	TheDisplay->setModelAssetPreloadPriority( PRELOAD_PRIORITY_OTHER );
 	extern std::vector<AsciiString>	debrisModelNamesGlobalHack;
 	size_t i=0;
 	for (; i<debrisModelNamesGlobalHack.size(); ++i)
@@ -1160,6 +1228,7 @@ void GameClient::preloadAssets( TimeOfDay timeOfDay )
 
 	GlobalMemoryStatus(&before);
 	TheParticleSystemManager->preloadAssets( timeOfDay );
+	TheDisplay->endModelAssetPreload();
 	GlobalMemoryStatus(&after);
 
 	DEBUG_LOG(("Preloading memory dwAvailPageFile %d --> %d : %d",
@@ -28,6 +28,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+#include "Common/GameEndChecks.h"
 #include "Common/Xfer.h"
 #include "GameClient/TerrainVisual.h"
 
@@ -42,11 +43,22 @@ TerrainVisual *TheTerrainVisual = NULL;
 // DEFINITIONS
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//-------------------------------------------------------------------------------------------------
+/** The terrain rebuild benchmark of -benchmarkTerrainRebuild */
+//-------------------------------------------------------------------------------------------------
+static void runTerrainRebuildBenchmark( UnsignedInt )
+{
+	if( TheTerrainVisual )
+		TheTerrainVisual->runRebuildBenchmark( 10 );
+}
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 TerrainVisual::TerrainVisual()
 {
 
+	GameEndChecks::registerCheck( GameEndChecks::BENCHMARK_TERRAIN_REBUILD, runTerrainRebuildBenchmark );
+
 }
 
 //-------------------------------------------------------------------------------------------------
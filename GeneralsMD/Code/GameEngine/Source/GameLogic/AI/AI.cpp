@@ -688,10 +688,11 @@ Object *AI::findClosestEnemy( const Object *me, Real range, UnsignedInt qualifie
 	Object *bestEnemy = NULL;
 	Int			effectivePriority=0;
 	Int			actualPriority=0;
-	ObjectIterator *iter = ThePartitionManager->iterateObjectsInRange(me, range, FROM_BOUNDINGSPHERE_2D, filters, ITER_SORTED_NEAR_TO_FAR);
-	MemoryPoolObjectHolder holder(iter);
-	for (Object *theEnemy = iter->first(); theEnemy; theEnemy = iter->next())
+	ObjectRangeBufferHolder enemies;
+	ThePartitionManager->getObjectsInRange(me, range, FROM_BOUNDINGSPHERE_2D, enemies, filters, ITER_SORTED_NEAR_TO_FAR);
+	for (Int i = 0; i < enemies->getCount(); ++i)
 	{
+		Object *theEnemy = enemies->getObject(i);
 		Int curPriority = info->getPriority(theEnemy->getTemplate());
 		if (curPriority == 0)
 			continue; // don't attack 0 priority targets.
@@ -32,10 +32,13 @@
 #include "Common/PerfTimer.h"
 #include "Common/Player.h"
 #include "Common/CRCDebug.h"
+#include "Common/GameEndChecks.h"
 #include "Common/GlobalData.h"
 #include "Common/LatchRestore.h"
+#include "Common/ProfileUtil.h"
 #include "Common/ThingTemplate.h"
 #include "Common/ThingFactory.h"
+#include "Common/WorkerPool.h"
 
 #include "GameClient/Line2D.h"
 
@@ -50,12 +53,14 @@
 #include "GameLogic/TerrainLogic.h"
 #include "GameLogic/Weapon.h"
 
+#include <algorithm>
+
+#include "Common/PathQueryLog.h"
+#include "Common/Tracer.h"
 #include "Common/UnitTimings.h" //Contains the DO_UNIT_TIMINGS define jba.
 
 #define no_INTENSE_DEBUG
 
-#define DEBUG_QPF
-
 #ifdef INTENSE_DEBUG
 #include "GameLogic/ScriptEngine.h"
 #endif
@@ -2061,6 +2066,13 @@ void ZoneBlock::freeZones(void)
 /* Allocate zone equivalency arrays large enough to hold required entries.  If the arrays are already
 large enough, reuse.  Then calculate terrain equivalencies. */
 void ZoneBlock::blockCalculateZones(PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds)
+{
+	blockPrepareZones(map, bounds);
+	blockResolveZones(map, bounds);
+}
+
+/* Find the zone range of the block and allocate its equivalency arrays. */
+void ZoneBlock::blockPrepareZones(PathfindCell **map, const IRegion2D &bounds)
 {
 	Int i, j;
 	m_cellOrigin = bounds.lo;
@@ -2079,7 +2091,13 @@ void ZoneBlock::blockCalculateZones(PathfindCell **map, PathfindLayer layers[],
 	m_numZones = 1 + maxZone - minZone;
 
 	allocateZones();
+}
 
+/* Calculate the terrain equivalencies of the block. Only touches the arrays of this block, so blocks
+can be resolved in parallel once they are prepared. */
+void ZoneBlock::blockResolveZones(PathfindCell **map, const IRegion2D &bounds)
+{
+	Int i, j;
 	if (m_numZones==1) return; // all zones are equivalent.
 
 	// Determine water/ground equivalent zones, and ground/cliff equivalent zones.
@@ -2344,24 +2362,202 @@ void PathfindZoneManager::markZonesDirty( Bool insert )  ///< Called when the zo
  */
 
 #define dont_forceRefreshCalling
+//
+// Zone flood of the whole map, one block per worker pool job.
+//
+enum { BLOCK_ZONE_STRIDE = PathfindZoneManager::ZONE_BLOCK_SIZE * PathfindZoneManager::ZONE_BLOCK_SIZE + 1 };
+
+struct ZoneBlockJobs
+{
+	PathfindCell **map;
+	ZoneBlock **zoneBlocks;
+	IRegion2D globalBounds;
+	Int yCount;
+	zoneStorageType *equivalency;	///< BLOCK_ZONE_STRIDE block local equivalencies per block
+	Int *zoneCounts;							///< number of block local zones per block
+	Int *zoneOffsets;							///< what to add to the block local zones to get the map zones
+};
+
+static Bool getZoneBlockBounds( const ZoneBlockJobs *jobs, Int index, Int &xBlock, Int &yBlock, IRegion2D &bounds )
+{
+	xBlock = index / jobs->yCount;
+	yBlock = index % jobs->yCount;
+	bounds.lo.x = jobs->globalBounds.lo.x + xBlock*PathfindZoneManager::ZONE_BLOCK_SIZE;
+	bounds.lo.y = jobs->globalBounds.lo.y + yBlock*PathfindZoneManager::ZONE_BLOCK_SIZE;
+	bounds.hi.x = MIN(bounds.lo.x + PathfindZoneManager::ZONE_BLOCK_SIZE - 1, jobs->globalBounds.hi.x); // bounds are inclusive.
+	bounds.hi.y = MIN(bounds.lo.y + PathfindZoneManager::ZONE_BLOCK_SIZE - 1, jobs->globalBounds.hi.y); // bounds are inclusive.
+	return bounds.lo.x <= bounds.hi.x && bounds.lo.y <= bounds.hi.y;
+}
+
+/* Flood one block exactly like the serial flood does, but number its zones from 1. The serial flood
+only ever merges zones within a block, so the map zones are the block local zones plus the number of
+zones of all blocks before it. */
+static void floodZoneBlock( Int index, void *userData )
+{
+	const ZoneBlockJobs *jobs = (const ZoneBlockJobs *)userData;
+	PathfindCell **map = jobs->map;
+	Int xBlock, yBlock;
+	IRegion2D bounds;
+	jobs->zoneCounts[index] = 0;
+	if (!getZoneBlockBounds(jobs, index, xBlock, yBlock, bounds)) {
+		return;
+	}
+
+	zoneStorageType *zoneEquivalency = jobs->equivalency + index * BLOCK_ZONE_STRIDE;
+	Int i, j;
+	for (i=0; i<BLOCK_ZONE_STRIDE; i++) {
+		zoneEquivalency[i] = i;
+	}
+
+	Int maxZone = 1;
+	Bool interactsWithBridge = false;
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			PathfindCell *cell = &map[i][j];
+			cell->setZone(0);
+
+			if (i>bounds.lo.x) {
+				if (map[i][j].getType() == map[i-1][j].getType()) {
+					applyZone(map[i][j], map[i-1][j], zoneEquivalency, maxZone);
+				}
+			}
+			if (j>bounds.lo.y) {
+				if (map[i][j].getType() == map[i][j-1].getType()) {
+					applyZone(map[i][j], map[i][j-1], zoneEquivalency, maxZone);
+				}
+			}
+			if (cell->getZone()==0) {
+				cell->setZone(maxZone);
+				maxZone++;
+			}
+			if (cell->getConnectLayer() > LAYER_GROUND) {
+				interactsWithBridge = true;
+			}
+		}
+	}
+
+	jobs->zoneBlocks[xBlock][yBlock].setInteractsWithBridge(interactsWithBridge);
+	jobs->zoneCounts[index] = maxZone - 1;
+}
+
+static void offsetZoneBlock( Int index, void *userData )
+{
+	const ZoneBlockJobs *jobs = (const ZoneBlockJobs *)userData;
+	Int xBlock, yBlock;
+	IRegion2D bounds;
+	if (!getZoneBlockBounds(jobs, index, xBlock, yBlock, bounds)) {
+		return;
+	}
+
+	const Int offset = jobs->zoneOffsets[index];
+	for (Int j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for (Int i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			PathfindCell &cell = jobs->map[i][j];
+			cell.setZone(cell.getZone() + offset);
+		}
+	}
+}
+
+static void resolveZoneBlock( Int index, void *userData )
+{
+	const ZoneBlockJobs *jobs = (const ZoneBlockJobs *)userData;
+	Int xBlock, yBlock;
+	IRegion2D bounds;
+	if (getZoneBlockBounds(jobs, index, xBlock, yBlock, bounds)) {
+		jobs->zoneBlocks[xBlock][yBlock].blockResolveZones(jobs->map, bounds);
+	}
+}
+
+/**
+ * Flood the zones of all blocks on the worker pool. The cells end up with the same zones, and the
+ * equivalency table with the same entries, as the serial flood gives. Returns false when the map
+ * has too many zones, the serial flood has to handle that.
+ */
+Bool PathfindZoneManager::floodZoneBlocks( PathfindCell **map, const IRegion2D &globalBounds, Int xCount, Int yCount,
+																					zoneStorageType *zoneEquivalency, Int maxZones )
+{
+	const Int blockCount = xCount * yCount;
+	if (blockCount <= 0) {
+		return false;
+	}
+
+	std::vector<zoneStorageType> equivalency(blockCount * BLOCK_ZONE_STRIDE);
+	std::vector<Int> zoneCounts(blockCount);
+	std::vector<Int> zoneOffsets(blockCount);
+
+	ZoneBlockJobs jobs;
+	jobs.map = map;
+	jobs.zoneBlocks = m_zoneBlocks;
+	jobs.globalBounds = globalBounds;
+	jobs.yCount = yCount;
+	jobs.equivalency = &equivalency[0];
+	jobs.zoneCounts = &zoneCounts[0];
+	jobs.zoneOffsets = &zoneOffsets[0];
+
+	WorkerPool::run(blockCount, floodZoneBlock, &jobs);
+
+	Int maxZone = 1;
+	Int index;
+	for (index = 0; index < blockCount; index++) {
+		maxZone += zoneCounts[index];
+	}
+	if (maxZone >= maxZones) {
+		return false;
+	}
+
+	// Merge in the same block order as the serial flood numbers the zones.
+	maxZone = 1;
+	for (index = 0; index < blockCount; index++) {
+		const Int count = zoneCounts[index];
+		const Int offset = maxZone - 1;
+		const zoneStorageType *blockEquivalency = &equivalency[index * BLOCK_ZONE_STRIDE];
+		for (Int zone = 1; zone <= count; zone++) {
+			zoneEquivalency[offset + zone] = offset + blockEquivalency[zone];
+		}
+		zoneOffsets[index] = offset;
+		maxZone += count;
+	}
+
+	WorkerPool::run(blockCount, offsetZoneBlock, &jobs);
+
+	m_maxZone = maxZone;
+	return true;
+}
+
+/**
+ * Resolve the zone equivalencies of all blocks on the worker pool, after the zones are collapsed.
+ */
+void PathfindZoneManager::resolveZoneBlocks( PathfindCell **map, const IRegion2D &globalBounds, Int xCount, Int yCount )
+{
+	ZoneBlockJobs jobs;
+	jobs.map = map;
+	jobs.zoneBlocks = m_zoneBlocks;
+	jobs.globalBounds = globalBounds;
+	jobs.yCount = yCount;
+	jobs.equivalency = NULL;
+	jobs.zoneCounts = NULL;
+	jobs.zoneOffsets = NULL;
+
+	// The equivalency arrays are allocated serially, the workers only fill them in.
+	for (Int index = 0; index < xCount * yCount; index++) {
+		Int xBlock, yBlock;
+		IRegion2D bounds;
+		if (getZoneBlockBounds(&jobs, index, xBlock, yBlock, bounds)) {
+			m_zoneBlocks[xBlock][yBlock].blockPrepareZones(map, bounds);
+		}
+	}
+
+	WorkerPool::run(xCount * yCount, resolveZoneBlock, &jobs);
+}
+
 #ifdef forceRefreshCalling
 static  Bool  s_stopForceCalling = FALSE;
 #endif
 
 void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds )
 {
-
-#ifdef DEBUG_QPF
-#if defined(DEBUG_LOGGING)
-	__int64 startTime64;
-	static double timeToUpdate = 0.0f;
-  static double averageTimeToUpdate = 0.0f;
-  static Int updateSamples = 0;
-	__int64 endTime64,freq64;
-	QueryPerformanceFrequency((LARGE_INTEGER *)&freq64);
-	QueryPerformanceCounter((LARGE_INTEGER *)&startTime64);
-#endif
-#endif
+	// TheSuperHackers @performance 18/10/2026 Trace the pathfinder, see Tracer.
+	TRACE_SCOPE("PathfindZoneManager::calculateZones");
 
 	m_maxZone = 1;	// we start using zone 0 as a flag.
 	const Int maxZones=24000;
@@ -2378,7 +2574,10 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 	Int yCount = (globalBounds.hi.y-globalBounds.lo.y+1+ZONE_BLOCK_SIZE-1)/ZONE_BLOCK_SIZE;
 
 	Int xBlock, yBlock;
-	for (xBlock = 0; xBlock<xCount; xBlock++) {
+	// TheSuperHackers @performance The blocks are flooded in parallel and merged in block order. The serial flood
+	// below only runs when the map has more zones than the equivalency table can hold.
+	const Bool flooded = floodZoneBlocks(map, globalBounds, xCount, yCount, zoneEquivalency, maxZones);
+	for (xBlock = 0; !flooded && xBlock<xCount; xBlock++) {
 		for (yBlock=0; yBlock<yCount; yBlock++) {
 			IRegion2D bounds;
 			bounds.lo.x = globalBounds.lo.x + xBlock*ZONE_BLOCK_SIZE;
@@ -2485,25 +2684,8 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 
 	allocateZones();
 
-	for (xBlock=0; xBlock<xCount; xBlock++)
-  {
-		for (yBlock=0; yBlock<yCount; yBlock++)
-    {
-			IRegion2D bounds;
-			bounds.lo.x = globalBounds.lo.x + xBlock*ZONE_BLOCK_SIZE;
-			bounds.lo.y = globalBounds.lo.y + yBlock*ZONE_BLOCK_SIZE;
-			bounds.hi.x = bounds.lo.x + ZONE_BLOCK_SIZE - 1; // bounds are inclusive.
-			bounds.hi.y = bounds.lo.y + ZONE_BLOCK_SIZE - 1; // bounds are inclusive.
-
-      if (bounds.hi.x > globalBounds.hi.x)
-				bounds.hi.x = globalBounds.hi.x;
-
-      if (bounds.hi.y > globalBounds.hi.y)
-				bounds.hi.y = globalBounds.hi.y;
-
-			m_zoneBlocks[xBlock][yBlock].blockCalculateZones(map, layers, bounds);
-		}
-	}
+	// TheSuperHackers @performance Every block only touches its own equivalency arrays, so they are resolved in parallel.
+	resolveZoneBlocks(map, globalBounds, xCount, yCount);
 
 	i = 0;
   while ( i < m_zonesAllocated )
@@ -2622,29 +2804,6 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 	flattenZones(m_terrainZones, m_hierarchicalZones, m_maxZone);
 	flattenZones(m_crusherZones, m_hierarchicalZones, m_maxZone);
 
-#ifdef DEBUG_QPF
-#if defined(DEBUG_LOGGING)
-	QueryPerformanceCounter((LARGE_INTEGER *)&endTime64);
-	timeToUpdate = ((double)(endTime64-startTime64) / (double)(freq64));
-
-  if ( updateSamples < 400 )
-  {
-    averageTimeToUpdate = ((averageTimeToUpdate * updateSamples) + timeToUpdate) / (updateSamples + 1.0f);
-    updateSamples++;
-  	DEBUG_LOG(("computing...: %f", averageTimeToUpdate));
-  }
-  else if ( updateSamples == 400 )
-  {
-  	DEBUG_LOG((" =============DONE============= Average time to calculate zones: %f", averageTimeToUpdate));
-  	DEBUG_LOG(("                                           Percent of baseline : %f", averageTimeToUpdate/0.003335f));
-    updateSamples = 777;
-#ifdef forceRefreshCalling
-    s_stopForceCalling = TRUE;
-#endif
-  }
-
-#endif
-#endif
 #if defined(RTS_DEBUG)
 	if (TheGlobalData->m_debugAI == AI_DEBUG_ZONES)
 	{
@@ -2680,16 +2839,8 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
  */
 void PathfindZoneManager::updateZonesForModify(PathfindCell **map, PathfindLayer layers[], const IRegion2D &structureBounds, const IRegion2D &globalBounds )
 {
+	TRACE_SCOPE("PathfindZoneManager::updateZonesForModify");
 
-#ifdef DEBUG_QPF
-#if defined(DEBUG_LOGGING)
-	__int64 startTime64;
-	double timeToUpdate=0.0f;
-	__int64 endTime64,freq64;
-	QueryPerformanceFrequency((LARGE_INTEGER *)&freq64);
-	QueryPerformanceCounter((LARGE_INTEGER *)&startTime64);
-#endif
-#endif
 	IRegion2D bounds = structureBounds;
 	bounds.hi.x++;
 	bounds.hi.y++;
@@ -2778,12 +2929,6 @@ void PathfindZoneManager::updateZonesForModify(PathfindCell **map, PathfindLayer
 			}
  		}
 	}
-#ifdef DEBUG_QPF
-#if defined(DEBUG_LOGGING)
-	QueryPerformanceCounter((LARGE_INTEGER *)&endTime64);
-	timeToUpdate = ((double)(endTime64-startTime64) / (double)(freq64));
-#endif
-#endif
 #if defined(RTS_DEBUG)
 	if (TheGlobalData->m_debugAI==AI_DEBUG_ZONES)
 	{
@@ -3657,15 +3802,26 @@ void PathfindLayer::classifyWallMapCell( Int i, Int j , PathfindCell *cell, Obje
 
 //----------------------- Pathfinder ---------------------------------------
 
+// The report of -benchmarkGroupPath
+static void runGroupPathBenchmark( UnsignedInt )
+{
+	if (TheAI && TheAI->pathfinder()) {
+		TheAI->pathfinder()->reportGroupPathStats();
+	}
+}
+
 Pathfinder::Pathfinder( void ) :m_map(NULL)
 {
 	debugPath = NULL;
+	resetGroupPathStats();
 	PathfindCellInfo::allocateCellInfos();
 	reset();
+	GameEndChecks::registerCheck(GameEndChecks::BENCHMARK_GROUP_PATH, runGroupPathBenchmark);
 }
 
 Pathfinder::~Pathfinder( void )
 {
+	clearFlowFields();
 	PathfindCellInfo::releaseCellInfos();
 }
 
@@ -3674,6 +3830,9 @@ void Pathfinder::reset( void )
 	frameToShowObstacles = 0;
 	DEBUG_LOG(("Pathfind cell is %d bytes, PathfindCellInfo is %d bytes", sizeof(PathfindCell), sizeof(PathfindCellInfo)));
 
+	resetGroupPathStats();
+	clearFlowFields();
+
 	delete [] m_blockOfMapCells;
 	m_blockOfMapCells = NULL;
 
@@ -3994,6 +4153,7 @@ void Pathfinder::classifyObjectFootprint( Object *obj, Bool insert )
   {
 		return; // Don't add bounds that are up in the air.... unless a blast crater wants to do just that
 	}
+	clearFlowFields(); // the fields were built around the old footprints.
 	internal_classifyObjectFootprint(obj, insert);
 }
 
@@ -4231,26 +4391,19 @@ void Pathfinder::internal_classifyObjectFootprint( Object *obj, Bool insert )
 }
 
 /**
- * Classify the given map cell as WATER, CLIFF, etc.
- * Note that this does NOT classify cells as OBSTACLES.
- * OBSTACLE cells are classified only via objects.
- * @todo optimize this - lots of redundant computation
+ * Classify the terrain under the given map cell as WATER, CLIFF or CLEAR.
+ * This only reads the terrain, so it can run for many cells in parallel.
  */
-void Pathfinder::classifyMapCell( Int i, Int j , PathfindCell *cell)
+static PathfindCell::CellType classifyTerrainCell( Int i, Int j )
 {
 	Coord3D topLeftCorner, bottomRightCorner;
 
-
-	Bool hasObstacle =  (cell->getType() == PathfindCell::CELL_OBSTACLE) ;
-
 	topLeftCorner.y = (Real)j * PATHFIND_CELL_SIZE_F;
 	bottomRightCorner.y = topLeftCorner.y + PATHFIND_CELL_SIZE_F;
 
 	topLeftCorner.x = (Real)i * PATHFIND_CELL_SIZE_F;
 	bottomRightCorner.x = topLeftCorner.x + PATHFIND_CELL_SIZE_F;
 
-	cell->setPinched(false);
-
 	PathfindCell::CellType type = PathfindCell::CELL_CLEAR;
 	if (TheTerrainLogic->isCliffCell(topLeftCorner.x, topLeftCorner.y))
 	{
@@ -4265,6 +4418,18 @@ void Pathfinder::classifyMapCell( Int i, Int j , PathfindCell *cell)
 	if (TheTerrainLogic->isUnderwater( bottomRightCorner.x, bottomRightCorner.y ) ) type = PathfindCell::CELL_WATER;
 	if (TheTerrainLogic->isUnderwater( bottomRightCorner.x, topLeftCorner.y ) ) type = PathfindCell::CELL_WATER;
 
+	return type;
+}
+
+/**
+ * Give the map cell the classified terrain type, unless it is an obstacle.
+ */
+static void applyTerrainCellType( PathfindCell *cell, PathfindCell::CellType type )
+{
+	Bool hasObstacle =  (cell->getType() == PathfindCell::CELL_OBSTACLE) ;
+
+	cell->setPinched(false);
+
 	if (hasObstacle) {
 		type =  PathfindCell::CELL_OBSTACLE;
 	}
@@ -4272,6 +4437,17 @@ void Pathfinder::classifyMapCell( Int i, Int j , PathfindCell *cell)
 	cell->releaseInfo();
 }
 
+/**
+ * Classify the given map cell as WATER, CLIFF, etc.
+ * Note that this does NOT classify cells as OBSTACLES.
+ * OBSTACLE cells are classified only via objects.
+ * @todo optimize this - lots of redundant computation
+ */
+void Pathfinder::classifyMapCell( Int i, Int j , PathfindCell *cell)
+{
+	applyTerrainCellType( cell, classifyTerrainCell( i, j ) );
+}
+
 /**
  * Set up for a new map.
  */
@@ -4327,6 +4503,31 @@ void Pathfinder::newMap( void )
 	m_isMapReady = true;
 }
 
+enum { CLASSIFY_BAND_ROWS = 16 };
+
+struct ClassifyTerrainBands
+{
+	IRegion2D extent;
+	UnsignedByte *types;	///< the terrain type of every cell in the extent, row by row
+};
+
+static void classifyTerrainBand( Int band, void *userData )
+{
+	const ClassifyTerrainBands *bands = (const ClassifyTerrainBands *)userData;
+	const Int width = bands->extent.hi.x - bands->extent.lo.x + 1;
+	const Int loY = bands->extent.lo.y + band * CLASSIFY_BAND_ROWS;
+	const Int hiY = MIN(loY + CLASSIFY_BAND_ROWS - 1, bands->extent.hi.y);
+
+	for (Int j = loY; j <= hiY; ++j)
+	{
+		UnsignedByte *row = bands->types + (j - bands->extent.lo.y) * width;
+		for (Int i = bands->extent.lo.x; i <= bands->extent.hi.x; ++i)
+		{
+			row[i - bands->extent.lo.x] = (UnsignedByte)classifyTerrainCell( i, j );
+		}
+	}
+}
+
 /**
  * Classify all cells in grid as obstacles, etc.
  */
@@ -4335,11 +4536,29 @@ void Pathfinder::classifyMap(void)
 
 	Int i, j;
 	// for now, sample cell corners and classify cell accordingly
-	for( j=m_extent.lo.y; j<=m_extent.hi.y; j++ )
+	// TheSuperHackers @performance The terrain under the cells is sampled in row bands on the worker pool,
+	// then the types are applied to the cells serially in the same order as before.
+	const Int width = m_extent.hi.x - m_extent.lo.x + 1;
+	const Int height = m_extent.hi.y - m_extent.lo.y + 1;
+	if (width > 0 && height > 0)
 	{
-		for( i=m_extent.lo.x; i<=m_extent.hi.x; i++ )
+		std::vector<UnsignedByte> terrainTypes(width * height);
+		ClassifyTerrainBands bands;
+		bands.extent = m_extent;
+		bands.types = &terrainTypes[0];
+
+		// Let the water areas compute their lazy bounds here, before the workers read them.
+		TheTerrainLogic->isUnderwater( 0.0f, 0.0f );
+
+		WorkerPool::run( (height + CLASSIFY_BAND_ROWS - 1) / CLASSIFY_BAND_ROWS, classifyTerrainBand, &bands );
+
+		for( j=m_extent.lo.y; j<=m_extent.hi.y; j++ )
 		{
-			classifyMapCell( i, j, &m_map[i][j]);
+			const UnsignedByte *row = &terrainTypes[(j - m_extent.lo.y) * width];
+			for( i=m_extent.lo.x; i<=m_extent.hi.x; i++ )
+			{
+				applyTerrainCellType( &m_map[i][j], (PathfindCell::CellType)row[i - m_extent.lo.x] );
+			}
 		}
 	}
 #if 1
@@ -5568,26 +5787,109 @@ Path *Pathfinder::getAircraftPath( const Object *obj, const Coord3D *to )
 }
 
 
+// TheSuperHackers @feature 18/10/2026 Passes the path queries of the pathfind queue on to the pathfinder
+// and records or checks the returned paths for -recordPaths and -verifyPaths, see PathQueryLog.
+class PathQueryLogger : public PathfindServicesInterface
+{
+public:
+	PathQueryLogger(Pathfinder *pathfinder, PathfindServicesInterface *services) : m_pathfinder(pathfinder), m_services(services) {}
+
+	virtual Path *findPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from, const Coord3D *to )
+	{
+		Path *path = m_services->findPath(obj, locomotorSet, from, to);
+		addQuery(PathQueryLog::FIND_PATH, obj, from, to, path);
+		return path;
+	}
+
+	virtual Path *findClosestPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from,
+		Coord3D *to, Bool blocked, Real pathCostMultiplier, Bool moveAllies )
+	{
+		const Coord3D requestedTo = *to;
+		Path *path = m_services->findClosestPath(obj, locomotorSet, from, to, blocked, pathCostMultiplier, moveAllies);
+		addQuery(PathQueryLog::FIND_CLOSEST_PATH, obj, from, &requestedTo, path);
+		return path;
+	}
+
+	virtual Path *findAttackPath( const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from,
+		const Object *victim, const Coord3D* victimPos, const Weapon *weapon )
+	{
+		Path *path = m_services->findAttackPath(obj, locomotorSet, from, victim, victimPos, weapon);
+		addQuery(PathQueryLog::FIND_ATTACK_PATH, obj, from, victim ? victim->getPosition() : victimPos, path);
+		return path;
+	}
+
+	virtual Path *patchPath( const Object *obj, const LocomotorSet& locomotorSet,
+		Path *originalPath, Bool blocked )
+	{
+		Coord3D originalGoal;
+		originalGoal.zero();
+		if (originalPath && originalPath->getLastNode()) {
+			originalGoal = *originalPath->getLastNode()->getPosition();
+		}
+		const Coord3D from = *obj->getPosition();
+		Path *path = m_services->patchPath(obj, locomotorSet, originalPath, blocked);
+		addQuery(PathQueryLog::PATCH_PATH, obj, &from, &originalGoal, path);
+		return path;
+	}
+
+	virtual Path *findSafePath( const Object *obj, const LocomotorSet& locomotorSet,
+		const Coord3D *from, const Coord3D* repulsorPos1, const Coord3D* repulsorPos2, Real repulsorRadius )
+	{
+		Path *path = m_services->findSafePath(obj, locomotorSet, from, repulsorPos1, repulsorPos2, repulsorRadius);
+		addQuery(PathQueryLog::FIND_SAFE_PATH, obj, from, repulsorPos1, path);
+		return path;
+	}
+
+private:
+	void addQuery(PathQueryLog::QueryType type, const Object *obj, const Coord3D *from, const Coord3D *to, Path *path)
+	{
+		m_pathfinder->logPathQuery(type, obj, from, to, path);
+	}
+
+	Pathfinder *m_pathfinder;
+	PathfindServicesInterface *m_services;
+};
+
+//-------------------------------------------------------------------------------------------------
+void Pathfinder::logPathQuery( Int queryType, const Object *obj, const Coord3D *from, const Coord3D *to, Path *path )
+{
+	if (!PathQueryLog::isActive()) {
+		return;
+	}
+
+	PathQueryLog::Query query;
+	query.type = queryType;
+	query.frame = TheGameLogic->getFrame();
+	query.objectID = obj ? (UnsignedInt)obj->getID() : (UnsignedInt)INVALID_ID;
+	query.from = *from;
+	if (to) {
+		query.to = *to;
+	} else {
+		query.to.zero();
+	}
+	for (PathNode *node = path ? path->getFirstNode() : NULL; node; node = node->getNext()) {
+		ICoord2D cellCoord;
+		worldToCell(node->getPosition(), &cellCoord);
+		PathQueryLog::Cell cell;
+		cell.x = cellCoord.x;
+		cell.y = cellCoord.y;
+		cell.layer = node->getLayer();
+		query.cells.push_back(cell);
+	}
+	PathQueryLog::addQuery(query);
+}
+
 /**
  * Process some path requests in the pathfind queue.
  */
 //DECLARE_PERF_TIMER(processPathfindQueue)
 void Pathfinder::processPathfindQueue(void)
 {
+	TRACE_SCOPE("Pathfinder::processPathfindQueue");
 	//USE_PERF_TIMER(processPathfindQueue)
 	if (!m_isMapReady) {
 		return;
 	}
-#ifdef DEBUG_QPF
-#ifdef DEBUG_LOGGING
-	Int startTimeMS = ::GetTickCount();
-	__int64 startTime64;
-	double timeToUpdate=0.0f;
-	__int64 endTime64,freq64;
-	QueryPerformanceFrequency((LARGE_INTEGER *)&freq64);
-	QueryPerformanceCounter((LARGE_INTEGER *)&startTime64);
-#endif
-#endif
 
 	if (
 #ifdef forceRefreshCalling
@@ -5613,9 +5915,12 @@ void Pathfinder::processPathfindQueue(void)
 	m_logicalExtent = bounds;
 
 	m_cumulativeCellsAllocated = 0;	// Number of pathfind cells examined.
-#ifdef DEBUG_QPF
-	Int pathsFound = 0;
-#endif
+	integrateFlowFields();
+	PathQueryLogger logger(this, this);
+	PathfindServicesInterface *services = this;
+	if (PathQueryLog::isActive()) {
+		services = &logger;
+	}
 	while (m_cumulativeCellsAllocated < PATHFIND_CELLS_PER_FRAME &&
 		m_queuePRTail!=m_queuePRHead) {
 		Object *obj = TheGameLogic->findObjectByID(m_queuedPathfindRequests[m_queuePRHead]);
@@ -5623,10 +5928,7 @@ void Pathfinder::processPathfindQueue(void)
 		if (obj) {
 			AIUpdateInterface *ai = obj->getAIUpdateInterface();
 			if (ai) {
-				ai->doPathfind(this);
-#ifdef DEBUG_QPF
-				pathsFound++;
-#endif
+				ai->doPathfind(services);
 			}
 		}
 		m_queuePRHead = m_queuePRHead+1;
@@ -5634,19 +5936,6 @@ void Pathfinder::processPathfindQueue(void)
 			m_queuePRHead = 0;
 		}
 	}
-	if (pathsFound>0) {
-#ifdef DEBUG_QPF
-#ifdef DEBUG_LOGGING
-		QueryPerformanceCounter((LARGE_INTEGER *)&endTime64);
-		timeToUpdate = ((double)(endTime64-startTime64) / (double)(freq64));
-		if (timeToUpdate>0.01f)
-		{
-			DEBUG_LOG(("%d Pathfind queue: %d paths, %d cells --", TheGameLogic->getFrame(), pathsFound, m_cumulativeCellsAllocated));
-			DEBUG_LOG(("time %f (%f)", timeToUpdate, (::GetTickCount()-startTimeMS)/1000.0f));
-		}
-#endif
-#endif
-	}
 #if defined(RTS_DEBUG)
 	doDebugIcons();
 #endif
@@ -6036,6 +6325,25 @@ Int Pathfinder::examineNeighboringCells(PathfindCell *parentCell, PathfindCell *
 Path *Pathfinder::findPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from,
 													 const Coord3D *rawTo)
 {
+	TRACE_SCOPE("Pathfinder::findPath");
+	// Members of a group move order first try the flow field of the order.
+	PathfindFlowField *field = NULL;
+	if (obj && !m_flowFields.empty()) {
+		field = takeFlowField(obj);
+	}
+	if (field) {
+		Path *fieldPath = buildFlowFieldPath(field, obj, locomotorSet, from, rawTo);
+		if (fieldPath) {
+			m_groupPathStats.m_fieldPaths++;
+#if ENABLE_GROUP_FLOW_FIELD_PATHING
+			return fieldPath;
+#else
+			deleteInstance(fieldPath); // only built for the benchmark.
+#endif
+		}
+	}
+	const Int cellsBefore = m_cumulativeCellsAllocated;
+
 	if (!clientSafeQuickDoesPathExist(locomotorSet, from, rawTo)) {
 		return NULL;
 	}
@@ -6053,6 +6361,10 @@ Path *Pathfinder::findPath( Object *obj, const LocomotorSet& locomotorSet, const
 	}
 
 	Path *pat = internalFindPath(obj, locomotorSet, from, rawTo);
+	if (field) {
+		m_groupPathStats.m_searchPaths++;
+		m_groupPathStats.m_searchCells += m_cumulativeCellsAllocated - cellsBefore;
+	}
 	if (pat!=NULL) {
 		return pat;
 	}
@@ -6634,6 +6946,7 @@ struct GroundCellsStruct
 Path *Pathfinder::findGroundPath( const Coord3D *from,
 													 const Coord3D *rawTo, Int pathDiameter, Bool crusher)
 {
+	TRACE_SCOPE("Pathfinder::findGroundPath");
 	//CRCDEBUG_LOG(("Pathfinder::findGroundPath()"));
 #ifdef DEBUG_LOGGING
 	Int startTimeMS = ::GetTickCount();
@@ -7876,6 +8189,7 @@ Bool Pathfinder::slowDoesPathExist( Object *obj,
 	m_ignoreObstacleID = ignoreObject;
 	Path *path = findPath(obj, locoSet, from, to);
 	m_ignoreObstacleID = INVALID_ID;
+	logPathQuery(PathQueryLog::FIND_PATH, obj, from, to, path);
 	Bool found = (path!=NULL);
 
 	deleteInstance(path);
@@ -8448,6 +8762,7 @@ Int Pathfinder::checkPathCost(Object *obj, const LocomotorSet& locomotorSet, con
 Path *Pathfinder::findClosestPath( Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from,
 																	Coord3D *rawTo, Bool blocked, Real pathCostMultiplier, Bool moveAllies)
 {
+	TRACE_SCOPE("Pathfinder::findClosestPath");
 	//CRCDEBUG_LOG(("Pathfinder::findClosestPath()"));
 #ifdef DEBUG_LOGGING
 	Int startTimeMS = ::GetTickCount();
@@ -9535,6 +9850,7 @@ void Pathfinder::changeBridgeState( PathfindLayerEnum layer, Bool repaired)
 {
 	if (m_layers[layer].isUnused()) return;
 	if (m_layers[layer].setDestroyed(!repaired)) {
+		clearFlowFields();
 		m_zoneManager.markZonesDirty( repaired );
 	}
 }
@@ -10240,6 +10556,7 @@ Path *Pathfinder::getMoveAwayFromPath(Object* obj, Object *otherObj,
 Path *Pathfinder::patchPath( const Object *obj, const LocomotorSet& locomotorSet,
 		Path *originalPath, Bool blocked )
 {
+	TRACE_SCOPE("Pathfinder::patchPath");
 	//CRCDEBUG_LOG(("Pathfinder::patchPath()"));
 #ifdef DEBUG_LOGGING
 	Int startTimeMS = ::GetTickCount();
@@ -10460,6 +10777,7 @@ Path *Pathfinder::patchPath( const Object *obj, const LocomotorSet& locomotorSet
 Path *Pathfinder::findAttackPath( const Object *obj, const LocomotorSet& locomotorSet, const Coord3D *from,
 		const Object *victim, const Coord3D* victimPos, const Weapon *weapon )
 {
+	TRACE_SCOPE("Pathfinder::findAttackPath");
 	if (!m_isMapReady)
 		return NULL; // Should always be ok.
 
@@ -10803,6 +11121,7 @@ Path *Pathfinder::findAttackPath( const Object *obj, const LocomotorSet& locomot
 Path *Pathfinder::findSafePath( const Object *obj, const LocomotorSet& locomotorSet,
 		const Coord3D *from, const Coord3D* repulsorPos1, const Coord3D* repulsorPos2, Real repulsorRadius)
 {
+	TRACE_SCOPE("Pathfinder::findSafePath");
 	//CRCDEBUG_LOG(("Pathfinder::findSafePath()"));
 	if (m_isMapReady == false) return NULL; // Should always be ok.
 #if defined(RTS_DEBUG)
@@ -10974,6 +11293,593 @@ Path *Pathfinder::findSafePath( const Object *obj, const LocomotorSet& locomotor
 	return NULL;
 }
 
+//-----------------------------------------------------------------------------
+// Group flow fields
+//-----------------------------------------------------------------------------
+
+enum
+{
+	MIN_FLOW_FIELD_GROUP_SIZE = 6,		///< smaller groups are cheap enough to search one by one
+	FLOW_FIELD_MARGIN_CELLS = 16,			///< how far the field reaches beyond the members and the goal
+	FLOW_FIELD_DEST_CELLS = 24,				///< how far a member destination may be from the group goal
+	FLOW_FIELD_LIFETIME = 5*LOGICFRAMES_PER_SECOND,
+	MAX_FLOW_FIELDS = 8
+};
+
+// The flags of PathfindFlowField::m_cellState.
+enum
+{
+	FLOW_FIELD_PASSABLE_KNOWN = 0x01,
+	FLOW_FIELD_PASSABLE = 0x02,
+	FLOW_FIELD_START = 0x04
+};
+
+static const ICoord2D s_flowFieldDelta[] =
+{
+	{ 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 },
+	{ 1, 1 }, { -1, 1 }, { -1, -1 }, { 1, -1 }
+};
+
+static inline Int oppositeFlowFieldNeighbor( Int neighbor )
+{
+	return neighbor < 4 ? (neighbor + 2) & 3 : 4 + ((neighbor - 2) & 3);
+}
+
+// Orders the open heap by cost and then by cell, so that ties always resolve the same way.
+struct FlowFieldEntryGreater
+{
+	Bool operator()( const PathfindFlowField::OpenEntry &a, const PathfindFlowField::OpenEntry &b ) const
+	{
+		if (a.m_cost != b.m_cost)
+			return a.m_cost > b.m_cost;
+		return a.m_index > b.m_index;
+	}
+};
+
+PathfindFlowField::PathfindFlowField() :
+	m_surfaces(0),
+	m_isCrusher(false),
+	m_isHuman(false),
+	m_width(0),
+	m_height(0),
+	m_cost(NULL),
+	m_next(NULL),
+	m_isComplete(false),
+	m_startsLeft(0),
+	m_expireFrame(0)
+{
+	m_goalCell.x = m_goalCell.y = 0;
+	m_bounds.lo.x = m_bounds.lo.y = m_bounds.hi.x = m_bounds.hi.y = 0;
+}
+
+PathfindFlowField::~PathfindFlowField()
+{
+	delete [] m_cost;
+	delete [] m_next;
+}
+
+/**
+ * Set up the flow fields for a group move order. Every kind of mover in the group gets one field
+ * that covers the group and the goal, and the members keep it until they ask for their path.
+ * The fields are integrated on the pathfind queue, see integrateFlowFields.
+ * Nothing of the pathfind map is touched, so this is also safe to run for the benchmark only.
+ */
+void Pathfinder::buildGroupFlowFields( const std::vector<Object *> &members, const Coord3D *goal )
+{
+#if !ENABLE_GROUP_FLOW_FIELD_PATHING
+	if (!GameEndChecks::isEnabled(GameEndChecks::BENCHMARK_GROUP_PATH)) {
+		return;
+	}
+#endif
+	if (!m_isMapReady) {
+		return;
+	}
+
+	size_t i, j;
+	// The members have a new order, so the fields of their older orders no longer apply.
+	for (i = 0; i < m_flowFields.size(); ++i) {
+		std::vector<ObjectID> &ids = m_flowFields[i]->m_members;
+		for (j = 0; j < members.size(); ++j) {
+			std::vector<ObjectID>::iterator it = std::find(ids.begin(), ids.end(), members[j]->getID());
+			if (it != ids.end()) {
+				ids.erase(it);
+			}
+		}
+	}
+
+	if ((Int)members.size() < MIN_FLOW_FIELD_GROUP_SIZE) {
+		return;
+	}
+	if (TheTerrainLogic->getLayerForDestination(goal) != LAYER_GROUND) {
+		return;
+	}
+	ICoord2D goalCell;
+	if (worldToCell(goal, &goalCell)) {
+		return; // off the map.
+	}
+
+	std::vector<PathfindFlowField *> fields;
+	std::vector< std::vector<ICoord2D> > starts;
+	Int memberCount = 0;
+	for (i = 0; i < members.size(); ++i) {
+		Object *obj = members[i];
+		AIUpdateInterface *ai = obj->getAIUpdateInterface();
+		if (ai == NULL || obj->getLayer() != LAYER_GROUND || !ai->isDoingGroundMovement()) {
+			continue;
+		}
+		if (obj->isKindOf(KINDOF_DOZER)) {
+			continue; // the search lets dozers through the obstacles of their allies.
+		}
+
+		LocomotorSurfaceTypeMask surfaces = ai->getLocomotorSet().getValidSurfaces();
+		Bool isCrusher = obj->getCrusherLevel() > 0;
+		Bool isHuman = true;
+		if (obj->getControllingPlayer() && (obj->getControllingPlayer()->getPlayerType()==PLAYER_COMPUTER)) {
+			isHuman = false; // computer gets to cheat.
+		}
+
+		for (j = 0; j < fields.size(); ++j) {
+			const PathfindFlowField *field = fields[j];
+			if (field->m_surfaces == surfaces && field->m_isCrusher == isCrusher && field->m_isHuman == isHuman) {
+				break;
+			}
+		}
+		if (j == fields.size()) {
+			PathfindFlowField *field = NEW PathfindFlowField;
+			field->m_surfaces = surfaces;
+			field->m_isCrusher = isCrusher;
+			field->m_isHuman = isHuman;
+			field->m_goalCell = goalCell;
+			field->m_bounds.lo = goalCell;
+			field->m_bounds.hi = goalCell;
+			field->m_expireFrame = TheGameLogic->getFrame() + FLOW_FIELD_LIFETIME;
+			fields.push_back(field);
+			starts.push_back(std::vector<ICoord2D>());
+		}
+
+		ICoord2D startCell;
+		worldToCell(obj->getPosition(), &startCell);
+		PathfindFlowField *field = fields[j];
+		field->m_members.push_back(obj->getID());
+		if (startCell.x < field->m_bounds.lo.x) field->m_bounds.lo.x = startCell.x;
+		if (startCell.y < field->m_bounds.lo.y) field->m_bounds.lo.y = startCell.y;
+		if (startCell.x > field->m_bounds.hi.x) field->m_bounds.hi.x = startCell.x;
+		if (startCell.y > field->m_bounds.hi.y) field->m_bounds.hi.y = startCell.y;
+		starts[j].push_back(startCell);
+		++memberCount;
+	}
+
+	if (memberCount < MIN_FLOW_FIELD_GROUP_SIZE) {
+		for (j = 0; j < fields.size(); ++j) {
+			delete fields[j];
+		}
+		return;
+	}
+
+	m_groupPathStats.m_groupOrders++;
+	m_groupPathStats.m_members += memberCount;
+	for (j = 0; j < fields.size(); ++j) {
+		PathfindFlowField *field = fields[j];
+		IRegion2D &bounds = field->m_bounds;
+		bounds.lo.x = MAX(bounds.lo.x - FLOW_FIELD_MARGIN_CELLS, m_extent.lo.x);
+		bounds.lo.y = MAX(bounds.lo.y - FLOW_FIELD_MARGIN_CELLS, m_extent.lo.y);
+		bounds.hi.x = MIN(bounds.hi.x + FLOW_FIELD_MARGIN_CELLS, m_extent.hi.x);
+		bounds.hi.y = MIN(bounds.hi.y + FLOW_FIELD_MARGIN_CELLS, m_extent.hi.y);
+		field->m_width = bounds.hi.x - bounds.lo.x + 1;
+		field->m_height = bounds.hi.y - bounds.lo.y + 1;
+
+		m_groupPathStats.m_fields++;
+		if (startFlowField(field, starts[j])) {
+			m_flowFields.push_back(field);
+		} else {
+			delete field;
+		}
+	}
+
+	while (m_flowFields.size() > MAX_FLOW_FIELDS) {
+		delete m_flowFields.front();
+		m_flowFields.erase(m_flowFields.begin());
+	}
+}
+
+/**
+ * The terrain check the search does for the cell it moves into. Like validMovementPosition, it
+ * doesn't depend on the cell moved from or on the footprint of the mover, so the fields are shared
+ * by members of any size. The footprint is checked against the units when a member takes its path.
+ */
+Bool Pathfinder::isFlowFieldCellPassable( const PathfindFlowField *field, Int x, Int y )
+{
+	ICoord2D cellNdx;
+	cellNdx.x = x;
+	cellNdx.y = y;
+	if (field->m_isHuman && checkCellOutsideExtents(cellNdx)) {
+		return false;
+	}
+	return validMovementPosition(field->m_isCrusher, field->m_surfaces, getCell(LAYER_GROUND, x, y));
+}
+
+/**
+ * isFlowFieldCellPassable, cached for the integration.
+ */
+Bool Pathfinder::isFlowFieldCellOpen( PathfindFlowField *field, Int x, Int y )
+{
+	UnsignedByte &state = field->m_cellState[field->getIndex(x, y)];
+	if ((state & FLOW_FIELD_PASSABLE_KNOWN) == 0) {
+		state |= FLOW_FIELD_PASSABLE_KNOWN;
+		if (isFlowFieldCellPassable(field, x, y)) {
+			state |= FLOW_FIELD_PASSABLE;
+		}
+	}
+	return (state & FLOW_FIELD_PASSABLE) != 0;
+}
+
+/**
+ * Allocate the field and put the goal on the open heap. Returns false if the goal can't be reached.
+ */
+Bool Pathfinder::startFlowField( PathfindFlowField *field, const std::vector<ICoord2D> &starts )
+{
+	const Int cellCount = field->m_width * field->m_height;
+	field->m_cost = MSGNEW("PathfindFlowField") UnsignedInt[cellCount];
+	field->m_next = MSGNEW("PathfindFlowField") UnsignedByte[cellCount];
+	field->m_cellState.assign(cellCount, 0);
+
+	Int i;
+	for (i = 0; i < cellCount; ++i) {
+		field->m_cost[i] = PathfindFlowField::UNREACHED;
+		field->m_next[i] = PathfindFlowField::NO_NEXT_CELL;
+	}
+
+	if (!isFlowFieldCellOpen(field, field->m_goalCell.x, field->m_goalCell.y)) {
+		return false;
+	}
+
+	for (i = 0; i < (Int)starts.size(); ++i) {
+		UnsignedByte &state = field->m_cellState[field->getIndex(starts[i].x, starts[i].y)];
+		if ((state & FLOW_FIELD_START) == 0) {
+			state |= FLOW_FIELD_START;
+			field->m_startsLeft++;
+		}
+	}
+
+	const Int goalIndex = field->getIndex(field->m_goalCell.x, field->m_goalCell.y);
+	PathfindFlowField::OpenEntry entry;
+	entry.m_cost = 0;
+	entry.m_index = goalIndex;
+	field->m_cost[goalIndex] = 0;
+	field->m_open.push_back(entry);
+	return true;
+}
+
+/**
+ * Integrate the cost from the goal outwards with Dijkstra, until every start cell is reached or the
+ * bounds of the field are exhausted. Each expanded cell counts against the cell budget of the
+ * pathfind queue, like the cells of a search, so the integration stops when the budget is spent
+ * and carries on next frame. Returns true once the field is complete.
+ *
+ * A member follows the field towards the goal, so it moves from a neighbor into the expanded cell.
+ * The expanded cell is the one the search would move into, and the extra costs of the search for
+ * the cell it moves into are charged for it. The turn costs depend on the path so far and are left
+ * out. Like the search, only a cell that can be moved into leads anywhere, and a diagonal step
+ * needs one of the two cells beside it to be open.
+ */
+Bool Pathfinder::integrateFlowField( PathfindFlowField *field )
+{
+	FlowFieldEntryGreater greater;
+	std::vector<PathfindFlowField::OpenEntry> &open = field->m_open;
+	while (!open.empty() && field->m_startsLeft > 0) {
+		if (m_cumulativeCellsAllocated >= PATHFIND_CELLS_PER_FRAME) {
+			return false;
+		}
+
+		std::pop_heap(open.begin(), open.end(), greater);
+		const PathfindFlowField::OpenEntry entry = open.back();
+		open.pop_back();
+		if (entry.m_cost != field->m_cost[entry.m_index]) {
+			continue; // a cheaper way to this cell was found after it was queued.
+		}
+
+		m_cumulativeCellsAllocated++;
+		m_groupPathStats.m_fieldCells++;
+		UnsignedByte &state = field->m_cellState[entry.m_index];
+		if (state & FLOW_FIELD_START) {
+			state &= ~FLOW_FIELD_START;
+			field->m_startsLeft--;
+		}
+
+		const Int x = field->m_bounds.lo.x + entry.m_index % field->m_width;
+		const Int y = field->m_bounds.lo.y + entry.m_index / field->m_width;
+		if (!isFlowFieldCellOpen(field, x, y)) {
+			continue; // a member may start here, but nobody can move in.
+		}
+
+		// The same extra costs as costSoFar and examineNeighboringCells charge for the cell moved into.
+		PathfindCell *cell = getCell(LAYER_GROUND, x, y);
+		UnsignedInt enterCost = 0;
+		const Bool isCliff = cell->getType() == PathfindCell::CELL_CLIFF && !cell->getPinched();
+		if (cell->getPinched()) {
+			enterCost += COST_DIAGONAL + COST_ORTHOGONAL;
+		}
+		if (cell->getType() == PathfindCell::CELL_OBSTACLE) {
+			enterCost += 100*COST_ORTHOGONAL;
+		}
+		Real cellZ = 0;
+		if (isCliff) {
+			cellZ = TheTerrainLogic->getGroundHeight(x * PATHFIND_CELL_SIZE_F, y * PATHFIND_CELL_SIZE_F);
+		}
+
+		for (Int k = 0; k < 8; ++k) {
+			const Int newX = x + s_flowFieldDelta[k].x;
+			const Int newY = y + s_flowFieldDelta[k].y;
+			if (!field->contains(newX, newY)) {
+				continue;
+			}
+			if (k >= 4 && !isFlowFieldCellOpen(field, newX, y) && !isFlowFieldCellOpen(field, x, newY)) {
+				continue;
+			}
+
+			const Int newIndex = field->getIndex(newX, newY);
+			UnsignedInt newCost = entry.m_cost + (k < 4 ? COST_ORTHOGONAL : COST_DIAGONAL) + enterCost;
+			if (isCliff) {
+				Real fromZ = TheTerrainLogic->getGroundHeight(newX * PATHFIND_CELL_SIZE_F, newY * PATHFIND_CELL_SIZE_F);
+				if (fabs(fromZ - cellZ) < PATHFIND_CELL_SIZE_F) {
+					newCost += 7*COST_DIAGONAL;
+				}
+			}
+
+			if (newCost < field->m_cost[newIndex]) {
+				field->m_cost[newIndex] = newCost;
+				field->m_next[newIndex] = (UnsignedByte)oppositeFlowFieldNeighbor(k);
+				PathfindFlowField::OpenEntry newEntry;
+				newEntry.m_cost = newCost;
+				newEntry.m_index = newIndex;
+				open.push_back(newEntry);
+				std::push_heap(open.begin(), open.end(), greater);
+			}
+		}
+	}
+
+	field->m_isComplete = true;
+	std::vector<PathfindFlowField::OpenEntry>().swap(field->m_open);
+	std::vector<UnsignedByte>().swap(field->m_cellState);
+	return true;
+}
+
+/**
+ * Carry on with the integration of the flow fields, oldest first. Runs before the queued path
+ * requests, so a member that gets its turn finds the field of its order complete.
+ */
+void Pathfinder::integrateFlowFields( void )
+{
+#if ENABLE_GROUP_FLOW_FIELD_PATHING
+	for (size_t i = 0; i < m_flowFields.size(); ++i) {
+		PathfindFlowField *field = m_flowFields[i];
+		if (!field->m_isComplete && !field->m_members.empty() && !integrateFlowField(field)) {
+			return; // out of cells for this frame.
+		}
+	}
+#else
+	// Only built for the benchmark. Finish them at once and keep them off the cell budget, so the
+	// queued searches run on the same frames as they do without the fields.
+	const Int cellsAllocated = m_cumulativeCellsAllocated;
+	for (size_t i = 0; i < m_flowFields.size(); ++i) {
+		PathfindFlowField *field = m_flowFields[i];
+		while (!field->m_isComplete) {
+			m_cumulativeCellsAllocated = 0;
+			integrateFlowField(field);
+		}
+	}
+	m_cumulativeCellsAllocated = cellsAllocated;
+#endif
+}
+
+/**
+ * Find the newest complete flow field the object is a member of, and take the object off it, as a
+ * member only takes its first path from the field. Repaths go through the regular search.
+ */
+PathfindFlowField *Pathfinder::takeFlowField( const Object *obj )
+{
+	const UnsignedInt frame = TheGameLogic->getFrame();
+	Int i;
+	for (i = (Int)m_flowFields.size() - 1; i >= 0; --i) {
+		PathfindFlowField *field = m_flowFields[i];
+		if (field->m_expireFrame < frame || field->m_members.empty()) {
+			delete field;
+			m_flowFields.erase(m_flowFields.begin() + i);
+		}
+	}
+
+	for (i = (Int)m_flowFields.size() - 1; i >= 0; --i) {
+		PathfindFlowField *field = m_flowFields[i];
+		if (!field->m_isComplete) {
+			continue;
+		}
+		std::vector<ObjectID>::iterator it = std::find(field->m_members.begin(), field->m_members.end(), obj->getID());
+		if (it != field->m_members.end()) {
+			field->m_members.erase(it);
+			return field;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Derive the path of a group member from its flow field. The member follows the field down from
+ * its cell until it meets the cells its own destination runs down through, and then follows
+ * those back up to the destination. Every cell of the path must pass the unit checks of the
+ * regular search, as the field itself ignores the units. Returns NULL when the field can't serve
+ * this request, and the member then runs the regular search.
+ */
+Path *Pathfinder::buildFlowFieldPath( const PathfindFlowField *field, Object *obj, const LocomotorSet& locomotorSet,
+	const Coord3D *from, const Coord3D *rawTo )
+{
+	Bool isCrusher = obj->getCrusherLevel() > 0;
+	Bool isHuman = true;
+	if (obj->getControllingPlayer() && (obj->getControllingPlayer()->getPlayerType()==PLAYER_COMPUTER)) {
+		isHuman = false; // computer gets to cheat.
+	}
+	if (field->m_surfaces != locomotorSet.getValidSurfaces() || field->m_isCrusher != isCrusher || field->m_isHuman != isHuman) {
+		return NULL; // the member changed since the order was given.
+	}
+	Int radius;
+	Bool centerInCell;
+	getRadiusAndCenter(obj, radius, centerInCell);
+	if (m_ignoreObstacleID != INVALID_ID || locomotorSet.isDownhillOnly()) {
+		return NULL;
+	}
+
+	Coord3D adjustTo = *rawTo;
+	Coord3D clipFrom = *from;
+	clip(&clipFrom, &adjustTo);
+	if (!centerInCell) {
+		adjustTo.x += PATHFIND_CELL_SIZE_F/2;
+		adjustTo.y += PATHFIND_CELL_SIZE_F/2;
+	}
+	if (obj->getLayer() != LAYER_GROUND || TheTerrainLogic->getLayerForDestination(&adjustTo) != LAYER_GROUND) {
+		return NULL;
+	}
+
+	ICoord2D startCell, destCell;
+	worldToCell(&clipFrom, &startCell);
+	worldToCell(&adjustTo, &destCell);
+	if (!field->contains(startCell.x, startCell.y) || !field->contains(destCell.x, destCell.y)) {
+		return NULL;
+	}
+	if (abs(destCell.x - field->m_goalCell.x) > FLOW_FIELD_DEST_CELLS || abs(destCell.y - field->m_goalCell.y) > FLOW_FIELD_DEST_CELLS) {
+		return NULL;
+	}
+	const Int startIndex = field->getIndex(startCell.x, startCell.y);
+	const Int destIndex = field->getIndex(destCell.x, destCell.y);
+	if (field->m_cost[startIndex] == PathfindFlowField::UNREACHED || field->m_cost[destIndex] == PathfindFlowField::UNREACHED) {
+		return NULL;
+	}
+	if (!isFlowFieldCellPassable(field, destCell.x, destCell.y)) {
+		return NULL; // the search finds the closest cell it can move into instead.
+	}
+	if (!checkDestination(obj, destCell.x, destCell.y, LAYER_GROUND, radius, centerInCell)) {
+		return NULL;
+	}
+
+	// The costs strictly fall along the next cells, so both walks end at the goal.
+	std::vector<Int> destChain;
+	Int index = destIndex;
+	for (;;) {
+		destChain.push_back(index);
+		Int next = field->m_next[index];
+		if (next == PathfindFlowField::NO_NEXT_CELL) {
+			break;
+		}
+		Int x = field->m_bounds.lo.x + index % field->m_width + s_flowFieldDelta[next].x;
+		Int y = field->m_bounds.lo.y + index / field->m_width + s_flowFieldDelta[next].y;
+		index = field->getIndex(x, y);
+	}
+	std::vector<Int> sortedDestChain(destChain);
+	std::sort(sortedDestChain.begin(), sortedDestChain.end());
+
+	std::vector<Int> cells;
+	index = startIndex;
+	for (;;) {
+		cells.push_back(index);
+		if (std::binary_search(sortedDestChain.begin(), sortedDestChain.end(), index)) {
+			break;
+		}
+		Int next = field->m_next[index];
+		Int x = field->m_bounds.lo.x + index % field->m_width + s_flowFieldDelta[next].x;
+		Int y = field->m_bounds.lo.y + index / field->m_width + s_flowFieldDelta[next].y;
+		index = field->getIndex(x, y);
+	}
+	Int meet = (Int)(std::find(destChain.begin(), destChain.end(), index) - destChain.begin());
+	for (Int k = meet - 1; k >= 0; --k) {
+		cells.push_back(destChain[k]);
+	}
+
+	// The field only knows the terrain, so check the units in the way like the search does for
+	// every cell it moves into. A blocked path goes back to the regular search, which routes around.
+	TCheckMovementInfo info;
+	info.layer = LAYER_GROUND;
+	info.centerInCell = centerInCell;
+	info.radius = radius;
+	info.considerTransient = false;
+	info.acceptableSurfaces = locomotorSet.getValidSurfaces();
+	for (size_t c = 1; c < cells.size(); ++c) {
+		info.cell.x = field->m_bounds.lo.x + cells[c] % field->m_width;
+		info.cell.y = field->m_bounds.lo.y + cells[c] / field->m_width;
+		if (!checkForMovement(obj, info) || info.enemyFixed) {
+			m_groupPathStats.m_blockedFieldPaths++;
+			return NULL;
+		}
+	}
+
+	// Same as prependCells: skip the cell of the unit itself and start at its feet.
+	Path *path = newInstance(Path);
+	Coord3D pos;
+	PathfindCell *prevCell = NULL;
+	Int last = (Int)cells.size() - 1;
+	for (Int k = last; k >= 0; --k) {
+		if (k == 0 && last > 0) {
+			break;
+		}
+		Int x = field->m_bounds.lo.x + cells[k] % field->m_width;
+		Int y = field->m_bounds.lo.y + cells[k] / field->m_width;
+		PathfindCell *cell = getCell(LAYER_GROUND, x, y);
+		adjustCoordToCell(x, y, centerInCell, pos, LAYER_GROUND);
+
+		Bool canOptimize = true;
+		if (cell->getType() == PathfindCell::CELL_CLIFF) {
+			if (prevCell && prevCell->getType() != PathfindCell::CELL_CLIFF) {
+				path->getFirstNode()->setCanOptimize(false);
+			}
+		}	else {
+			if (prevCell && prevCell->getType() == PathfindCell::CELL_CLIFF) {
+				canOptimize = false;
+			}
+		}
+
+		path->prependNode(&pos, LAYER_GROUND);
+		path->getFirstNode()->setCanOptimize(canOptimize);
+		prevCell = cell;
+	}
+	if (from->x != path->getFirstNode()->getPosition()->x || from->y != path->getFirstNode()->getPosition()->y) {
+		path->prependNode(from, LAYER_GROUND);
+	}
+
+	path->optimize(obj, locomotorSet.getValidSurfaces(), false);
+	return path;
+}
+
+//-----------------------------------------------------------------------------
+void Pathfinder::clearFlowFields( void )
+{
+	for (size_t i = 0; i < m_flowFields.size(); ++i) {
+		delete m_flowFields[i];
+	}
+	m_flowFields.clear();
+}
+
+//-----------------------------------------------------------------------------
+void Pathfinder::resetGroupPathStats( void )
+{
+	memset(&m_groupPathStats, 0, sizeof(m_groupPathStats));
+}
+
+//-----------------------------------------------------------------------------
+void Pathfinder::reportGroupPathStats( void ) const
+{
+	const GroupPathStats &stats = m_groupPathStats;
+	if (stats.m_groupOrders == 0) {
+		return;
+	}
+
+	const Real orders = (Real)stats.m_groupOrders;
+	ProfileUtil::print("Group path benchmark: %u group orders, %u members, %u flow fields\n",
+		stats.m_groupOrders, stats.m_members, stats.m_fields);
+	ProfileUtil::print("  flow fields:     %u cells expanded, %.1f per order, %u member paths, %u blocked by units\n",
+		stats.m_fieldCells, stats.m_fieldCells / orders, stats.m_fieldPaths, stats.m_blockedFieldPaths);
+	ProfileUtil::print("  member searches: %u cells expanded, %.1f per order, %u member paths\n",
+		stats.m_searchCells, stats.m_searchCells / orders, stats.m_searchPaths);
+	DEBUG_LOG(("Pathfinder - %u group orders: flow fields %u cells for %u paths, member searches %u cells for %u paths",
+		stats.m_groupOrders, stats.m_fieldCells, stats.m_fieldPaths, stats.m_searchCells, stats.m_searchPaths));
+}
+
 //-----------------------------------------------------------------------------
 void Pathfinder::crc( Xfer *xfer )
 {
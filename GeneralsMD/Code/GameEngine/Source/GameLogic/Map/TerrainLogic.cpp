@@ -31,6 +31,7 @@
 
 
 #include "Common/DataChunk.h"
+#include "Common/GameEndChecks.h"
 #include "Common/GameState.h"
 #include "Common/MapObject.h"
 #include "Common/Radar.h"
@@ -953,6 +954,15 @@ Real Bridge::getBridgeHeight(const Coord3D *pLoc, Coord3D* normal)
 	return t*factor;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** The line of sight check of -verifyLOS */
+//-------------------------------------------------------------------------------------------------
+static void runVerifyLineOfSight( UnsignedInt seed )
+{
+	if( TheTerrainLogic )
+		TheTerrainLogic->verifyLineOfSight( seed, 100000 );
+}
+
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
 TerrainLogic::TerrainLogic()
@@ -983,6 +993,7 @@ TerrainLogic::TerrainLogic()
 	m_mapDX = 0;
 	m_mapDY = 0;
 
+	GameEndChecks::registerCheck( GameEndChecks::VERIFY_LOS, runVerifyLineOfSight );
 
 }
 
@@ -2635,6 +2646,20 @@ void TerrainLogic::setActiveBoundary(Int newActiveBoundary)
 	TheTacticalView->forceCameraConstraintRecalc();
 }
 
+// ------------------------------------------------------------------------------------------------
+/** Queue a radar refresh of the height map cells from iMin to iMax, including the neighbor
+	* cells that the flattening and cratering also lower. */
+// ------------------------------------------------------------------------------------------------
+static void queueRadarRefreshOfCells( const ICoord2D &iMin, const ICoord2D &iMax )
+{
+	Region2D area;
+	area.lo.x = (iMin.x - 1) * MAP_XY_FACTOR;
+	area.lo.y = (iMin.y - 1) * MAP_XY_FACTOR;
+	area.hi.x = (iMax.x + 1) * MAP_XY_FACTOR;
+	area.hi.y = (iMax.y + 1) * MAP_XY_FACTOR;
+	TheRadar->queueTerrainAreaRefresh( &area );
+}
+
 // ------------------------------------------------------------------------------------------------
 /** Flatten the terrain beneath a struture. */
 // ------------------------------------------------------------------------------------------------
@@ -2763,6 +2788,8 @@ void TerrainLogic::flattenTerrain(Object *obj)
 				}
 			}
 
+			// TheSuperHackers @performance 18/10/2026 Show the flattened area on the radar.
+			queueRadarRefreshOfCells( iMin, iMax );
 
 		break;
 		}
@@ -2845,6 +2872,9 @@ void TerrainLogic::flattenTerrain(Object *obj)
 				}
 			}
 
+			// TheSuperHackers @performance 18/10/2026 Show the flattened area on the radar.
+			queueRadarRefreshOfCells( iMin, iMax );
+
 		}
 		break;
 	}
@@ -2900,6 +2930,9 @@ void TerrainLogic::createCraterInTerrain(Object *obj)
     }
   }
 
+	// TheSuperHackers @performance 18/10/2026 Show the crater on the radar.
+	queueRadarRefreshOfCells( iMin, iMax );
+
 }
 
 
@@ -696,8 +696,9 @@ void BridgeBehavior::onBodyDamageStateChange( const DamageInfo* damageInfo,
 	// track of how often we makes requests to do a refresh and doesn't do them too
 	// often because it's expensive to refresh the terrain
 	//
+	// TheSuperHackers @performance 18/10/2026 Refresh the area of the bridge only.
 	if( oldState == BODY_RUBBLE || newState == BODY_RUBBLE )
-		TheRadar->queueTerrainRefresh();
+		TheRadar->queueTerrainAreaRefresh( bridge->getBounds() );
 
 }
 
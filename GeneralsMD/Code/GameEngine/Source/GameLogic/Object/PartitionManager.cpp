@@ -51,6 +51,7 @@
 
 #include "Common/ActionManager.h"
 #include "Common/DiscreteCircle.h"
+#include "Common/GameEndChecks.h"
 #include "Common/GameEngine.h"
 #include "Common/GameState.h"
 #include "Common/GameUtility.h"
@@ -59,9 +60,11 @@
 #include "Common/PerfTimer.h"
 #include "Common/Player.h"
 #include "Common/PlayerList.h"
+#include "Common/ProfileUtil.h"
 #include "Common/Radar.h"
 #include "Common/ThingFactory.h"	// for bullet type hack
 #include "Common/ThingTemplate.h"
+#include "Common/Tracer.h"
 #include "Common/Xfer.h"
 
 #include "GameLogic/AIPathfind.h"
@@ -118,13 +121,96 @@ static PartitionContactList* TheContactList = NULL;
 //-----------------------------------------------------------------------------
 //         Local Types
 //-----------------------------------------------------------------------------
-struct ThreatValueParms
+//-----------------------------------------------------------------------------
+/**
+	The cells of a DiscreteCircle of one radius, relative to its center. The shape doesn't depend on
+	where the circle is drawn, so every radius is generated once and shared by all the look, shroud,
+	threat and value updates instead of running Bresenham again for each of them.
+*/
+struct PartitionManager::CircleTable
 {
-	Int playerIndex;
-	Real xCenter;
-	Real yCenter;
-	Real radius;
-	UnsignedInt threatOrValue;
+	struct Span
+	{
+		Int yOffset;
+		Int halfWidth;		///< the span covers xCenter - halfWidth to xCenter + halfWidth, inclusive
+		Int firstCell;		///< index of the leftmost cell of the span in m_falloff
+	};
+
+	std::vector<Span> m_spans;		///< in the order DiscreteCircle::drawCircle draws them
+	std::vector<Real> m_falloff;	///< threat and value multiplier of every cell, 1 at the center
+
+	void addSpan(Int yOffset, Int halfWidth, Real radius);
+};
+
+//-----------------------------------------------------------------------------
+/// A cell changed shroud status for a player.
+static void onShroudEdge(Int playerIndex, Int x, Int y, CellShroudStatus newShroud)
+{
+	// On an edge trigger, tell all objects to think about their shroudedness
+	ThePartitionManager->getCellAt(x, y)->invalidateShroudedStatusForAllCois( playerIndex );
+
+	if( playerIndex == rts::getObservedOrLocalPlayer()->getPlayerIndex() )
+	{
+		// and if this is the local player, do the Client update.
+		TheDisplay->setShroudLevel(x, y, newShroud);
+		TheRadar->setShroudLevel(x, y, newShroud);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/// The players of a mask, highest index first like the per player loops always went.
+struct CirclePlayers
+{
+	Int m_index[MAX_PLAYER_COUNT];
+	Int m_count;
+
+	CirclePlayers(PlayerMaskType playerMask) : m_count(0)
+	{
+		for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
+		{
+			const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
+			if( BitIsSet( playerMask, currentPlayer->getPlayerMask() ) )
+				m_index[m_count++] = currentIndex;
+		}
+	}
+};
+
+//-----------------------------------------------------------------------------
+/// Applies a looker or shrouder change for all the players to each span of a circle.
+template <void (ShroudMap::*SpanFunc)(Int, Int, Int, Int)>
+struct ShroudCircleOp
+{
+	const CirclePlayers &m_players;
+	ShroudMap *m_shroudMap;
+
+	ShroudCircleOp(const CirclePlayers &players, ShroudMap *shroudMap) : m_players(players), m_shroudMap(shroudMap) { }
+
+	void operator()(PartitionCell *, Int x1, Int x2, Int y, const Real *) const
+	{
+		for (Int i = 0; i < m_players.m_count; ++i)
+			(m_shroudMap->*SpanFunc)(m_players.m_index[i], x1, x2, y);
+	}
+};
+
+//-----------------------------------------------------------------------------
+/// Applies a threat or value change for all the players to each span of a circle.
+template <void (PartitionCell::*CellFunc)(Int, UnsignedInt)>
+struct ThreatValueCircleOp
+{
+	const CirclePlayers &m_players;
+	UnsignedInt m_threatOrValue;
+
+	ThreatValueCircleOp(const CirclePlayers &players, UnsignedInt threatOrValue) : m_players(players), m_threatOrValue(threatOrValue) { }
+
+	void operator()(PartitionCell *cell, Int x1, Int x2, Int, const Real *falloff) const
+	{
+		for (Int x = x1; x <= x2; ++x, ++cell, ++falloff)
+		{
+			UnsignedInt amount = REAL_TO_UNSIGNEDINT(m_threatOrValue * *falloff);
+			for (Int i = 0; i < m_players.m_count; ++i)
+				(cell->*CellFunc)(m_players.m_index[i], amount);
+		}
+	}
 };
 
 struct CollideInfo
@@ -332,15 +418,6 @@ inline Real maxReal(Real a, Real b)
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-static void hLineAddLooker(Int x1, Int x2, Int y, void *playerIndexVoid);
-static void hLineRemoveLooker(Int x1, Int x2, Int y, void *playerIndexVoid);
-static void hLineAddShrouder(Int x1, Int x2, Int y, void *playerIndexVoid);
-static void hLineRemoveShrouder(Int x1, Int x2, Int y, void *playerIndexVoid);
-static void hLineAddThreat(Int x1, Int x2, Int y, void *threatValueParms);
-static void hLineRemoveThreat(Int x1, Int x2, Int y, void *threatValueParms);
-static void hLineAddValue(Int x1, Int x2, Int y, void *threatValueParms);
-static void hLineRemoveValue(Int x1, Int x2, Int y, void *threatValueParms);
-
 static void projectCoord3D(Coord3D *coord, const Coord3D *unitDir, Real dist);
 static void flipCoord3D(Coord3D *coord);
 
@@ -1235,18 +1312,8 @@ PartitionCell::PartitionCell()
 	m_loTerrainZ = HUGE_DIST;		// huge positive
 	m_hiTerrainZ = -HUGE_DIST;	// huge negative
 #endif
-	/*
-		You may be asking yourself: why do we model the shroud for all players,
-		rather than just the local player? And the answer is: because this allows
-		us to checksum these values for net games, to help prevent "shroud cheaters"
-		(who use a trainer to disable the shroud on their system).
-	*/
 	for (int i = 0; i < MAX_PLAYER_COUNT; ++i)
 	{
-		// Default is "passive shroud".  1,0.
-		m_shroudLevel[i].m_currentShroud = 1;
-		m_shroudLevel[i].m_activeShroudLevel = 0;
-
 		// default cash value is 0
 		m_cashValue[i] = 0;
 
@@ -1274,124 +1341,32 @@ void PartitionCell::invalidateShroudedStatusForAllCois(Int playerIndex)
 //-----------------------------------------------------------------------------
 void PartitionCell::addLooker(Int playerIndex)
 {
-	CellShroudStatus oldShroud = getShroudStatusForPlayer( playerIndex );
-	// The decreasing Algorithm: A 1 will go straight to -1, otherwise it just gets decremented
-	m_shroudLevel[playerIndex].m_currentShroud = min( m_shroudLevel[playerIndex].m_currentShroud - 1, -1 );
-
-	CellShroudStatus newShroud = getShroudStatusForPlayer( playerIndex );
-
-//	DEBUG_LOG(( "ADD    %d, %d.  CS = %d, AS = %d for player %d.",
-//							m_cellX,
-//							m_cellY,
-//							m_shroudLevel[playerIndex].m_currentShroud,
-//							m_shroudLevel[playerIndex].m_activeShroudLevel,
-//							playerIndex
-//							));
-
-	if( oldShroud != newShroud )
-	{
-		// On an edge trigger, tell all objects to think about their shroudedness
-		invalidateShroudedStatusForAllCois( playerIndex );
-
-		if( playerIndex == rts::getObservedOrLocalPlayer()->getPlayerIndex() )
-		{
-			// and if this is the local player, do the Client update.
-			TheDisplay->setShroudLevel(m_cellX, m_cellY, newShroud);
-			TheRadar->setShroudLevel(m_cellX, m_cellY, newShroud);
-		}
-	}
+	ThePartitionManager->friend_getShroudMap()->addLookers( playerIndex, m_cellX, m_cellX, m_cellY );
 }
 
 //-----------------------------------------------------------------------------
 void PartitionCell::removeLooker(Int playerIndex)
 {
-	CellShroudStatus oldShroud = getShroudStatusForPlayer( playerIndex );
-	// the increasing Algorithm: a -1 goes up to min(1,activeLevel), otherwise it just gets incremented
-	if( m_shroudLevel[playerIndex].m_currentShroud == -1 )
-		m_shroudLevel[playerIndex].m_currentShroud = min( m_shroudLevel[playerIndex].m_activeShroudLevel, (Short)1 );
-	else
-	{
-		DEBUG_ASSERTCRASH( m_shroudLevel[playerIndex].m_currentShroud < 0, ("Someone is RemoveLooker-ing on a cell that is not looked at.  This will make a permanent shroud blob.") );
-		m_shroudLevel[playerIndex].m_currentShroud++;
-	}
-	CellShroudStatus newShroud = getShroudStatusForPlayer( playerIndex );
-
-//	DEBUG_LOG(( "REMOVE %d, %d.  CS = %d, AS = %d for player %d.",
-//							m_cellX,
-//							m_cellY,
-//							m_shroudLevel[playerIndex].m_currentShroud,
-//							m_shroudLevel[playerIndex].m_activeShroudLevel,
-//							playerIndex
-//							));
-
-	if( oldShroud != newShroud )
-	{
-		// On an edge trigger, tell all objects to think about their shroudedness
-		invalidateShroudedStatusForAllCois( playerIndex );
-
-		if( playerIndex == rts::getObservedOrLocalPlayer()->getPlayerIndex() )
-		{
-			// and if this is the local player, do the Client update.
-			TheDisplay->setShroudLevel(m_cellX, m_cellY, newShroud);
-			TheRadar->setShroudLevel(m_cellX, m_cellY, newShroud);
-		}
-	}
+	ThePartitionManager->friend_getShroudMap()->removeLookers( playerIndex, m_cellX, m_cellX, m_cellY );
 }
 
 //-----------------------------------------------------------------------------
 void PartitionCell::addShrouder( Int playerIndex )
 {
-	CellShroudStatus oldShroud = getShroudStatusForPlayer( playerIndex );
-	// Increasing active shroud: activeLevel gets incremented, and CS is set to 1 if at zero
-	// do the algorithm
-	m_shroudLevel[playerIndex].m_activeShroudLevel++;
-	if( m_shroudLevel[playerIndex].m_currentShroud == 0 )
-	{
-		m_shroudLevel[playerIndex].m_currentShroud = 1;
-	}
-	CellShroudStatus newShroud = getShroudStatusForPlayer( playerIndex );
-
-	if( oldShroud != newShroud )
-	{
-		// On an edge trigger, tell all objects to think about their shroudedness
-		invalidateShroudedStatusForAllCois( playerIndex );
-
-		// and update the client if we are on the local player
-		if( playerIndex == rts::getObservedOrLocalPlayer()->getPlayerIndex() )
-		{
-			TheDisplay->setShroudLevel(m_cellX, m_cellY, newShroud);
-			TheRadar->setShroudLevel(m_cellX, m_cellY, newShroud);
-		}
-	}
+	ThePartitionManager->friend_getShroudMap()->addShrouders( playerIndex, m_cellX, m_cellX, m_cellY );
 }
 
 //-----------------------------------------------------------------------------
 void PartitionCell::removeShrouder( Int playerIndex )
 {
-	// Decreasing active shroud: just decrement activeLevel.  This will never result in a client change.
-	// Either it was passive shroud and is now active, or it was being looked at and still is.
-	m_shroudLevel[playerIndex].m_activeShroudLevel--;
-	DEBUG_ASSERTCRASH( m_shroudLevel[playerIndex].m_activeShroudLevel >= 0, ("Shroud generation has gone negative.  This can't happen.") );
+	ThePartitionManager->friend_getShroudMap()->removeShrouders( playerIndex, m_cellX, m_cellX, m_cellY );
 }
 
-//-----------------------------------------------------------------------------
-//Bool PartitionCell::isShroudedForPlayer( Int playerIndex ) const
-//{
-	// There isn't an absolute answer.  This cell is only shrouded in regards to a person
-//	return (m_shroudLevel[playerIndex].m_currentShroud == 1);
-//}
-
 //-----------------------------------------------------------------------------
 CellShroudStatus PartitionCell::getShroudStatusForPlayer( Int playerIndex ) const
 {
 	// There are now three answers, but the question still requires "to whom"
-
-	if( m_shroudLevel[playerIndex].m_currentShroud == 1 )
-		return CELLSHROUD_SHROUDED;
-	else if( m_shroudLevel[playerIndex].m_currentShroud == 0 )
-		return CELLSHROUD_FOGGED;// ie Nobody actively looking
-	else
-		return CELLSHROUD_CLEAR;
+	return ThePartitionManager->friend_getShroudMap()->getShroudStatus( playerIndex, m_cellX, m_cellY );
 }
 
 //-----------------------------------------------------------------------------
@@ -1508,7 +1483,9 @@ void PartitionCell::validateCoiList()
 void PartitionCell::crc( Xfer *xfer )
 {
 
-	xfer->xferUser(&m_shroudLevel, sizeof(ShroudLevel) * MAX_PLAYER_COUNT);
+	ShroudLevel shroudLevel[MAX_PLAYER_COUNT];
+	ThePartitionManager->friend_getShroudMap()->getShroudLevels( m_cellX, m_cellY, shroudLevel );
+	xfer->xferUser(&shroudLevel, sizeof(ShroudLevel) * MAX_PLAYER_COUNT);
 	xfer->xferUser(&m_cellX, sizeof(m_cellX));
 	xfer->xferUser(&m_cellY, sizeof(m_cellY));
 
@@ -1525,8 +1502,13 @@ void PartitionCell::xfer( Xfer *xfer )
 	XferVersion version = currentVersion;
 	xfer->xferVersion( &version, currentVersion );
 
-	// xfer shroud data
-	xfer->xferUser( &m_shroudLevel, sizeof( ShroudLevel ) * MAX_PLAYER_COUNT );
+	// xfer shroud data, the shroud map keeps it by player now but it is still saved by cell
+	ShroudMap *shroudMap = ThePartitionManager->friend_getShroudMap();
+	ShroudLevel shroudLevel[MAX_PLAYER_COUNT];
+	shroudMap->getShroudLevels( m_cellX, m_cellY, shroudLevel );
+	xfer->xferUser( &shroudLevel, sizeof( ShroudLevel ) * MAX_PLAYER_COUNT );
+	if( xfer->getXferMode() == XFER_LOAD )
+		shroudMap->setShroudLevels( m_cellX, m_cellY, shroudLevel );
 
 }
 
@@ -2567,6 +2549,20 @@ void PartitionContactList::processContactList()
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+// The checks of -verifyShroudCircles and -benchmarkShroud
+static void runVerifyShroudCircles(UnsignedInt seed)
+{
+	if (ThePartitionManager)
+		ThePartitionManager->verifyCircles(seed, 2000);
+}
+
+static void runBenchmarkShroud(UnsignedInt)
+{
+	if (ThePartitionManager)
+		ThePartitionManager->runShroudBenchmark();
+}
+
 //-----------------------------------------------------------------------------
 PartitionManager::PartitionManager()
 {
@@ -2583,6 +2579,9 @@ PartitionManager::PartitionManager()
 #ifdef FASTER_GCO
 	m_maxGcoRadius = 0;
 #endif
+
+	GameEndChecks::registerCheck(GameEndChecks::VERIFY_SHROUD_CIRCLES, runVerifyShroudCircles);
+	GameEndChecks::registerCheck(GameEndChecks::BENCHMARK_SHROUD, runBenchmarkShroud);
 }
 
 //-----------------------------------------------------------------------------
@@ -2591,6 +2590,14 @@ PartitionManager::~PartitionManager()
 
 	shutdown();
 
+	for (std::vector<CircleTable *>::iterator it = m_circleTables.begin(); it != m_circleTables.end(); ++it)
+		delete *it;
+	m_circleTables.clear();
+
+	for (std::vector<ObjectRangeBuffer *>::iterator it = m_freeRangeBuffers.begin(); it != m_freeRangeBuffers.end(); ++it)
+		delete *it;
+	m_freeRangeBuffers.clear();
+
 }
 
 //-----------------------------------------------------------------------------
@@ -2643,6 +2650,9 @@ void PartitionManager::init()
 		m_cellCountY = REAL_TO_INT_CEIL(m_worldExtents.height() * m_cellSizeInv);
 		m_totalCellCount = m_cellCountX * m_cellCountY;
 		m_cells = MSGNEW("PartitionManager_Cells") PartitionCell[m_totalCellCount];
+		m_shroudMap.init(m_cellCountX, m_cellCountY, onShroudEdge);
+		if (GameEndChecks::isEnabled(GameEndChecks::BENCHMARK_SHROUD))
+			m_shroudMap.startRecording();
 		for (Int x = 0; x < m_cellCountX; x++)
 		{
 			for (Int y = 0; y < m_cellCountY; y++)
@@ -2731,6 +2741,7 @@ void PartitionManager::shutdown()
 
 	delete [] m_cells;
 	m_cells = NULL;
+	m_shroudMap.clear();
 
 	m_cellSize = m_cellSizeInv = 0.0f;
 	m_cellCountX = 0;
@@ -2745,6 +2756,8 @@ void PartitionManager::shutdown()
 void PartitionManager::update()
 {
 	//USE_PERF_TIMER(PartitionManager_update)
+	// TheSuperHackers @performance 18/10/2026 Trace the partition manager, see Tracer.
+	TRACE_SCOPE("PartitionManager::update");
 	{
 #ifdef INTENSE_DEBUG
 		Int cc = 0;
@@ -2997,10 +3010,10 @@ void PartitionManager::revealMapForPlayer( Int playerIndex )
 {
 	// By looking and then stopping on every cell, I clear all Passive Shroud
 	// By adding a looker directly I don't hit the Ally logic of the normal look/doShroudReveal
-	for (int i = 0; i < m_totalCellCount; ++i)
+	for (Int y = 0; y < m_cellCountY; ++y)
 	{
-		m_cells[i].addLooker( playerIndex );
-		m_cells[i].removeLooker( playerIndex );
+		m_shroudMap.addLookers( playerIndex, 0, m_cellCountX - 1, y );
+		m_shroudMap.removeLookers( playerIndex, 0, m_cellCountX - 1, y );
 	}
 }
 
@@ -3012,9 +3025,9 @@ void PartitionManager::revealMapForPlayerPermanently( Int playerIndex )
 	// By skipping the removeLooker, I consider myself as actively looking at everything,
 	// so Shroud generation will no longer function
 	// By adding a looker directly I don't hit the Ally logic of the normal look/doShroudReveal
-	for (int i = 0; i < m_totalCellCount; ++i)
+	for (Int y = 0; y < m_cellCountY; ++y)
 	{
-		m_cells[i].addLooker( playerIndex );
+		m_shroudMap.addLookers( playerIndex, 0, m_cellCountX - 1, y );
 	}
 }
 
@@ -3028,9 +3041,9 @@ void PartitionManager::undoRevealMapForPlayerPermanently( Int playerIndex )
 
 	// This will have amusing consequences if done without a preceding revealMapForPlayerPermanently.
 	// Everything you own can become shrouded.
-	for (int i = 0; i < m_totalCellCount; ++i)
+	for (Int y = 0; y < m_cellCountY; ++y)
 	{
-		m_cells[i].removeLooker( playerIndex );
+		m_shroudMap.removeLookers( playerIndex, 0, m_cellCountX - 1, y );
 	}
 }
 
@@ -3043,10 +3056,10 @@ void PartitionManager::shroudMapForPlayer( Int playerIndex )
 	processEntirePendingUndoShroudRevealQueue();
 
 	// By pulsing a blast of shroud like this, we will set everything not actively looked at as Passive Shroud
-	for (int i = 0; i < m_totalCellCount; ++i)
+	for (Int y = 0; y < m_cellCountY; ++y)
 	{
-		m_cells[i].addShrouder( playerIndex );
-		m_cells[i].removeShrouder( playerIndex );
+		m_shroudMap.addShrouders( playerIndex, 0, m_cellCountX - 1, y );
+		m_shroudMap.removeShrouders( playerIndex, 0, m_cellCountX - 1, y );
 	}
 }
 
@@ -3075,8 +3088,10 @@ CellShroudStatus PartitionManager::getShroudStatusForPlayer(Int playerIndex, Int
 	if( playerIndex < 0 )
 		return CELLSHROUD_SHROUDED;// Safety.  There are no Negative players, but PlayerIndex is typedef'd to Int, not UnsignedInt
 
-	const PartitionCell* cell = getCellAt(x, y);
-	return cell ? cell->getShroudStatusForPlayer(playerIndex) : CELLSHROUD_SHROUDED;
+	if (x < 0 || y < 0 || x >= m_cellCountX || y >= m_cellCountY)
+		return CELLSHROUD_SHROUDED;
+
+	return m_shroudMap.getShroudStatus(playerIndex, x, y);
 }
 
 //-----------------------------------------------------------------------------
@@ -3231,12 +3246,13 @@ Object *PartitionManager::getClosestObjects(
 	Real maxDist,
 	DistanceCalculationType dc,
 	PartitionFilter **filters,
-	SimpleObjectIterator *iterArg,	// if nonnull, append ALL satisfactory objects to the iterator (not just the single closest)
+	ObjectRangeBuffer *bufferArg,	// if nonnull, append ALL satisfactory objects to the buffer (not just the single closest)
 	Real *closestDistArg,
 	Coord3D *closestVecArg
 )
 {
 	//USE_PERF_TIMER(getClosestObjects)
+	TRACE_SCOPE("PartitionManager::getClosestObjects");
 
 #ifdef DUMP_PERF_STATS
 	if (TheGameLogic->getFrame() != s_gcoPerfFrame)
@@ -3350,9 +3366,9 @@ Object *PartitionManager::getClosestObjects(
 
 				// ok, this is within the range, and the filters allow it.
 				// add it to the iter, if we have one....
-				if (iterArg)
+				if (bufferArg)
 				{
-					iterArg->insert(thisObj, thisDistSqr);
+					bufferArg->insert(thisObj, thisDistSqr);
 				}
 				else
 				{
@@ -3365,7 +3381,7 @@ Object *PartitionManager::getClosestObjects(
 
 					if (!foundAny)
 					{
-						// if not adding to iterArg, we want to stop once we have the closest object.
+						// if not adding to bufferArg, we want to stop once we have the closest object.
 						maxRadiusLimit = curRadius;
 					}
 					foundAny = true;
@@ -3425,9 +3441,9 @@ Object *PartitionManager::getClosestObjects(
 				continue;
 
 			// ok, guess this is a winner!
-			if (iterArg)
+			if (bufferArg)
 			{
-				iterArg->insert(thisObj, thisDistSqr);
+				bufferArg->insert(thisObj, thisDistSqr);
 			}
 			else
 			{
@@ -3437,10 +3453,10 @@ Object *PartitionManager::getClosestObjects(
 
 				if (!foundAny)
 				{
-					// if not adding to iterArg, we want to stop once we have the closest object.
+					// if not adding to bufferArg, we want to stop once we have the closest object.
 					// since all objects in this radius (and the next radius, due to slop) might
 					// be slightly closer, we still have to check all of them. so set the termination
-					// radius to be our-current-radius-plus-1. (if we ARE adding to the iterArg, we skip
+					// radius to be our-current-radius-plus-1. (if we ARE adding to the bufferArg, we skip
 					// this, cuz we want to go all the way out to the original max we specified as an arg.)
 					iter.setMaxRadius(iter.getCurCellRadius() + 2);
 				}
@@ -3635,13 +3651,31 @@ SimpleObjectIterator *PartitionManager::iterateObjectsInRange(
 	SimpleObjectIterator *iter = newInstance(SimpleObjectIterator);
 	iterHolder.hold(iter);
 
-	getClosestObjects(obj, NULL, maxDist, dc, filters, iter, NULL, NULL);
+	ObjectRangeBufferHolder buffer;
+	getClosestObjects(obj, NULL, maxDist, dc, filters, buffer, NULL, NULL);
+	for (Int i = 0; i < buffer->getCount(); ++i)
+		iter->insert(buffer->getObject(i), buffer->getNumeric(i));
 
 	iter->sort(order);
 	iterHolder.release();
 	return iter;
 }
 
+//-----------------------------------------------------------------------------
+void PartitionManager::getObjectsInRange(
+	const Object *obj,
+	Real maxDist,
+	DistanceCalculationType dc,
+	ObjectRangeBuffer *buffer,
+	PartitionFilter **filters,
+	IterOrderType order
+)
+{
+	buffer->makeEmpty();
+	getClosestObjects(obj, NULL, maxDist, dc, filters, buffer, NULL, NULL);
+	buffer->sort(order);
+}
+
 //-----------------------------------------------------------------------------
 SimpleObjectIterator *PartitionManager::iterateObjectsInRange(
 	const Coord3D *pos,
@@ -3655,13 +3689,31 @@ SimpleObjectIterator *PartitionManager::iterateObjectsInRange(
 	SimpleObjectIterator *iter = newInstance(SimpleObjectIterator);
 	iterHolder.hold(iter);
 
-	getClosestObjects(NULL, pos, maxDist, dc, filters, iter, NULL, NULL);
+	ObjectRangeBufferHolder buffer;
+	getClosestObjects(NULL, pos, maxDist, dc, filters, buffer, NULL, NULL);
+	for (Int i = 0; i < buffer->getCount(); ++i)
+		iter->insert(buffer->getObject(i), buffer->getNumeric(i));
 
 	iter->sort(order);
 	iterHolder.release();
 	return iter;
 }
 
+//-----------------------------------------------------------------------------
+void PartitionManager::getObjectsInRange(
+	const Coord3D *pos,
+	Real maxDist,
+	DistanceCalculationType dc,
+	ObjectRangeBuffer *buffer,
+	PartitionFilter **filters,
+	IterOrderType order
+)
+{
+	buffer->makeEmpty();
+	getClosestObjects(NULL, pos, maxDist, dc, filters, buffer, NULL, NULL);
+	buffer->sort(order);
+}
+
 //-----------------------------------------------------------------------------
 SimpleObjectIterator* PartitionManager::iteratePotentialCollisions(
 	const Coord3D* pos,
@@ -3680,12 +3732,33 @@ SimpleObjectIterator* PartitionManager::iteratePotentialCollisions(
 	PartitionFilterWouldCollide filter(*pos, geom, angle, true);
 	PartitionFilter *filters[] = { &filter, NULL };
 
-	getClosestObjects(NULL, pos, maxDist, use2D ? FROM_BOUNDINGSPHERE_2D : FROM_BOUNDINGSPHERE_3D, filters, iter, NULL, NULL);
+	ObjectRangeBufferHolder buffer;
+	getClosestObjects(NULL, pos, maxDist, use2D ? FROM_BOUNDINGSPHERE_2D : FROM_BOUNDINGSPHERE_3D, filters, buffer, NULL, NULL);
+	for (Int i = 0; i < buffer->getCount(); ++i)
+		iter->insert(buffer->getObject(i), buffer->getNumeric(i));
 
 	iterHolder.release();
 	return iter;
 }
 
+//-----------------------------------------------------------------------------
+ObjectRangeBuffer *PartitionManager::acquireRangeBuffer()
+{
+	if (m_freeRangeBuffers.empty())
+		return NEW ObjectRangeBuffer;
+
+	ObjectRangeBuffer *buffer = m_freeRangeBuffers.back();
+	m_freeRangeBuffers.pop_back();
+	return buffer;
+}
+
+//-----------------------------------------------------------------------------
+void PartitionManager::releaseRangeBuffer(ObjectRangeBuffer *buffer)
+{
+	buffer->makeEmpty();
+	m_freeRangeBuffers.push_back(buffer);
+}
+
 //-----------------------------------------------------------------------------
 Bool PartitionManager::isColliding( const Object *a, const Object *b ) const
 {
@@ -3989,6 +4062,94 @@ Bool PartitionManager::findPositionAround( const Coord3D *center,
 
 }
 
+//-----------------------------------------------------------------------------
+void PartitionManager::CircleTable::addSpan(Int yOffset, Int halfWidth, Real radius)
+{
+	Span span;
+	span.yOffset = yOffset;
+	span.halfWidth = halfWidth;
+	span.firstCell = (Int)m_falloff.size();
+	m_spans.push_back(span);
+
+	// This must stay the exact float math the threat and value maps have always used, as the AI
+	// decides on their contents and has to come to the same conclusions on every machine.
+	for (Int x = -halfWidth; x <= halfWidth; ++x)
+	{
+		Real xDist = INT_TO_REAL(x);
+		Real yDist = INT_TO_REAL(yOffset);
+		Real distance = sqrt( pow(xDist, 2) + pow(yDist, 2) );
+		Real mulVal = 1 - distance / radius;
+		if (mulVal < 0.0f)
+			mulVal = 0.0f;
+		else if (mulVal > 1.0f)
+			mulVal = 1.0f;
+
+		m_falloff.push_back(mulVal);
+	}
+}
+
+//-----------------------------------------------------------------------------
+const PartitionManager::CircleTable *PartitionManager::getCircleTable(Int cellRadius)
+{
+	if (cellRadius >= (Int)m_circleTables.size())
+		m_circleTables.resize(cellRadius + 1, NULL);
+
+	CircleTable *table = m_circleTables[cellRadius];
+	if (table == NULL)
+	{
+		table = new CircleTable;
+
+		// Threat and value fall off to nothing one cell past the edge of the circle.
+		Real fCellRadius = INT_TO_REAL(cellRadius + 1);
+
+		DiscreteCircle circle(0, 0, cellRadius);
+		const VecHorzLine &edges = circle.getEdges();
+		for (VecHorzLine::const_iterator it = edges.begin(); it != edges.end(); ++it)
+		{
+			table->addSpan(it->yPos, it->xEnd, fCellRadius);
+			if (it->yPos != 0)
+				table->addSpan(-it->yPos, it->xEnd, fCellRadius);
+		}
+
+		m_circleTables[cellRadius] = table;
+	}
+
+	return table;
+}
+
+//-----------------------------------------------------------------------------
+/**
+	Calls op(firstCell, x1, x2, y, firstFalloff) for the part of every span of the circle that is on
+	the map. Every cell of a circle is in exactly one span, so the order doesn't change the outcome.
+*/
+template <class CellOp>
+void PartitionManager::drawCircleSpans(Int cellCenterX, Int cellCenterY, Int cellRadius, const CellOp &op)
+{
+	const CircleTable *table = getCircleTable(cellRadius);
+
+	for (std::vector<CircleTable::Span>::const_iterator it = table->m_spans.begin(); it != table->m_spans.end(); ++it)
+	{
+		Int y = cellCenterY + it->yOffset;
+		if (y < 0 || y >= m_cellCountY)
+			continue;
+
+		Int x1 = cellCenterX - it->halfWidth;
+		Int x2 = cellCenterX + it->halfWidth;
+		Int firstCell = it->firstCell;
+		if (x1 < 0)
+		{
+			firstCell -= x1;
+			x1 = 0;
+		}
+		if (x2 >= m_cellCountX)
+			x2 = m_cellCountX - 1;
+		if (x1 > x2)
+			continue;
+
+		op(&m_cells[y * m_cellCountX + x1], x1, x2, y, &table->m_falloff[firstCell]);
+	}
+}
+
 //-----------------------------------------------------------------------------
 // This is the main accessor of the shroud system.  At this level, allies are taken
 // into consideration as specified by the caller.  Look/Unlook are the ones sending Ally info, as that
@@ -4004,18 +4165,9 @@ void PartitionManager::doShroudReveal(Real centerX, Real centerY, Real radius, P
 	if (cellRadius < 1)
 		cellRadius = 1;
 
-	DiscreteCircle circle(cellCenterX, cellCenterY, cellRadius);
-
-	for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
-	{
-		// Object's Look is the one who knows about allies.  Anyone can pask a player mask to me and all
-		// of those players will have an active looker applied to a bunch of cells
-		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
-		if( BitIsSet( playerMask, currentPlayer->getPlayerMask() ) )
-		{
-			circle.drawCircle(hLineAddLooker, (void*)currentIndex);
-		}
-	}
+	CirclePlayers players(playerMask);
+	if (players.m_count > 0)
+		drawCircleSpans(cellCenterX, cellCenterY, cellRadius, ShroudCircleOp<&ShroudMap::addLookers>(players, &m_shroudMap));
 }
 
 //-----------------------------------------------------------------------------
@@ -4071,16 +4223,9 @@ void PartitionManager::undoShroudReveal(Real centerX, Real centerY, Real radius,
 	if (cellRadius < 1)
 		cellRadius = 1;
 
-	DiscreteCircle circle(cellCenterX, cellCenterY, cellRadius);
-
-	for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
-	{
-		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
-		if( BitIsSet( playerMask, currentPlayer->getPlayerMask() ) )
-		{
-			circle.drawCircle(hLineRemoveLooker, (void*)currentIndex);
-		}
-	}
+	CirclePlayers players(playerMask);
+	if (players.m_count > 0)
+		drawCircleSpans(cellCenterX, cellCenterY, cellRadius, ShroudCircleOp<&ShroudMap::removeLookers>(players, &m_shroudMap));
 }
 
 //-----------------------------------------------------------------------------
@@ -4108,18 +4253,9 @@ void PartitionManager::doShroudCover(Real centerX, Real centerY, Real radius, Pl
 	if (cellRadius < 1)
 		cellRadius = 1;
 
-	DiscreteCircle circle(cellCenterX, cellCenterY, cellRadius);
-
-	for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
-	{
-		// Object's Shroud is the one who knows about allies.  Anyone can pask a player mask to me and all
-		// of those players will have an active shrouder applied to a bunch of cells
-		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
-		if( BitIsSet( playerMask, currentPlayer->getPlayerMask() ) )
-		{
-			circle.drawCircle(hLineAddShrouder, (void*)currentIndex);
-		}
-	}
+	CirclePlayers players(playerMask);
+	if (players.m_count > 0)
+		drawCircleSpans(cellCenterX, cellCenterY, cellRadius, ShroudCircleOp<&ShroudMap::addShrouders>(players, &m_shroudMap));
 }
 
 //-----------------------------------------------------------------------------
@@ -4132,16 +4268,9 @@ void PartitionManager::undoShroudCover(Real centerX, Real centerY, Real radius,
 	if (cellRadius < 1)
 		cellRadius = 1;
 
-	DiscreteCircle circle(cellCenterX, cellCenterY, cellRadius);
-
-	for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
-	{
-		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
-		if( BitIsSet( playerMask, currentPlayer->getPlayerMask() ) )
-		{
-			circle.drawCircle(hLineRemoveShrouder, (void*)currentIndex);
-		}
-	}
+	CirclePlayers players(playerMask);
+	if (players.m_count > 0)
+		drawCircleSpans(cellCenterX, cellCenterY, cellRadius, ShroudCircleOp<&ShroudMap::removeShrouders>(players, &m_shroudMap));
 }
 
 //-----------------------------------------------------------------------------
@@ -4149,131 +4278,363 @@ void PartitionManager::doThreatAffect( Real centerX, Real centerY, Real radius,
 {
 	Int cellCenterX, cellCenterY;
 	ThePartitionManager->worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
-	Real fCellCenterX = INT_TO_REAL(cellCenterX);
-	Real fCellCenterY = INT_TO_REAL(cellCenterY);
 
 	Int cellRadius = ThePartitionManager->worldToCellDist(radius);
 	if (cellRadius < 1)
 		cellRadius = 1;
 
-	Real fCellRadius = INT_TO_REAL(cellRadius + 1);
+	CirclePlayers players(playerMask);
+	if (players.m_count > 0)
+		drawCircleSpans(cellCenterX, cellCenterY, cellRadius, ThreatValueCircleOp<&PartitionCell::addThreatValue>(players, threatVal));
+}
 
-	DiscreteCircle circle(cellCenterX, cellCenterY, cellRadius);
+//-----------------------------------------------------------------------------
+void PartitionManager::undoThreatAffect( Real centerX, Real centerY, Real radius, UnsignedInt threatVal, PlayerMaskType playerMask)
+{
+	Int cellCenterX, cellCenterY;
+	ThePartitionManager->worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
 
-	ThreatValueParms parms;
-	parms.radius = fCellRadius;
-	parms.threatOrValue = threatVal;
-	parms.xCenter = fCellCenterX;
-	parms.yCenter = fCellCenterY;
+	Int cellRadius = ThePartitionManager->worldToCellDist(radius);
+	if (cellRadius < 1)
+		cellRadius = 1;
 
-	for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
-	{
-		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
-		if( BitIsSet( playerMask, currentPlayer->getPlayerMask() ) )
-		{
-			parms.playerIndex = currentIndex;
-			circle.drawCircle(hLineAddThreat, &parms);
-		}
-	}
+	CirclePlayers players(playerMask);
+	if (players.m_count > 0)
+		drawCircleSpans(cellCenterX, cellCenterY, cellRadius, ThreatValueCircleOp<&PartitionCell::removeThreatValue>(players, threatVal));
 }
 
 //-----------------------------------------------------------------------------
-void PartitionManager::undoThreatAffect( Real centerX, Real centerY, Real radius, UnsignedInt threatVal, PlayerMaskType playerMask)
+void PartitionManager::doValueAffect( Real centerX, Real centerY, Real radius, UnsignedInt valueVal, PlayerMaskType playerMask)
 {
 	Int cellCenterX, cellCenterY;
 	ThePartitionManager->worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
-	Real fCellCenterX = INT_TO_REAL(cellCenterX);
-	Real fCellCenterY = INT_TO_REAL(cellCenterY);
 
 	Int cellRadius = ThePartitionManager->worldToCellDist(radius);
 	if (cellRadius < 1)
 		cellRadius = 1;
 
-	Real fCellRadius = INT_TO_REAL(cellRadius + 1);
+	CirclePlayers players(playerMask);
+	if (players.m_count > 0)
+		drawCircleSpans(cellCenterX, cellCenterY, cellRadius, ThreatValueCircleOp<&PartitionCell::addCashValue>(players, valueVal));
+}
 
-	DiscreteCircle circle(cellCenterX, cellCenterY, cellRadius);
+//-----------------------------------------------------------------------------
+void PartitionManager::undoValueAffect( Real centerX, Real centerY, Real radius, UnsignedInt valueVal, PlayerMaskType playerMask)
+{
+	Int cellCenterX, cellCenterY;
+	ThePartitionManager->worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
 
-	ThreatValueParms parms;
-	parms.radius = fCellRadius;
-	parms.threatOrValue = threatVal;
-	parms.xCenter = fCellCenterX;
-	parms.yCenter = fCellCenterY;
+	Int cellRadius = ThePartitionManager->worldToCellDist(radius);
+	if (cellRadius < 1)
+		cellRadius = 1;
 
-	for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
+	CirclePlayers players(playerMask);
+	if (players.m_count > 0)
+		drawCircleSpans(cellCenterX, cellCenterY, cellRadius, ThreatValueCircleOp<&PartitionCell::removeCashValue>(players, valueVal));
+}
+
+//-----------------------------------------------------------------------------
+Bool PartitionManager::isSameThreatValueCircle(const Coord3D *posA, Real radiusA, const Coord3D *posB, Real radiusB)
+{
+	Int cellAX, cellAY, cellBX, cellBY;
+	worldToCell(posA->x, posA->y, &cellAX, &cellAY);
+	worldToCell(posB->x, posB->y, &cellBX, &cellBY);
+	if (cellAX != cellBX || cellAY != cellBY)
+		return false;
+
+	Int cellRadiusA = worldToCellDist(radiusA);
+	if (cellRadiusA < 1)
+		cellRadiusA = 1;
+
+	Int cellRadiusB = worldToCellDist(radiusB);
+	if (cellRadiusB < 1)
+		cellRadiusB = 1;
+
+	return cellRadiusA == cellRadiusB;
+}
+
+//-----------------------------------------------------------------------------
+/// One random look, shroud, threat or value circle of verifyCircles.
+struct PartitionManager::CircleUpdate
+{
+	enum Type { LOOK, SHROUD, THREAT, VALUE, TYPE_COUNT };
+
+	Int m_type;
+	Bool m_remove;
+	Real m_x;
+	Real m_y;
+	Real m_radius;
+	UnsignedInt m_amount;
+	PlayerMaskType m_playerMask;
+};
+
+//-----------------------------------------------------------------------------
+/// What the DiscreteCircle callback of verifyCircles needs to draw one circle for one player.
+struct VerifyCircleParms
+{
+	Int type;
+	Bool remove;
+	UnsignedInt amount;
+	Int playerIndex;
+	Real xCenter;
+	Real yCenter;
+	Real radius;
+};
+
+//-----------------------------------------------------------------------------
+/**
+	Draws a span of a circle the way the shroud, threat and value updates did before the span
+	tables, as the reference verifyCircles compares against.
+*/
+void PartitionManager::hLineVerifyCircle(Int x1, Int x2, Int y, void *parmsVoid)
+{
+	if (y < 0 || y >= ThePartitionManager->m_cellCountY || x1 >= ThePartitionManager->m_cellCountX || x2 < 0)
+		return;
+
+	const VerifyCircleParms *parms = (const VerifyCircleParms *)parmsVoid;
+
+	PartitionCell* cell = &ThePartitionManager->m_cells[y * ThePartitionManager->m_cellCountX + x1];	// yes, this could be invalid. we'll skip the bad ones.
+	for (Int x = x1; x <= x2; ++x, ++cell)
 	{
-		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
-		if( BitIsSet( playerMask, currentPlayer->getPlayerMask() ) )
+		if (x < 0 || x >= ThePartitionManager->m_cellCountX)
+			continue;
+
+		Real distance = sqrt( pow(x - parms->xCenter, 2) + pow(y - parms->yCenter, 2) );
+		Real mulVal = 1 - distance / parms->radius;
+		if (mulVal < 0.0f)
+			mulVal = 0.0f;
+		else if (mulVal > 1.0f)
+			mulVal = 1.0f;
+		UnsignedInt amount = REAL_TO_UNSIGNEDINT(parms->amount * mulVal);
+
+		switch (parms->type)
 		{
-			parms.playerIndex = currentIndex;
-			circle.drawCircle(hLineRemoveThreat, &parms);
+			case CircleUpdate::LOOK:
+				if (parms->remove) cell->removeLooker(parms->playerIndex); else cell->addLooker(parms->playerIndex);
+				break;
+			case CircleUpdate::SHROUD:
+				if (parms->remove) cell->removeShrouder(parms->playerIndex); else cell->addShrouder(parms->playerIndex);
+				break;
+			case CircleUpdate::THREAT:
+				if (parms->remove) cell->removeThreatValue(parms->playerIndex, amount); else cell->addThreatValue(parms->playerIndex, amount);
+				break;
+			case CircleUpdate::VALUE:
+				if (parms->remove) cell->removeCashValue(parms->playerIndex, amount); else cell->addCashValue(parms->playerIndex, amount);
+				break;
 		}
 	}
 }
 
 //-----------------------------------------------------------------------------
-void PartitionManager::doValueAffect( Real centerX, Real centerY, Real radius, UnsignedInt valueVal, PlayerMaskType playerMask)
+void PartitionManager::applyCircleUpdate(const CircleUpdate &update, Bool useSpanTables)
 {
+	if (useSpanTables)
+	{
+		switch (update.m_type)
+		{
+			case CircleUpdate::LOOK:
+				if (update.m_remove)
+					undoShroudReveal(update.m_x, update.m_y, update.m_radius, update.m_playerMask);
+				else
+					doShroudReveal(update.m_x, update.m_y, update.m_radius, update.m_playerMask);
+				break;
+			case CircleUpdate::SHROUD:
+				if (update.m_remove)
+					undoShroudCover(update.m_x, update.m_y, update.m_radius, update.m_playerMask);
+				else
+					doShroudCover(update.m_x, update.m_y, update.m_radius, update.m_playerMask);
+				break;
+			case CircleUpdate::THREAT:
+				if (update.m_remove)
+					undoThreatAffect(update.m_x, update.m_y, update.m_radius, update.m_amount, update.m_playerMask);
+				else
+					doThreatAffect(update.m_x, update.m_y, update.m_radius, update.m_amount, update.m_playerMask);
+				break;
+			case CircleUpdate::VALUE:
+				if (update.m_remove)
+					undoValueAffect(update.m_x, update.m_y, update.m_radius, update.m_amount, update.m_playerMask);
+				else
+					doValueAffect(update.m_x, update.m_y, update.m_radius, update.m_amount, update.m_playerMask);
+				break;
+		}
+		return;
+	}
+
 	Int cellCenterX, cellCenterY;
-	ThePartitionManager->worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
-	Real fCellCenterX = INT_TO_REAL(cellCenterX);
-	Real fCellCenterY = INT_TO_REAL(cellCenterY);
+	worldToCell(update.m_x, update.m_y, &cellCenterX, &cellCenterY);
 
-	Int cellRadius = ThePartitionManager->worldToCellDist(radius);
+	Int cellRadius = worldToCellDist(update.m_radius);
 	if (cellRadius < 1)
 		cellRadius = 1;
 
-	Real fCellRadius = INT_TO_REAL(cellRadius + 1);
+	VerifyCircleParms parms;
+	parms.type = update.m_type;
+	parms.remove = update.m_remove;
+	parms.amount = update.m_amount;
+	parms.xCenter = INT_TO_REAL(cellCenterX);
+	parms.yCenter = INT_TO_REAL(cellCenterY);
+	parms.radius = INT_TO_REAL(cellRadius + 1);
 
 	DiscreteCircle circle(cellCenterX, cellCenterY, cellRadius);
 
-	ThreatValueParms parms;
-	parms.radius = fCellRadius;
-	parms.threatOrValue = valueVal;
-	parms.xCenter = fCellCenterX;
-	parms.yCenter = fCellCenterY;
-
 	for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
 	{
 		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
-		if( BitIsSet( playerMask, currentPlayer->getPlayerMask() ) )
+		if( BitIsSet( update.m_playerMask, currentPlayer->getPlayerMask() ) )
 		{
 			parms.playerIndex = currentIndex;
-			circle.drawCircle(hLineAddValue, &parms);
+			circle.drawCircle(hLineVerifyCircle, &parms);
 		}
 	}
 }
 
 //-----------------------------------------------------------------------------
-void PartitionManager::undoValueAffect( Real centerX, Real centerY, Real radius, UnsignedInt valueVal, PlayerMaskType playerMask)
+/// The looker and shrouder counts and the threat and value of every cell and player, in this order.
+void PartitionManager::getCircleCellStates(std::vector<Int> &states)
 {
-	Int cellCenterX, cellCenterY;
-	ThePartitionManager->worldToCell(centerX, centerY, &cellCenterX, &cellCenterY);
-	Real fCellCenterX = INT_TO_REAL(cellCenterX);
-	Real fCellCenterY = INT_TO_REAL(cellCenterY);
+	enum { VALUES_PER_PLAYER = 4 };
 
-	Int cellRadius = ThePartitionManager->worldToCellDist(radius);
-	if (cellRadius < 1)
-		cellRadius = 1;
+	states.resize(m_totalCellCount * MAX_PLAYER_COUNT * VALUES_PER_PLAYER);
+	std::vector<Int>::iterator state = states.begin();
+	for (Int y = 0; y < m_cellCountY; ++y)
+	{
+		for (Int x = 0; x < m_cellCountX; ++x)
+		{
+			ShroudLevel levels[MAX_PLAYER_COUNT];
+			m_shroudMap.getShroudLevels(x, y, levels);
 
-	Real fCellRadius = INT_TO_REAL(cellRadius + 1);
+			PartitionCell *cell = &m_cells[y * m_cellCountX + x];
+			for (Int i = 0; i < MAX_PLAYER_COUNT; ++i)
+			{
+				*state++ = levels[i].m_currentShroud;
+				*state++ = levels[i].m_activeShroudLevel;
+				*state++ = (Int)cell->getThreatValue(i);
+				*state++ = (Int)cell->getCashValue(i);
+			}
+		}
+	}
+}
 
-	DiscreteCircle circle(cellCenterX, cellCenterY, cellRadius);
+//-----------------------------------------------------------------------------
+void PartitionManager::runShroudBenchmark()
+{
+	if (m_cellCountX <= 0)
+		return;
 
-	ThreatValueParms parms;
-	parms.radius = fCellRadius;
-	parms.threatOrValue = valueVal;
-	parms.xCenter = fCellCenterX;
-	parms.yCenter = fCellCenterY;
+	m_shroudMap.stopRecording();
+	ShroudMap::runBenchmark(m_shroudMap.getRecording(), m_cellCountX, m_cellCountY, 10);
+}
 
-	for( Int currentIndex = ThePlayerList->getPlayerCount() - 1; currentIndex >=0; currentIndex-- )
+//-----------------------------------------------------------------------------
+/**
+	Applies random look, shroud, threat and value circles once through the span tables and once
+	through DiscreteCircle the way it was done before them, starting from the same cells, and
+	prints how many cells came out differently. The circles are taken back afterwards, but the
+	client may have been told about the shroud in between, so this is only meant for the end of a game.
+*/
+void PartitionManager::verifyCircles(UnsignedInt seed, Int updateCount)
+{
+	if (m_totalCellCount == 0 || ThePlayerList->getPlayerCount() == 0)
+		return;
+
+	// A local generator, so that the game's random numbers stay untouched.
+	UnsignedInt random = seed != 0 ? seed : 1;
+	#define VERIFY_CIRCLE_RANDOM() (random ^= random << 13, random ^= random >> 17, random ^= random << 5, random)
+
+	const Real border = 10.0f * m_cellSize;
+	const Real width = m_worldExtents.hi.x - m_worldExtents.lo.x + 2.0f * border;
+	const Real height = m_worldExtents.hi.y - m_worldExtents.lo.y + 2.0f * border;
+
+	// Every removal takes back an earlier addition, as the game does, so that no count goes negative.
+	std::vector<CircleUpdate> updates;
+	std::vector<CircleUpdate> added;
+	updates.reserve(updateCount);
+	for (Int i = 0; i < updateCount; ++i)
 	{
-		const Player *currentPlayer = ThePlayerList->getNthPlayer( currentIndex );
-		if( BitIsSet( playerMask, currentPlayer->getPlayerMask() ) )
+		if (!added.empty() && VERIFY_CIRCLE_RANDOM() % 3 == 0)
 		{
-			parms.playerIndex = currentIndex;
-			circle.drawCircle(hLineRemoveValue, &parms);
+			const size_t index = VERIFY_CIRCLE_RANDOM() % added.size();
+			CircleUpdate update = added[index];
+			update.m_remove = TRUE;
+			updates.push_back(update);
+			added[index] = added.back();
+			added.pop_back();
+			continue;
+		}
+
+		CircleUpdate update;
+		update.m_type = VERIFY_CIRCLE_RANDOM() % CircleUpdate::TYPE_COUNT;
+		update.m_remove = FALSE;
+		update.m_x = m_worldExtents.lo.x - border + width * (VERIFY_CIRCLE_RANDOM() % 10000) / 10000.0f;
+		update.m_y = m_worldExtents.lo.y - border + height * (VERIFY_CIRCLE_RANDOM() % 10000) / 10000.0f;
+		update.m_radius = INT_TO_REAL(VERIFY_CIRCLE_RANDOM() % 500);
+		update.m_amount = VERIFY_CIRCLE_RANDOM() % 5000;
+		update.m_playerMask = 0;
+		for (Int p = 0; p < ThePlayerList->getPlayerCount(); ++p)
+		{
+			if (VERIFY_CIRCLE_RANDOM() % 2 == 0)
+				update.m_playerMask |= ThePlayerList->getNthPlayer(p)->getPlayerMask();
+		}
+		updates.push_back(update);
+		added.push_back(update);
+	}
+	#undef VERIFY_CIRCLE_RANDOM
+
+	std::vector<Int> startStates, spanStates, drawnStates;
+	getCircleCellStates(startStates);
+
+	for (std::vector<CircleUpdate>::const_iterator it = updates.begin(); it != updates.end(); ++it)
+		applyCircleUpdate(*it, TRUE);
+	getCircleCellStates(spanStates);
+
+	// Take the circles back in reverse order to start the reference from the same cells.
+	for (std::vector<CircleUpdate>::const_reverse_iterator it = updates.rbegin(); it != updates.rend(); ++it)
+	{
+		CircleUpdate undo = *it;
+		undo.m_remove = !undo.m_remove;
+		applyCircleUpdate(undo, TRUE);
+	}
+	Int undoMismatchCount = 0;
+	getCircleCellStates(drawnStates);
+	for (size_t i = 0; i < startStates.size(); ++i)
+	{
+		if (drawnStates[i] != startStates[i])
+			++undoMismatchCount;
+	}
+
+	for (std::vector<CircleUpdate>::const_iterator it = updates.begin(); it != updates.end(); ++it)
+		applyCircleUpdate(*it, FALSE);
+	getCircleCellStates(drawnStates);
+
+	for (std::vector<CircleUpdate>::const_reverse_iterator it = updates.rbegin(); it != updates.rend(); ++it)
+	{
+		CircleUpdate undo = *it;
+		undo.m_remove = !undo.m_remove;
+		applyCircleUpdate(undo, FALSE);
+	}
+
+	static const char *const valueNames[] = { "looker", "shrouder", "threat", "value" };
+	Int mismatchCounts[4] = { 0, 0, 0, 0 };
+	Int printedCount = 0;
+	for (size_t i = 0; i < spanStates.size(); ++i)
+	{
+		if (spanStates[i] == drawnStates[i])
+			continue;
+
+		const Int valueIndex = (Int)(i % 4);
+		++mismatchCounts[valueIndex];
+		if (printedCount < 10)
+		{
+			const Int cellIndex = (Int)(i / (4 * MAX_PLAYER_COUNT));
+			const Int playerIndex = (Int)(i / 4 % MAX_PLAYER_COUNT);
+			ProfileUtil::print("Circle mismatch: %s of player %d in cell %d,%d is %d, DiscreteCircle gives %d\n",
+				valueNames[valueIndex], playerIndex, cellIndex % m_cellCountX, cellIndex / m_cellCountX, spanStates[i], drawnStates[i]);
+			++printedCount;
 		}
 	}
+
+	ProfileUtil::print("Circles: %d updates of seed %u on %dx%d cells, mismatches: %d looker, %d shrouder, %d threat, %d value, %d after taking them back\n",
+		updateCount, seed, m_cellCountX, m_cellCountY, mismatchCounts[0], mismatchCounts[1], mismatchCounts[2], mismatchCounts[3], undoMismatchCount);
 }
 
 //-----------------------------------------------------------------------------
@@ -5624,186 +5985,6 @@ static int cellValueProc(PartitionCell* cell, void* userData)
 	return 0;
 }
 
-// -----------------------------------------------------------------------------
-static void hLineAddLooker(Int x1, Int x2, Int y, void *playerIndexVoid)
-{
-	if (y < 0 || y >= ThePartitionManager->m_cellCountY || x1 >= ThePartitionManager->m_cellCountX || x2 < 0)
-		return;
-
-	Int playerIndex = (Int)(playerIndexVoid);
-
-	PartitionCell* cell = &ThePartitionManager->m_cells[y * ThePartitionManager->m_cellCountX + x1];	// yes, this could be invalid. we'll skip the bad ones.
-	for (Int x = x1; x <= x2; ++x, ++cell)
-	{
-		if (x < 0 || x >= ThePartitionManager->m_cellCountX)
-			continue;
-		cell->addLooker(playerIndex);
-	}
-}
-
-// -----------------------------------------------------------------------------
-static void hLineRemoveLooker(Int x1, Int x2, Int y, void *playerIndexVoid)
-{
-	if (y < 0 || y >= ThePartitionManager->m_cellCountY || x1 >= ThePartitionManager->m_cellCountX || x2 < 0)
-		return;
-
-	Int playerIndex = (Int)(playerIndexVoid);
-
-	PartitionCell* cell = &ThePartitionManager->m_cells[y * ThePartitionManager->m_cellCountX + x1];	// yes, this could be invalid. we'll skip the bad ones.
-	for (Int x = x1; x <= x2; ++x, ++cell)
-	{
-		if (x < 0 || x >= ThePartitionManager->m_cellCountX)
-			continue;
-		cell->removeLooker(playerIndex);
-	}
-}
-
-// -----------------------------------------------------------------------------
-static void hLineAddShrouder(Int x1, Int x2, Int y, void *playerIndexVoid)
-{
-	if (y < 0 || y >= ThePartitionManager->m_cellCountY || x1 >= ThePartitionManager->m_cellCountX || x2 < 0)
-		return;
-
-	Int playerIndex = (Int)(playerIndexVoid);
-
-	PartitionCell* cell = &ThePartitionManager->m_cells[y * ThePartitionManager->m_cellCountX + x1];	// yes, this could be invalid. we'll skip the bad ones.
-	for (Int x = x1; x <= x2; ++x, ++cell)
-	{
-		if (x < 0 || x >= ThePartitionManager->m_cellCountX)
-			continue;
-		cell->addShrouder( playerIndex );
-	}
-}
-
-// -----------------------------------------------------------------------------
-static void hLineRemoveShrouder(Int x1, Int x2, Int y, void *playerIndexVoid)
-{
-	if (y < 0 || y >= ThePartitionManager->m_cellCountY || x1 >= ThePartitionManager->m_cellCountX || x2 < 0)
-		return;
-
-	Int playerIndex = (Int)(playerIndexVoid);
-
-	PartitionCell* cell = &ThePartitionManager->m_cells[y * ThePartitionManager->m_cellCountX + x1];	// yes, this could be invalid. we'll skip the bad ones.
-	for (Int x = x1; x <= x2; ++x, ++cell)
-	{
-		if (x < 0 || x >= ThePartitionManager->m_cellCountX)
-			continue;
-		cell->removeShrouder( playerIndex );
-	}
-}
-
-// -----------------------------------------------------------------------------
-static void hLineAddThreat(Int x1, Int x2, Int y, void *threatValueParms)
-{
-	if (y < 0 || y >= ThePartitionManager->m_cellCountY || x1 >= ThePartitionManager->m_cellCountX || x2 < 0)
-		return;
-
-	ThreatValueParms *parms = (ThreatValueParms*)threatValueParms;
-
-	Real distance;
-	Real mulVal = 1.0f;
-
-	PartitionCell* cell = &ThePartitionManager->m_cells[y * ThePartitionManager->m_cellCountX + x1];	// yes, this could be invalid. we'll skip the bad ones.
-	for (Int x = x1; x <= x2; ++x, ++cell)
-	{
-		if (x < 0 || x >= ThePartitionManager->m_cellCountX)
-			continue;
-
-		distance = sqrt( pow(x - parms->xCenter, 2) + pow(y - parms->yCenter, 2) );
-		mulVal = 1 - distance / parms->radius;
-		if (mulVal < 0.0f)
-			mulVal = 0.0f;
-		else if (mulVal > 1.0f)
-			mulVal = 1.0f;
-
-		cell->addThreatValue( parms->playerIndex, REAL_TO_UNSIGNEDINT(parms->threatOrValue * mulVal) );
-	}
-}
-
-// -----------------------------------------------------------------------------
-static void hLineRemoveThreat(Int x1, Int x2, Int y, void *threatValueParms)
-{
-	if (y < 0 || y >= ThePartitionManager->m_cellCountY || x1 >= ThePartitionManager->m_cellCountX || x2 < 0)
-		return;
-
-	ThreatValueParms *parms = (ThreatValueParms*)threatValueParms;
-
-	Real distance;
-	Real mulVal = 1.0f;
-
-	PartitionCell* cell = &ThePartitionManager->m_cells[y * ThePartitionManager->m_cellCountX + x1];	// yes, this could be invalid. we'll skip the bad ones.
-	for (Int x = x1; x <= x2; ++x, ++cell)
-	{
-		if (x < 0 || x >= ThePartitionManager->m_cellCountX)
-			continue;
-
-		distance = sqrt( pow(x - parms->xCenter, 2) + pow(y - parms->yCenter, 2) );
-		mulVal = 1 - distance / parms->radius;
-		if (mulVal < 0.0f)
-			mulVal = 0.0f;
-		else if (mulVal > 1.0f)
-			mulVal = 1.0f;
-
-		cell->removeThreatValue( parms->playerIndex, REAL_TO_UNSIGNEDINT(parms->threatOrValue * mulVal) );
-	}
-}
-
-// -----------------------------------------------------------------------------
-static void hLineAddValue(Int x1, Int x2, Int y, void *threatValueParms)
-{
-	if (y < 0 || y >= ThePartitionManager->m_cellCountY || x1 >= ThePartitionManager->m_cellCountX || x2 < 0)
-		return;
-
-	ThreatValueParms *parms = (ThreatValueParms*)threatValueParms;
-
-	Real distance;
-	Real mulVal = 1.0f;
-
-	PartitionCell* cell = &ThePartitionManager->m_cells[y * ThePartitionManager->m_cellCountX + x1];	// yes, this could be invalid. we'll skip the bad ones.
-	for (Int x = x1; x <= x2; ++x, ++cell)
-	{
-		if (x < 0 || x >= ThePartitionManager->m_cellCountX)
-			continue;
-
-		distance = sqrt( pow(x - parms->xCenter, 2) + pow(y - parms->yCenter, 2) );
-		mulVal = 1 - distance / parms->radius;
-		if (mulVal < 0.0f)
-			mulVal = 0.0f;
-		else if (mulVal > 1.0f)
-			mulVal = 1.0f;
-
-		cell->addCashValue( parms->playerIndex, REAL_TO_UNSIGNEDINT(parms->threatOrValue * mulVal) );
-	}
-}
-
-// -----------------------------------------------------------------------------
-static void hLineRemoveValue(Int x1, Int x2, Int y, void *threatValueParms)
-{
-	if (y < 0 || y >= ThePartitionManager->m_cellCountY || x1 >= ThePartitionManager->m_cellCountX || x2 < 0)
-		return;
-
-	ThreatValueParms *parms = (ThreatValueParms*)threatValueParms;
-
-	Real distance;
-	Real mulVal = 1.0f;
-
-	PartitionCell* cell = &ThePartitionManager->m_cells[y * ThePartitionManager->m_cellCountX + x1];	// yes, this could be invalid. we'll skip the bad ones.
-	for (Int x = x1; x <= x2; ++x, ++cell)
-	{
-		if (x < 0 || x >= ThePartitionManager->m_cellCountX)
-			continue;
-
-		distance = sqrt( pow(x - parms->xCenter, 2) + pow(y - parms->yCenter, 2) );
-		mulVal = 1 - distance / parms->radius;
-		if (mulVal < 0.0f)
-			mulVal = 0.0f;
-		else if (mulVal > 1.0f)
-			mulVal = 1.0f;
-
-		cell->removeCashValue( parms->playerIndex, REAL_TO_UNSIGNEDINT(parms->threatOrValue * mulVal) );
-	}
-}
-
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 SightingInfo::SightingInfo()
@@ -271,3 +271,94 @@ Real SimpleObjectIterator::sortExpensiveToCheap(Clump *a, Clump *b)
 				 a->m_obj->getTemplate()->friend_getBuildCost();
 }
 
+//=============================================================================
+ObjectRangeBuffer::EntryCompareProc ObjectRangeBuffer::theEntryCompareProcs[] =
+{
+	NULL,						// "fastest" gets no proc
+	ObjectRangeBuffer::sortNearToFar,
+	ObjectRangeBuffer::sortFarToNear,
+	ObjectRangeBuffer::sortCheapToExpensive,
+	ObjectRangeBuffer::sortExpensiveToCheap
+};
+
+//=============================================================================
+void ObjectRangeBuffer::insert(Object *obj, Real numeric)
+{
+	DEBUG_ASSERTCRASH(obj, ("sorry, no nulls allowed here"));
+
+	Entry entry;
+	entry.m_obj = obj;
+	entry.m_numeric = numeric;
+	m_entries.push_back(entry);
+}
+
+//=============================================================================
+void ObjectRangeBuffer::sort(IterOrderType order)
+{
+	// SimpleObjectIterator inserts at the head of its list, so flip to its order first.
+	std::reverse(m_entries.begin(), m_entries.end());
+
+	EntryCompareProc cmpProc = theEntryCompareProcs[order];
+	const Int count = (Int)m_entries.size();
+	if (!cmpProc || count < 2)
+		return;
+
+	// the same stable mergesort as SimpleObjectIterator::sort, with the same
+	// compare procs, so that objects that compare equal keep the same order.
+	m_scratch.resize(count);
+	EntryVec *from = &m_entries;
+	EntryVec *to = &m_scratch;
+	for (Int n = 1; n < count; n *= 2)
+	{
+		for (Int start = 0; start < count; start += 2 * n)
+		{
+			Int left = start;
+			const Int leftEnd = min(start + n, count);
+			Int right = leftEnd;
+			const Int rightEnd = min(start + 2 * n, count);
+			Int out = start;
+
+			while (left < leftEnd && right < rightEnd)
+			{
+				if ((*cmpProc)((*from)[left], (*from)[right]) <= 0.0f)
+					(*to)[out++] = (*from)[left++];
+				else
+					(*to)[out++] = (*from)[right++];
+			}
+			while (left < leftEnd)
+				(*to)[out++] = (*from)[left++];
+			while (right < rightEnd)
+				(*to)[out++] = (*from)[right++];
+		}
+		std::swap(from, to);
+	}
+
+	if (from != &m_entries)
+		m_entries.swap(m_scratch);
+}
+
+//-----------------------------------------------------------------------------
+Real ObjectRangeBuffer::sortNearToFar(const Entry &a, const Entry &b)
+{
+	return a.m_numeric - b.m_numeric;
+}
+
+//-----------------------------------------------------------------------------
+Real ObjectRangeBuffer::sortFarToNear(const Entry &a, const Entry &b)
+{
+	return b.m_numeric - a.m_numeric;
+}
+
+//-----------------------------------------------------------------------------
+Real ObjectRangeBuffer::sortCheapToExpensive(const Entry &a, const Entry &b)
+{
+	return a.m_obj->getTemplate()->friend_getBuildCost() -
+				 b.m_obj->getTemplate()->friend_getBuildCost();
+}
+
+//-----------------------------------------------------------------------------
+Real ObjectRangeBuffer::sortExpensiveToCheap(const Entry &a, const Entry &b)
+{
+	return b.m_obj->getTemplate()->friend_getBuildCost() -
+				 a.m_obj->getTemplate()->friend_getBuildCost();
+}
@@ -196,11 +196,11 @@ UpdateSleepTime StealthDetectorUpdate::update( void )
 	}
 	Bool foundSomeone = FALSE;
 
-	SimpleObjectIterator *iter = ThePartitionManager->iterateObjectsInRange(
-								self, visionRange, FROM_CENTER_2D, filters);
-	MemoryPoolObjectHolder hold(iter);
-	for (Object *them = iter->first(); them; them = iter->next())
+	ObjectRangeBufferHolder candidates;
+	ThePartitionManager->getObjectsInRange(self, visionRange, FROM_CENTER_2D, candidates, filters);
+	for (Int i = 0; i < candidates->getCount(); ++i)
 	{
+		Object *them = candidates->getObject(i);
 		if ( them->isEffectivelyDead() )
 			continue;
 
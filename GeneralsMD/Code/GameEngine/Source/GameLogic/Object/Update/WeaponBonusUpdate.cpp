@@ -138,19 +138,17 @@ UpdateSleepTime WeaponBonusUpdate::update( void )
 	PartitionFilter *filters[] = { &relationship, &filterAlive, &filterMapStatus, NULL };
 
 	// scan objects in our region
-	ObjectIterator *iter = ThePartitionManager->iterateObjectsInRange( me->getPosition(),
-																																			data->m_bonusRange,
-																																			FROM_CENTER_2D,
-																																			filters );
-	MemoryPoolObjectHolder hold( iter );
+	ObjectRangeBufferHolder candidates;
+	ThePartitionManager->getObjectsInRange( me->getPosition(), data->m_bonusRange, FROM_CENTER_2D, candidates, filters );
 	tempWeaponBonusData weaponBonusData;
 	weaponBonusData.m_type = data->m_bonusConditionType;
 	weaponBonusData.m_duration = data->m_bonusDuration;
 	weaponBonusData.m_requiredMask = data->m_requiredAffectKindOf;
 	weaponBonusData.m_forbiddenMask = data->m_forbiddenAffectKindOf;
 
-	for( Object *currentObj = iter->first(); currentObj != NULL; currentObj = iter->next() )
+	for( Int i = 0; i < candidates->getCount(); ++i )
 	{
+		Object *currentObj = candidates->getObject( i );
 		if( currentObj->isKindOfMulti(data->m_requiredAffectKindOf, data->m_forbiddenAffectKindOf) )
 		{
 			currentObj->doTempWeaponBonus(data->m_bonusConditionType, data->m_bonusDuration);
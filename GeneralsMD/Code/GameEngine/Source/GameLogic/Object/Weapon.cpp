@@ -1353,9 +1353,8 @@ void WeaponTemplate::dealDamageInternal(ObjectID sourceID, ObjectID victimID, co
 	ObjectStatusTypes damageStatusType = getDamageStatusType();
 	if (getProjectileTemplate() == NULL || isProjectileDetonation)
 	{
-		SimpleObjectIterator *iter;
-		Object *curVictim;
-		Real curVictimDistSqr;
+		// TheSuperHackers @performance The victims are gathered into a pooled buffer instead of a new iterator per detonation.
+		ObjectRangeBufferHolder victims;
 
 		Real primaryRadius = getPrimaryDamageRadius(bonus);
 		Real secondaryRadius = getSecondaryDamageRadius(bonus);
@@ -1369,8 +1368,7 @@ void WeaponTemplate::dealDamageInternal(ObjectID sourceID, ObjectID victimID, co
 		Real radius = max(primaryRadius, secondaryRadius);
 		if (radius > 0.0f)
 		{
-			iter = ThePartitionManager->iterateObjectsInRange(pos, radius, DAMAGE_RANGE_CALC_TYPE);
-			curVictim = iter->firstWithNumeric(&curVictimDistSqr);
+			ThePartitionManager->getObjectsInRange(pos, radius, DAMAGE_RANGE_CALC_TYPE, victims);
 		}
 		else
 		{
@@ -1378,9 +1376,8 @@ void WeaponTemplate::dealDamageInternal(ObjectID sourceID, ObjectID victimID, co
 			// check against victimID rather than primaryVictim, since we may have targeted a legitimate victim
 			// that got killed before the damage was dealt... (srj)
 			//DEBUG_ASSERTCRASH(victimID != 0, ("weapons without radii should always pass in specific victims"));
-			iter = NULL;
-			curVictim = primaryVictim;
-			curVictimDistSqr = 0.0f;
+			if (primaryVictim != NULL)
+				victims->insert(primaryVictim, 0.0f);
 
 			if( affects & WEAPON_KILLS_SELF )
 			{
@@ -1395,10 +1392,11 @@ void WeaponTemplate::dealDamageInternal(ObjectID sourceID, ObjectID victimID, co
 				return;
 			}
 		}
-		MemoryPoolObjectHolder hold(iter);
 
-		for (; curVictim != NULL; curVictim = iter ? iter->nextWithNumeric(&curVictimDistSqr) : NULL)
+		for (Int victimIndex = 0; victimIndex < victims->getCount(); ++victimIndex)
 		{
+			Object *curVictim = victims->getObject(victimIndex);
+			Real curVictimDistSqr = victims->getNumeric(victimIndex);
 			Bool killSelf = false;
 			if (source != NULL)
 			{
@@ -41,6 +41,9 @@
 #include "Common/GameUtility.h"
 #include "Common/INI.h"
 #include "Common/LatchRestore.h"
+#include "Common/LoadProfiler.h"
+#include "Common/LogicProfiler.h"
+#include "Common/Tracer.h"
 #include "Common/MapObject.h"
 #include "Common/MultiplayerSettings.h"
 #include "Common/OSDisplay.h"
@@ -238,6 +241,7 @@ GameLogic::GameLogic( void )
 	//
 
 	m_frame = 0;
+	m_frameAllocationCount = 0;
 	m_hasUpdated = FALSE;
 	m_frameObjectsChangedTriggerAreas = 0;
 	m_width = 0;
@@ -1217,6 +1221,9 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	}
 
+	// TheSuperHackers @performance Time every phase of the map load, see LoadProfiler.
+	LoadProfiler::beginLoad();
+
 	m_rankLevelLimit = 1000;	// this is reset every game.
 	setDefaults( loadingSaveGame );
 	TheWritableGlobalData->m_loadScreenRender = TRUE;	///< mark it so only a few select things are rendered during load
@@ -1337,6 +1344,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 	// update the loadscreen
 	if(m_loadScreen)
 		updateLoadProgress(LOAD_PROGRESS_POST_PARTICLE_INI_LOAD);
+	LoadProfiler::markPhase("gameSetup");
 
 	DEBUG_ASSERTCRASH(m_frame == 0, ("framecounter expected to be 0 here"));
 
@@ -1350,6 +1358,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_LOAD_MAP);
+	LoadProfiler::markPhase("loadMap");
 
 	#ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
@@ -1539,6 +1548,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_SIDE_LIST_INIT);
+	LoadProfiler::markPhase("sideList");
 
 	// update the player list to match the new map.
 	TheTeamFactory->reset();
@@ -1546,12 +1556,14 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_PLAYER_LIST_RESET);
+	LoadProfiler::markPhase("playerList");
 
 	// Tell the script engine that a newe set of scripts is loaded.
 	TheScriptEngine->newMap();
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_SCRIPT_ENGINE_NEW_MAP);
+	LoadProfiler::markPhase("scriptEngine");
 
 	if (TheGameEngine->isMultiplayerSession() || isSkirmishOrSkirmishReplay)
 	{
@@ -1676,6 +1688,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_VICTORY_CONDITION_SETUP);
+	LoadProfiler::markPhase("victoryConditionSetup");
 
 	Player *localPlayer = ThePlayerList->getLocalPlayer();
 	Player *observerPlayer = ThePlayerList->findPlayerWithNameKey(TheNameKeyGenerator->nameToKey("ReplayObserver"));
@@ -1701,6 +1714,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_VICTORY_CONDITION_SET_VICTORY_CONDITION);
+	LoadProfiler::markPhase("radar");
 
 	// set the world extents to that of the map
 	Region3D extent;
@@ -1718,12 +1732,14 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_GHOST_OBJECT_MANAGER_RESET);
+	LoadProfiler::markPhase("partitionManager");
 
 	// update the terrain logic now that all is loaded
 	TheTerrainLogic->newMap( loadingSaveGame );
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_TERRAIN_LOGIC_NEW_MAP);
+	LoadProfiler::markPhase("terrainLogic");
 
 	#ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
@@ -1776,6 +1792,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_BRIDGE_LOAD);
+	LoadProfiler::markPhase("bridges");
 
 	// refresh the radar to reflect loaded bridges
 	TheRadar->refreshTerrain( TheTerrainLogic );
@@ -1786,6 +1803,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_PATHFINDER_NEW_MAP);
+	LoadProfiler::markPhase("pathfinder");
 
 	// reveal the map for the permanent observer
 	ThePartitionManager->revealMapForPlayerPermanently( observerPlayer->getPlayerIndex() );
@@ -1973,6 +1991,8 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	}
 
+	LoadProfiler::markPhase("objects");
+
 	#ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
 	sprintf(Buf,"After loading objects=%f",((double)(endTime64-startTime64)/(double)(freq64)*1000.0));
@@ -2052,6 +2072,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 	}
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_INITIAL_NETWORK_BUILDINGS);
+	LoadProfiler::markPhase("networkBuildings");
 
 	//
 	// tell the client to pre-load some assets that we will use such as faction things we
@@ -2076,6 +2097,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_PRELOAD_ASSETS);
+	LoadProfiler::markPhase("preloadAssets");
 
 	TheTacticalView->setAngleAndPitchToDefault();
 	TheTacticalView->setZoomToDefault();
@@ -2128,6 +2150,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_STARTING_CAMERA_2);
+	LoadProfiler::markPhase("camera");
 
 	// update partition info - We need to do the initial update so that it can be queried
 	// during the first frame.  jba.
@@ -2212,6 +2235,7 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 	}
 
 	updateLoadProgress(LOAD_PROGRESS_END);
+	LoadProfiler::markPhase("finishSetup");
 
 	if(isInMultiplayerGame() && TheNetwork)
 	{
@@ -2265,6 +2289,8 @@ void GameLogic::startNewGame( Bool loadingSaveGame )
 	DEBUG_LOG(("%s", Buf));
 	#endif
 
+	LoadProfiler::endLoad("loadScreen");
+
 	if(m_gameMode == GAME_SHELL)
 	{
 		if (!TheGlobalData->m_headless)
@@ -3701,14 +3727,20 @@ void GameLogic::update( void )
 	UnsignedInt now = TheGameLogic->getFrame();
 	TheGameClient->setFrame(now);
 
+	// TheSuperHackers @performance Count the memory allocations of the logic update, they show in the debug display.
+	const UnsignedInt allocationCountAtStart = getMemoryAllocationCount();
+
+	// TheSuperHackers @performance 18/10/2026 The phases of the update are timed during replay benchmarks.
 	// update (execute) scripts
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_SCRIPTS);
 		TheScriptEngine->UPDATE();
 	}
 
 	// Note - TerrainLogic update needs to happen after ScriptEngine update, but before object updates.  jba.
 	// This way changes in bridges are noted in the script engine before being cleared in TerrainLogic->update
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_TERRAIN);
 		TheTerrainLogic->UPDATE();
 	}
 
@@ -3726,6 +3758,7 @@ void GameLogic::update( void )
 
 	if (generateForSolo || generateForMP)
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_CRC);
 		m_CRC = getCRC( CRC_RECALC );
 		bool isPlayback = (TheRecorder && TheRecorder->isPlaybackMode());
 
@@ -3757,6 +3790,7 @@ void GameLogic::update( void )
 
 	// process client commands
 	{
+		TRACE_SCOPE("processCommandList");
 		processCommandList( TheCommandList );
 	}
 
@@ -3769,6 +3803,7 @@ void GameLogic::update( void )
 			if (!dis.any() || dis.anyIntersectionWith(u->getDisabledTypesToProcess()))
 			{
 				USE_PERF_TIMER(GameLogic_update_normal)
+				TRACE_SCOPE(u->getModuleName());
 
 				m_curUpdateModule = u;
 
@@ -3786,6 +3821,7 @@ void GameLogic::update( void )
 #endif
 
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_SLEEPY_UPDATES);
 		while (!m_sleepyUpdates.empty())
 		{
 			UpdateModulePtr u = peekSleepyUpdate();
@@ -3809,6 +3845,8 @@ void GameLogic::update( void )
 			if (!dis.any() || dis.anyIntersectionWith(u->getDisabledTypesToProcess()))
 			{
 				USE_PERF_TIMER(GameLogic_update_sleepy)
+				// TheSuperHackers @performance 18/10/2026 Trace the update modules by type.
+				TRACE_SCOPE(u->getModuleName());
 
 				//DEBUG_LOG(("calling update %08lx (%d %d)...",update,update->friend_getNextCallFrame(),update->friend_getNextCallPhase()));
 				m_curUpdateModule = u;
@@ -3832,6 +3870,7 @@ void GameLogic::update( void )
 
 	// update the Artificial Intelligence system
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_AI);
 		TheAI->UPDATE();
 	}
 
@@ -3842,6 +3881,7 @@ void GameLogic::update( void )
 
 	// update partition info
 	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_PARTITION);
 		ThePartitionManager->UPDATE();
 	}
 
@@ -3850,7 +3890,11 @@ void GameLogic::update( void )
 	//
 
 	// destroy all pending objects
-	processDestroyList();
+	{
+		LogicPhaseScope phaseScope(LogicProfiler::PHASE_DESTROY_LIST);
+		TRACE_SCOPE("processDestroyList");
+		processDestroyList();
+	}
 
 	// reset the command list, destroying all messages
 	TheCommandList->reset();
@@ -3874,12 +3918,19 @@ void GameLogic::update( void )
 
 
 
+	// the counter wraps around, the unsigned difference is still right.
+	m_frameAllocationCount = getMemoryAllocationCount() - allocationCountAtStart;
+
 	// increment world time
 	if (!m_startNewGame)
 	{
 		m_frame++;
 		m_hasUpdated = TRUE;
 	}
+
+	// TheSuperHackers @performance 18/10/2026 Stream the zones of this frame to the trace file of -trace,
+	// so the buffers of the threads only need to hold a single frame.
+	Tracer::flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -157,6 +157,12 @@ public:
 	void doTextures(Bool flag) {m_disableTextures = !flag;};
 	/// Update the diffuse value from static light info for one vertex.
 	void doTheLight(VERTEX_FORMAT *vb, Vector3*light, Vector3*normal, RefRenderObjListIterator *pLightsIterator, UnsignedByte alpha);
+	/// Same as doTheLight, but with the global lights taken from the static lighting cache of the vertex.
+	void doTheCachedLight(VERTEX_FORMAT *vb, Vector3*light, Vector3*normal, UnsignedInt &staticLight, UnsignedByte alpha);
+	/// Recalculate the static lighting of the given map cells, because their heights have changed.
+	void invalidateStaticLighting(const IRegion2D &range);
+	/// Time rebuilding all and a few terrain blocks, with and without the static lighting cache, and print it.
+	void runRebuildBenchmark(Int repeats);
 	void addScorch(Vector3 location, Real radius, Scorches type);
 	void addTree(DrawableID id, Coord3D location, Real scale, Real angle,
 								Real randomScaleAmount,  const W3DTreeDrawModuleData *data);
@@ -211,6 +217,8 @@ public:
 	Real getMaxCellHeight(Real x, Real y) const;	///< returns maximum height of the 4 cell corners.
 	WorldHeightMap *getMap(void) {return m_map;}	///< returns object holding the heightmap samples - need this for fast access.
 	Bool isClearLineOfSight(const Coord3D& pos, const Coord3D& posOther) const;
+	/// Compare the max height pyramid with the cell by cell walk on random rays and print the mismatches.
+	void verifyLineOfSight(UnsignedInt seed, Int rayCount) const;
 
 	Bool getShowImpassableAreas(void) {return m_showImpassableAreas;}
 	void setShowImpassableAreas(Bool show) {m_showImpassableAreas = show;}
@@ -275,6 +283,54 @@ protected:
 	// STL is "smart." This is a variable sized bitset. Very memory efficient.
 	std::vector<bool> m_showAsVisibleCliff;
 
+	// TheSuperHackers @performance The lighting of the global lights only depends on the terrain, so it is
+	// calculated once per map vertex and kept until the lighting or the heights change.
+	enum { STATIC_LIGHTING_VALID = 0xff000000 };
+	struct LightSource
+	{
+		Vector3 position;	///< location of a point or spot light
+		Vector3 lightRay;	///< normalized ray of a directional light
+		Vector3 diffuse;
+		Vector3 ambient;
+		Real midRange;
+		Real range;
+		Bool isDirectional;
+	};
+	std::vector<UnsignedInt> m_staticLighting;	///< packed diffuse of the global lights for each map vertex, 0 until calculated.
+	Int m_staticLightingWidth;
+	Int m_staticLightingHeight;
+	const WorldHeightMap *m_staticLightingMap;	///< map the static lighting was calculated for, not owned.
+	std::vector<LightSource> m_lightSources;	///< lights of the light list, read once per vertex buffer update.
+
+	// TheSuperHackers @performance Maximum heights of blocks of cells, so that isClearLineOfSight can pass
+	// whole blocks that are lower than the line. Built on demand and dropped when the heights change.
+	enum { MAX_LOS_PYRAMID_LEVELS = 7 };
+	mutable std::vector<UnsignedByte> m_losPyramid;	///< all levels, level n holds blocks of 2^n by 2^n cells.
+	mutable Int m_losPyramidOffset[MAX_LOS_PYRAMID_LEVELS];	///< start of each level in m_losPyramid.
+	mutable Int m_losPyramidWidth[MAX_LOS_PYRAMID_LEVELS];	///< number of blocks in a row of each level.
+	mutable Int m_losPyramidLevels;
+	mutable const WorldHeightMap *m_losPyramidMap;	///< map the pyramid was built for, not owned.
+
+	void updateLineOfSightPyramid(WorldHeightMap *map) const;
+	Bool isClearLineOfSightOnMap(WorldHeightMap *map, const Coord3D& pos, const Coord3D& posOther, Bool usePyramid) const;
+
+	void prepareStaticLighting(WorldHeightMap *pMap);	///< resets the static lighting cache when the map changed.
+	void gatherLightSources(RefRenderObjListIterator *pLightsIterator);	///< reads the light list into m_lightSources.
+	UnsignedInt &getStaticLighting(Int x, Int y)	///< cached static lighting of the map vertex.
+	{
+		x = MIN(MAX(x, 0), m_staticLightingWidth - 1);
+		y = MIN(MAX(y, 0), m_staticLightingHeight - 1);
+		return m_staticLighting[x + y*m_staticLightingWidth];
+	}
+	Bool needsLightNormal(UnsignedInt staticLight) const	///< true if doTheCachedLight needs the vertex normal.
+	{
+#ifdef USE_NORMALS
+		return true;
+#else
+		return (staticLight & STATIC_LIGHTING_VALID) == 0 || !m_lightSources.empty();
+#endif
+	}
+
 
 	ShaderClass m_shaderClass; ///<shader or rendering state for heightmap
 	VertexMaterialClass	  	  *m_vertexMaterialClass;	///< vertex shader (lighting) for terrain
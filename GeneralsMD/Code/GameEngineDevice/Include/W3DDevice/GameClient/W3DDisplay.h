@@ -137,6 +137,9 @@ public:
 #endif
 	virtual void preloadModelAssets( AsciiString model );			///< preload model asset
 	virtual void preloadTextureAssets( AsciiString texture );	///< preload texture asset
+	virtual void beginModelAssetPreload( void );	///< queue the following model preloads and read them in the background
+	virtual void setModelAssetPreloadPriority( Int priority );	///< queued model preloads with lower priorities are loaded first
+	virtual void endModelAssetPreload( void );	///< finish loading all queued model preloads
 
 	/// @todo Need a scene abstraction
 	static RTS3DScene *m_3DScene;							///< our 3d scene representation
@@ -128,6 +128,8 @@ public:
 	virtual void setRawMapHeight(const ICoord2D *gridPos, Int height);
 	virtual Int getRawMapHeight(const ICoord2D *gridPos);
 
+	virtual void runRebuildBenchmark( Int repeats );
+
 	/// Replace the skybox texture
 	virtual void replaceSkyboxTextures(const AsciiString *oldTexName[NumSkyboxTextures], const AsciiString *newTexName[NumSkyboxTextures]);
 
@@ -310,6 +310,7 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 	Int xCoord, yCoord;
 	Int vn0,un0,vp1,up1;
 	Vector3 l2r,n2f,normalAtTexel;
+	UnsignedInt *staticLight;
 	Int	vertsPerRow=(VERTEX_BUFFER_TILE_LENGTH)*4;	//vertices per row of VB
 
 	Int cellOffset = 1;
@@ -324,6 +325,10 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 		assert(x0 >= originX && y0 >= originY && x1>x0 && y1>y0 && x1<=originX+VERTEX_BUFFER_TILE_LENGTH && y1<=originY+VERTEX_BUFFER_TILE_LENGTH);
 #endif
 
+		// TheSuperHackers @performance The global lights come from the static lighting cache, so only the light list is evaluated per vertex.
+		prepareStaticLighting(pMap);
+		gatherLightSources(pLightsIterator);
+
 		DX8VertexBufferClass::WriteLockClass lockVtxBuffer(pVB);
 		VERTEX_FORMAT *vbHardware = (VERTEX_FORMAT*)lockVtxBuffer.Get_Vertex_Array();
 		VERTEX_FORMAT *vBase = (VERTEX_FORMAT*)data;
@@ -382,14 +387,17 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 				}
 
 				//top-left sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset, getYWithOrigin(j)) - pMap->getDisplayHeight(un0, getYWithOrigin(j))));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i), (getYWithOrigin(j)+cellOffset)) - pMap->getDisplayHeight(getXWithOrigin(i), vn0)));
-
+				staticLight = &getStaticLighting(getXWithOrigin(i)+pMap->getDrawOrgX(), getYWithOrigin(j)+pMap->getDrawOrgY());
+				if (needsLightNormal(*staticLight))
+				{
+					l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset, getYWithOrigin(j)) - pMap->getDisplayHeight(un0, getYWithOrigin(j))));
+					n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i), (getYWithOrigin(j)+cellOffset)) - pMap->getDisplayHeight(getXWithOrigin(i), vn0)));
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+					normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+					Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
 #endif
+				}
 
 				vb->x=xCoord;
 				vb->y=yCoord;
@@ -400,18 +408,21 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 				vb->v1=V[0];
 				vb->u2=UA[0];
 				vb->v2=VA[0];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[0]);
+				doTheCachedLight(vb, lightRay, &normalAtTexel, *staticLight, alpha[0]);
 				vb++;
 
 				//top-right sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , getYWithOrigin(j) ) - pMap->getDisplayHeight(getXWithOrigin(i) , getYWithOrigin(j) )));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , vn0 )));
-
+				staticLight = &getStaticLighting(getXWithOrigin(i)+cellOffset+pMap->getDrawOrgX(), getYWithOrigin(j)+pMap->getDrawOrgY());
+				if (needsLightNormal(*staticLight))
+				{
+					l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , getYWithOrigin(j) ) - pMap->getDisplayHeight(getXWithOrigin(i) , getYWithOrigin(j) )));
+					n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , vn0 )));
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+					normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+					Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
 #endif
+				}
 
 				vb->x=xCoord+cellOffset;
 				vb->y=yCoord;
@@ -422,18 +433,21 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 				vb->v1=V[1];
 				vb->u2=UA[1];
 				vb->v2=VA[1];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[1]);
+				doTheCachedLight(vb, lightRay, &normalAtTexel, *staticLight, alpha[1]);
 				vb++;
 
 				//bottom-right sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(getXWithOrigin(i) , (getYWithOrigin(j)+cellOffset) )));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , vp1 ) - pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , getYWithOrigin(j) )));
-
+				staticLight = &getStaticLighting(getXWithOrigin(i)+cellOffset+pMap->getDrawOrgX(), getYWithOrigin(j)+cellOffset+pMap->getDrawOrgY());
+				if (needsLightNormal(*staticLight))
+				{
+					l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(up1 , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(getXWithOrigin(i) , (getYWithOrigin(j)+cellOffset) )));
+					n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , vp1 ) - pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , getYWithOrigin(j) )));
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+					normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+					Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
 #endif
+				}
 
 				vb->x=xCoord+cellOffset;
 				if (yCoord + 1 == pMap->getDrawOrgY() + m_y - 1) {
@@ -448,18 +462,21 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 				vb->v1=V[2];
 				vb->u2=UA[2];
 				vb->v2=VA[2];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[2]);
+				doTheCachedLight(vb, lightRay, &normalAtTexel, *staticLight, alpha[2]);
 				vb++;
 
 				//bottom-left sample
-				l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(un0 , (getYWithOrigin(j)+cellOffset) )));
-				n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i) , vp1 ) - pMap->getDisplayHeight(getXWithOrigin(i) , getYWithOrigin(j) )));
-
+				staticLight = &getStaticLighting(getXWithOrigin(i)+pMap->getDrawOrgX(), getYWithOrigin(j)+cellOffset+pMap->getDrawOrgY());
+				if (needsLightNormal(*staticLight))
+				{
+					l2r.Set(2*MAP_XY_FACTOR,0,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i)+cellOffset , (getYWithOrigin(j)+cellOffset) ) - pMap->getDisplayHeight(un0 , (getYWithOrigin(j)+cellOffset) )));
+					n2f.Set(0,2*MAP_XY_FACTOR,MAP_HEIGHT_SCALE*(pMap->getDisplayHeight(getXWithOrigin(i) , vp1 ) - pMap->getDisplayHeight(getXWithOrigin(i) , getYWithOrigin(j) )));
 #ifdef ALLOW_TEMPORARIES
-				normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
+					normalAtTexel= Normalize(Vector3::Cross_Product(l2r,n2f));
 #else
-				Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
+					Vector3::Normalized_Cross_Product(l2r, n2f, &normalAtTexel);
 #endif
+				}
 
 				if (xCoord == pMap->getDrawOrgX()) {
 					vb->x=xCoord;
@@ -479,7 +496,7 @@ Int HeightMapRenderObjClass::updateVB(DX8VertexBufferClass	*pVB, char *data, Int
 				vb->v1=V[3];
 				vb->u2=UA[3];
 				vb->v2=VA[3];
-				doTheLight(vb, lightRay, &normalAtTexel, pLightsIterator, alpha[3]);
+				doTheCachedLight(vb, lightRay, &normalAtTexel, *staticLight, alpha[3]);
 				vb++;
 
 				VERTEX_FORMAT *pCurVertices = vb-4;
@@ -917,6 +934,8 @@ The vertex coordinates and texture coordinates, as well as static lighting are u
 */
 void HeightMapRenderObjClass::doPartialUpdate(const IRegion2D &partialRange, WorldHeightMap *htMap, RefRenderObjListIterator *pLightsIterator)
 {
+	invalidateStaticLighting(partialRange);
+
 	// Adjust range into the current drawn map range.
 	Int minX = partialRange.lo.x - htMap->getDrawOrgX();
 	Int maxX = partialRange.hi.x - htMap->getDrawOrgX();
@@ -1001,6 +1020,8 @@ void HeightMapRenderObjClass::doPartialUpdate(const IRegion2D &partialRange, Wor
 	updateViewImpassableAreas(TRUE, minX, maxX, minY, maxY);
 }
 
+DECLARE_PERF_TIMER(Terrain_UpdateBlock)
+
 //=============================================================================
 // HeightMapRenderObjClass::updateBlock
 //=============================================================================
@@ -1009,6 +1030,8 @@ The vertex coordinates and texture coordinates, as well as static lighting are u
 */
 Int HeightMapRenderObjClass::updateBlock(Int x0, Int y0, Int x1, Int y1,  WorldHeightMap *pMap, RefRenderObjListIterator *pLightsIterator)
 {
+	USE_PERF_TIMER(Terrain_UpdateBlock)
+
 #ifdef RTS_DEBUG
 	DEBUG_ASSERTCRASH(x0>=0,  ("HeightMapRenderObjClass::UpdateBlock parameters extend beyond left edge."));
 	DEBUG_ASSERTCRASH(y0>=0,  ("HeightMapRenderObjClass::UpdateBlock parameters extend beyond bottom edge."));
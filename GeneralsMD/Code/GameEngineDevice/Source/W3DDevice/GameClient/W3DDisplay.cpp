@@ -42,6 +42,8 @@ static void drawFramerateBar(void);
 
 // USER INCLUDES //////////////////////////////////////////////////////////////
 #include "Common/FramePacer.h"
+#include "Common/GameEndChecks.h"
+#include "Common/ProfileUtil.h"
 #include "Common/ThingFactory.h"
 #include "Common/GlobalData.h"
 #include "Common/PerfTimer.h"
@@ -96,6 +98,8 @@ static void drawFramerateBar(void);
 #include "WW3D2/dx8webbrowser.h"
 #include "WW3D2/mesh.h"
 #include "WW3D2/hlod.h"
+#include "WW3D2/htree.h"
+#include "WW3D2/hanim.h"
 #include "WW3D2/meshmatdesc.h"
 #include "WW3D2/meshmdl.h"
 #include "WW3D2/rddesc.h"
@@ -376,6 +380,8 @@ inline Int64 getPerformanceCounterFrequency()
 	return tmp;
 }
 
+static void runAnimationBenchmark( UnsignedInt );
+
 // W3DDisplay::W3DDisplay =====================================================
 /** */
 //=============================================================================
@@ -404,6 +410,8 @@ W3DDisplay::W3DDisplay()
 	for (i = 0; i < DisplayStringCount; i++)
 		m_displayStrings[i] = NULL;
 
+	GameEndChecks::registerCheck(GameEndChecks::BENCHMARK_ANIM, runAnimationBenchmark);
+
 }
 
 // W3DDisplay::~W3DDisplay ====================================================
@@ -840,6 +848,114 @@ void W3DDisplay::init( void )
 	}
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Animate many instances of every compressed animation that the game has loaded, each at its own
+	frame, once through the channel caches that are shared by all instances and once through a
+	cursor per instance. Both have to produce the same pivot transforms. */
+//-------------------------------------------------------------------------------------------------
+static void benchmarkAnimations( WW3DAssetManager *assetManager, Int instances, Int passes )
+{
+	LARGE_INTEGER freq, start, stop;
+	QueryPerformanceFrequency(&freq);
+
+	Int animCount = 0;
+	Int64 pivotUpdates = 0;
+	Int64 sharedTicks = 0;
+	Int64 cursorTicks = 0;
+	Int mismatches = 0;
+
+	HAnimCursorClass *cursors = NEW HAnimCursorClass[instances];
+	Real *frames = NEW Real[instances];
+
+	AssetIterator *it = assetManager->Create_HAnim_Iterator();
+	for (it->First(); !it->Is_Done(); it->Next())
+	{
+		HAnimClass *anim = assetManager->Get_HAnim(it->Current_Item_Name());
+		if (anim == NULL)
+			continue;
+
+		HTreeClass *baseTree = NULL;
+		if (anim->Class_ID() == HAnimClass::CLASSID_HCOMPRESSEDANIM && anim->Get_Num_Frames() > 1)
+			baseTree = assetManager->Get_HTree(anim->Get_HName());
+
+		if (baseTree != NULL)
+		{
+			HTreeClass tree(*baseTree);
+			const Matrix3D root(true);
+			const Real lastFrame = (Real)(anim->Get_Num_Frames() - 1);
+			const Real frameStep = anim->Get_Frame_Rate() / LOGICFRAMES_PER_SECOND;
+			const Int lastPivot = tree.Num_Pivots() - 1;
+			Int i, p;
+
+			// Spread the instances over the animation, like units that started it at different times.
+			for (i = 0; i < instances; ++i)
+			{
+				frames[i] = lastFrame * i / instances;
+				cursors[i].Reset();
+			}
+
+			for (p = 0; p < passes; ++p)
+			{
+				QueryPerformanceCounter(&start);
+				for (i = 0; i < instances; ++i)
+					tree.Anim_Update(root, anim, (Real)fmod(frames[i] + p * frameStep, lastFrame));
+				QueryPerformanceCounter(&stop);
+				sharedTicks += stop.QuadPart - start.QuadPart;
+
+				QueryPerformanceCounter(&start);
+				for (i = 0; i < instances; ++i)
+					tree.Anim_Update(root, anim, (Real)fmod(frames[i] + p * frameStep, lastFrame), &cursors[i]);
+				QueryPerformanceCounter(&stop);
+				cursorTicks += stop.QuadPart - start.QuadPart;
+			}
+
+			for (i = 0; i < instances; ++i)
+			{
+				const Real frame = (Real)fmod(frames[i] + passes * frameStep, lastFrame);
+				tree.Anim_Update(root, anim, frame);
+				const Matrix3D shared = tree.Get_Transform(lastPivot);
+				tree.Anim_Update(root, anim, frame, &cursors[i]);
+				if (memcmp(&shared, &tree.Get_Transform(lastPivot), sizeof(Matrix3D)) != 0)
+					++mismatches;
+			}
+
+			++animCount;
+			pivotUpdates += (Int64)tree.Num_Pivots() * instances * passes;
+		}
+
+		anim->Release_Ref();
+	}
+	delete it;
+
+	delete [] frames;
+	delete [] cursors;
+
+	if (animCount == 0)
+		return;
+
+	const double sharedMs = (double)sharedTicks * 1000.0 / ((double)freq.QuadPart * passes);
+	const double cursorMs = (double)cursorTicks * 1000.0 / ((double)freq.QuadPart * passes);
+
+	ProfileUtil::print("Animation benchmark: %d compressed animations, %d instances each, %d passes, %lld pivot updates\n",
+		animCount, instances, passes, pivotUpdates);
+	ProfileUtil::print("  shared channel caches: %.3f ms per pass\n", sharedMs);
+	ProfileUtil::print("  instance cursors:      %.3f ms per pass\n", cursorMs);
+	if (mismatches != 0)
+		ProfileUtil::print("  MISMATCH: %d instances ended in a different pose\n", mismatches);
+
+	DEBUG_LOG(("W3DDisplay - animation benchmark of %d animations: shared %.3f ms, cursors %.3f ms, %d mismatches",
+		animCount, sharedMs, cursorMs, mismatches));
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The animation benchmark of -benchmarkAnim */
+//-------------------------------------------------------------------------------------------------
+static void runAnimationBenchmark( UnsignedInt )
+{
+	if (W3DDisplay::m_assetManager)
+		benchmarkAnimations(W3DDisplay::m_assetManager, 256, 30);
+}
+
 // W3DDisplay::reset ===========================================================
 /** Reset the W3D display system.  Here we need to
   * remove the objects from the previous map. */
@@ -1186,7 +1302,7 @@ void W3DDisplay::gatherDebugStats( void )
 		m_displayStrings[FPS]->setText( unibuffer );
 
 		// Actual GameLogic frame number
-		unibuffer.format(L"Frame: %d", TheGameLogic->getFrame());
+		unibuffer.format(L"Frame: %d, %u allocations in logic update", TheGameLogic->getFrame(), TheGameLogic->getFrameAllocationCount());
 		m_displayStrings[Frame]->setText( unibuffer );
 
 		// polygons this frame
@@ -3239,12 +3355,48 @@ void W3DDisplay::preloadModelAssets( AsciiString model )
 		AsciiString nameWithExtension;
 
 		nameWithExtension.format( "%s.w3d", model.str() );
-		m_assetManager->Load_3D_Assets( nameWithExtension.str() );
+		if( m_assetManager->isPreloading() )
+			m_assetManager->queuePreload( nameWithExtension.str() );
+		else
+			m_assetManager->Load_3D_Assets( nameWithExtension.str() );
 
 	}
 
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Start reading the preloaded models on worker threads */
+//-------------------------------------------------------------------------------------------------
+void W3DDisplay::beginModelAssetPreload( void )
+{
+
+	if( m_assetManager )
+		m_assetManager->beginPreload();
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Set the priority of the models preloaded from here on */
+//-------------------------------------------------------------------------------------------------
+void W3DDisplay::setModelAssetPreloadPriority( Int priority )
+{
+
+	if( m_assetManager )
+		m_assetManager->setPreloadPriority( priority );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Turn all preloaded models into prototypes, in the order of their priority */
+//-------------------------------------------------------------------------------------------------
+void W3DDisplay::endModelAssetPreload( void )
+{
+
+	if( m_assetManager )
+		m_assetManager->endPreload();
+
+}
+
 //-------------------------------------------------------------------------------------------------
 /** Preload using the W3D asset manager the texture referenced by the string parameter */
 //-------------------------------------------------------------------------------------------------
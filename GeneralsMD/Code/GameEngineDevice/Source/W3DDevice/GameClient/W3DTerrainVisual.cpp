@@ -483,6 +483,13 @@ void W3DTerrainVisual::updateSeismicSimulations( void )
       {
         Int border = m_clientHeightMap->getBorderSizeInline();
 
+        IRegion2D changedRange = hur->m_region;
+        changedRange.lo.x += border;
+        changedRange.lo.y += border;
+        changedRange.hi.x += border;
+        changedRange.hi.y += border;
+        TheTerrainRenderObject->invalidateStaticLighting( changedRange );
+
 		    TheTerrainRenderObject->updateBlock(
           hur->m_region.lo.x + border,
           hur->m_region.lo.y + border,
@@ -1136,6 +1143,14 @@ void W3DTerrainVisual::setShoreLineDetail(void)
 		m_terrainRenderObject->setShoreLineDetail();
 }
 
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DTerrainVisual::runRebuildBenchmark( Int repeats )
+{
+	if( m_terrainRenderObject )
+		m_terrainRenderObject->runRebuildBenchmark( repeats );
+}
+
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 /// Replace the skybox texture
@@ -252,6 +252,15 @@ Bool W3DTerrainLogic::isClearLineOfSight(const Coord3D& pos, const Coord3D& posO
 	}
 }
 
+//-------------------------------------------------------------------------------------------------
+void W3DTerrainLogic::verifyLineOfSight( UnsignedInt seed, Int rayCount ) const
+{
+	if (TheTerrainRenderObject)
+	{
+		TheTerrainRenderObject->verifyLineOfSight(seed, rayCount);
+	}
+}
+
 //-------------------------------------------------------------------------------------------------
 /** W3D specific get height function for logical terrain */
 //-------------------------------------------------------------------------------------------------
@@ -247,6 +247,7 @@ void Animatable3DObjClass::Release( void )
 				ModeAnim.Motion->Release_Ref();
 				ModeAnim.Motion = NULL;
 			}
+			AnimCursor.Reset();
 			break;
 
 		case DOUBLE_ANIM:
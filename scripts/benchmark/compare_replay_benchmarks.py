@@ -0,0 +1,181 @@
+# Created with python 3.11.4
+
+# This script compares the results of two replay benchmarks that were written with -benchmarkReplays.
+# It flags the replays and update phases whose mean logic frame time changed by more than the threshold,
+# if the change is statistically significant after Welch's t-test.
+#
+# The frames of one run depend on each other and share the state of the machine during that run, so they
+# are no independent samples. The test therefore compares the per run means, and every side needs several
+# runs of -benchmarkReplays:
+#   python compare_replay_benchmarks.py --baseline base1.json base2.json base3.json --candidate new1.json new2.json new3.json
+#
+# Returns exit code 1 if a regression was found, 2 if there are too few runs, 0 otherwise.
+
+import argparse
+import json
+import math
+import sys
+
+
+def mean(values: list[float]) -> float:
+    return sum(values) / len(values)
+
+
+def variance(values: list[float]) -> float:
+    m = mean(values)
+    return sum((v - m) * (v - m) for v in values) / (len(values) - 1)
+
+
+def incomplete_beta_fraction(a: float, b: float, x: float) -> float:
+    # Continued fraction of the regularized incomplete beta function, after Numerical Recipes.
+    tiny = 1e-300
+    c = 1.0
+    d = 1.0 - (a + b) * x / (a + 1.0)
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    h = d
+    for m in range(1, 300):
+        m2 = 2 * m
+        aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + aa / c
+        c = c if abs(c) > tiny else tiny
+        h *= d * c
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + aa / c
+        c = c if abs(c) > tiny else tiny
+        delta = d * c
+        h *= delta
+        if abs(delta - 1.0) < 1e-12:
+            break
+    return h
+
+
+def regularized_incomplete_beta(a: float, b: float, x: float) -> float:
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    front = math.exp(math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) + a * math.log(x) + b * math.log(1.0 - x))
+    if x < (a + 1.0) / (a + b + 2.0):
+        return front * incomplete_beta_fraction(a, b, x) / a
+    return 1.0 - front * incomplete_beta_fraction(b, a, 1.0 - x) / b
+
+
+def welch_p_value(a: list[float], b: list[float]) -> float:
+    # Two sided p-value of the difference of the means of the runs. With a handful of runs per side
+    # the t distribution with the Welch-Satterthwaite degrees of freedom is used.
+    va = variance(a) / len(a)
+    vb = variance(b) / len(b)
+    difference = abs(mean(b) - mean(a))
+    if va + vb == 0.0:
+        return 0.0 if difference != 0.0 else 1.0
+    t = difference / math.sqrt(va + vb)
+    dof = (va + vb) ** 2 / (va * va / (len(a) - 1) + vb * vb / (len(b) - 1))
+    return regularized_incomplete_beta(dof / 2.0, 0.5, dof / (dof + t * t))
+
+
+def load_runs(filenames: list[str]) -> dict:
+    replays = {}
+    for filename in filenames:
+        with open(filename, "r", encoding="utf-8") as file:
+            data = json.load(file)
+        for replay in data["replays"]:
+            if replay["failed"]:
+                print(f"Warning: {replay['replay']} failed in {filename} and is ignored")
+                continue
+            replays.setdefault(replay["replay"], []).append(replay)
+    return replays
+
+
+def run_frame_times(runs: list, statistic: str) -> list[float]:
+    key = "meanMs" if statistic == "mean" else "p50Ms"
+    return [run["frameTime"][key] for run in runs]
+
+
+def run_phase_times(runs: list, name: str) -> list[float]:
+    return [run["phases"][name]["meanMs"] for run in runs]
+
+
+def compare(name: str, base: list[float], new: list[float], args) -> str:
+    base_mean = mean(base)
+    new_mean = mean(new)
+    change = (new_mean - base_mean) / base_mean * 100.0 if base_mean > 0.0 else 0.0
+    p_value = welch_p_value(base, new)
+    verdict = ""
+    if p_value < args.alpha and abs(new_mean - base_mean) >= args.min_ms:
+        if change > args.threshold:
+            verdict = "REGRESSION"
+        elif change < -args.threshold:
+            verdict = "improvement"
+    print(f"  {name:<16} {base_mean:10.4f} ms {new_mean:10.4f} ms {change:+8.2f} %  p={p_value:.4f}  {verdict}")
+    return verdict
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two replay benchmark results of -benchmarkReplays.")
+    parser.add_argument("--baseline", nargs="+", required=True, help="benchmark files of the baseline build, one per run")
+    parser.add_argument("--candidate", nargs="+", required=True, help="benchmark files of the candidate build, one per run")
+    parser.add_argument("--min-runs", type=int, default=3, help="fewest runs per side and replay that are compared")
+    parser.add_argument("--statistic", choices=["mean", "median"], default="mean", help="per run frame time that is compared")
+    parser.add_argument("--threshold", type=float, default=3.0, help="smallest change in percent that is flagged")
+    parser.add_argument("--alpha", type=float, default=0.01, help="significance level of the t-test")
+    parser.add_argument("--min-ms", type=float, default=0.001, help="smallest change in milliseconds per frame that is flagged")
+    args = parser.parse_args()
+
+    if args.min_runs < 2:
+        print("Error: --min-runs must be at least 2, the run to run variance needs two runs")
+        return 2
+
+    baseline = load_runs(args.baseline)
+    candidate = load_runs(args.candidate)
+
+    regressions = 0
+    compared = 0
+    for replay in sorted(baseline):
+        if replay not in candidate:
+            print(f"Warning: {replay} is missing in the candidate results")
+            continue
+
+        base_runs = baseline[replay]
+        new_runs = candidate[replay]
+        print(f"{replay}")
+        if len(base_runs) < args.min_runs or len(new_runs) < args.min_runs:
+            print(f"  Skipped: {len(base_runs)} baseline and {len(new_runs)} candidate runs, {args.min_runs} per side are needed")
+            continue
+        compared += 1
+
+        # The simulation is deterministic, so every run of a replay must have the same number of frames.
+        frame_counts = set(run["frames"] for run in base_runs + new_runs)
+        if len(frame_counts) != 1:
+            print(f"  Warning: the runs have different frame counts {sorted(frame_counts)}")
+
+        base_fps = mean([run["logicFps"] for run in base_runs])
+        new_fps = mean([run["logicFps"] for run in new_runs])
+        print(f"  logic fps {base_fps:.1f} -> {new_fps:.1f} over {len(base_runs)} and {len(new_runs)} runs")
+        print(f"  {'':<16} {'baseline':>13} {'candidate':>13}")
+
+        frame_name = "frame" if args.statistic == "mean" else "frame p50"
+        if compare(frame_name, run_frame_times(base_runs, args.statistic), run_frame_times(new_runs, args.statistic), args) == "REGRESSION":
+            regressions += 1
+
+        for phase in base_runs[0]["phases"]:
+            if compare(phase, run_phase_times(base_runs, phase), run_phase_times(new_runs, phase), args) == "REGRESSION":
+                regressions += 1
+
+    for replay in sorted(candidate):
+        if replay not in baseline:
+            print(f"Warning: {replay} is missing in the baseline results")
+
+    if compared == 0:
+        print(f"Error: no replay has {args.min_runs} runs on both sides, run -benchmarkReplays several times per build")
+        return 2
+
+    print(f"Regressions found: {regressions}")
+    return 1 if regressions != 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())